@@ -0,0 +1,60 @@
+#include "common.h.hlsl"
+#include "scene_cb.h.hlsl"
+
+cbuffer Particle : register(b1) {
+  float2 ParticleParallax;
+  uint ParticleTextured;
+  uint Particle_pad;
+}
+
+struct VSInput {
+  uint vertexId : SV_VertexID;
+
+  // Per instance
+  float2 pos : POSITION;
+  float size : PSIZE;
+  float4 color : COLOR;
+};
+
+struct PSInput {
+  float4 pos : SV_POSITION;
+  float2 uv : TEXCOORD0;
+  float4 color : COLOR;
+};
+
+#if ANKER_VS
+
+PSInput main(VSInput vin) {
+  // Corners of the two triangles forming a quad, counter-clockwise:
+  // (0, 1), (0, 0), (1, 0), (0, 1), (1, 0), (1, 1). Bit i of each mask holds
+  // the coordinate of vertex i.
+  float2 corner = float2((0x34u >> vin.vertexId) & 1, (0x29u >> vin.vertexId) & 1);
+
+  float3 pos = float3(vin.pos + (corner - 0.5) * vin.size, 1);
+  pos.xy = applyParallax(ParticleParallax, pos.xy, SceneCameraPos);
+  pos = mul((float3x3)SceneView, pos);
+
+  PSInput pin;
+  pin.pos = float4(pos.xy, 0, 1);
+  pin.uv = float2(corner.x, 1 - corner.y);
+  pin.color = vin.color;
+  return pin;
+}
+
+#elif ANKER_PS
+
+Texture2D colorTex : register(t0);
+SamplerState colorSampler : register(s0);
+
+float4 main(PSInput pin) : SV_TARGET {
+  if (ParticleTextured) {
+    return colorTex.Sample(colorSampler, pin.uv) * pin.color;
+  }
+
+  // Untextured particles are drawn as soft discs.
+  float distance = length(pin.uv * 2 - 1);
+  float alpha = saturate(1 - distance);
+  return float4(pin.color.rgb, pin.color.a * alpha);
+}
+
+#endif
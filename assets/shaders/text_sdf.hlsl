@@ -0,0 +1,19 @@
+struct PSInput {
+  float4 pos : SV_POSITION;
+  float2 uv : TEXCOORD0;
+};
+
+#if ANKER_PS
+
+Texture2D distanceTex : register(t0);
+SamplerState distanceSampler : register(s0);
+
+float4 main(PSInput pin) : SV_TARGET {
+  // The outline is at 0.5, edges stay about one pixel wide at any scale.
+  float d = distanceTex.Sample(distanceSampler, pin.uv).x;
+  float w = max(fwidth(d), 1e-4);
+  float c = smoothstep(0.5 - w, 0.5 + w, d);
+  return float4(1, 0, 1, c);
+}
+
+#endif
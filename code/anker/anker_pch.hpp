@@ -1,10 +1,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <limits>
@@ -36,7 +42,7 @@
 #include <dxgi1_3.h>
 #pragma comment(lib, "dxguid.lib")
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 #pragma comment(lib, "d3d11.lib")
 
 #include <wrl.h>
@@ -0,0 +1,406 @@
+#include <anker/audio/anker_audio_mixer.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ANKER_AUDIO_MIXER_SSE2
+#endif
+
+namespace Anker {
+
+// Voice ids hold the slot in the lower bits.
+const u32 VoiceSlotBits = 8;
+static_assert(AudioMixer::MaxVoices == 1u << VoiceSlotBits);
+
+// Volume changes without fade are still ramped over a few frames, since
+// jumps are audible as clicks.
+const u32 MinRampFrames = 64;
+
+////////////////////////////////////////////////////////////
+// Sample Processing
+
+// dst[i] += src[i] * gain, with gain increasing by gainStep per stereo frame.
+static void addScaled(float* dst, const float* src, u32 frames, float gain, float gainStep)
+{
+	u32 i = 0;
+
+#ifdef ANKER_AUDIO_MIXER_SSE2
+	// Two stereo frames per vector.
+	__m128 gains = _mm_set_ps(gain + gainStep, gain + gainStep, gain, gain);
+	const __m128 gainSteps = _mm_set1_ps(2.0f * gainStep);
+
+	for (; i + 2 <= frames; i += 2) {
+		const __m128 samples = _mm_loadu_ps(src + i * AudioMixer::Channels);
+		const __m128 mixed = _mm_add_ps(_mm_loadu_ps(dst + i * AudioMixer::Channels), _mm_mul_ps(samples, gains));
+		_mm_storeu_ps(dst + i * AudioMixer::Channels, mixed);
+		gains = _mm_add_ps(gains, gainSteps);
+	}
+#endif
+
+	for (; i < frames; ++i) {
+		const float frameGain = gain + gainStep * float(i);
+		dst[i * AudioMixer::Channels + 0] += src[i * AudioMixer::Channels + 0] * frameGain;
+		dst[i * AudioMixer::Channels + 1] += src[i * AudioMixer::Channels + 1] * frameGain;
+	}
+}
+
+static void monoToStereo(float* dst, const float* src, u32 frames)
+{
+	u32 i = 0;
+
+#ifdef ANKER_AUDIO_MIXER_SSE2
+	for (; i + 4 <= frames; i += 4) {
+		const __m128 samples = _mm_loadu_ps(src + i);
+		_mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(samples, samples));
+		_mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(samples, samples));
+	}
+#endif
+
+	for (; i < frames; ++i) {
+		dst[i * 2 + 0] = src[i];
+		dst[i * 2 + 1] = src[i];
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Audio Ring
+
+AudioRing::AudioRing(u32 capacityFrames) : m_capacity(capacityFrames)
+{
+	m_samples.resize(usize(capacityFrames) * AudioMixer::Channels);
+}
+
+u32 AudioRing::writableFrames() const
+{
+	const u64 writeFrame = m_writeFrame.load(std::memory_order_relaxed);
+	return m_capacity - u32(writeFrame - m_readFrame.load(std::memory_order_acquire));
+}
+
+void AudioRing::write(std::span<const float> frames)
+{
+	const u64 writeFrame = m_writeFrame.load(std::memory_order_relaxed);
+	const u32 count = u32(frames.size() / AudioMixer::Channels);
+	ANKER_CHECK(count <= writableFrames());
+
+	// Copied in up to two parts, wrapping around at the end.
+	const u32 start = u32(writeFrame % m_capacity);
+	const u32 first = std::min(count, m_capacity - start);
+	std::copy_n(frames.data(), first * AudioMixer::Channels, m_samples.data() + start * AudioMixer::Channels);
+	std::copy_n(frames.data() + first * AudioMixer::Channels, (count - first) * AudioMixer::Channels,
+	            m_samples.data());
+
+	m_writeFrame.store(writeFrame + count, std::memory_order_release);
+}
+
+u32 AudioRing::read(float* output, u32 frames)
+{
+	const u64 readFrame = m_readFrame.load(std::memory_order_relaxed);
+	const u32 count = u32(std::min(u64(frames), m_writeFrame.load(std::memory_order_acquire) - readFrame));
+
+	const u32 start = u32(readFrame % m_capacity);
+	const u32 first = std::min(count, m_capacity - start);
+	std::copy_n(m_samples.data() + start * AudioMixer::Channels, first * AudioMixer::Channels, output);
+	std::copy_n(m_samples.data(), (count - first) * AudioMixer::Channels, output + first * AudioMixer::Channels);
+
+	m_readFrame.store(readFrame + count, std::memory_order_release);
+	return count;
+}
+
+bool AudioRing::drained() const
+{
+	// Frames written before finish are visible once finish is observed.
+	return m_finished.load(std::memory_order_acquire)
+	    && m_readFrame.load(std::memory_order_relaxed) == m_writeFrame.load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////
+// Game Thread
+
+AudioMixer::AudioMixer(u32 sampleRate) : m_sampleRate(sampleRate)
+{
+	// Lower slots are used first.
+	m_freeSlots.reserve(MaxVoices);
+	for (u32 slot = MaxVoices; slot > 0; --slot) {
+		m_freeSlots.push_back(slot - 1);
+	}
+}
+
+AudioMixer::VoiceId AudioMixer::play(AudioSamplesPtr samples, const AudioPlayParams& params)
+{
+	ANKER_CHECK(samples && samples->sampleRate > 0, 0);
+	ANKER_CHECK(samples->channels == 1 || samples->channels == 2, 0);
+	ANKER_CHECK(params.pitch > 0.0f, 0);
+
+	auto slot = startVoice({.type = Command::Type::Play, .samples = samples.get(), .params = params});
+	if (!slot) {
+		return 0;
+	}
+	m_samples[*slot] = std::move(samples);
+
+	return m_generations[*slot] << VoiceSlotBits | *slot;
+}
+
+AudioMixer::VoiceId AudioMixer::play(AudioRingPtr ring, const AudioPlayParams& params)
+{
+	ANKER_CHECK(ring, 0);
+
+	auto slot = startVoice({.type = Command::Type::Play, .ring = ring.get(), .params = params});
+	if (!slot) {
+		return 0;
+	}
+	m_rings[*slot] = std::move(ring);
+
+	return m_generations[*slot] << VoiceSlotBits | *slot;
+}
+
+std::optional<u32> AudioMixer::startVoice(const Command& play)
+{
+	if (m_freeSlots.empty()) {
+		ANKER_WARN("Not enough voices available");
+		return std::nullopt;
+	}
+
+	Command command = play;
+	command.slot = m_freeSlots.back();
+	if (!pushCommand(command)) {
+		return std::nullopt;
+	}
+	m_freeSlots.pop_back();
+
+	// Generations wrap around, skipping 0 to keep ids non-null.
+	u32& generation = m_generations[command.slot];
+	generation = (generation + 1) & ((1u << (32 - VoiceSlotBits)) - 1);
+	if (generation == 0) {
+		generation = 1;
+	}
+
+	return command.slot;
+}
+
+void AudioMixer::stop(VoiceId id, float fadeTime)
+{
+	if (auto slot = activeSlot(id)) {
+		pushCommand({.type = Command::Type::Stop, .slot = *slot, .params = {.fadeTime = fadeTime}});
+	}
+}
+
+void AudioMixer::setVolume(VoiceId id, float volume, float fadeTime)
+{
+	if (auto slot = activeSlot(id)) {
+		pushCommand({
+		    .type = Command::Type::SetVolume,
+		    .slot = *slot,
+		    .params = {.volume = volume, .fadeTime = fadeTime},
+		});
+	}
+}
+
+void AudioMixer::setMasterVolume(float volume)
+{
+	m_masterVolume = std::clamp(volume, 0.0f, 1.0f);
+	pushCommand({.type = Command::Type::SetMasterVolume, .params = {.volume = m_masterVolume}});
+}
+
+bool AudioMixer::isPlaying(VoiceId id) const
+{
+	return activeSlot(id).has_value();
+}
+
+void AudioMixer::update()
+{
+	while (auto slot = m_finished.pop()) {
+		m_samples[*slot].reset();
+		m_rings[*slot].reset();
+		m_freeSlots.push_back(*slot);
+	}
+}
+
+bool AudioMixer::pushCommand(const Command& command)
+{
+	if (!m_commands.push(command)) {
+		ANKER_WARN("Audio command queue is full, dropping command");
+		return false;
+	}
+	return true;
+}
+
+std::optional<u32> AudioMixer::activeSlot(VoiceId id) const
+{
+	const u32 slot = id & (MaxVoices - 1);
+	if (id == 0 || m_generations[slot] != id >> VoiceSlotBits || (!m_samples[slot] && !m_rings[slot])) {
+		return std::nullopt;
+	}
+	return slot;
+}
+
+////////////////////////////////////////////////////////////
+// Audio Thread
+
+void AudioMixer::setTarget(GainRamp& ramp, float target, float fadeTime) const
+{
+	const float rampFrames = std::max(fadeTime * float(m_sampleRate), float(MinRampFrames));
+	ramp.target = target;
+	ramp.step = (target - ramp.gain) / rampFrames;
+}
+
+void AudioMixer::mixRamped(float* dst, const float* src, u32 frames, GainRamp& ramp)
+{
+	u32 rampFrames = 0;
+	if (ramp.step != 0.0f) {
+		const u32 framesToTarget = u32(std::max(std::ceil((ramp.target - ramp.gain) / ramp.step), 1.0f));
+		rampFrames = std::min(frames, framesToTarget);
+		addScaled(dst, src, rampFrames, ramp.gain, ramp.step);
+
+		if (rampFrames == framesToTarget) {
+			ramp = {.gain = ramp.target, .target = ramp.target};
+		} else {
+			ramp.gain += ramp.step * float(rampFrames);
+		}
+	}
+
+	// Silent voices are still advanced, but not mixed.
+	if (ramp.gain != 0.0f) {
+		addScaled(dst + rampFrames * Channels, src + rampFrames * Channels, frames - rampFrames, ramp.gain, 0.0f);
+	}
+}
+
+void AudioMixer::processCommands()
+{
+	while (auto command = m_commands.pop()) {
+		switch (command->type) {
+		case Command::Type::Play: {
+			auto& voice = m_voices[command->slot];
+			const float volume = std::max(command->params.volume, 0.0f);
+			voice = {
+			    .samples = command->samples,
+			    .ring = command->ring,
+			    .gain = {.gain = volume, .target = volume},
+			};
+			if (command->samples) {
+				const double rateRatio = double(command->samples->sampleRate) / double(m_sampleRate);
+				voice.step = rateRatio * double(command->params.pitch);
+				voice.loop = command->params.loop;
+			}
+			if (command->params.fadeTime > 0.0f) {
+				voice.gain.gain = 0.0f;
+				setTarget(voice.gain, volume, command->params.fadeTime);
+			}
+			break;
+		}
+
+		case Command::Type::Stop: {
+			auto& voice = m_voices[command->slot];
+			if (voice.samples || voice.ring) {
+				setTarget(voice.gain, 0.0f, command->params.fadeTime);
+				voice.stopAtTarget = true;
+			}
+			break;
+		}
+
+		case Command::Type::SetVolume: {
+			auto& voice = m_voices[command->slot];
+			if ((voice.samples || voice.ring) && !voice.stopAtTarget) {
+				setTarget(voice.gain, std::max(command->params.volume, 0.0f), command->params.fadeTime);
+			}
+			break;
+		}
+
+		case Command::Type::SetMasterVolume:
+			setTarget(m_mixGain, command->params.volume, 0.0f);
+			break;
+		}
+	}
+}
+
+void AudioMixer::mix(std::span<float> output)
+{
+	ANKER_PROFILE_ZONE();
+
+	processCommands();
+
+	const u32 outputFrames = u32(output.size() / Channels);
+	for (u32 blockStart = 0; blockStart < outputFrames; blockStart += BlockFrames) {
+		const u32 frames = std::min(BlockFrames, outputFrames - blockStart);
+		std::fill_n(m_mixBuffer.begin(), frames * Channels, 0.0f);
+
+		for (u32 slot = 0; slot < MaxVoices; ++slot) {
+			auto& voice = m_voices[slot];
+
+			u32 done = 0;
+			while ((voice.samples || voice.ring) && done < frames) {
+				auto rendered = renderVoice(voice, frames - done);
+				const u32 renderedFrames = u32(rendered.size() / Channels);
+				mixRamped(m_mixBuffer.data() + done * Channels, rendered.data(), renderedFrames, voice.gain);
+				done += renderedFrames;
+
+				const bool ended =
+				    voice.samples && !voice.loop && voice.position >= double(voice.samples->frameCount());
+				const bool faded = voice.stopAtTarget && voice.gain.step == 0.0f;
+				if (ended || faded || renderedFrames == 0) {
+					voice = {};
+					m_finished.push(slot);
+				}
+			}
+		}
+
+		mixRamped(output.data() + blockStart * Channels, m_mixBuffer.data(), frames, m_mixGain);
+	}
+}
+
+std::span<const float> AudioMixer::renderVoice(Voice& voice, u32 frames)
+{
+	if (voice.ring) {
+		u32 count = voice.ring->read(m_voiceBuffer.data(), frames);
+
+		// The producer fell behind, the gap is filled with silence.
+		if (count < frames && !voice.ring->drained()) {
+			std::fill(m_voiceBuffer.begin() + count * Channels, m_voiceBuffer.begin() + frames * Channels, 0.0f);
+			count = frames;
+		}
+		return {m_voiceBuffer.data(), count * Channels};
+	}
+
+	const AudioSamples& samples = *voice.samples;
+	const u32 frameCount = samples.frameCount();
+	const float* data = samples.data.data();
+
+	if (voice.position >= double(frameCount)) {
+		if (!voice.loop || frameCount == 0) {
+			return {};
+		}
+		voice.position = std::fmod(voice.position, double(frameCount));
+	}
+
+	// Without resampling, stereo samples are mixed in place.
+	if (voice.step == 1.0 && voice.position == std::floor(voice.position)) {
+		const u32 position = u32(voice.position);
+		const u32 count = std::min(frames, frameCount - position);
+		voice.position += double(count);
+
+		if (samples.channels == Channels) {
+			return {data + position * Channels, count * Channels};
+		}
+		monoToStereo(m_voiceBuffer.data(), data + position, count);
+		return {m_voiceBuffer.data(), count * Channels};
+	}
+
+	// Linear interpolation, the last frame is interpolated towards the first
+	// one when looping.
+	u32 count = 0;
+	for (; count < frames && voice.position < double(frameCount); ++count) {
+		const u32 index = u32(voice.position);
+		const u32 next = index + 1 < frameCount ? index + 1 : (voice.loop ? 0 : index);
+		const float t = float(voice.position - double(index));
+
+		for (u32 channel = 0; channel < Channels; ++channel) {
+			const u32 sourceChannel = std::min(channel, samples.channels - 1);
+			const float a = data[index * samples.channels + sourceChannel];
+			const float b = data[next * samples.channels + sourceChannel];
+			m_voiceBuffer[count * Channels + channel] = a + (b - a) * t;
+		}
+
+		voice.position += voice.step;
+	}
+	return {m_voiceBuffer.data(), count * Channels};
+}
+
+} // namespace Anker
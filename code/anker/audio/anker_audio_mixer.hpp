@@ -0,0 +1,196 @@
+#pragma once
+
+#include <anker/common/anker_spsc_queue.hpp>
+
+namespace Anker {
+
+// Decoded PCM samples, interleaved floats with one or two channels.
+struct AudioSamples {
+	u32 sampleRate = 0;
+	u32 channels = 0;
+	std::vector<float> data;
+
+	u32 frameCount() const { return channels ? u32(data.size() / channels) : 0; }
+};
+using AudioSamplesPtr = std::shared_ptr<const AudioSamples>;
+
+// Fixed-size ring of interleaved stereo frames, filled by a streaming thread
+// while the AudioMixer plays from it. Single producer, single consumer.
+class AudioRing {
+  public:
+	explicit AudioRing(u32 capacityFrames);
+	AudioRing(const AudioRing&) = delete;
+	AudioRing& operator=(const AudioRing&) = delete;
+	AudioRing(AudioRing&&) noexcept = delete;
+	AudioRing& operator=(AudioRing&&) noexcept = delete;
+
+	// Producer only.
+	u32 writableFrames() const;
+	void write(std::span<const float> frames);
+
+	// No frames are written after finish, the voice ends once drained.
+	void finish() { m_finished.store(true, std::memory_order_release); }
+
+	// Consumer only, returns the number of frames read.
+	u32 read(float* output, u32 frames);
+	bool drained() const;
+
+  private:
+	u32 m_capacity = 0;
+	std::vector<float> m_samples;
+
+	alignas(64) std::atomic<u64> m_readFrame = 0;
+	alignas(64) std::atomic<u64> m_writeFrame = 0;
+	std::atomic<bool> m_finished = false;
+};
+using AudioRingPtr = std::shared_ptr<AudioRing>;
+
+struct AudioPlayParams {
+	float volume = 1.0f;
+
+	// Playback rate, 2 plays an octave higher.
+	float pitch = 1.0f;
+
+	bool loop = false;
+	float fadeTime = 0.0f;
+};
+
+// AudioMixer mixes voices into interleaved stereo floats. It is independent of
+// the output device, the AudioSystem mixes into SDL's audio stream, while
+// benchmarks render into memory.
+//
+// Voices are controlled from the game thread, commands are passed to the audio
+// thread via a lock-free queue. Mixing neither blocks nor allocates. Samples and
+// rings of a voice are kept alive by the game thread until the audio thread
+// reports the voice as finished, see update.
+//
+// Volume changes are ramped, sources with a different sample rate or pitch are
+// resampled linearly.
+//
+// Streamed voices play from an AudioRing at the mixer's sample rate, they are
+// neither resampled nor looped by the mixer. When a ring runs empty, silence is
+// played instead of waiting for the producer.
+class AudioMixer {
+  public:
+	static constexpr u32 Channels = 2;
+	static constexpr u32 MaxVoices = 256;
+
+	// Frames mixed at once, mix requests are split accordingly.
+	static constexpr u32 BlockFrames = 256;
+
+	explicit AudioMixer(u32 sampleRate);
+	AudioMixer(const AudioMixer&) = delete;
+	AudioMixer& operator=(const AudioMixer&) = delete;
+	AudioMixer(AudioMixer&&) noexcept = delete;
+	AudioMixer& operator=(AudioMixer&&) noexcept = delete;
+
+	// Generation in the upper bits, the null id is 0.
+	using VoiceId = u32;
+
+	////////////////////////////////////////////////////////////
+	// Game Thread
+
+	// Returns the null id if all voices are in use.
+	VoiceId play(AudioSamplesPtr, const AudioPlayParams& = {});
+
+	// Pitch and loop are ignored, the producer is responsible for looping.
+	VoiceId play(AudioRingPtr, const AudioPlayParams& = {});
+
+	// Finished or unknown voices are ignored.
+	void stop(VoiceId, float fadeTime = 0.0f);
+	void setVolume(VoiceId, float volume, float fadeTime = 0.0f);
+
+	void setMasterVolume(float volume);
+	float masterVolume() const { return m_masterVolume; }
+
+	bool isPlaying(VoiceId) const;
+
+	// Releases the samples of voices finished by the audio thread, call once
+	// per frame.
+	void update();
+
+	u32 activeVoices() const { return MaxVoices - u32(m_freeSlots.size()); }
+
+	////////////////////////////////////////////////////////////
+	// Audio Thread
+
+	// Adds the mix of all voices to the interleaved stereo output.
+	void mix(std::span<float> output);
+
+	u32 sampleRate() const { return m_sampleRate; }
+
+  private:
+	struct Command {
+		enum class Type : u8 { Play, Stop, SetVolume, SetMasterVolume };
+		Type type = Type::Play;
+		u32 slot = 0;
+		const AudioSamples* samples = nullptr;
+		AudioRing* ring = nullptr;
+		AudioPlayParams params;
+	};
+
+	// Reserves a slot and sends the play command, the caller keeps the
+	// source alive in the returned slot.
+	std::optional<u32> startVoice(const Command&);
+
+	bool pushCommand(const Command&);
+
+	// Returns the slot of a voice started by the game thread and not yet
+	// released.
+	std::optional<u32> activeSlot(VoiceId) const;
+
+	u32 m_sampleRate = 0;
+
+	// Game thread state.
+	std::vector<u32> m_freeSlots;
+	std::array<u32, MaxVoices> m_generations = {};
+	std::array<AudioSamplesPtr, MaxVoices> m_samples;
+	std::array<AudioRingPtr, MaxVoices> m_rings;
+	float m_masterVolume = 1.0f;
+
+	SpscQueue<Command, 1024> m_commands;
+
+	// Slots of finished voices, each voice finishes once, hence this never
+	// overflows.
+	SpscQueue<u32, MaxVoices> m_finished;
+
+	// Audio thread state.
+	struct GainRamp {
+		float gain = 0.0f;
+		float target = 0.0f;
+		float step = 0.0f; // Per frame, towards target
+	};
+
+	struct Voice {
+		// Either samples or ring is set while the voice is playing.
+		const AudioSamples* samples = nullptr;
+		AudioRing* ring = nullptr;
+
+		double position = 0.0; // Source frames
+		double step = 1.0;
+		bool loop = false;
+
+		GainRamp gain;
+		bool stopAtTarget = false;
+	};
+
+	void processCommands();
+	void setTarget(GainRamp&, float target, float fadeTime) const;
+
+	// Adds the samples with the ramp's gain, advancing the ramp.
+	static void mixRamped(float* dst, const float* src, u32 frames, GainRamp&);
+
+	// Renders up to the given number of frames, at most BlockFrames, of the
+	// voice as stereo. Returns either the samples directly or m_voiceBuffer.
+	// Fewer frames are returned at the end of the samples or stream.
+	std::span<const float> renderVoice(Voice&, u32 frames);
+
+	std::array<Voice, MaxVoices> m_voices;
+
+	GainRamp m_mixGain = {.gain = 1.0f, .target = 1.0f};
+
+	std::array<float, BlockFrames * Channels> m_voiceBuffer = {};
+	std::array<float, BlockFrames * Channels> m_mixBuffer = {};
+};
+
+} // namespace Anker
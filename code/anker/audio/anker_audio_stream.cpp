@@ -1,44 +1,232 @@
 #include <anker/audio/anker_audio_stream.hpp>
 
+#include <anker/audio/anker_audio_mixer.hpp>
 #include <anker/core/anker_data_loader.hpp>
 
+#if !ANKER_HEADLESS
+#include <SDL_mixer.h>
+#endif
+
 namespace Anker {
 
-AudioStream::~AudioStream()
+// Increment when the output of AudioStream::load changes, this invalidates the
+// derived data of all audio streams.
+const u32 AudioStreamDecoderVersion = 1;
+
+const usize AudioStreamFrameBytes = AudioMixer::Channels * sizeof(i16);
+
+// Streams are only kept in memory up to this size, about a minute at 48 kHz.
+// Longer streams fail to load without the derived data cache.
+const usize MaxInMemoryStreamBytes = 12 * 1024 * 1024;
+
+Status AudioStreamReader::read(u64 frame, std::span<float> output)
 {
-	if (m_music) {
-		Mix_FreeMusic(m_music);
+	const i16* samples = nullptr;
+
+	if (m_memory) {
+		ANKER_CHECK(frame * AudioMixer::Channels + output.size() <= m_memory->size(), ReadError);
+		samples = m_memory->data() + frame * AudioMixer::Channels;
+	} else {
+		m_buffer.resize(output.size());
+
+		m_file.seekg(std::streamoff(frame * AudioStreamFrameBytes));
+		m_file.read(reinterpret_cast<char*>(m_buffer.data()), std::streamsize(m_buffer.size() * sizeof(i16)));
+		if (!m_file) {
+			m_file.clear();
+			return ReadError;
+		}
+		samples = m_buffer.data();
 	}
-	if (m_rwops) {
-		SDL_RWclose(m_rwops);
+
+	for (usize i = 0; i < output.size(); ++i) {
+		output[i] = float(samples[i]) * (1.0f / 32768.0f);
 	}
+	return Ok;
 }
 
-Status AudioStream::load(std::string_view identifier)
+////////////////////////////////////////////////////////////
+
+#if ANKER_HEADLESS
+
+// Streams are not loaded headless, see AudioStream::load.
+static Status decodePcm(std::vector<i16>&, std::string_view, const ByteBuffer&)
 {
-	if (m_music) {
-		Mix_FreeMusic(m_music);
-		m_music = nullptr;
+	return NotImplementedError;
+}
+
+#else
+
+// Loop points are only exposed by SDL_mixer's music interface, in seconds.
+static std::pair<double, double> loadLoopTimes(std::string_view identifier, const ByteBuffer& buffer)
+{
+	SDL_RWops* src = SDL_RWFromConstMem(static_cast<const void*>(buffer.data()), int(buffer.size()));
+	if (!src) {
+		ANKER_ERROR("{}: SDL_RWFromConstMem failed: {}", identifier, SDL_GetError());
+		return {-1.0, -1.0};
 	}
-	if (m_rwops) {
-		SDL_RWclose(m_rwops);
-		m_rwops = nullptr;
+
+	Mix_Music* music = Mix_LoadMUS_RW(src, 1);
+	if (!music) {
+		ANKER_WARN("{}: Mix_LoadMUS_RW failed: {}", identifier, Mix_GetError());
+		return {-1.0, -1.0};
 	}
+	ANKER_DEFER(Mix_FreeMusic(music));
+
+	return {Mix_GetMusicLoopStartTime(music), Mix_GetMusicLoopEndTime(music)};
+}
 
-	ANKER_TRY(g_assetDataLoader.load(m_buffer, std::string{identifier} + ".opus"));
+// Decodes the whole stream, which only happens once thanks to the derived data
+// cache. SDL_mixer converts to the device format.
+static Status decodePcm(std::vector<i16>& pcm, std::string_view identifier, const ByteBuffer& buffer)
+{
+	ANKER_PROFILE_ZONE();
 
-	m_rwops = SDL_RWFromConstMem(static_cast<const void*>(m_buffer.data()), int(m_buffer.size()));
-	if (!m_rwops) {
+	SDL_RWops* src = SDL_RWFromConstMem(static_cast<const void*>(buffer.data()), int(buffer.size()));
+	if (!src) {
 		ANKER_ERROR("{}: SDL_RWFromConstMem failed: {}", identifier, SDL_GetError());
 		return ReadError;
 	}
 
-	m_music = Mix_LoadMUS_RW(m_rwops, 0);
-	if (!m_music) {
-		ANKER_ERROR("{}: Mix_LoadMUS_RW: failed: {}", identifier, Mix_GetError());
+	Mix_Chunk* chunk = Mix_LoadWAV_RW(src, 1);
+	if (!chunk) {
+		ANKER_ERROR("{}: Mix_LoadWAV_RW failed: {}", identifier, Mix_GetError());
+		return ReadError;
+	}
+	ANKER_DEFER(Mix_FreeChunk(chunk));
+
+	auto samples = std::span(reinterpret_cast<const float*>(chunk->abuf), chunk->alen / sizeof(float));
+	pcm.resize(samples.size() - samples.size() % AudioMixer::Channels);
+	for (usize i = 0; i < pcm.size(); ++i) {
+		pcm[i] = i16(std::lround(std::clamp(samples[i], -1.0f, 1.0f) * 32767.0f));
+	}
+
+	return Ok;
+}
+
+#endif
+
+Status AudioStream::load(std::string_view identifier)
+{
+	m_decode.reset();
+	m_memory.reset();
+	m_sampleRate = 0;
+	m_frameCount = 0;
+	m_loopStart = 0;
+	m_loopEnd = 0;
+
+#if ANKER_HEADLESS
+	ANKER_ERROR("{}: Audio is not available in headless builds", identifier);
+	return NotImplementedError;
+#else
+	ByteBuffer buffer;
+	ANKER_TRY(g_assetDataLoader.load(buffer, std::string{identifier} + ".opus"));
+
+	// Like AudioTrack, samples are decoded into the format of the audio
+	// device, which is therefore part of the key.
+	int frequency = 0;
+	int channels = 0;
+	u16 format = 0;
+	if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+		ANKER_ERROR("{}: Mix_QuerySpec failed: {}", identifier, Mix_GetError());
+		return ReadError;
+	}
+	if (format != AUDIO_F32SYS || channels != int(AudioMixer::Channels)) {
+		ANKER_ERROR("{}: Audio device format not supported by AudioMixer", identifier);
 		return ReadError;
 	}
+	u64 deviceSpec = u64(frequency) << 32 | u64(format) << 16 | u64(channels);
+
+	m_derivedDataKey = DerivedDataCache::key("pcm_stream", AudioStreamDecoderVersion, buffer, deviceSpec);
+	m_sampleRate = u32(frequency);
 
+	auto loopTimes = loadLoopTimes(identifier, buffer);
+
+	if (std::ifstream file; g_derivedDataCache.open(file, m_derivedDataKey)) {
+		file.seekg(0, std::ios_base::end);
+		return finishLoad(identifier, u64(file.tellg()) / AudioStreamFrameBytes, loopTimes);
+	}
+
+	m_decode = std::make_shared<Decode>();
+	m_decode->identifier = identifier;
+	m_decode->source = std::move(buffer);
+	m_decode->key = m_derivedDataKey;
+	m_decode->loopTimes = loopTimes;
+	return Ok;
+#endif
+}
+
+void AudioStream::decode(Decode& decode)
+{
+	std::vector<i16> pcm;
+	decode.status = decodePcm(pcm, decode.identifier, decode.source);
+	decode.source = {};
+
+	if (decode.status) {
+		decode.frameCount = pcm.size() / AudioMixer::Channels;
+
+		g_derivedDataCache.store(decode.key, asBytes(std::span(pcm)));
+		if (std::ifstream file; !g_derivedDataCache.open(file, decode.key)) {
+			if (pcm.size() * sizeof(i16) > MaxInMemoryStreamBytes) {
+				ANKER_ERROR("{}: Derived data cache unavailable, stream is too long to keep in memory",
+				            decode.identifier);
+				decode.status = ReadError;
+			} else {
+				ANKER_WARN("{}: Derived data cache unavailable, stream is kept in memory", decode.identifier);
+				decode.pcm = std::move(pcm);
+				decode.inMemory = true;
+			}
+		}
+	}
+
+	decode.done.store(true, std::memory_order_release);
+}
+
+Status AudioStream::update()
+{
+	if (!m_decode || !m_decode->done.load(std::memory_order_acquire)) {
+		return Ok;
+	}
+
+	auto decode = std::move(m_decode);
+	ANKER_TRY(decode->status);
+
+	if (decode->inMemory) {
+		m_memory = std::make_shared<const std::vector<i16>>(std::move(decode->pcm));
+	}
+	return finishLoad(decode->identifier, decode->frameCount, decode->loopTimes);
+}
+
+Status AudioStream::finishLoad(std::string_view identifier, u64 frameCount, std::pair<double, double> loopTimes)
+{
+	if (frameCount == 0) {
+		ANKER_ERROR("{}: Stream is empty", identifier);
+		return ReadError;
+	}
+	m_frameCount = frameCount;
+
+	auto toFrame = [&](double seconds) { return u64(std::llround(seconds * double(m_sampleRate))); };
+
+	auto [loopStartTime, loopEndTime] = loopTimes;
+	m_loopEnd = loopEndTime > 0.0 ? std::min(toFrame(loopEndTime), m_frameCount) : m_frameCount;
+	m_loopStart = loopStartTime > 0.0 ? std::min(toFrame(loopStartTime), m_loopEnd - 1) : 0;
+
+	return Ok;
+}
+
+Status AudioStream::openReader(AudioStreamReader& reader) const
+{
+	ANKER_CHECK(m_frameCount > 0, ReadError);
+
+	reader = {};
+	if (m_memory) {
+		reader.m_memory = m_memory;
+		return Ok;
+	}
+
+	if (!g_derivedDataCache.open(reader.m_file, m_derivedDataKey)) {
+		ANKER_ERROR("Failed to open derived data of audio stream");
+		return ReadError;
+	}
 	return Ok;
 }
 
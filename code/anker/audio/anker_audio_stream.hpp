@@ -1,9 +1,42 @@
 #pragma once
 
-#include <SDL_mixer.h>
+#include <anker/core/anker_derived_data_cache.hpp>
 
 namespace Anker {
 
+// Reads frames of an AudioStream as interleaved stereo floats. Each playback
+// uses its own reader, so reloading the stream does not affect it.
+class AudioStreamReader {
+  public:
+	AudioStreamReader() = default;
+	AudioStreamReader(const AudioStreamReader&) = delete;
+	AudioStreamReader& operator=(const AudioStreamReader&) = delete;
+	AudioStreamReader(AudioStreamReader&&) noexcept = default;
+	AudioStreamReader& operator=(AudioStreamReader&&) noexcept = default;
+
+	Status read(u64 frame, std::span<float> output);
+
+  private:
+	friend class AudioStream;
+
+	std::ifstream m_file;
+
+	// Only set if the stream is kept in memory, see AudioStream.
+	std::shared_ptr<const std::vector<i16>> m_memory;
+
+	std::vector<i16> m_buffer;
+};
+
+// AudioStream is a long track, like music or ambience, played while it is read.
+//
+// Opus decoding is only available through SDL_mixer, which cannot decode
+// incrementally on our side. Hence, streams are decoded once into the derived
+// data cache as 16-bit PCM, from where playbacks read small parts ahead of time,
+// see AudioStreamer. Only if the cache is unavailable, the PCM of short streams
+// is kept in memory; longer streams fail to load then.
+//
+// Decoding takes a while, so load does not decode on a cache miss. The stream
+// is pending instead, until the AudioStreamer has decoded it in the background.
 class AudioStream {
   public:
 	AudioStream() = default;
@@ -11,16 +44,64 @@ class AudioStream {
 	AudioStream& operator=(const AudioStream&) = delete;
 	AudioStream(AudioStream&&) noexcept = delete;
 	AudioStream& operator=(AudioStream&&) noexcept = delete;
-	~AudioStream();
-
-	operator Mix_Music*() { return m_music; }
 
 	Status load(std::string_view identifier);
 
+	// Pending streams cannot be played yet, see update.
+	bool pending() const { return m_decode != nullptr; }
+
+	// Takes over the result once the AudioStreamer finished decoding, called
+	// from the game thread. Fails if decoding failed.
+	Status update();
+
+	Status openReader(AudioStreamReader&) const;
+
+	u32 sampleRate() const { return m_sampleRate; }
+	u64 frameCount() const { return m_frameCount; }
+
+	// Looping playback jumps from loop end back to loop start, taken from the
+	// LOOPSTART and LOOPEND tags if present.
+	u64 loopStart() const { return m_loopStart; }
+	u64 loopEnd() const { return m_loopEnd; }
+
+	// Only streams kept in memory occupy memory.
+	usize byteSize() const { return m_memory ? m_memory->size() * sizeof(i16) : 0; }
+
   private:
-	ByteBuffer m_buffer;
-	SDL_RWops* m_rwops = nullptr;
-	Mix_Music* m_music = nullptr;
+	friend class AudioStreamer;
+
+	// Shared with the AudioStreamer's decode thread, results are published
+	// by done.
+	struct Decode {
+		std::string identifier;
+		ByteBuffer source;
+		DerivedDataKey key;
+		std::pair<double, double> loopTimes;
+
+		Status status = ReadError;
+		u64 frameCount = 0;
+		std::vector<i16> pcm; // Only kept if the cache is unavailable
+		bool inMemory = false;
+		std::atomic<bool> done = false;
+
+		// Game thread only.
+		bool queued = false;
+	};
+
+	// Runs on the AudioStreamer's decode thread.
+	static void decode(Decode&);
+
+	Status finishLoad(std::string_view identifier, u64 frameCount, std::pair<double, double> loopTimes);
+
+	std::shared_ptr<Decode> m_decode;
+
+	DerivedDataKey m_derivedDataKey;
+	std::shared_ptr<const std::vector<i16>> m_memory;
+
+	u32 m_sampleRate = 0;
+	u64 m_frameCount = 0;
+	u64 m_loopStart = 0;
+	u64 m_loopEnd = 0;
 };
 
 } // namespace Anker
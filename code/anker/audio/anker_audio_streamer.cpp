@@ -0,0 +1,167 @@
+#include <anker/audio/anker_audio_streamer.hpp>
+
+namespace Anker {
+
+// Frames read from a stream at once.
+const u32 StreamReadFrames = 4096;
+
+// How often rings are topped up, well below the time a ring lasts.
+const auto StreamRefillInterval = std::chrono::milliseconds(20);
+
+AudioStreamer::~AudioStreamer() noexcept
+{
+	stop();
+}
+
+void AudioStreamer::stop()
+{
+	{
+		std::scoped_lock lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_one();
+	m_decodeWake.notify_one();
+
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+	if (m_decodeThread.joinable()) {
+		m_decodeThread.join();
+	}
+}
+
+AudioRingPtr AudioStreamer::start(const AudioStream& stream, u64 startFrame, bool loop)
+{
+	ANKER_PROFILE_ZONE();
+
+	auto playback = std::make_unique<Playback>();
+	if (!stream.openReader(playback->reader)) {
+		return nullptr;
+	}
+
+	playback->end = loop ? stream.loopEnd() : stream.frameCount();
+	playback->loopStart = stream.loopStart();
+	playback->position = std::min(startFrame, playback->end);
+	playback->loop = loop;
+
+	auto ring = std::make_shared<AudioRing>(RingFrames);
+	playback->ring = ring;
+
+	// Filling the ring up front avoids starting with silence. Short streams
+	// may not need the thread at all.
+	std::vector<float> buffer;
+	if (!refill(*playback, buffer)) {
+		return ring;
+	}
+
+	{
+		std::scoped_lock lock(m_mutex);
+		if (!m_thread.joinable()) {
+			m_thread = std::thread([this] { run(); });
+		}
+		m_started.push_back(std::move(playback));
+	}
+	m_wake.notify_one();
+
+	return ring;
+}
+
+void AudioStreamer::decode(AudioStream& stream)
+{
+	auto& decode = stream.m_decode;
+	if (!decode || decode->queued) {
+		return;
+	}
+	decode->queued = true;
+
+	{
+		std::scoped_lock lock(m_mutex);
+		if (m_stop) {
+			return;
+		}
+		if (!m_decodeThread.joinable()) {
+			m_decodeThread = std::thread([this] { runDecodes(); });
+		}
+		m_decodes.push_back(decode);
+	}
+	m_decodeWake.notify_one();
+}
+
+bool AudioStreamer::refill(Playback& playback, std::vector<float>& buffer)
+{
+	auto ring = playback.ring.lock();
+	if (!ring) {
+		return false;
+	}
+
+	while (true) {
+		const u32 frames = u32(std::min(u64(StreamReadFrames), playback.end - playback.position));
+		if (ring->writableFrames() < frames) {
+			return true;
+		}
+
+		buffer.resize(usize(frames) * AudioMixer::Channels);
+		if (!playback.reader.read(playback.position, buffer)) {
+			ANKER_ERROR("Failed to read audio stream at frame {}", playback.position);
+			ring->finish();
+			return false;
+		}
+		ring->write(buffer);
+		playback.position += frames;
+
+		if (playback.position == playback.end) {
+			if (!playback.loop) {
+				ring->finish();
+				return false;
+			}
+			playback.position = playback.loopStart;
+		}
+	}
+}
+
+void AudioStreamer::run()
+{
+	std::vector<std::unique_ptr<Playback>> playbacks;
+	std::vector<float> buffer;
+
+	std::unique_lock lock(m_mutex);
+	while (true) {
+		m_wake.wait_for(lock, StreamRefillInterval, [&] { return m_stop || !m_started.empty(); });
+		if (m_stop) {
+			return;
+		}
+
+		std::ranges::move(m_started, std::back_inserter(playbacks));
+		m_started.clear();
+
+		lock.unlock();
+		{
+			ANKER_PROFILE_ZONE_N("AudioStreamer::refill");
+			std::erase_if(playbacks, [&](auto& playback) { return !refill(*playback, buffer); });
+		}
+		lock.lock();
+	}
+}
+
+void AudioStreamer::runDecodes()
+{
+	std::unique_lock lock(m_mutex);
+	while (true) {
+		m_decodeWake.wait(lock, [&] { return m_stop || !m_decodes.empty(); });
+		if (m_stop) {
+			return;
+		}
+
+		auto decode = std::move(m_decodes.front());
+		m_decodes.pop_front();
+
+		lock.unlock();
+		{
+			ANKER_PROFILE_ZONE_N("AudioStreamer::decode");
+			AudioStream::decode(*decode);
+		}
+		lock.lock();
+	}
+}
+
+} // namespace Anker
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <anker/audio/anker_audio_mixer.hpp>
+#include <anker/audio/anker_audio_stream.hpp>
+
+namespace Anker {
+
+// The AudioStreamer reads playing AudioStreams ahead of time on a background
+// thread, keeping the AudioRing of each playback filled. The audio thread never
+// waits for the disk, and memory per playback is bounded by the ring size.
+//
+// Looping playbacks continue at the loop start within the same ring, hence
+// loops are gapless.
+//
+// Pending streams are decoded on a separate thread, so playing streams are not
+// starved meanwhile.
+class AudioStreamer {
+  public:
+	// Frames buffered per playback, about 0.7s at 48kHz.
+	static constexpr u32 RingFrames = 32 * 1024;
+
+	AudioStreamer() = default;
+	AudioStreamer(const AudioStreamer&) = delete;
+	AudioStreamer& operator=(const AudioStreamer&) = delete;
+	AudioStreamer(AudioStreamer&&) noexcept = delete;
+	AudioStreamer& operator=(AudioStreamer&&) noexcept = delete;
+	~AudioStreamer() noexcept;
+
+	// Returns the ring to play from, null if the stream cannot be read. The
+	// ring is filled before returning, the thread is started on first use.
+	//
+	// A playback ends with the stream, or once the ring is no longer
+	// referenced by anyone else.
+	AudioRingPtr start(const AudioStream&, u64 startFrame = 0, bool loop = false);
+
+	// Queues a pending stream for decoding, see AudioStream::update. Streams
+	// already queued are ignored.
+	void decode(AudioStream&);
+
+	// Joins the threads, the AudioSystem stops before closing the audio
+	// device, which decoding depends on.
+	void stop();
+
+  private:
+	struct Playback {
+		std::weak_ptr<AudioRing> ring;
+		AudioStreamReader reader;
+
+		u64 position = 0;
+		u64 end = 0; // Loop end when looping
+		u64 loopStart = 0;
+		bool loop = false;
+	};
+
+	// Returns false once the playback has ended.
+	static bool refill(Playback&, std::vector<float>& buffer);
+
+	void run();
+	void runDecodes();
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::vector<std::unique_ptr<Playback>> m_started;
+	bool m_stop = false;
+	std::thread m_thread;
+
+	std::condition_variable m_decodeWake;
+	std::deque<std::shared_ptr<AudioStream::Decode>> m_decodes;
+	std::thread m_decodeThread;
+};
+
+} // namespace Anker
@@ -1,13 +1,24 @@
 #include <anker/audio/anker_audio_system.hpp>
 
+#include <anker/core/anker_asset_cache.hpp>
 #include <anker/core/anker_data_loader.hpp>
 
+#if !ANKER_HEADLESS
 #include <SDL_mixer.h>
+#endif
 
 namespace Anker {
 
-AudioSystem::AudioSystem()
+// Native rate of Opus, the device converts if it runs at a different rate.
+const u32 AudioSampleRate = 48000;
+
+// Crossfade when seeking, short enough to not be heard as a fade.
+const float MusicSeekFadeTime = 0.02f;
+
+AudioSystem::AudioSystem(AssetCache& assetCache, [[maybe_unused]] u32 bufferFrames)
+    : m_assetCache(assetCache), m_mixer(AudioSampleRate)
 {
+#if !ANKER_HEADLESS
 	int flags = MIX_INIT_OGG | MIX_INIT_OPUS;
 	int inited = Mix_Init(flags);
 	if (flags != inited) {
@@ -15,75 +26,181 @@ AudioSystem::AudioSystem()
 		return;
 	}
 
-	if (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 4096) != 0) {
-		ANKER_ERROR("Mix_OpenAudio failed: {}", Mix_GetError());
+	// The AudioMixer relies on the exact format, SDL converts as necessary.
+	const int opened = Mix_OpenAudioDevice(int(AudioSampleRate), AUDIO_F32SYS, int(AudioMixer::Channels),
+	                                       int(bufferFrames), nullptr, 0);
+	if (opened != 0) {
+		ANKER_ERROR("Mix_OpenAudioDevice failed: {}", Mix_GetError());
+		return;
 	}
+	m_opened = true;
 
-	int allocatedChannels = Mix_AllocateChannels(EffectChannelCount);
-	if (allocatedChannels != EffectChannelCount) {
-		ANKER_ERROR("Mix_AllocateChannels: Could not allocate desired number of effect channels allocatedChannels={} "
-		            "EffectChannelCount={}",
-		            allocatedChannels, EffectChannelCount);
-	}
+	// Neither channels nor music of SDL_mixer are used.
+	Mix_AllocateChannels(0);
+
+	Mix_SetPostMix(&AudioSystem::postMix, this);
+#endif
 }
 
 AudioSystem::~AudioSystem()
 {
-	m_music = nullptr;
-	m_effects.fill(nullptr);
+	// Decoding relies on the audio device.
+	m_streamer.stop();
+
+#if !ANKER_HEADLESS
+	if (m_opened) {
+		// Waits for the audio callback, the mixer is not used afterwards.
+		Mix_SetPostMix(nullptr, nullptr);
+		Mix_CloseAudio();
+	}
+#endif
+	m_music.clear();
+#if !ANKER_HEADLESS
 	Mix_Quit();
+#endif
 }
 
-void AudioSystem::playMusic(AssetPtr<AudioStream> music, float fadeTime)
+void AudioSystem::postMix(void* audioSystem, u8* stream, int length)
 {
-	if (!music) {
+	auto output = std::span(reinterpret_cast<float*>(stream), usize(length) / sizeof(float));
+	static_cast<AudioSystem*>(audioSystem)->m_mixer.mix(output);
+}
+
+void AudioSystem::tick()
+{
+	m_mixer.update();
+
+	// Streams still pending are queued again.
+	auto pendingStreams = std::move(m_pendingStreams);
+	m_pendingStreams.clear();
+	for (auto& pending : pendingStreams) {
+		if (pending.music) {
+			pending.params.volume = m_musicVolume;
+		}
+
+		const auto voice = startStream(pending);
+		if (pending.music && voice) {
+			m_musicVoice = voice;
+		}
+	}
+}
+
+void AudioSystem::playMusic(AssetHandle<AudioStream> handle, float fadeTime)
+{
+	if (!m_assetCache.get(handle)) {
 		stopMusic();
 		return;
 	}
 
-	if (fadeTime <= 0) {
-		Mix_PlayMusic(*music, -1);
-	} else {
-		Mix_FadeInMusic(*music, -1, int(fadeTime * 1000.0f));
-	}
+	stopMusic(fadeTime);
 
-	m_music = music;
+	m_musicHandle = handle;
+	m_assetCache.pin(m_music, handle);
+	m_musicVoice = startStream({
+	    .handle = handle,
+	    .params = {.volume = m_musicVolume, .loop = true, .fadeTime = fadeTime},
+	    .music = true,
+	});
 }
 
 void AudioSystem::stopMusic(float fadeTime)
 {
-	if (fadeTime <= 0) {
-		Mix_HaltMusic();
-	} else {
-		Mix_FadeOutMusic(int(fadeTime * 1000.0f));
+	m_mixer.stop(m_musicVoice, fadeTime);
+	m_musicVoice = 0;
+	m_musicHandle = {};
+	m_music.clear();
+
+	std::erase_if(m_pendingStreams, [](const PendingStream& pending) { return pending.music; });
+}
+
+void AudioSystem::seekMusic(float position)
+{
+	auto* music = m_assetCache.get(m_musicHandle);
+	if (!music) {
+		return;
 	}
-	m_music = nullptr;
+	const u64 frame = u64(std::max(position, 0.0f) * float(music->sampleRate()));
+
+	// Pending music starts at the new position.
+	for (auto& pending : m_pendingStreams) {
+		if (pending.music) {
+			pending.startFrame = frame;
+			return;
+		}
+	}
+
+	if (!m_mixer.isPlaying(m_musicVoice)) {
+		return;
+	}
+
+	// The ring still holds frames of the old position, hence a new voice takes
+	// over with a short crossfade.
+	m_mixer.stop(m_musicVoice, MusicSeekFadeTime);
+	m_musicVoice = startStream(*music, {.volume = m_musicVolume, .loop = true, .fadeTime = MusicSeekFadeTime}, frame);
 }
 
 float AudioSystem::musicVolume()
 {
-	return float(Mix_VolumeMusic(-1)) / MIX_MAX_VOLUME;
+	return m_musicVolume;
 }
 
 void AudioSystem::setMusicVolume(float volume)
 {
-	Mix_VolumeMusic(int(std::clamp(volume, 0.0f, 1.0f) * MIX_MAX_VOLUME));
+	m_musicVolume = std::clamp(volume, 0.0f, 1.0f);
+	m_mixer.setVolume(m_musicVoice, m_musicVolume);
 }
 
-void AudioSystem::playEffect(AssetPtr<AudioTrack> effect, float volume)
+AudioMixer::VoiceId AudioSystem::playEffect(AssetHandle<AudioTrack> handle, float volume)
 {
-	ANKER_CHECK(effect);
+	auto* effect = m_assetCache.get(handle);
+	ANKER_CHECK(effect && effect->samples(), 0);
 
-	int channel = Mix_PlayChannel(-1, *effect, 0);
-	if (channel < 0) {
-		ANKER_WARN("Not enough audio channels available");
-		return;
+	return m_mixer.play(effect->samples(), {.volume = std::clamp(volume, 0.0f, 1.0f)});
+}
+
+AudioMixer::VoiceId AudioSystem::playStream(AssetHandle<AudioStream> handle, const AudioPlayParams& params)
+{
+	ANKER_CHECK(m_assetCache.get(handle), 0);
+
+	return startStream({.handle = handle, .params = params});
+}
+
+void AudioSystem::stopEffect(AudioMixer::VoiceId voice, float fadeTime)
+{
+	m_mixer.stop(voice, fadeTime);
+}
+
+AudioMixer::VoiceId AudioSystem::startStream(const PendingStream& pending)
+{
+	auto* stream = m_assetCache.get(pending.handle);
+	if (!stream || not stream->update()) {
+		return 0;
 	}
 
-	Mix_Volume(channel, int(std::clamp(volume, 0.0f, 1.0f) * MIX_MAX_VOLUME));
+	if (stream->pending()) {
+		m_streamer.decode(*stream);
+		m_pendingStreams.push_back(pending);
+		return 0;
+	}
+
+	// Failed to load, already reported by AudioStream::load.
+	if (stream->frameCount() == 0) {
+		return 0;
+	}
 
-	ANKER_CHECK(channel < m_effects.size());
-	m_effects[channel] = effect;
+	return startStream(*stream, pending.params, pending.startFrame);
+}
+
+AudioMixer::VoiceId AudioSystem::startStream(const AudioStream& stream, const AudioPlayParams& params, u64 startFrame)
+{
+	// Streams are decoded at the device's sample rate, see AudioStream.
+	ANKER_CHECK(stream.sampleRate() == m_mixer.sampleRate(), 0);
+
+	auto ring = m_streamer.start(stream, startFrame, params.loop);
+	if (!ring) {
+		return 0;
+	}
+	return m_mixer.play(std::move(ring), params);
 }
 
 } // namespace Anker
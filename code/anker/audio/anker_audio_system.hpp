@@ -1,33 +1,85 @@
 #pragma once
 
+#include <anker/audio/anker_audio_mixer.hpp>
 #include <anker/audio/anker_audio_stream.hpp>
+#include <anker/audio/anker_audio_streamer.hpp>
 #include <anker/audio/anker_audio_track.hpp>
 #include <anker/core/anker_asset.hpp>
 
 namespace Anker {
 
+class AssetCache;
+
+// Music, streams, and effects are mixed by the AudioMixer from within SDL's
+// audio callback. SDL_mixer is only used for decoding. Headless builds have no
+// audio device, nothing is loaded or played there.
 class AudioSystem {
   public:
-	AudioSystem();
+	// Frames per audio device buffer, smaller buffers lower the latency.
+	static constexpr u32 DefaultBufferFrames = 512;
+
+	explicit AudioSystem(AssetCache&, u32 bufferFrames = DefaultBufferFrames);
 	AudioSystem(const AudioSystem&) = delete;
 	AudioSystem& operator=(const AudioSystem&) = delete;
 	AudioSystem(AudioSystem&&) noexcept = delete;
 	AudioSystem& operator=(AudioSystem&&) noexcept = delete;
 	~AudioSystem();
 
-	void playMusic(AssetPtr<AudioStream>, float fadeTime = 0.5f);
+	// Releases the samples of finished effects and starts streams decoded in
+	// the meantime, called once per frame.
+	void tick();
+
+	// Music loops, starting a new one fades out the current one. Pending music
+	// starts once decoded, see AudioStream::pending.
+	void playMusic(AssetHandle<AudioStream>, float fadeTime = 0.5f);
 	void stopMusic(float fadeTime = 0.5f);
 
+	// Continues the current music at the given position, in seconds.
+	void seekMusic(float position);
+
 	float musicVolume();
 	void setMusicVolume(float volume);
 
-	void playEffect(AssetPtr<AudioTrack>, float volume = 1);
+	AudioMixer::VoiceId playEffect(AssetHandle<AudioTrack>, float volume = 1);
+
+	// Plays a long track, e.g. ambience, streamed like music. Pending streams
+	// start once decoded, the null id is returned for them.
+	AudioMixer::VoiceId playStream(AssetHandle<AudioStream>, const AudioPlayParams& = {});
+
+	// Stops effects and streams.
+	void stopEffect(AudioMixer::VoiceId, float fadeTime = 0);
+
+	AudioMixer& mixer() { return m_mixer; }
 
   private:
-	static constexpr int EffectChannelCount = 64;
+	static void postMix(void* audioSystem, u8* stream, int length);
+
+	struct PendingStream {
+		AssetHandle<AudioStream> handle;
+		AudioPlayParams params;
+		u64 startFrame = 0;
+		bool music = false;
+	};
+
+	// Returns the null id if the stream is pending, it is started by tick
+	// instead.
+	AudioMixer::VoiceId startStream(const PendingStream&);
+
+	AudioMixer::VoiceId startStream(const AudioStream&, const AudioPlayParams&, u64 startFrame = 0);
+
+	AssetCache& m_assetCache;
+
+	std::vector<PendingStream> m_pendingStreams;
+
+	// Playing assets are pinned, so they cannot be evicted mid-playback.
+	AssetPins m_music;
+	AssetHandle<AudioStream> m_musicHandle;
+	AudioMixer::VoiceId m_musicVoice = 0;
+	float m_musicVolume = 1.0f;
 
-	AssetPtr<AudioStream> m_music;
-	std::array<AssetPtr<AudioTrack>, EffectChannelCount> m_effects = {};
+	AudioMixer m_mixer;
+	AudioStreamer m_streamer;
+	bool m_opened = false;
 };
 
 } // namespace Anker
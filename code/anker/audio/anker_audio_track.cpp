@@ -1,39 +1,84 @@
 #include <anker/audio/anker_audio_track.hpp>
 
 #include <anker/core/anker_data_loader.hpp>
+#include <anker/core/anker_derived_data_cache.hpp>
+
+#if !ANKER_HEADLESS
+#include <SDL_mixer.h>
+#endif
 
 namespace Anker {
 
-AudioTrack::~AudioTrack()
-{
-	if (m_chunk) {
-		Mix_FreeChunk(m_chunk);
-	}
-}
+// Increment when the output of AudioTrack::load changes, this invalidates the
+// derived data of all audio tracks.
+const u32 AudioDecoderVersion = 2;
 
 Status AudioTrack::load(std::string_view identifier)
 {
-	if (m_chunk) {
-		Mix_FreeChunk(m_chunk);
-		m_chunk = nullptr;
-	}
+	m_samples.reset();
 
+#if ANKER_HEADLESS
+	ANKER_ERROR("{}: Audio is not available in headless builds", identifier);
+	return NotImplementedError;
+#else
 	ByteBuffer buffer;
 	ANKER_TRY(g_assetDataLoader.load(buffer, std::string{identifier} + ".opus"));
 
+	// Samples are decoded into the format of the audio device, which is
+	// therefore part of the key.
+	int frequency = 0;
+	int channels = 0;
+	u16 format = 0;
+	if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+		ANKER_ERROR("{}: Mix_QuerySpec failed: {}", identifier, Mix_GetError());
+		return ReadError;
+	}
+	if (format != AUDIO_F32SYS || channels < 1 || channels > 2) {
+		ANKER_ERROR("{}: Audio device format not supported by AudioMixer", identifier);
+		return ReadError;
+	}
+	u64 deviceSpec = u64(frequency) << 32 | u64(format) << 16 | u64(channels);
+
+	auto samples = std::make_shared<AudioSamples>();
+	samples->sampleRate = u32(frequency);
+	samples->channels = u32(channels);
+
+	auto derivedDataKey = DerivedDataCache::key("pcm", AudioDecoderVersion, buffer, deviceSpec);
+
+	if (MappedFile derivedData; g_derivedDataCache.load(derivedData, derivedDataKey)) {
+		auto bytes = derivedData.data();
+		if (bytes.size() % (sizeof(float) * samples->channels) == 0) {
+			samples->data.resize(bytes.size() / sizeof(float));
+			std::memcpy(samples->data.data(), bytes.data(), bytes.size());
+			m_samples = std::move(samples);
+			return Ok;
+		}
+		ANKER_WARN("{}: Derived data has unexpected size {}", identifier, bytes.size());
+	}
+
 	SDL_RWops* src = SDL_RWFromConstMem(static_cast<const void*>(buffer.data()), int(buffer.size()));
 	if (!src) {
 		ANKER_ERROR("{}: SDL_RWFromConstMem failed: {}", identifier, SDL_GetError());
 		return ReadError;
 	}
 
-	m_chunk = Mix_LoadWAV_RW(src, 1);
-	if (!m_chunk) {
+	Mix_Chunk* chunk = Mix_LoadWAV_RW(src, 1);
+	if (!chunk) {
 		ANKER_ERROR("{}: Mix_LoadWAV_RW failed: {}", identifier, Mix_GetError());
 		return ReadError;
 	}
 
+	// SDL_mixer converts to the device format, the chunk is only used for
+	// decoding.
+	samples->data.resize(chunk->alen / sizeof(float));
+	std::memcpy(samples->data.data(), chunk->abuf, samples->data.size() * sizeof(float));
+	Mix_FreeChunk(chunk);
+
+	g_derivedDataCache.store(derivedDataKey, asBytes(std::span(samples->data)));
+
+	m_samples = std::move(samples);
 	return Ok;
+#endif
 }
 
 } // namespace Anker
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <SDL_mixer.h>
+#include <anker/audio/anker_audio_mixer.hpp>
 
 namespace Anker {
 
@@ -11,14 +11,18 @@ class AudioTrack {
 	AudioTrack& operator=(const AudioTrack&) = delete;
 	AudioTrack(AudioTrack&&) noexcept = delete;
 	AudioTrack& operator=(AudioTrack&&) noexcept = delete;
-	~AudioTrack();
-
-	operator Mix_Chunk*() { return m_chunk; }
 
 	Status load(std::string_view identifier);
 
+	// Samples in the AudioMixer's format, null if not loaded. Voices share
+	// them, hence reloading the track does not affect playing voices.
+	const AudioSamplesPtr& samples() const { return m_samples; }
+
+	// Size of the decoded samples.
+	usize byteSize() const { return m_samples ? m_samples->data.size() * sizeof(float) : 0; }
+
   private:
-	Mix_Chunk* m_chunk = nullptr;
+	AudioSamplesPtr m_samples;
 };
 
 } // namespace Anker
@@ -12,10 +12,13 @@
 #include <anker/common/anker_log.hpp>
 #include <anker/common/anker_macros.hpp>
 #include <anker/common/anker_math.hpp>
+#include <anker/common/anker_memory.hpp>
 #include <anker/common/anker_physics_utils.hpp>
 #include <anker/common/anker_profiling.hpp>
 #include <anker/common/anker_serialize.hpp>
+#include <anker/common/anker_serialize_binary.hpp>
 #include <anker/common/anker_serialize_json.hpp>
+#include <anker/common/anker_spsc_queue.hpp>
 #include <anker/common/anker_status.hpp>
 #include <anker/common/anker_string_utils.hpp>
 #include <anker/common/anker_type_utils.hpp>
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <anker/common/anker_type_utils.hpp>
+
 namespace Anker {
 
 struct StringHash {
@@ -12,4 +14,35 @@ struct StringHash {
 template <typename T>
 using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
 
+// Fast, non-cryptographic 64-bit hash of arbitrary bytes, processing 8 bytes
+// per step. Suitable for content hashing, e.g. to detect modified data.
+inline u64 hashBytes(std::span<const u8> data, u64 seed = 0)
+{
+	constexpr u64 Multiplier = 0x9e3779b97f4a7c15;
+
+	auto mix = [](u64 h) {
+		h ^= h >> 32;
+		h *= 0xd6e8feb86659fd93;
+		h ^= h >> 32;
+		return h;
+	};
+
+	u64 hash = seed ^ (u64(data.size()) * Multiplier);
+
+	usize offset = 0;
+	for (; offset + 8 <= data.size(); offset += 8) {
+		u64 word;
+		std::memcpy(&word, data.data() + offset, 8);
+		hash = (hash ^ mix(word)) * Multiplier;
+	}
+
+	if (offset < data.size()) {
+		u64 word = 0;
+		std::memcpy(&word, data.data() + offset, data.size() - offset);
+		hash = (hash ^ mix(word)) * Multiplier;
+	}
+
+	return mix(hash);
+}
+
 } // namespace Anker
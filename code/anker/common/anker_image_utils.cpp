@@ -20,4 +20,13 @@ Image::~Image()
 	stbi_image_free((void*)m_pixels);
 }
 
+std::optional<Vec2u> Image::querySize(std::span<const u8> imageData)
+{
+	int width = 0, height = 0, channels = 0;
+	if (!stbi_info_from_memory(imageData.data(), int(imageData.size()), &width, &height, &channels)) {
+		return std::nullopt;
+	}
+	return Vec2u(u32(width), u32(height));
+}
+
 } // namespace Anker
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <anker/common/anker_file_utils.hpp>
+#include <anker/common/anker_math.hpp>
 #include <anker/common/anker_type_utils.hpp>
 
 namespace Anker {
@@ -17,19 +18,22 @@ class Image {
 	Image& operator=(Image&&) noexcept = delete;
 	~Image() noexcept;
 
+	// Reads the dimensions from the image header, without decoding the image.
+	static std::optional<Vec2u> querySize(std::span<const u8>);
+
 	explicit operator bool() const { return m_pixels; }
 	const u8* pixels() const { return m_pixels; }
 
 	template <typename T>
 	const T& pixel(int index) const
 	{
-		return reinterpret_cast<const T&>(m_pixels + m_pixelStride * index);
+		return *reinterpret_cast<const T*>(m_pixels + m_pixelStride * index);
 	}
 
 	template <typename T>
 	const T& pixel(int x, int y) const
 	{
-		return pixel(y * m_width + x);
+		return pixel<T>(y * m_width + x);
 	}
 
 	int width() const { return m_width; }
@@ -0,0 +1,115 @@
+#include <anker/common/anker_mapped_file.hpp>
+
+#if ANKER_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Anker {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other) {
+		close();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+#if ANKER_PLATFORM_WINDOWS
+		m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+	}
+	return *this;
+}
+
+#if ANKER_PLATFORM_WINDOWS
+
+Status MappedFile::open(const fs::path& filepath)
+{
+	close();
+
+	HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+	                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return ReadError;
+	}
+	ANKER_DEFER(CloseHandle(file));
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		return ReadError;
+	}
+
+	m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		return ReadError;
+	}
+
+	m_data = static_cast<const u8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_data) {
+		close();
+		return ReadError;
+	}
+	m_size = usize(size.QuadPart);
+
+	return Ok;
+}
+
+void MappedFile::close()
+{
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+}
+
+#elif ANKER_PLATFORM_LINUX
+
+Status MappedFile::open(const fs::path& filepath)
+{
+	close();
+
+	int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return ReadError;
+	}
+	ANKER_DEFER(::close(fd));
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		return ReadError;
+	}
+
+	void* data = mmap(nullptr, usize(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return ReadError;
+	}
+
+	m_data = static_cast<const u8*>(data);
+	m_size = usize(info.st_size);
+
+	return Ok;
+}
+
+void MappedFile::close()
+{
+	if (m_data) {
+		munmap(const_cast<u8*>(m_data), m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+}
+
+#endif
+
+} // namespace Anker
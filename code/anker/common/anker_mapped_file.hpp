@@ -0,0 +1,35 @@
+#pragma once
+
+#include <anker/common/anker_file_utils.hpp>
+
+namespace Anker {
+
+// Read-only memory mapping of a file. The mapped data is valid as long as the
+// MappedFile is alive and open.
+class MappedFile {
+  public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) noexcept;
+	MappedFile& operator=(MappedFile&&) noexcept;
+	~MappedFile() noexcept { close(); }
+
+	// Errors are not logged, a missing file is a common case for callers.
+	Status open(const fs::path&);
+	void close();
+
+	bool isOpen() const { return m_data != nullptr; }
+
+	std::span<const u8> data() const { return {m_data, m_size}; }
+
+  private:
+	const u8* m_data = nullptr;
+	usize m_size = 0;
+
+#if ANKER_PLATFORM_WINDOWS
+	HANDLE m_mapping = nullptr;
+#endif
+};
+
+} // namespace Anker
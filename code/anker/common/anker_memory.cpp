@@ -1,37 +1,52 @@
 // This file overrides C++' memory allocation operators. We use this to forward
 // allocation calls to mimalloc and enable profiling.
 
+#include <anker/common/anker_memory.hpp>
+
+static std::atomic<Anker::u64> g_allocationCount = 0;
+
+Anker::u64 Anker::allocationCount()
+{
+	return g_allocationCount.load(std::memory_order_relaxed);
+}
+
 #if 1
 
 #include <mimalloc.h>
 
+static void trackAllocation([[maybe_unused]] void* ptr, [[maybe_unused]] size_t size)
+{
+	g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	ANKER_PROFILE_ALLOC(ptr, size);
+}
+
 // replaceable allocation functions
 
 [[nodiscard]] void* operator new(size_t size)
 {
 	void* ptr = mi_new(size);
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new[](size_t size)
 {
 	void* ptr = mi_new(size);
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new(size_t size, std::align_val_t al)
 {
 	void* ptr = mi_new_aligned(size, static_cast<size_t>(al));
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new[](size_t size, std::align_val_t al)
 {
 	void* ptr = mi_new_aligned(size, static_cast<size_t>(al));
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
@@ -40,28 +55,28 @@
 [[nodiscard]] void* operator new(size_t size, const std::nothrow_t&) noexcept
 {
 	void* ptr = mi_new_nothrow(size);
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new[](size_t size, const std::nothrow_t&) noexcept
 {
 	void* ptr = mi_new_nothrow(size);
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
 {
 	void* ptr = mi_new_aligned_nothrow(size, static_cast<size_t>(al));
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
 [[nodiscard]] void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
 {
 	void* ptr = mi_new_aligned_nothrow(size, static_cast<size_t>(al));
-	ANKER_PROFILE_ALLOC(ptr, size);
+	trackAllocation(ptr, size);
 	return ptr;
 }
 
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <anker/common/anker_type_utils.hpp>
+
+namespace Anker {
+
+// Number of allocations done via operator new since program start. This is
+// tracked independently of the profiling backend and is cheap enough to query
+// every frame.
+u64 allocationCount();
+
+} // namespace Anker
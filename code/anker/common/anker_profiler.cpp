@@ -0,0 +1,346 @@
+#include <anker/common/anker_profiler.hpp>
+
+#include <rapidjson/writer.h>
+
+namespace Anker::Profiler {
+
+enum class EventType : u8 {
+	Zone,
+	Frame,
+	Counters,
+};
+
+struct AllocationCounters {
+	u64 allocations;
+	u64 allocatedBytes;
+	u64 frees;
+};
+
+struct Event {
+	i64 begin = 0; // ns since profiler start
+	i64 end = 0;   // ns since profiler start
+	const char* name = nullptr;
+	union {
+		std::array<char, 32> text{};
+		AllocationCounters counters;
+	};
+	EventType type = EventType::Zone;
+	u8 textSize = 0;
+};
+static_assert(sizeof(Event) == 64);
+static_assert(std::is_trivially_copyable_v<Event>);
+
+// Events are stored as atomic words, since captures read them while the owning
+// thread may overwrite them. The sequence is odd while the slot is written, and
+// 2 * (index + 1) once event index is complete.
+struct EventSlot {
+	std::atomic<u64> sequence = 0;
+	std::array<std::atomic<u64>, sizeof(Event) / sizeof(u64)> words{};
+};
+
+// Ring buffer of events, written by a single thread only. When the buffer is
+// full, the oldest events are overwritten.
+struct ThreadBuffer {
+	static constexpr usize Capacity = 1 << 16;
+
+	u32 threadId = 0;
+	std::atomic<u64> head = 0;
+	std::unique_ptr<EventSlot[]> slots = std::make_unique<EventSlot[]>(Capacity);
+};
+
+static const Clock::time_point g_startTimestamp = Clock::now();
+
+static std::mutex g_threadBuffersMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> g_threadBuffers;
+
+static fs::path g_captureAtExitPath;
+
+// Allocation counters are kept separate from the thread buffer, since touching
+// the buffer may allocate, which would recurse into recordAlloc.
+static thread_local AllocationCounters t_allocationCounters{};
+
+static i64 toProfilerTime(Clock::time_point timestamp)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - g_startTimestamp).count();
+}
+
+static ThreadBuffer& threadBuffer()
+{
+	// Buffers are owned by the global list so that events of threads that have
+	// already terminated are still part of the capture.
+	static thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		std::scoped_lock lock(g_threadBuffersMutex);
+		auto& newBuffer = g_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+		newBuffer->threadId = u32(g_threadBuffers.size());
+		buffer = newBuffer.get();
+	}
+	return *buffer;
+}
+
+static void pushEvent(const Event& event)
+{
+	auto& buffer = threadBuffer();
+	u64 head = buffer.head.load(std::memory_order_relaxed);
+	auto& slot = buffer.slots[head % ThreadBuffer::Capacity];
+
+	const auto words = std::bit_cast<std::array<u64, sizeof(Event) / sizeof(u64)>>(event);
+
+	slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (usize i = 0; i < words.size(); ++i) {
+		slot.words[i].store(words[i], std::memory_order_relaxed);
+	}
+	slot.sequence.store(2 * (head + 1), std::memory_order_release);
+
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+// Copies the events of the given buffer. Events overwritten by the owning
+// thread while copying, including one that is only partially written, are
+// discarded.
+static std::vector<Event> collectEvents(const ThreadBuffer& buffer)
+{
+	u64 head = buffer.head.load(std::memory_order_acquire);
+	u64 tail = head > ThreadBuffer::Capacity ? head - ThreadBuffer::Capacity : 0;
+
+	std::vector<Event> events;
+	events.reserve(head - tail);
+	for (u64 i = tail; i < head; ++i) {
+		auto& slot = buffer.slots[i % ThreadBuffer::Capacity];
+		const u64 sequence = 2 * (i + 1);
+		if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+			continue;
+		}
+
+		std::array<u64, sizeof(Event) / sizeof(u64)> words;
+		for (usize w = 0; w < words.size(); ++w) {
+			words[w] = slot.words[w].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+			continue;
+		}
+
+		events.push_back(std::bit_cast<Event>(words));
+	}
+
+	return events;
+}
+
+void recordZone(Clock::time_point begin, const char* name, std::string_view text)
+{
+	Event event;
+	event.type = EventType::Zone;
+	event.begin = toProfilerTime(begin);
+	event.end = toProfilerTime(Clock::now());
+	event.name = name;
+	event.textSize = u8(std::min(text.size(), event.text.size()));
+	std::ranges::copy(text.substr(0, event.textSize), event.text.begin());
+	pushEvent(event);
+}
+
+void recordFrameMark()
+{
+	Event frameMark;
+	frameMark.type = EventType::Frame;
+	frameMark.begin = frameMark.end = toProfilerTime(Clock::now());
+	frameMark.name = "Frame";
+	pushEvent(frameMark);
+
+	Event counters = frameMark;
+	counters.type = EventType::Counters;
+	counters.name = "Allocations";
+	counters.counters = t_allocationCounters;
+	pushEvent(counters);
+}
+
+void recordAlloc(usize size)
+{
+	t_allocationCounters.allocations++;
+	t_allocationCounters.allocatedBytes += size;
+}
+
+void recordFree()
+{
+	t_allocationCounters.frees++;
+}
+
+////////////////////////////////////////////////////////////
+// Capture
+
+static std::string writeChromeTrace(std::span<const std::pair<u32, std::vector<Event>>> threads)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer writer(buffer);
+
+	auto writeCommon = [&](const char* phase, u32 threadId, const Event& event) {
+		writer.Key("name");
+		writer.String(event.name ? event.name : "?");
+		writer.Key("ph");
+		writer.String(phase);
+		writer.Key("pid");
+		writer.Uint(0);
+		writer.Key("tid");
+		writer.Uint(threadId);
+		writer.Key("ts");
+		writer.Double(double(event.begin) / 1000.0);
+	};
+
+	writer.StartObject();
+	writer.Key("displayTimeUnit");
+	writer.String("ms");
+	writer.Key("traceEvents");
+	writer.StartArray();
+
+	for (auto& [threadId, events] : threads) {
+		for (auto& event : events) {
+			writer.StartObject();
+			switch (event.type) {
+			case EventType::Zone:
+				writeCommon("X", threadId, event);
+				writer.Key("dur");
+				writer.Double(double(event.end - event.begin) / 1000.0);
+				if (event.textSize > 0) {
+					writer.Key("args");
+					writer.StartObject();
+					writer.Key("text");
+					writer.String(event.text.data(), event.textSize);
+					writer.EndObject();
+				}
+				break;
+			case EventType::Frame:
+				writeCommon("i", threadId, event);
+				writer.Key("s");
+				writer.String("p");
+				break;
+			case EventType::Counters:
+				writeCommon("C", threadId, event);
+				writer.Key("args");
+				writer.StartObject();
+				writer.Key("allocations");
+				writer.Uint64(event.counters.allocations);
+				writer.Key("allocatedBytes");
+				writer.Uint64(event.counters.allocatedBytes);
+				writer.Key("frees");
+				writer.Uint64(event.counters.frees);
+				writer.EndObject();
+				break;
+			}
+			writer.EndObject();
+		}
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+
+	return {buffer.GetString(), buffer.GetSize()};
+}
+
+// The binary format consists of a header, a table of zone names, and the
+// events of each thread. Names are referenced by index. Values are stored in
+// host byte order, readers detect a mismatch by the magic.
+//
+//   u32 magic 'ANKP', u32 version
+//   u32 nameCount, { u16 size, char[size] }...
+//   u32 threadCount, { u32 threadId, u32 eventCount, Event... }...
+//
+//   Event: u8 type, u32 nameIndex, i64 begin, i64 end, followed by
+//          u8 textSize, char[textSize] for zones, or
+//          u64 allocations, u64 allocatedBytes, u64 frees for counters.
+static ByteBuffer writeBinary(std::span<const std::pair<u32, std::vector<Event>>> threads)
+{
+	ByteBuffer buffer;
+
+	auto write = [&]<typename T>(const T& value) {
+		auto bytes = std::as_bytes(std::span(&value, 1));
+		buffer.insert(buffer.end(), reinterpret_cast<const u8*>(bytes.data()),
+		              reinterpret_cast<const u8*>(bytes.data()) + bytes.size());
+	};
+
+	std::vector<const char*> names;
+	std::unordered_map<const char*, u32> nameIndices;
+	for (auto& [threadId, events] : threads) {
+		for (auto& event : events) {
+			if (auto [it, inserted] = nameIndices.try_emplace(event.name, u32(names.size())); inserted) {
+				names.push_back(event.name);
+			}
+		}
+	}
+
+	write(u32('A' | 'N' << 8 | 'K' << 16 | 'P' << 24));
+	write(u32(1));
+
+	write(u32(names.size()));
+	for (auto* name : names) {
+		std::string_view nameView = name ? name : "?";
+		write(u16(nameView.size()));
+		buffer.insert(buffer.end(), nameView.begin(), nameView.end());
+	}
+
+	write(u32(threads.size()));
+	for (auto& [threadId, events] : threads) {
+		write(threadId);
+		write(u32(events.size()));
+		for (auto& event : events) {
+			write(event.type);
+			write(nameIndices[event.name]);
+			write(event.begin);
+			write(event.end);
+			if (event.type == EventType::Counters) {
+				write(event.counters.allocations);
+				write(event.counters.allocatedBytes);
+				write(event.counters.frees);
+			} else {
+				write(event.textSize);
+				buffer.insert(buffer.end(), event.text.begin(), event.text.begin() + event.textSize);
+			}
+		}
+	}
+
+	return buffer;
+}
+
+Status writeCapture(const fs::path& filepath, CaptureFormat format)
+{
+	std::vector<std::pair<u32, std::vector<Event>>> threads;
+	{
+		std::scoped_lock lock(g_threadBuffersMutex);
+		for (auto& buffer : g_threadBuffers) {
+			threads.emplace_back(buffer->threadId, collectEvents(*buffer));
+		}
+	}
+
+	Status status = Ok;
+	switch (format) {
+	case CaptureFormat::ChromeTrace:
+		status = writeFile(writeChromeTrace(threads), filepath);
+		break;
+	case CaptureFormat::Binary:
+		status = writeFile(writeBinary(threads), filepath);
+		break;
+	}
+
+	if (status) {
+		ANKER_INFO("Profiler capture written to {}", filepath);
+	}
+
+	return status;
+}
+
+void writeCaptureAtExit(const fs::path& filepath)
+{
+	static bool registered = false;
+	if (!registered) {
+		std::atexit([] {
+			auto format = g_captureAtExitPath.extension() == ".json" ? CaptureFormat::ChromeTrace : CaptureFormat::Binary;
+			std::ignore = writeCapture(g_captureAtExitPath, format);
+		});
+		registered = true;
+	}
+
+	g_captureAtExitPath = filepath;
+}
+
+} // namespace Anker::Profiler
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <anker/common/anker_status.hpp>
+#include <anker/common/anker_type_utils.hpp>
+
+// The builtin profiler is a lightweight alternative to Tracy. It records zones,
+// frame marks, and allocation counters into per-thread ring buffers. Each
+// thread only writes to its own buffer, so recording is lock-free. Recorded
+// events can be written as Chrome trace (chrome://tracing, Perfetto) or in a
+// compact binary format, either on demand or at exit.
+//
+// Use the ANKER_PROFILE_* macros from anker_profiling.hpp instead of calling
+// these functions directly.
+namespace Anker::Profiler {
+
+namespace fs = std::filesystem;
+
+enum class CaptureFormat {
+	ChromeTrace,
+	Binary,
+};
+
+// Writes all events currently held by the ring buffers to the given file.
+Status writeCapture(const fs::path&, CaptureFormat = CaptureFormat::ChromeTrace);
+
+// Sets a file the capture is written to when the application exits. The format
+// is determined by the file extension (.json or .ankprof).
+void writeCaptureAtExit(const fs::path&);
+
+void recordZone(Clock::time_point begin, const char* name, std::string_view text = {});
+void recordFrameMark();
+
+void recordAlloc(usize size);
+void recordFree();
+
+// Scoped zone used by ANKER_PROFILE_ZONE macros. The zone is recorded as single
+// event holding begin and end timestamp when the scope is left.
+class Zone {
+  public:
+	explicit Zone(const char* name, std::string_view text = {}) : m_name(name)
+	{
+		if (!text.empty()) {
+			// Keep the tail of the text, for file paths this is the interesting bit.
+			m_textSize = u8(std::min(text.size(), m_text.size()));
+			std::ranges::copy(text.substr(text.size() - m_textSize), m_text.begin());
+		}
+	}
+
+	Zone(const Zone&) = delete;
+	Zone& operator=(const Zone&) = delete;
+	Zone(Zone&&) noexcept = delete;
+	Zone& operator=(Zone&&) noexcept = delete;
+
+	~Zone() noexcept { recordZone(m_begin, m_name, {m_text.data(), m_textSize}); }
+
+  private:
+	Clock::time_point m_begin = Clock::now();
+	const char* m_name = nullptr;
+	std::array<char, 32> m_text;
+	u8 m_textSize = 0;
+};
+
+} // namespace Anker::Profiler
@@ -1,8 +1,20 @@
 #pragma once
 
-#define ANKER_PROFILE_ENALBED 0
+// The profiling backend is selected at compile time via ANKER_PROFILE_BACKEND,
+// see the ANKER_PROFILER option in CMakeLists.txt. Tracy streams events to the
+// Tracy profiler, while the builtin backend records them in-process and writes
+// a capture file (see anker_profiler.hpp).
+#define ANKER_PROFILE_BACKEND_NONE 0
+#define ANKER_PROFILE_BACKEND_TRACY 1
+#define ANKER_PROFILE_BACKEND_BUILTIN 2
+
+#ifndef ANKER_PROFILE_BACKEND
+#define ANKER_PROFILE_BACKEND ANKER_PROFILE_BACKEND_NONE
+#endif
+
+#define ANKER_PROFILE_ENABLED (ANKER_PROFILE_BACKEND != ANKER_PROFILE_BACKEND_NONE)
 
-#if ANKER_PROFILE_ENALBED
+#if ANKER_PROFILE_BACKEND == ANKER_PROFILE_BACKEND_TRACY
 
 #define TRACY_CALLSTACK 16
 #include <tracy/Tracy.hpp>
@@ -23,9 +35,23 @@
 #define ANKER_PROFILE_ALLOC(ptr, size) TracyAlloc(ptr, size)
 #define ANKER_PROFILE_FREE(ptr) TracyFree(ptr)
 
+#elif ANKER_PROFILE_BACKEND == ANKER_PROFILE_BACKEND_BUILTIN
+
+#include <anker/common/anker_macros.hpp>
+#include <anker/common/anker_profiler.hpp>
+
+#define ANKER_PROFILE_ZONE() const ::Anker::Profiler::Zone ANKER_TEMPORARY(ankerProfileZone)(__func__)
+#define ANKER_PROFILE_ZONE_N(name) const ::Anker::Profiler::Zone ANKER_TEMPORARY(ankerProfileZone)(name)
+#define ANKER_PROFILE_ZONE_T(text) const ::Anker::Profiler::Zone ANKER_TEMPORARY(ankerProfileZone)(__func__, text)
+
+#define ANKER_PROFILE_FRAME_MARK() ::Anker::Profiler::recordFrameMark()
+
+#define ANKER_PROFILE_ALLOC(ptr, size) ::Anker::Profiler::recordAlloc(size)
+#define ANKER_PROFILE_FREE(ptr) ::Anker::Profiler::recordFree()
+
 #else
 
-#define ANKER_PROFILE_ZONE(name)
+#define ANKER_PROFILE_ZONE()
 #define ANKER_PROFILE_ZONE_N(name)
 #define ANKER_PROFILE_ZONE_T(text)
 #define ANKER_PROFILE_FRAME_MARK()
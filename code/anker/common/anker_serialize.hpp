@@ -24,6 +24,87 @@ concept CustomSerialization = requires(Archive archive, T v)
 template <typename Archive, typename T>
 concept SerializableClass = std::is_class_v<T> && (CustomSerialization<Archive, T> || refl::is_reflectable<T>());
 
+// Members of a reflectable type which are read during deserialization: fields
+// and properties providing a getter and setter.
+template <typename T>
+constexpr auto readableMembers()
+{
+	return filter(refl::reflect<T>().members, [](auto member) {
+		if constexpr (is_property(member)) {
+			return is_writable(member) && has_reader(member);
+		} else {
+			return is_field(member);
+		}
+	});
+}
+
+template <typename T>
+using ReadableMembers = decltype(readableMembers<T>());
+
+// Value type of a field, or the type returned by the getter of a property.
+template <typename Member>
+struct MemberValueTypeImpl {
+	using type = typename Member::value_type;
+};
+
+template <typename Member>
+requires refl::trait::is_property_v<Member>
+struct MemberValueTypeImpl<Member> {
+	using type = std::invoke_result_t<decltype(refl::descriptor::get_reader(Member{})), typename Member::declaring_type&>;
+};
+
+template <typename Member>
+using MemberValueType = std::remove_cvref_t<typename MemberValueTypeImpl<Member>::type>;
+
+// Storage for the (display) name of a member, so string views can refer to it.
+template <typename Member>
+inline constexpr auto memberName = refl::descriptor::get_display_name_const(Member{});
+
+struct MemberKey {
+	u32 hash = 0;
+	u32 index = 0;
+	std::string_view name;
+};
+
+constexpr u32 memberKeyHash(std::string_view name)
+{
+	return entt::hashed_string::value(name.data(), name.size());
+}
+
+// Member names of a reflectable type, sorted by hash. Used by deserializers to
+// map keys to members without comparing against every member name.
+template <typename T>
+inline constexpr auto memberKeyTable = [] {
+	using Members = ReadableMembers<T>;
+
+	std::array<MemberKey, Members::size> table;
+	for_each(Members{}, [&](auto member, usize index) {
+		constexpr auto& name = memberName<decltype(member)>;
+		table[index].name = std::string_view(name.c_str(), name.size);
+		table[index].hash = memberKeyHash(table[index].name);
+		table[index].index = u32(index);
+	});
+	std::ranges::sort(table, {}, &MemberKey::hash);
+	return table;
+}();
+
+// Returns the index of the member with the given name, as used by
+// ReadableMembers<T>.
+template <typename T>
+constexpr std::optional<u32> findMemberKey(std::string_view name)
+{
+	const auto& table = memberKeyTable<T>;
+	const u32 hash = memberKeyHash(name);
+
+	auto it = std::ranges::lower_bound(table, hash, {}, &MemberKey::hash);
+	for (; it != table.end() && it->hash == hash; ++it) {
+		if (it->name == name) {
+			return it->index;
+		}
+	}
+	return std::nullopt;
+}
+
 } // namespace Internal
 
 namespace Attr {
@@ -0,0 +1,455 @@
+#pragma once
+
+#include <anker/common/anker_file_utils.hpp>
+#include <anker/common/anker_io_utils.hpp>
+#include <anker/common/anker_serialize.hpp>
+#include <anker/common/anker_status.hpp>
+#include <anker/common/anker_type_utils.hpp>
+
+namespace Anker {
+
+class BinaryReader;
+class BinaryWriter;
+
+namespace Internal {
+
+template <typename T>
+constexpr bool isBinaryBulkCopyable();
+
+// Types whose serialized form is their in-memory representation. These are
+// copied in bulk, which also applies to arrays of such types. Types with
+// custom serialization or properties are excluded, since their serialized form
+// may differ. Reflectable types qualify only if all their members do, which
+// rules out pointers.
+template <typename T>
+inline constexpr bool BinaryBulkCopyable = isBinaryBulkCopyable<T>();
+
+template <typename T>
+constexpr bool isBinaryBulkCopyable()
+{
+	if constexpr (!std::is_trivially_copyable_v<T> || std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+		return false;
+	} else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+		return true;
+	} else if constexpr (CustomSerialization<BinaryWriter, T> || CustomSerialization<BinaryReader, T>) {
+		return false;
+	} else if constexpr (refl::is_reflectable<T>()) {
+		return !refl::util::contains(readableMembers<T>(), [](auto member) {
+			return is_property(member) || !BinaryBulkCopyable<MemberValueType<decltype(member)>>;
+		});
+	} else {
+		return true;
+	}
+}
+
+template <typename T>
+struct IsStdVector : std::false_type {};
+template <typename T>
+struct IsStdVector<std::vector<T>> : std::true_type {};
+
+template <typename T>
+struct IsStdArray : std::false_type {};
+template <typename T, usize N>
+struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct IsStdSmartPointer : std::false_type {};
+template <typename T>
+struct IsStdSmartPointer<std::shared_ptr<T>> : std::true_type {};
+template <typename T, typename D>
+struct IsStdSmartPointer<std::unique_ptr<T, D>> : std::true_type {};
+
+// Class types handled by the binary archives. Since refl-cpp provides
+// reflection data for smart pointers, these would be serialized as empty
+// objects. They require a custom serialize function instead.
+template <typename Archive, typename T>
+concept BinarySerializableClass = std::is_class_v<T>
+                               && (CustomSerialization<Archive, T>
+                                   || (!IsStdSmartPointer<T>::value
+                                       && (refl::is_reflectable<T>() || BinaryBulkCopyable<T>)));
+
+constexpr u32 schemaHashCombine(u32 seed, u32 value)
+{
+	// FNV-1a step
+	return (seed ^ value) * 16777619u;
+}
+
+constexpr u32 schemaHashCombine(u32 seed, std::string_view value)
+{
+	return schemaHashCombine(seed, entt::hashed_string::value(value.data(), value.size()));
+}
+
+// The schema hash captures the structure of a type as seen by the binary
+// archives: member names, member types, and the size of bulk copied types.
+// Types with custom serialization only contribute their size, their
+// serialize functions are opaque.
+template <typename T>
+constexpr u32 binarySchemaHash()
+{
+	u32 hash = 2166136261u;
+
+	if constexpr (std::is_enum_v<T>) {
+		hash = schemaHashCombine(hash, "enum");
+		hash = schemaHashCombine(hash, binarySchemaHash<std::underlying_type_t<T>>());
+	} else if constexpr (std::is_arithmetic_v<T>) {
+		hash = schemaHashCombine(hash, std::is_floating_point_v<T> ? "float" : std::is_signed_v<T> ? "int" : "uint");
+		hash = schemaHashCombine(hash, u32(sizeof(T)));
+	} else if constexpr (std::is_same_v<T, std::string>) {
+		hash = schemaHashCombine(hash, "string");
+	} else if constexpr (IsStdVector<T>::value) {
+		hash = schemaHashCombine(hash, "vector");
+		hash = schemaHashCombine(hash, binarySchemaHash<typename T::value_type>());
+	} else if constexpr (IsStdArray<T>::value) {
+		hash = schemaHashCombine(hash, "array");
+		hash = schemaHashCombine(hash, u32(std::tuple_size_v<T>));
+		hash = schemaHashCombine(hash, binarySchemaHash<typename T::value_type>());
+	} else if constexpr (refl::is_reflectable<T>() && !CustomSerialization<BinaryWriter, T>) {
+		if constexpr (BinaryBulkCopyable<T>) {
+			hash = schemaHashCombine(hash, u32(sizeof(T)));
+		}
+		for_each(ReadableMembers<T>{}, [&](auto member) {
+			using Member = decltype(member);
+			hash = schemaHashCombine(hash, std::string_view(memberName<Member>.c_str(), memberName<Member>.size));
+			if constexpr (Serializable<BinaryWriter, MemberValueType<Member>>) {
+				hash = schemaHashCombine(hash, binarySchemaHash<MemberValueType<Member>>());
+			}
+		});
+	} else {
+		hash = schemaHashCombine(hash, "opaque");
+		hash = schemaHashCombine(hash, u32(sizeof(T)));
+	}
+
+	return hash;
+}
+
+// Header preceding the value when using toFile / fromFile.
+struct BinaryHeader {
+	static constexpr u32 Magic = 'A' | 'N' << 8 | 'K' << 16 | 'B' << 24;
+
+	u32 magic = Magic;
+	u32 schemaHash = 0;
+};
+
+} // namespace Internal
+
+////////////////////////////////////////////////////////////
+// Binary Writer
+
+// The binary writer serializes data into a compact byte buffer. It uses the
+// same reflection data and serialize customization points as the JSON
+// archives, but no keys are stored. Members are written in declaration order,
+// reading therefore requires the exact same type layout. Use the schema hash
+// to detect mismatches, toFile does this automatically.
+//
+// Trivially copyable types (without custom serialization or properties) are
+// copied in bulk. Members that cannot be serialized are skipped.
+//
+// Values are stored in native byte order; the format is meant for snapshots,
+// save games, and cooked data, not for exchange between platforms.
+class BinaryWriter {
+  public:
+	template <typename T>
+	static Status toFile(const fs::path& filepath, const T& value) requires Serializable<BinaryWriter, T>
+	{
+		BinaryWriter write;
+		write.header<T>();
+		write(value);
+		return writeFile(write.output(), filepath);
+	}
+
+	std::span<const u8> output() const { return m_buffer; }
+
+	// Moves the output out of the writer, the writer is empty afterwards.
+	ByteBuffer takeOutput() { return std::move(m_buffer); }
+
+	usize size() const { return m_buffer.size(); }
+	void reserve(usize size) { m_buffer.reserve(size); }
+	void clear() { m_buffer.clear(); }
+
+	// Overwrites a value previously written at the given offset, e.g. to fill
+	// in a count or size once it is known.
+	template <typename T>
+	void patch(usize offset, T value) requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	{
+		auto data = asBytes(std::span(&value, 1));
+		ANKER_CHECK(offset + data.size() <= m_buffer.size());
+		std::ranges::copy(data, m_buffer.begin() + std::ptrdiff_t(offset));
+	}
+
+	// Writes a header containing the schema hash of T.
+	template <typename T>
+	void header()
+	{
+		Internal::BinaryHeader header;
+		header.schemaHash = Internal::binarySchemaHash<T>();
+		(*this)(header.magic);
+		(*this)(header.schemaHash);
+	}
+
+	template <typename T>
+	void operator()(T value) requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			(*this)(u8(value));
+		} else {
+			bytes(asBytes(std::span(&value, 1)));
+		}
+	}
+
+	void operator()(std::string_view value)
+	{
+		(*this)(u32(value.size()));
+		bytes(asBytes(std::span(value)));
+	}
+
+	// Required, since refl-cpp provides reflection data for std::string.
+	void operator()(const std::string& value) { (*this)(std::string_view(value)); }
+
+	// Size-prefixed blob, can be read back without copying.
+	void operator()(std::span<const u8> data)
+	{
+		(*this)(u32(data.size()));
+		bytes(data);
+	}
+
+	template <typename T>
+	void operator()(const std::vector<T>& values) requires Serializable<BinaryWriter, T>
+	{
+		(*this)(u32(values.size()));
+		elements(std::span<const T>(values));
+	}
+
+	template <typename T, usize N>
+	void operator()(const std::array<T, N>& values) requires Serializable<BinaryWriter, T>
+	{
+		elements(std::span<const T>(values));
+	}
+
+	template <typename T>
+	void operator()(const T& object) requires Internal::BinarySerializableClass<BinaryWriter, T>
+	{
+		if constexpr (Internal::CustomSerialization<BinaryWriter, T>) {
+			serialize(*this, object);
+		}
+
+		else if constexpr (Internal::BinaryBulkCopyable<T>) {
+			bytes(asBytes(std::span(&object, 1)));
+		}
+
+		else if constexpr (refl::is_reflectable<T>()) {
+			for_each(Internal::ReadableMembers<T>{}, [&](auto member) {
+				if constexpr (!Serializable<BinaryWriter, Internal::MemberValueType<decltype(member)>>) {
+					// skipped
+				} else if constexpr (is_property(member)) {
+					// For fields accessible via getter/setter (i.e. properties),
+					// we can just use the getter.
+					(*this)(std::invoke(get_reader(member).pointer, object));
+				} else {
+					(*this)(member(object));
+				}
+			});
+		}
+	}
+
+	void bytes(std::span<const u8> data)
+	{
+		const usize offset = m_buffer.size();
+		m_buffer.resize(offset + data.size());
+		std::ranges::copy(data, m_buffer.begin() + std::ptrdiff_t(offset));
+	}
+
+  private:
+	template <typename T>
+	void elements(std::span<const T> values)
+	{
+		if constexpr (Internal::BinaryBulkCopyable<T> && !std::is_same_v<T, bool>) {
+			bytes(asBytes(values));
+		} else {
+			for (auto& value : values) {
+				(*this)(value);
+			}
+		}
+	}
+
+	ByteBuffer m_buffer;
+};
+
+////////////////////////////////////////////////////////////
+// Binary Reader
+
+// The binary reader deserializes data written by the binary writer. The input
+// is not copied and must outlive the reader. Like the JSON reader, functions
+// return false when the input does not match the expected data, e.g. when
+// reading past the end of the input.
+class BinaryReader {
+  public:
+	template <typename T>
+	static Status fromFile(T& outValue, const fs::path& filepath) requires Serializable<BinaryReader, T>
+	{
+		ByteBuffer buffer;
+		ANKER_TRY(readFile(buffer, filepath));
+
+		BinaryReader read(buffer);
+		if (!read.header<T>()) {
+			ANKER_ERROR("{}: Schema mismatch", filepath);
+			return FormatError;
+		}
+		if (!read(outValue)) {
+			return FormatError;
+		}
+		return Ok;
+	}
+
+	explicit BinaryReader(std::span<const u8> input) : m_input(input) {}
+
+	// Reads a header and checks it against the schema hash of T.
+	template <typename T>
+	bool header()
+	{
+		Internal::BinaryHeader header;
+		ANKER_TRY((*this)(header.magic));
+		ANKER_TRY((*this)(header.schemaHash));
+		return header.magic == Internal::BinaryHeader::Magic //
+		    && header.schemaHash == Internal::binarySchemaHash<T>();
+	}
+
+	template <typename T>
+	bool operator()(T& outValue) requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			u8 value = 0;
+			ANKER_TRY((*this)(value));
+			outValue = value != 0;
+			return true;
+		} else {
+			return bytes(asBytesWritable(std::span(&outValue, 1)));
+		}
+	}
+
+	bool operator()(std::string& outValue)
+	{
+		u32 size = 0;
+		ANKER_TRY((*this)(size));
+		ANKER_TRY(size <= remaining());
+		outValue.assign(reinterpret_cast<const char*>(m_input.data() + m_offset), size);
+		m_offset += size;
+		return true;
+	}
+
+	// The view refers to the input, which has to outlive the view.
+	bool operator()(std::string_view& outValue)
+	{
+		u32 size = 0;
+		ANKER_TRY((*this)(size));
+		ANKER_TRY(size <= remaining());
+		outValue = std::string_view(reinterpret_cast<const char*>(m_input.data() + m_offset), size);
+		m_offset += size;
+		return true;
+	}
+
+	// The view refers to the input, which has to outlive the view.
+	bool operator()(std::span<const u8>& outData)
+	{
+		u32 size = 0;
+		ANKER_TRY((*this)(size));
+		ANKER_TRY(size <= remaining());
+		outData = m_input.subspan(m_offset, size);
+		m_offset += size;
+		return true;
+	}
+
+	template <typename T>
+	bool operator()(std::vector<T>& outValues) requires Serializable<BinaryReader, T>
+	{
+		u32 size = 0;
+		ANKER_TRY((*this)(size));
+
+		// Guard against bogus sizes before allocating. Every element occupies
+		// at least one byte.
+		ANKER_TRY(size <= remaining());
+
+		outValues.resize(size);
+		return elements(std::span<T>(outValues));
+	}
+
+	template <typename T, usize N>
+	bool operator()(std::array<T, N>& outValues) requires Serializable<BinaryReader, T>
+	{
+		return elements(std::span<T>(outValues));
+	}
+
+	template <typename T>
+	bool operator()(T& outObject) requires Internal::BinarySerializableClass<BinaryReader, T>
+	{
+		bool ok = true;
+
+		if constexpr (Internal::CustomSerialization<BinaryReader, T>) {
+			ok = serialize(*this, outObject);
+		}
+
+		else if constexpr (Internal::BinaryBulkCopyable<T>) {
+			ok = bytes(asBytesWritable(std::span(&outObject, 1)));
+		}
+
+		else if constexpr (refl::is_reflectable<T>()) {
+			// Stop at the first failure, the remaining input is misaligned.
+			for_each(Internal::ReadableMembers<T>{}, [&](auto member) {
+				if (!ok) {
+					return;
+				}
+
+				if constexpr (!Serializable<BinaryReader, Internal::MemberValueType<decltype(member)>>) {
+					// skipped
+				} else if constexpr (is_property(member)) {
+					// For fields accessible via getter/setter (i.e. properties)
+					auto valueCopy = std::invoke(get_reader(member).pointer, outObject);
+					ok = (*this)(valueCopy);
+					if (ok) {
+						std::invoke(get_writer(member), outObject, valueCopy);
+					}
+				} else {
+					ok = (*this)(member(outObject));
+				}
+			});
+		}
+
+		return ok;
+	}
+
+	bool bytes(std::span<u8> outData)
+	{
+		ANKER_TRY(outData.size() <= remaining());
+		std::ranges::copy(m_input.subspan(m_offset, outData.size()), outData.begin());
+		m_offset += outData.size();
+		return true;
+	}
+
+	bool skip(usize size)
+	{
+		ANKER_TRY(size <= remaining());
+		m_offset += size;
+		return true;
+	}
+
+	usize remaining() const { return m_input.size() - m_offset; }
+	bool atEnd() const { return m_offset == m_input.size(); }
+
+  private:
+	template <typename T>
+	bool elements(std::span<T> outValues)
+	{
+		if constexpr (Internal::BinaryBulkCopyable<T> && !std::is_same_v<T, bool>) {
+			return bytes(asBytesWritable(outValues));
+		} else {
+			for (auto& value : outValues) {
+				ANKER_TRY((*this)(value));
+			}
+			return true;
+		}
+	}
+
+	std::span<const u8> m_input;
+	usize m_offset = 0;
+};
+
+} // namespace Anker
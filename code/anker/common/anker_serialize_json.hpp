@@ -28,7 +28,8 @@ class JsonReader {
 		std::string buffer;
 		ANKER_TRY(readFile(buffer, filepath));
 
-		JsonReader read(buffer);
+		JsonReader read;
+		ANKER_TRY(read.parse(buffer, filepath.string()));
 		if (!read(outValue)) {
 			return FormatError;
 		}
@@ -96,21 +97,7 @@ class JsonReader {
 		}
 
 		else if constexpr (refl::is_reflectable<T>()) {
-			// For fields accessible via getter/setter (i.e. properties)
-			auto properties = filter(refl::reflect<T>().members, [](auto member) { //
-				return is_property(member) && is_writable(member) && has_reader(member);
-			});
-			for_each(properties, [&](auto member) {
-				auto valueCopy = std::invoke(get_reader(member).pointer, outObject);
-				ok = fieldByReflection(get_display_name(member), valueCopy) && ok;
-				std::invoke(get_writer(member), outObject, valueCopy);
-			});
-
-			// Fields can be accessed directly via reference.
-			auto fields = filter(refl::reflect<T>().members, [](auto member) { return is_field(member); });
-			for_each(fields, [&](auto member) { //
-				ok = fieldByReflection(member.name.c_str(), member(outObject)) && ok;
-			});
+			ok = readByReflection(outObject);
 		}
 
 		return ok;
@@ -241,11 +228,91 @@ class JsonReader {
 		return true;
 	}
 
+	// Reflectable objects are read in a single pass over the JSON object. Each
+	// key is looked up in the member key table of T and dispatched to the
+	// corresponding member reader. Members missing from the input yield false,
+	// but do not stop the remaining members from being read.
+	template <typename T>
+	bool readByReflection(T& outObject)
+	{
+		using Members = Internal::ReadableMembers<T>;
+
+		if constexpr (Members::size == 0) {
+			return true;
+		} else {
+			ANKER_TRY(current().IsObject());
+
+			static constexpr auto readers = memberReaders<T>(std::make_index_sequence<Members::size>());
+
+			bool ok = true;
+			std::bitset<Members::size> present;
+
+			for (auto& [k, v] : current().GetObject()) {
+				auto index = Internal::findMemberKey<T>({k.GetString(), k.GetStringLength()});
+				if (!index) {
+					continue;
+				}
+
+				m_values.push_back(&v);
+				ok = readers[*index](*this, outObject) && ok;
+				m_values.pop_back();
+
+				present.set(*index);
+			}
+
+			if (!present.all()) {
+				for_each(Members{}, [&](auto member, usize index) {
+					if (!present.test(index)) {
+						ok = missingMember(member) && ok;
+					}
+				});
+			}
+
+			return ok;
+		}
+	}
+
+	template <typename T, usize... Indices>
+	static constexpr auto memberReaders(std::index_sequence<Indices...>)
+	{
+		return std::array{&readMember<T, Indices>...};
+	}
+
+	// Reads the current value into the member with the given index.
+	template <typename T, usize Index>
+	static bool readMember(JsonReader& read, T& outObject)
+	{
+		using Member = refl::trait::get_t<Index, Internal::ReadableMembers<T>>;
+		constexpr Member member;
+
+		if constexpr (is_property(member)) {
+			// For fields accessible via getter/setter (i.e. properties)
+			auto valueCopy = std::invoke(get_reader(member).pointer, outObject);
+			bool ok = read.valueByReflection(get_display_name(member), valueCopy);
+			std::invoke(get_writer(member), outObject, valueCopy);
+			return ok;
+		} else {
+			// Fields can be accessed directly via reference.
+			return read.valueByReflection(member.name.c_str(), member(outObject));
+		}
+	}
+
+	template <typename Member>
+	static bool missingMember(Member member)
+	{
+		if constexpr (Serializable<JsonReader, Internal::MemberValueType<Member>>) {
+			return false;
+		} else {
+			ANKER_WARN("JsonReader: field not serialized {}", get_display_name(member));
+			return true;
+		}
+	}
+
 	template <typename T>
-	bool fieldByReflection(const char* key, T& outValue)
+	bool valueByReflection(const char* key, T& outValue)
 	{
 		if constexpr (Serializable<JsonReader, T>) {
-			return field(key, outValue);
+			return (*this)(outValue);
 		} else {
 			ANKER_WARN("JsonReader: field not serialized {}", key);
 			return true;
@@ -258,6 +325,147 @@ class JsonReader {
 	std::vector<rapidjson::Document::GenericValue*> m_values;
 };
 
+////////////////////////////////////////////////////////////
+// JSON Stream Reader
+
+// Values passed to a JsonStreamHandler. All numbers are converted to double.
+using JsonStreamValue = std::variant<std::monostate, bool, double, std::string_view>;
+
+// Base class for handlers used with JsonStreamReader. It adapts rapidjson's
+// SAX handler interface to a smaller set of functions and keeps track of the
+// key under which the current value is located. Derived classes implement:
+//
+//     bool beginObject();
+//     bool endObject();
+//     bool beginArray();
+//     bool endArray();
+//     bool value(const JsonStreamValue&);
+//
+// Inside these functions, key() returns the key of the current value, or the
+// key of the object / array that is being started or ended. The key is empty
+// for array elements and the root value. Returning false aborts parsing.
+template <typename Derived>
+class JsonStreamHandler {
+  public:
+	bool Null() { return derived().value(JsonStreamValue{}); }
+	bool Bool(bool b) { return derived().value(JsonStreamValue{b}); }
+	bool Int(int i) { return derived().value(JsonStreamValue{double(i)}); }
+	bool Uint(unsigned u) { return derived().value(JsonStreamValue{double(u)}); }
+	bool Int64(int64_t i) { return derived().value(JsonStreamValue{double(i)}); }
+	bool Uint64(uint64_t u) { return derived().value(JsonStreamValue{double(u)}); }
+	bool Double(double d) { return derived().value(JsonStreamValue{d}); }
+	bool RawNumber(const char* str, rapidjson::SizeType length, bool) { return String(str, length, false); }
+	bool String(const char* str, rapidjson::SizeType length, bool)
+	{
+		return derived().value(JsonStreamValue{std::string_view(str, length)});
+	}
+
+	bool Key(const char* str, rapidjson::SizeType length, bool)
+	{
+		m_key = std::string_view(str, length);
+		return true;
+	}
+
+	bool StartObject()
+	{
+		ANKER_TRY(derived().beginObject());
+		m_keyStack.push_back(m_key);
+		m_key = {};
+		return true;
+	}
+
+	bool EndObject(rapidjson::SizeType)
+	{
+		m_key = m_keyStack.back();
+		m_keyStack.pop_back();
+		return derived().endObject();
+	}
+
+	bool StartArray()
+	{
+		ANKER_TRY(derived().beginArray());
+		m_keyStack.push_back(m_key);
+		m_key = {};
+		return true;
+	}
+
+	bool EndArray(rapidjson::SizeType)
+	{
+		m_key = m_keyStack.back();
+		m_keyStack.pop_back();
+		return derived().endArray();
+	}
+
+  protected:
+	std::string_view key() const { return m_key; }
+
+	// Nesting depth of the current value. The root value has depth 0.
+	usize depth() const { return m_keyStack.size(); }
+
+	// Typed access to values. Returns false if the value is of a different
+	// type, in which case the output parameter is not modified.
+	template <typename T>
+	static bool read(const JsonStreamValue& value, T& outValue)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			ANKER_TRY(std::holds_alternative<bool>(value));
+			outValue = std::get<bool>(value);
+		} else if constexpr (std::is_arithmetic_v<T>) {
+			ANKER_TRY(std::holds_alternative<double>(value));
+			outValue = T(std::get<double>(value));
+		} else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+			ANKER_TRY(std::holds_alternative<std::string_view>(value));
+			outValue = T(std::get<std::string_view>(value));
+		} else {
+			static_assert(AlwaysFalse<T>, "Not a primitive");
+		}
+		return true;
+	}
+
+  private:
+	Derived& derived() { return static_cast<Derived&>(*this); }
+
+	std::string_view m_key;
+	std::vector<std::string_view> m_keyStack;
+};
+
+// The JSON stream reader parses the input with rapidjson's SAX reader and
+// forwards parsing events to the given handler; no DOM is built. Parsing
+// happens in-situ, the input buffer is modified in the process and strings
+// passed to the handler point into the buffer. They remain valid as long as
+// the buffer is alive and not modified.
+//
+// Use this instead of JsonReader for large inputs, like maps.
+class JsonStreamReader {
+  public:
+	template <typename Handler>
+	static Status parse(ByteBuffer& input, Handler& handler, std::string_view identifier = {})
+	{
+		const auto parseFlags = rapidjson::kParseInsituFlag    //
+		                      | rapidjson::kParseCommentsFlag //
+		                      | rapidjson::kParseTrailingCommasFlag;
+
+		// In-situ parsing requires a null-terminated input.
+		if (input.empty() || input.back() != '\0') {
+			input.push_back('\0');
+		}
+
+		rapidjson::InsituStringStream stream(reinterpret_cast<char*>(input.data()));
+
+		rapidjson::Reader reader;
+		rapidjson::ParseResult ok = reader.Parse<parseFlags>(stream, handler);
+		if (!ok) {
+			// On termination, the handler is expected to report the error.
+			if (ok.Code() != rapidjson::kParseErrorTermination) {
+				ANKER_ERROR("{}: {} offset={}", identifier, rapidjson::GetParseError_En(ok.Code()), ok.Offset());
+			}
+			return FormatError;
+		}
+
+		return Ok;
+	}
+};
+
 ////////////////////////////////////////////////////////////
 // JSON Writer
 
@@ -287,13 +495,16 @@ class JsonWriter {
 	void operator()(const char* value) { m_writer.String(value); }
 	void operator()(std::string_view value) { m_writer.String(value.data(), u32(value.size())); }
 
+	// Required, since refl-cpp provides reflection data for std::string.
+	void operator()(const std::string& value) { (*this)(std::string_view(value)); }
+
 	void operator()(EntityID value) { (*this)(static_cast<entt::id_type>(value)); }
 
 	template <typename EnumType>
 	void operator()(EnumType value) requires std::is_enum_v<EnumType>
 	{
 		if constexpr (ToStringable<EnumType>) {
-			(*this)(to_string(value));
+			(*this)(toString(value));
 		} else {
 			(*this)(std::underlying_type_t<EnumType>(value));
 		}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <anker/common/anker_type_utils.hpp>
+
+namespace Anker {
+
+// Bounded, lock-free queue for exactly one producer thread and one consumer
+// thread. Push fails when the queue is full; it is up to the producer to deal
+// with this (e.g. by dropping the element and flagging an overflow).
+template <typename T, usize Capacity>
+class SpscQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+	SpscQueue() = default;
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+	SpscQueue(SpscQueue&&) noexcept = delete;
+	SpscQueue& operator=(SpscQueue&&) noexcept = delete;
+
+	// Producer only.
+	bool push(T value)
+	{
+		usize tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cachedHead == Capacity) {
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+			if (tail - m_cachedHead == Capacity) {
+				return false;
+			}
+		}
+
+		m_slots[tail & (Capacity - 1)] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only.
+	std::optional<T> pop()
+	{
+		usize head = m_head.load(std::memory_order_relaxed);
+		if (head == m_cachedTail) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if (head == m_cachedTail) {
+				return std::nullopt;
+			}
+		}
+
+		std::optional<T> value = std::move(m_slots[head & (Capacity - 1)]);
+		m_head.store(head + 1, std::memory_order_release);
+		return value;
+	}
+
+  private:
+	// Head and tail are kept on separate cache lines, each next to the cached
+	// copy of the other index used by the same thread.
+	alignas(64) std::atomic<usize> m_head = 0;
+	usize m_cachedTail = 0;
+
+	alignas(64) std::atomic<usize> m_tail = 0;
+	usize m_cachedHead = 0;
+
+	alignas(64) std::array<T, Capacity> m_slots{};
+};
+
+} // namespace Anker
@@ -129,4 +129,54 @@ inline void toUpper(std::string& s)
 }
 
 } // namespace Ascii
+
+////////////////////////////////////////////////////////////
+// UTF-8 string utilities
+
+namespace Utf8 {
+
+constexpr char32_t ReplacementCharacter = 0xFFFD;
+
+// Decodes the first codepoint and removes it from the input. Invalid or
+// truncated sequences yield the replacement character.
+inline char32_t popFront(std::string_view& s)
+{
+	if (s.empty()) {
+		return ReplacementCharacter;
+	}
+
+	const auto lead = u8(s[0]);
+
+	usize length = 0;
+	char32_t codepoint = 0;
+	if (lead < 0x80) {
+		s.remove_prefix(1);
+		return lead;
+	} else if ((lead & 0xE0) == 0xC0) {
+		length = 2;
+		codepoint = lead & 0x1F;
+	} else if ((lead & 0xF0) == 0xE0) {
+		length = 3;
+		codepoint = lead & 0x0F;
+	} else if ((lead & 0xF8) == 0xF0) {
+		length = 4;
+		codepoint = lead & 0x07;
+	} else {
+		s.remove_prefix(1);
+		return ReplacementCharacter;
+	}
+
+	for (usize i = 1; i < length; ++i) {
+		if (i >= s.size() || (u8(s[i]) & 0xC0) != 0x80) {
+			s.remove_prefix(i);
+			return ReplacementCharacter;
+		}
+		codepoint = codepoint << 6 | (u8(s[i]) & 0x3F);
+	}
+
+	s.remove_prefix(length);
+	return codepoint <= 0x10FFFF ? codepoint : ReplacementCharacter;
+}
+
+} // namespace Utf8
 } // namespace Anker
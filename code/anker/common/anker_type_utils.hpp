@@ -44,6 +44,7 @@ template <typename T>
 constexpr const char* typeName()
 {
 	static_assert(AlwaysFalse<T>, "typeName undefined");
+	return nullptr;
 }
 
 // clang-format off
@@ -0,0 +1,99 @@
+#include <anker/common/anker_worker_pool.hpp>
+
+namespace Anker {
+
+WorkerPool::WorkerPool(u32 threadCount) : m_threadCount(threadCount)
+{
+	if (m_threadCount == 0) {
+		m_threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	}
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+	{
+		std::scoped_lock lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+}
+
+void WorkerPool::parallelFor(usize count, const std::function<void(usize)>& fn)
+{
+	if (count == 0) {
+		return;
+	}
+
+	std::scoped_lock submitLock(m_submitMutex);
+
+	if (m_threads.empty()) {
+		for (u32 i = 0; i < m_threadCount; ++i) {
+			m_threads.emplace_back([this] { run(); });
+		}
+	}
+
+	Job job;
+	job.fn = &fn;
+	job.count = count;
+	job.pending = count;
+
+	{
+		std::scoped_lock lock(m_mutex);
+		m_job = &job;
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	usize completed = work(job);
+
+	// Workers may still refer to the job after all indices are done, it must
+	// outlive them.
+	std::unique_lock lock(m_mutex);
+	job.pending -= completed;
+	m_done.wait(lock, [&] { return job.pending == 0 && job.activeWorkers == 0; });
+	m_job = nullptr;
+}
+
+usize WorkerPool::work(Job& job)
+{
+	usize completed = 0;
+	for (usize i = job.next++; i < job.count; i = job.next++) {
+		(*job.fn)(i);
+		completed++;
+	}
+	return completed;
+}
+
+void WorkerPool::run()
+{
+	u64 generation = 0;
+
+	std::unique_lock lock(m_mutex);
+	while (true) {
+		m_wake.wait(lock, [&] { return m_stop || (m_job && m_generation != generation); });
+		if (m_stop) {
+			return;
+		}
+
+		generation = m_generation;
+
+		auto& job = *m_job;
+		job.activeWorkers++;
+
+		lock.unlock();
+		usize completed = work(job);
+		lock.lock();
+
+		job.activeWorkers--;
+		job.pending -= completed;
+		if (job.pending == 0 && job.activeWorkers == 0) {
+			m_done.notify_all();
+		}
+	}
+}
+
+} // namespace Anker
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace Anker {
+
+// The WorkerPool runs data-parallel jobs on a fixed set of threads. The
+// calling thread participates in the job and blocks until it is done.
+//
+// Only one job runs at a time, concurrent callers are serialized. Jobs must
+// not start further jobs.
+class WorkerPool {
+  public:
+	// Defaults to one thread less than the hardware supports, since the caller
+	// participates.
+	explicit WorkerPool(u32 threadCount = 0);
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+	WorkerPool(WorkerPool&&) noexcept = delete;
+	WorkerPool& operator=(WorkerPool&&) noexcept = delete;
+	~WorkerPool() noexcept;
+
+	// Invokes fn for every index in [0, count). Threads are started on first
+	// use.
+	void parallelFor(usize count, const std::function<void(usize)>& fn);
+
+	u32 threadCount() const { return m_threadCount; }
+
+  private:
+	struct Job {
+		const std::function<void(usize)>* fn = nullptr;
+		usize count = 0;
+		std::atomic<usize> next = 0;
+
+		// Guarded by the pool's mutex.
+		usize pending = 0;
+		u32 activeWorkers = 0;
+	};
+
+	static usize work(Job&);
+	void run();
+
+	u32 m_threadCount = 0;
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_submitMutex;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	Job* m_job = nullptr;
+	u64 m_generation = 0;
+	bool m_stop = false;
+};
+
+// Global pool for parallel work, e.g. glyph generation.
+inline WorkerPool g_workerPool;
+
+} // namespace Anker
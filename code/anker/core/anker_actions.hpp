@@ -68,7 +68,8 @@ struct Actions {
 	}
 
 	Action editorToggle = {MkbInput::F1};
-	Action editorMapReload = {MkbInput::F5};
+	Action editorMapReset = {MkbInput::F5};
+	Action editorMapReload = {MkbInput::F6};
 	Action editorCameraActivate = {MkbInput::MouseRight};
 	Vec2 editorCameraPan;
 	float editorCameraZoom = 0;
@@ -84,6 +85,7 @@ REFL_FIELD(playerMoveDown)
 REFL_FIELD(playerJump)
 REFL_FIELD(playerDash)
 REFL_FIELD(editorToggle)
+REFL_FIELD(editorMapReset)
 REFL_FIELD(editorMapReload)
 REFL_FIELD(editorCameraActivate)
 REFL_END
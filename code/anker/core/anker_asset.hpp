@@ -2,20 +2,209 @@
 
 namespace Anker {
 
-// AssetPtr is a reference counted pointer to a specific asset.
+// AssetHandle is a 32-bit reference to an asset stored in one of the
+// AssetCache's pools. It consists of a slot index and the generation of that
+// slot. Once the asset is evicted, the slot's generation changes and the
+// handle becomes stale; resolving a stale handle yields nullptr. Generations
+// never wrap, a slot is retired after MaxGeneration reuses.
+//
+// Handles do not keep assets alive, see AssetPins.
 template <typename T>
-using AssetPtr = std::shared_ptr<T>;
+class AssetHandle {
+  public:
+	static constexpr u32 IndexBits = 20;
+	static constexpr u32 GenerationBits = 32 - IndexBits;
+	static constexpr u32 MaxIndex = (1u << IndexBits) - 1;
+	static constexpr u32 MaxGeneration = (1u << GenerationBits) - 1;
 
+	constexpr AssetHandle() = default;
+	constexpr AssetHandle(u32 index, u32 generation) : m_value((generation << IndexBits) | index) {}
+
+	static constexpr AssetHandle fromValue(u32 value)
+	{
+		AssetHandle handle;
+		handle.m_value = value;
+		return handle;
+	}
+
+	constexpr u32 index() const { return m_value & MaxIndex; }
+	constexpr u32 generation() const { return m_value >> IndexBits; }
+	constexpr u32 value() const { return m_value; }
+
+	// Generations start at 1, hence the null handle is 0.
+	constexpr explicit operator bool() const { return m_value != 0; }
+
+	constexpr auto operator<=>(const AssetHandle&) const = default;
+
+  private:
+	u32 m_value = 0;
+};
+
+////////////////////////////////////////////////////////////
+
+class AssetPoolBase {
+  public:
+	virtual ~AssetPoolBase() = default;
+
+	virtual void unpin(u32 handleValue) = 0;
+};
+
+// Storage for all assets of one type. Slots are kept in chunks so that assets
+// never move in memory; freed slots are reused.
 template <typename T>
-AssetPtr<T> makeAssetPtr(T&& v)
-{
-	return std::make_shared<T>(std::forward<T>(v));
-}
-
-template <typename T, typename... Args>
-AssetPtr<T> makeAssetPtr(Args&&... args)
-{
-	return std::make_shared<T>(std::forward<Args>(args)...);
-}
+class AssetPool final : public AssetPoolBase {
+  public:
+	using Handle = AssetHandle<T>;
+
+	AssetPool() = default;
+	AssetPool(const AssetPool&) = delete;
+	AssetPool& operator=(const AssetPool&) = delete;
+	AssetPool(AssetPool&&) noexcept = delete;
+	AssetPool& operator=(AssetPool&&) noexcept = delete;
+
+	// Default constructs a new asset.
+	Handle create()
+	{
+		u32 index;
+		if (!m_freeSlots.empty()) {
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		} else {
+			ANKER_CHECK(m_slots.size() <= Handle::MaxIndex, {});
+			index = u32(m_slots.size());
+			m_slots.emplace_back();
+		}
+
+		auto& slot = m_slots[index];
+		slot.asset.emplace();
+		return Handle(index, slot.generation);
+	}
+
+	// Destroys the asset, regardless of pins. Outstanding handles become stale.
+	void destroy(Handle handle)
+	{
+		auto* slot = find(handle);
+		ANKER_CHECK(slot);
+
+		slot->asset.reset();
+		slot->pins = 0;
+
+		// Wrapping the generation would revive stale handles, hence slots
+		// that exhausted their generations are retired instead of reused.
+		if (slot->generation < Handle::MaxGeneration) {
+			slot->generation++;
+			m_freeSlots.push_back(handle.index());
+		}
+	}
+
+	T* get(Handle handle)
+	{
+		auto* slot = find(handle);
+		return slot ? &*slot->asset : nullptr;
+	}
+
+	const T* get(Handle handle) const { return const_cast<AssetPool*>(this)->get(handle); }
+
+	// Pinned assets are never evicted.
+	void pin(Handle handle)
+	{
+		if (auto* slot = find(handle)) {
+			slot->pins++;
+		}
+	}
+
+	void unpin(Handle handle)
+	{
+		if (auto* slot = find(handle); slot && slot->pins > 0) {
+			slot->pins--;
+		}
+	}
+
+	void unpin(u32 handleValue) override { unpin(Handle::fromValue(handleValue)); }
+
+	bool isPinned(Handle handle) const
+	{
+		auto* slot = const_cast<AssetPool*>(this)->find(handle);
+		return slot && slot->pins > 0;
+	}
+
+  private:
+	struct Slot {
+		std::optional<T> asset;
+		u32 generation = 1;
+		u32 pins = 0;
+	};
+
+	Slot* find(Handle handle)
+	{
+		if (!handle || handle.index() >= m_slots.size()) {
+			return nullptr;
+		}
+		auto& slot = m_slots[handle.index()];
+		return slot.asset && slot.generation == handle.generation() ? &slot : nullptr;
+	}
+
+	std::deque<Slot> m_slots;
+	std::vector<u32> m_freeSlots;
+};
+
+////////////////////////////////////////////////////////////
+
+// AssetPins keeps assets alive by pinning them in their pool. All pins are
+// released when the AssetPins is cleared or destroyed. Scenes use this to
+// retain the assets referenced by their entities.
+class AssetPins {
+  public:
+	AssetPins() = default;
+	AssetPins(const AssetPins&) = delete;
+	AssetPins& operator=(const AssetPins&) = delete;
+	AssetPins(AssetPins&& other) noexcept : m_pins(std::exchange(other.m_pins, {})) {}
+	AssetPins& operator=(AssetPins&& other) noexcept
+	{
+		if (this != &other) {
+			clear();
+			m_pins = std::exchange(other.m_pins, {});
+		}
+		return *this;
+	}
+	~AssetPins() noexcept { clear(); }
+
+	template <typename T>
+	AssetHandle<T> add(AssetPool<T>& pool, AssetHandle<T> handle)
+	{
+		if (handle) {
+			pool.pin(handle);
+			m_pins.emplace_back(&pool, handle.value());
+		}
+		return handle;
+	}
+
+	// Releases the pin of previous, if any, and pins handle instead.
+	template <typename T>
+	AssetHandle<T> replace(AssetPool<T>& pool, AssetHandle<T> previous, AssetHandle<T> handle)
+	{
+		if (previous == handle) {
+			return handle;
+		}
+
+		auto it = std::ranges::find(m_pins, std::pair<AssetPoolBase*, u32>(&pool, previous.value()));
+		if (previous && it != m_pins.end()) {
+			pool.unpin(previous);
+			m_pins.erase(it);
+		}
+		return add(pool, handle);
+	}
+
+	void clear()
+	{
+		for (auto [pool, handleValue] : m_pins) {
+			pool->unpin(handleValue);
+		}
+		m_pins.clear();
+	}
+
+  private:
+	std::vector<std::pair<AssetPoolBase*, u32>> m_pins;
+};
 
 } // namespace Anker
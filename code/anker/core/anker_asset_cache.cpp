@@ -1,156 +1,563 @@
 #include <anker/core/anker_asset_cache.hpp>
 
+#include <anker/common/anker_image_utils.hpp>
 #include <anker/core/anker_data_loader.hpp>
+#include <anker/core/anker_engine.hpp>
 #include <anker/graphics/anker_font_system.hpp>
 
 namespace Anker {
 
+static usize assetBytes(const VertexShader&)
+{
+	return 0;
+}
+
+static usize assetBytes(const PixelShader&)
+{
+	return 0;
+}
+
+static usize assetBytes(const Texture& texture)
+{
+	return textureByteSize(texture.info);
+}
+
+static usize assetBytes(const Font& font)
+{
+	return font.byteSize();
+}
+
+static usize assetBytes(const AudioTrack& track)
+{
+	return track.byteSize();
+}
+
+static usize assetBytes(const AudioStream& stream)
+{
+	return stream.byteSize();
+}
+
 AssetCache::AssetCache(RenderDevice& renderDevice, FontSystem& fontSystem)
     : m_renderDevice(renderDevice), m_fontSystem(fontSystem)
-{}
+{
+	constexpr usize MiB = 1024 * 1024;
+
+	m_vertexShaderCache.stats.name = "VertexShader";
+	m_pixelShaderCache.stats.name = "PixelShader";
+	m_textureCache.stats.name = "Texture";
+	m_textureCache.stats.budget = 512 * MiB;
+	m_fontCache.stats.name = "Font";
+	m_fontCache.stats.budget = 32 * MiB;
+	m_audioTrackCache.stats.name = "AudioTrack";
+	m_audioTrackCache.stats.budget = 128 * MiB;
+	m_audioStreamCache.stats.name = "AudioStream";
+}
 
-AssetPtr<VertexShader> AssetCache::loadVertexShader(std::string_view identifier,
-                                                    std::span<const D3D11_INPUT_ELEMENT_DESC> shaderInputs)
+template <typename T, typename Init>
+AssetHandle<T> AssetCache::loadCached(AssetId id, Init&& init)
 {
-	if (auto it = m_vertexShaderCache.find(identifier); it != m_vertexShaderCache.end()) {
-		return it->second;
+	auto& cache = this->cache<T>();
+
+	if (auto it = cache.entries.find(id); it != cache.entries.end()) {
+		cache.stats.hits++;
+		it->second.lastUsed = ++m_useCounter;
+		recordManifest(id, it->second);
+		return it->second.handle;
 	}
-	return m_vertexShaderCache[std::string{identifier}] = loadVertexShaderUncached(identifier, shaderInputs);
+
+	cache.stats.misses++;
+
+	// Registers literal ids, the table is not touched by cache hits.
+	id.intern();
+
+	auto handle = cache.pool.create();
+	ANKER_CHECK(handle, {});
+
+	init(*cache.pool.get(handle));
+	load(*cache.pool.get(handle), id);
+
+	auto& entry = cache.entries[id];
+	entry.handle = handle;
+	entry.lastUsed = ++m_useCounter;
+	updateBytes(entry);
+	cache.stats.count++;
+	recordManifest(id, entry);
+
+	// Keep the new asset alive while evicting, it has not been handed out yet.
+	cache.pool.pin(handle);
+	evictOverBudget(cache);
+	cache.pool.unpin(handle);
+
+	return handle;
 }
 
-AssetPtr<VertexShader> AssetCache::loadVertexShaderUncached(std::string_view identifier,
-                                                            std::span<const D3D11_INPUT_ELEMENT_DESC> shaderInputs)
+template <typename T>
+void AssetCache::recordManifest(AssetId id, const CacheEntry<T>& entry)
 {
-	auto vertexShader = makeAssetPtr<VertexShader>();
-	vertexShader->info.inputs.assign(shaderInputs.begin(), shaderInputs.end());
-	std::ignore = m_renderDevice.loadVertexShader(*vertexShader, identifier);
-	return vertexShader;
+	auto ref = AssetRef::of<T>(id);
+
+	for (auto* recorder = m_manifestRecorder; recorder; recorder = recorder->m_previous) {
+		if (!recorder->m_recordedAssets.insert(ref).second) {
+			continue;
+		}
+
+		recorder->m_manifest.assets.push_back({
+		    .type = cache<T>().stats.name,
+		    .identifier = id.toString(),
+		    .bytes = entry.bytes,
+		});
+
+		// Files of cached assets are not read again, take them from the
+		// dependency graph instead.
+		for (auto& file : m_dependencyGraph.files(ref)) {
+			recorder->m_files.add(file);
+		}
+	}
+}
+
+template <typename T>
+void AssetCache::updateBytes(CacheEntry<T>& entry)
+{
+	auto& cache = this->cache<T>();
+	cache.stats.bytes -= entry.bytes;
+	entry.bytes = assetBytes(*cache.pool.get(entry.handle));
+	cache.stats.bytes += entry.bytes;
 }
 
-AssetPtr<PixelShader> AssetCache::loadPixelShader(std::string_view identifier)
+template <typename T>
+void AssetCache::evictOverBudget(Cache<T>& cache)
 {
-	if (auto it = m_pixelShaderCache.find(identifier); it != m_pixelShaderCache.end()) {
-		return it->second;
+	if (cache.stats.bytes <= cache.stats.budget) {
+		return;
+	}
+
+	ANKER_PROFILE_ZONE_T(cache.stats.name);
+
+	using Iterator = typename std::unordered_map<AssetId, CacheEntry<T>>::iterator;
+
+	// Pinned assets cannot be evicted.
+	std::vector<Iterator> candidates;
+	for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+		if (!cache.pool.isPinned(it->second.handle)) {
+			candidates.push_back(it);
+		}
+	}
+
+	std::ranges::sort(candidates, {}, [](Iterator it) { return it->second.lastUsed; });
+
+	for (auto it : candidates) {
+		if (cache.stats.bytes <= cache.stats.budget) {
+			break;
+		}
+		cache.stats.evictions++;
+		erase(cache, it);
 	}
-	return m_pixelShaderCache[std::string{identifier}] = loadPixelShaderUncached(identifier);
 }
 
-AssetPtr<PixelShader> AssetCache::loadPixelShaderUncached(std::string_view identifier)
+template <typename T>
+void AssetCache::erase(Cache<T>& cache, typename std::unordered_map<AssetId, CacheEntry<T>>::iterator it)
 {
-	auto pixelShader = makeAssetPtr<PixelShader>();
-	std::ignore = m_renderDevice.loadPixelShader(*pixelShader, identifier);
-	return pixelShader;
+	cache.stats.bytes -= it->second.bytes;
+	cache.stats.count--;
+	cache.pool.destroy(it->second.handle);
+	m_dependencyGraph.remove(AssetRef::of<T>(it->first));
+	cache.entries.erase(it);
 }
 
-AssetPtr<Texture> AssetCache::loadTexture(std::string_view identifier)
+template <typename T>
+void AssetCache::load(T& asset, AssetId id)
 {
-	if (auto it = m_textureCache.find(identifier); it != m_textureCache.end()) {
-		return it->second;
+	DataLoadRecorder recorder;
+	loadAsset(asset, id);
+	m_dependencyGraph.set(AssetRef::of<T>(id), recorder.files());
+}
+
+template <typename T>
+void AssetCache::reload(AssetId id)
+{
+	auto& cache = this->cache<T>();
+
+	auto it = cache.entries.find(id);
+	if (it == cache.entries.end()) {
+		return;
 	}
-	return m_textureCache[std::string{identifier}] = loadTextureUncached(identifier);
+
+	ANKER_INFO("Reloading {}", id.str());
+	load(*cache.pool.get(it->second.handle), id);
+	updateBytes(it->second);
 }
 
-AssetPtr<Texture> AssetCache::loadTextureUncached(std::string_view identifier)
+void AssetCache::loadAsset(VertexShader& vertexShader, AssetId id)
 {
-	auto texture = makeAssetPtr<Texture>();
-	if (not m_renderDevice.loadTexture(*texture, identifier)) {
-		ANKER_ERROR("{}: Missing, fallback texture will be used!", identifier);
+	std::ignore = m_renderDevice.loadVertexShader(vertexShader, id.str());
+}
+
+void AssetCache::loadAsset(PixelShader& pixelShader, AssetId id)
+{
+	std::ignore = m_renderDevice.loadPixelShader(pixelShader, id.str());
+}
+
+void AssetCache::loadAsset(Texture& texture, AssetId id)
+{
+	if (not m_renderDevice.loadTexture(texture, id.str())) {
+		ANKER_ERROR("{}: Missing, fallback texture will be used!", id.str());
 	}
-	return texture;
 }
 
-AssetPtr<Font> AssetCache::loadFont(std::string_view identifier)
+void AssetCache::loadAsset(Font& font, AssetId id)
 {
-	if (auto it = m_fontCache.find(identifier); it != m_fontCache.end()) {
-		return it->second;
+	if (not m_fontSystem.loadFont(font, id.str())) {
+		ANKER_WARN("{}: Missing, using fallback!", id.str());
+		font = m_fontSystem.systemFont();
 	}
-	return m_fontCache[std::string{identifier}] = loadFontUncached(identifier);
 }
 
-AssetPtr<Font> AssetCache::loadFontUncached(std::string_view identifier)
+void AssetCache::loadAsset(AudioTrack& track, AssetId id)
 {
-	auto font = makeAssetPtr<Font>();
+	std::ignore = track.load(id.str());
+}
 
-	if (not m_fontSystem.loadFont(*font, identifier)) {
-		ANKER_WARN("{}: Missing, using fallback!", identifier);
-		*font = m_fontSystem.systemFont();
-	}
+void AssetCache::loadAsset(AudioStream& stream, AssetId id)
+{
+	std::ignore = stream.load(id.str());
+}
 
-	return font;
+AssetHandle<VertexShader> AssetCache::loadVertexShader(AssetId id, std::span<const VertexInput> shaderInputs)
+{
+	return loadCached<VertexShader>(id, [&](VertexShader& vertexShader) {
+		vertexShader.info.inputs.assign(shaderInputs.begin(), shaderInputs.end());
+	});
+}
+
+AssetHandle<PixelShader> AssetCache::loadPixelShader(AssetId id)
+{
+	return loadCached<PixelShader>(id, [](PixelShader&) {});
 }
 
-AssetPtr<AudioTrack> AssetCache::loadAudioTrack(std::string_view identifier)
+AssetHandle<Texture> AssetCache::loadTexture(AssetId id)
 {
-	if (auto it = m_audioTrackCache.find(identifier); it != m_audioTrackCache.end()) {
-		return it->second;
+	return loadCached<Texture>(id, [](Texture&) {});
+}
+
+AssetHandle<Font> AssetCache::loadFont(AssetId id)
+{
+	return loadCached<Font>(id, [](Font&) {});
+}
+
+AssetHandle<AudioTrack> AssetCache::loadAudioTrack(AssetId id)
+{
+	return loadCached<AudioTrack>(id, [](AudioTrack&) {});
+}
+
+AssetHandle<AudioStream> AssetCache::loadAudioStream(AssetId id)
+{
+	return loadCached<AudioStream>(id, [](AudioStream&) {});
+}
+
+////////////////////////////////////////////////////////////
+// Sprite Atlas
+
+// Textures up to this size are packed into the sprite atlas. Larger ones would
+// waste too much of a page.
+const u32 SpriteAtlasMaxSize = 256;
+
+// Only PNG and JPG images can be packed, DDS textures are used as is.
+static Status loadSpriteImageData(ByteBuffer& imageData, AssetId id)
+{
+	for (auto* ext : {".png", ".jpg"}) {
+		auto filepath = std::string(id.str()) + ext;
+		if (g_assetDataLoader.exists(filepath)) {
+			return g_assetDataLoader.load(imageData, filepath);
+		}
 	}
-	return m_audioTrackCache[std::string{identifier}] = loadAudioTrackUncached(identifier);
+	return ReadError;
 }
 
-AssetPtr<AudioTrack> AssetCache::loadAudioTrackUncached(std::string_view identifier)
+TextureRegion AssetCache::loadSpriteTexture(AssetId id)
 {
-	auto track = makeAssetPtr<AudioTrack>();
-	std::ignore = track->load(identifier);
-	return track;
+	if (auto it = m_spriteAtlas.entries.find(id); it != m_spriteAtlas.entries.end()) {
+		return it->second.region;
+	}
+
+	if (auto region = addToSpriteAtlas(id)) {
+		return *region;
+	}
+
+	return {.texture = loadTexture(id)};
 }
 
-AssetPtr<AudioStream> AssetCache::loadAudioStream(std::string_view identifier)
+std::optional<TextureRegion> AssetCache::addToSpriteAtlas(AssetId id)
 {
-	if (auto it = m_audioStreamCache.find(identifier); it != m_audioStreamCache.end()) {
-		return it->second;
+	ANKER_PROFILE_ZONE_T(id.str());
+
+	DataLoadRecorder recorder;
+
+	ByteBuffer imageData;
+	if (not loadSpriteImageData(imageData, id)) {
+		return std::nullopt;
+	}
+
+	auto size = Image::querySize(imageData);
+	if (!size || size->x > SpriteAtlasMaxSize || size->y > SpriteAtlasMaxSize) {
+		return std::nullopt;
+	}
+
+	Image image(imageData);
+	if (!image) {
+		return std::nullopt;
+	}
+
+	auto allocation = m_spriteAtlas.atlas.allocate(*size);
+	if (!allocation) {
+		return std::nullopt;
+	}
+
+	if (allocation->page == m_spriteAtlas.pages.size()) {
+		m_spriteAtlas.pages.push_back(addSpriteAtlasPage());
+	}
+
+	TextureRegion region = {
+	    .texture = m_spriteAtlas.pages[allocation->page],
+	    .rect = m_spriteAtlas.atlas.textureCoordinates(allocation->rect),
+	};
+
+	m_renderDevice.updateTexture(*get(region.texture), allocation->rect,
+	                             {.data = image.pixels(), .rowPitch = u32(image.rowPitch())});
+
+	m_spriteAtlas.entries[id] = {.region = region, .rect = allocation->rect};
+	m_dependencyGraph.set(AssetRef::of<TextureRegion>(id), recorder.files());
+
+	return region;
+}
+
+// Atlas regions are updated in place. Sprites keep their texture coordinates,
+// hence the size of the image must not change.
+void AssetCache::reloadSpriteTexture(AssetId id)
+{
+	auto it = m_spriteAtlas.entries.find(id);
+	if (it == m_spriteAtlas.entries.end()) {
+		return;
+	}
+
+	ANKER_INFO("Reloading {}", id.str());
+
+	ByteBuffer imageData;
+	{
+		DataLoadRecorder recorder;
+		std::ignore = loadSpriteImageData(imageData, id);
+		m_dependencyGraph.set(AssetRef::of<TextureRegion>(id), recorder.files());
+	}
+
+	Image image(imageData);
+	if (!image) {
+		ANKER_ERROR("{}: Invalid image format", id.str());
+		return;
+	}
+
+	auto& rect = it->second.rect;
+	if (Vec2u(u32(image.width()), u32(image.height())) != rect.size) {
+		ANKER_WARN("{}: Size changed, reload the map to update the sprite atlas", id.str());
+		return;
 	}
-	return m_audioStreamCache[std::string{identifier}] = loadAudioStreamUncached(identifier);
+
+	m_renderDevice.updateTexture(*get(it->second.region.texture), rect,
+	                             {.data = image.pixels(), .rowPitch = u32(image.rowPitch())});
 }
 
-AssetPtr<AudioStream> AssetCache::loadAudioStreamUncached(std::string_view identifier)
+AssetHandle<Texture> AssetCache::addSpriteAtlasPage()
 {
-	auto track = makeAssetPtr<AudioStream>();
-	std::ignore = track->load(identifier);
-	return track;
+	AssetId id(fmt::format("atlas/sprites/{}", m_spriteAtlas.pages.size()));
+
+	auto handle = m_textureCache.pool.create();
+	ANKER_CHECK(handle, {});
+
+	// Pages are cleared, so padding between regions is transparent.
+	auto& texture = *m_textureCache.pool.get(handle);
+	texture.info = {
+	    .name = id.toString(),
+	    .size = m_spriteAtlas.atlas.pageSize(),
+	    .format = TextureFormat::R8G8B8A8_UNORM,
+	};
+	std::vector<u8> pixels(usize(texture.info.size.x) * texture.info.size.y * 4);
+	if (not m_renderDevice.createTexture(texture, std::array{TextureInit{pixels.data(), texture.info.size.x * 4}})) {
+		ANKER_FATAL("Failed to create {}", id.str());
+	}
+
+	// Pages are registered like regular textures, so they can be looked up by
+	// name, e.g. when restoring a scene snapshot. Regions of a page cannot be
+	// evicted individually, hence pages stay pinned.
+	m_textureCache.pool.pin(handle);
+
+	auto& entry = m_textureCache.entries[id];
+	entry.handle = handle;
+	entry.lastUsed = ++m_useCounter;
+	updateBytes(entry);
+	m_textureCache.stats.count++;
+
+	return handle;
 }
 
+////////////////////////////////////////////////////////////
+
 void AssetCache::reloadModifiedAssets()
 {
-	for (const auto& modifiedAssetFilepath : g_assetDataLoader.modifiedFiles()) {
-		auto modifiedAssetIdentifier = toIdentifier(modifiedAssetFilepath);
+	const auto& modifiedFiles = g_assetDataLoader.modifiedFiles();
+	if (modifiedFiles.empty()) {
+		return;
+	}
 
-		if (auto it = m_vertexShaderCache.find(modifiedAssetIdentifier); it != m_vertexShaderCache.end()) {
-			ANKER_INFO("Reloading {}", modifiedAssetIdentifier);
-			std::ignore = m_renderDevice.loadVertexShader(*it->second, it->first);
-			continue;
-		}
-		if (auto it = m_pixelShaderCache.find(modifiedAssetIdentifier); it != m_pixelShaderCache.end()) {
-			ANKER_INFO("Reloading {}", modifiedAssetIdentifier);
-			std::ignore = m_renderDevice.loadPixelShader(*it->second, it->first);
-			continue;
+	ANKER_PROFILE_ZONE();
+
+	// All modifications of a frame are handled as one batch, hence assets
+	// affected by multiple files are only reloaded once.
+	for (const auto& ref : m_dependencyGraph.affectedBy(modifiedFiles)) {
+		if (ref.type == entt::type_hash<VertexShader>::value()) {
+			reload<VertexShader>(ref.id);
+		} else if (ref.type == entt::type_hash<PixelShader>::value()) {
+			reload<PixelShader>(ref.id);
+		} else if (ref.type == entt::type_hash<Texture>::value()) {
+			reload<Texture>(ref.id);
+		} else if (ref.type == entt::type_hash<Font>::value()) {
+			reload<Font>(ref.id);
+		} else if (ref.type == entt::type_hash<AudioTrack>::value()) {
+			reload<AudioTrack>(ref.id);
+		} else if (ref.type == entt::type_hash<AudioStream>::value()) {
+			reload<AudioStream>(ref.id);
+		} else if (ref.type == entt::type_hash<TextureRegion>::value()) {
+			reloadSpriteTexture(ref.id);
+		} else if (auto it = m_reloadHandlers.find(ref.type); it != m_reloadHandlers.end()) {
+			ANKER_INFO("Reloading {}", ref.id.str());
+			it->second(ref.id);
 		}
-		if (auto it = m_textureCache.find(modifiedAssetIdentifier); it != m_textureCache.end()) {
-			ANKER_INFO("Reloading {}", modifiedAssetIdentifier);
-			std::ignore = m_renderDevice.loadTexture(*it->second, it->first);
-			continue;
+	}
+}
+
+void AssetCache::prefetch(const AssetManifest& manifest)
+{
+	ANKER_PROFILE_ZONE();
+
+	for (auto& file : manifest.files) {
+		g_assetDataLoader.prefetch(file);
+	}
+
+	m_prefetchQueue.insert(m_prefetchQueue.end(), manifest.assets.begin(), manifest.assets.end());
+}
+
+void AssetCache::loadPrefetched(Clock::duration budget)
+{
+	if (m_prefetchQueue.empty()) {
+		return;
+	}
+
+	ANKER_PROFILE_ZONE();
+
+	auto deadline = Clock::now() + budget;
+
+	while (!m_prefetchQueue.empty() && Clock::now() < deadline) {
+		auto asset = std::move(m_prefetchQueue.front());
+		m_prefetchQueue.pop_front();
+
+		AssetId id(asset.identifier);
+		auto uncached = [&](auto& cache) { return asset.type == cache.stats.name && !cache.entries.contains(id); };
+
+		// Vertex shaders are skipped, loading them requires their input
+		// layout. They are loaded by the renderers on startup anyway.
+		if (uncached(m_pixelShaderCache)) {
+			loadPixelShader(id);
+		} else if (uncached(m_textureCache)) {
+			loadTexture(id);
+		} else if (uncached(m_fontCache)) {
+			loadFont(id);
+		} else if (uncached(m_audioTrackCache)) {
+			loadAudioTrack(id);
+		} else if (uncached(m_audioStreamCache)) {
+			loadAudioStream(id);
 		}
 	}
 }
 
+void AssetCache::evictOverBudget()
+{
+	evictOverBudget(m_vertexShaderCache);
+	evictOverBudget(m_pixelShaderCache);
+	evictOverBudget(m_textureCache);
+	evictOverBudget(m_fontCache);
+	evictOverBudget(m_audioTrackCache);
+	evictOverBudget(m_audioStreamCache);
+}
+
 void AssetCache::clearUnused()
 {
-	auto isUnused = [](auto& pair) { return pair.second.use_count() == 1; };
-	std::erase_if(m_vertexShaderCache, isUnused);
-	std::erase_if(m_pixelShaderCache, isUnused);
-	std::erase_if(m_textureCache, isUnused);
-	std::erase_if(m_fontCache, isUnused);
-	std::erase_if(m_audioTrackCache, isUnused);
-	std::erase_if(m_audioStreamCache, isUnused);
+	auto clear = [&](auto& cache) {
+		for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+			auto current = it++;
+			if (!cache.pool.isPinned(current->second.handle)) {
+				erase(cache, current);
+			}
+		}
+	};
+	clear(m_vertexShaderCache);
+	clear(m_pixelShaderCache);
+	clear(m_textureCache);
+	clear(m_fontCache);
+	clear(m_audioTrackCache);
+	clear(m_audioStreamCache);
 }
 
-void AssetCache::clearAll()
+std::array<AssetCacheStats*, 6> AssetCache::allStats()
 {
-	m_vertexShaderCache.clear();
-	m_pixelShaderCache.clear();
-	m_textureCache.clear();
-	m_fontCache.clear();
-	m_audioTrackCache.clear();
-	m_audioStreamCache.clear();
+	return {
+	    &m_vertexShaderCache.stats, &m_pixelShaderCache.stats, &m_textureCache.stats,
+	    &m_fontCache.stats,         &m_audioTrackCache.stats,  &m_audioStreamCache.stats,
+	};
+}
+
+////////////////////////////////////////////////////////////
+
+AssetManifestRecorder::AssetManifestRecorder(AssetCache& assetCache, AssetManifest& manifest)
+    : m_assetCache(assetCache), m_manifest(manifest), m_previous(assetCache.m_manifestRecorder)
+{
+	m_assetCache.m_manifestRecorder = this;
+}
+
+AssetManifestRecorder::~AssetManifestRecorder() noexcept
+{
+	m_assetCache.m_manifestRecorder = m_previous;
+
+	std::unordered_set<std::string> recordedFiles(m_manifest.files.begin(), m_manifest.files.end());
+	for (auto& file : m_files.files()) {
+		if (auto filepath = file.generic_string(); recordedFiles.insert(filepath).second) {
+			m_manifest.files.push_back(std::move(filepath));
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+
+void serialize(BinaryWriter& write, const AssetHandle<Texture>& handle)
+{
+	auto* texture = g_engine->assetCache.get(handle);
+	write(texture ? std::string_view(texture->info.name) : std::string_view());
+}
+
+bool serialize(BinaryReader& read, AssetHandle<Texture>& handle)
+{
+	std::string_view identifier;
+	ANKER_TRY(read(identifier));
+
+	if (identifier.empty()) {
+		handle = {};
+		return true;
+	}
+
+	// Not pinned here, the restored scene still pins the textures it referenced
+	// when the snapshot was taken.
+	auto* texture = g_engine->assetCache.get(handle);
+	if (!texture || texture->info.name != identifier) {
+		handle = g_engine->assetCache.loadTexture(AssetId(identifier));
+	}
+
+	return true;
 }
 
 } // namespace Anker
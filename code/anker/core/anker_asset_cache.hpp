@@ -3,22 +3,53 @@
 #include <anker/audio/anker_audio_track.hpp>
 #include <anker/audio/anker_audio_stream.hpp>
 #include <anker/core/anker_asset.hpp>
+#include <anker/core/anker_asset_dependency_graph.hpp>
+#include <anker/core/anker_asset_id.hpp>
+#include <anker/core/anker_asset_manifest.hpp>
+#include <anker/core/anker_data_loader.hpp>
 #include <anker/graphics/anker_font.hpp>
 #include <anker/graphics/anker_render_device.hpp>
+#include <anker/graphics/anker_texture_atlas.hpp>
 
 namespace Anker {
 
+class AssetManifestRecorder;
 class FontSystem;
 
+// Bookkeeping of the AssetCache for one asset type.
+struct AssetCacheStats {
+	const char* name = "";
+
+	usize count = 0;
+	usize bytes = 0;
+
+	// Unpinned assets are evicted in least-recently-used order while the total
+	// size exceeds the budget.
+	usize budget = std::numeric_limits<usize>::max();
+
+	u64 hits = 0;
+	u64 misses = 0;
+	u64 evictions = 0;
+};
+
+// A region of a texture, in texture coordinates.
+struct TextureRegion {
+	AssetHandle<Texture> texture;
+	Rect2 rect = Rect2::fromPoints({0, 0}, {1, 1});
+};
+
 // The AssetCache is in charge of loading various different types of assets and
 // setting them up so they can be used directly. For example, loading a texture
 // will automatically create the necessary GPU resources.
 //
-// Loaded assets are cached by their identifier. A subsequent load request with
-// the same identifier returns a pointer to the previously loaded asset.
-// Pointers are reference counted.
+// Loaded assets are cached by their AssetId. A subsequent load request with the
+// same id returns a handle to the previously loaded asset. Assets
+// are stored in per-type pools owned by the cache; handles are resolved via
+// get and become stale once their asset is evicted.
 //
-// Functions with the Uncached suffix will always bypass the cache.
+// Assets that are not pinned are kept around, so they do not need to be loaded
+// again, e.g. when switching back and forth between maps. Memory is bounded by
+// per-type budgets; see AssetCacheStats.
 class AssetCache {
   public:
 	AssetCache(RenderDevice&, FontSystem&);
@@ -28,34 +59,99 @@ class AssetCache {
 	AssetCache(AssetCache&&) noexcept = delete;
 	AssetCache& operator=(AssetCache&&) noexcept = delete;
 
-	AssetPtr<VertexShader> loadVertexShader(std::string_view identifier, std::span<const D3D11_INPUT_ELEMENT_DESC>);
-	AssetPtr<VertexShader> loadVertexShaderUncached(std::string_view identifier,
-	                                                std::span<const D3D11_INPUT_ELEMENT_DESC>);
+	AssetHandle<VertexShader> loadVertexShader(AssetId, std::span<const VertexInput>);
+	AssetHandle<PixelShader> loadPixelShader(AssetId);
+	AssetHandle<Texture> loadTexture(AssetId);
+	AssetHandle<Font> loadFont(AssetId);
+	AssetHandle<AudioTrack> loadAudioTrack(AssetId);
+	AssetHandle<AudioStream> loadAudioStream(AssetId);
+
+	// Loads a texture for use by sprites. Small PNG / JPG textures are packed
+	// into shared atlas pages, so sprites with different textures can be drawn
+	// without switching textures. The returned rect refers to the atlas page.
+	// Other textures are loaded via loadTexture. Atlas pages are never evicted.
+	TextureRegion loadSpriteTexture(AssetId);
 
-	AssetPtr<PixelShader> loadPixelShader(std::string_view identifier);
-	AssetPtr<PixelShader> loadPixelShaderUncached(std::string_view identifier);
+	const TextureAtlas& spriteAtlas() const { return m_spriteAtlas.atlas; }
 
-	AssetPtr<Texture> loadTexture(std::string_view identifier);
-	AssetPtr<Texture> loadTextureUncached(std::string_view identifier);
+	////////////////////////////////////////////////////////////
+
+	// Returns nullptr for null and stale handles.
+	template <typename T>
+	T* get(AssetHandle<T> handle)
+	{
+		return cache<T>().pool.get(handle);
+	}
 
-	AssetPtr<Font> loadFont(std::string_view identifier);
-	AssetPtr<Font> loadFontUncached(std::string_view identifier);
+	template <typename T>
+	const T* get(AssetHandle<T> handle) const
+	{
+		return const_cast<AssetCache*>(this)->cache<T>().pool.get(handle);
+	}
 
-	AssetPtr<AudioTrack> loadAudioTrack(std::string_view identifier);
-	AssetPtr<AudioTrack> loadAudioTrackUncached(std::string_view identifier);
+	// Pins the asset for the lifetime of the given AssetPins.
+	template <typename T>
+	AssetHandle<T> pin(AssetPins& pins, AssetHandle<T> handle)
+	{
+		return pins.add(cache<T>().pool, handle);
+	}
 
-	AssetPtr<AudioStream> loadAudioStream(std::string_view identifier);
-	AssetPtr<AudioStream> loadAudioStreamUncached(std::string_view identifier);
+	// Like pin, but releases the pin of previous, see AssetPins::replace.
+	template <typename T>
+	AssetHandle<T> repin(AssetPins& pins, AssetHandle<T> previous, AssetHandle<T> handle)
+	{
+		return pins.replace(cache<T>().pool, previous, handle);
+	}
 
 	////////////////////////////////////////////////////////////
 
-	// Reload assets that have been modified according to the underlying
-	// DataLoader. Not all assets can be reloaded. This will update the asset
-	// pointed to by the respective AssetPtr.
+	// Reloads everything affected by the files modified according to the
+	// underlying DataLoader, in dependency order. Assets are reloaded in place,
+	// handles remain valid. Reloading an audio asset stops its playback.
 	void reloadModifiedAssets();
 
+	// Content derived from asset files outside of the cache, e.g. the tile
+	// layers built from a tileset, can be added to the dependency graph. When
+	// affected by a modification, the reload handler registered for the node's
+	// type is invoked, after the node's dependencies have been reloaded.
+	using ReloadHandler = std::function<void(AssetId)>;
+
+	template <typename T>
+	void setReloadHandler(ReloadHandler handler)
+	{
+		m_reloadHandlers[entt::type_hash<T>::value()] = std::move(handler);
+	}
+
+	AssetDependencyGraph& dependencyGraph() { return m_dependencyGraph; }
+
+	////////////////////////////////////////////////////////////
+
+	// Reads the manifest's files in the background and queues its assets for
+	// loading, see loadPrefetched. Assets that are already cached are skipped.
+	// Prefetched assets are not pinned, they are kept like any other unused
+	// asset until requested.
+	void prefetch(const AssetManifest&);
+
+	// Loads queued assets until the time budget is used up. Called every
+	// frame.
+	void loadPrefetched(Clock::duration budget);
+
+	usize prefetchQueueSize() const { return m_prefetchQueue.size(); }
+
+	// Evicts unpinned assets of every type exceeding its budget. This also
+	// happens automatically when loading an asset.
+	void evictOverBudget();
+
+	// Evicts all unpinned assets, regardless of budgets.
 	void clearUnused();
-	void clearAll();
+
+	template <typename T>
+	AssetCacheStats& stats()
+	{
+		return cache<T>().stats;
+	}
+
+	std::array<AssetCacheStats*, 6> allStats();
 
 	////////////////////////////////////////////////////////////
 
@@ -63,11 +159,81 @@ class AssetCache {
 	FontSystem& fontSystem() { return m_fontSystem; }
 
   private:
+	friend class AssetManifestRecorder;
+
 	RenderDevice& m_renderDevice;
 	FontSystem& m_fontSystem;
 
 	template <typename T>
-	using Cache = StringMap<AssetPtr<T>>;
+	struct CacheEntry {
+		AssetHandle<T> handle;
+		usize bytes = 0;
+		u64 lastUsed = 0;
+	};
+
+	template <typename T>
+	struct Cache {
+		std::unordered_map<AssetId, CacheEntry<T>> entries;
+		AssetPool<T> pool;
+		AssetCacheStats stats;
+	};
+
+	template <typename T>
+	Cache<T>& cache()
+	{
+		if constexpr (std::is_same_v<T, VertexShader>) {
+			return m_vertexShaderCache;
+		} else if constexpr (std::is_same_v<T, PixelShader>) {
+			return m_pixelShaderCache;
+		} else if constexpr (std::is_same_v<T, Texture>) {
+			return m_textureCache;
+		} else if constexpr (std::is_same_v<T, Font>) {
+			return m_fontCache;
+		} else if constexpr (std::is_same_v<T, AudioTrack>) {
+			return m_audioTrackCache;
+		} else if constexpr (std::is_same_v<T, AudioStream>) {
+			return m_audioStreamCache;
+		} else {
+			static_assert(AlwaysFalse<T>, "Unsupported asset type");
+		}
+	}
+
+	// Looks up the id, or creates a new asset in the pool, prepares it with the
+	// given function and loads it.
+	template <typename T, typename Init>
+	AssetHandle<T> loadCached(AssetId, Init&&);
+
+	// Loads the asset in place, records the files read in the dependency graph.
+	template <typename T>
+	void load(T&, AssetId);
+
+	template <typename T>
+	void reload(AssetId);
+
+	void loadAsset(VertexShader&, AssetId);
+	void loadAsset(PixelShader&, AssetId);
+	void loadAsset(Texture&, AssetId);
+	void loadAsset(Font&, AssetId);
+	void loadAsset(AudioTrack&, AssetId);
+	void loadAsset(AudioStream&, AssetId);
+
+	std::optional<TextureRegion> addToSpriteAtlas(AssetId);
+	void reloadSpriteTexture(AssetId);
+	AssetHandle<Texture> addSpriteAtlasPage();
+
+	// Adds the asset to all active AssetManifestRecorders.
+	template <typename T>
+	void recordManifest(AssetId, const CacheEntry<T>&);
+
+	// Updates the recorded size after an asset has been modified in place.
+	template <typename T>
+	void updateBytes(CacheEntry<T>&);
+
+	template <typename T>
+	void evictOverBudget(Cache<T>&);
+
+	template <typename T>
+	void erase(Cache<T>&, typename std::unordered_map<AssetId, CacheEntry<T>>::iterator);
 
 	Cache<VertexShader> m_vertexShaderCache;
 	Cache<PixelShader> m_pixelShaderCache;
@@ -75,6 +241,57 @@ class AssetCache {
 	Cache<Font> m_fontCache;
 	Cache<AudioTrack> m_audioTrackCache;
 	Cache<AudioStream> m_audioStreamCache;
+
+	struct SpriteAtlasEntry {
+		TextureRegion region;
+		Rect2u rect;
+	};
+
+	struct SpriteAtlas {
+		TextureAtlas atlas{Vec2u(2048)};
+		std::vector<AssetHandle<Texture>> pages;
+		std::unordered_map<AssetId, SpriteAtlasEntry> entries;
+	};
+
+	SpriteAtlas m_spriteAtlas;
+
+	// Incremented on every load request, used for LRU ordering.
+	u64 m_useCounter = 0;
+
+	AssetDependencyGraph m_dependencyGraph;
+	std::unordered_map<entt::id_type, ReloadHandler> m_reloadHandlers;
+
+	AssetManifestRecorder* m_manifestRecorder = nullptr;
+	std::deque<AssetManifestEntry> m_prefetchQueue;
 };
 
+// While alive, every asset requested from the AssetCache is added to the
+// manifest, cache hits included, together with all files read. This covers
+// files not loaded through the AssetCache, like a map's .tmj file. Recorders
+// nest, assets and files are recorded by all active recorders.
+class AssetManifestRecorder {
+  public:
+	AssetManifestRecorder(AssetCache&, AssetManifest&);
+	AssetManifestRecorder(const AssetManifestRecorder&) = delete;
+	AssetManifestRecorder& operator=(const AssetManifestRecorder&) = delete;
+	AssetManifestRecorder(AssetManifestRecorder&&) noexcept = delete;
+	AssetManifestRecorder& operator=(AssetManifestRecorder&&) noexcept = delete;
+	~AssetManifestRecorder() noexcept;
+
+  private:
+	friend class AssetCache;
+
+	AssetCache& m_assetCache;
+	AssetManifest& m_manifest;
+	AssetManifestRecorder* m_previous = nullptr;
+
+	std::unordered_set<AssetRef> m_recordedAssets;
+	DataLoadRecorder m_files;
+};
+
+// Textures are serialized by identifier. When reading, the texture is loaded
+// via the engine's AssetCache, unless the handle already refers to it.
+void serialize(BinaryWriter&, const AssetHandle<Texture>&);
+bool serialize(BinaryReader&, AssetHandle<Texture>&);
+
 } // namespace Anker
@@ -0,0 +1,154 @@
+#include <anker/core/anker_asset_dependency_graph.hpp>
+
+namespace Anker {
+
+void AssetDependencyGraph::set(const AssetRef& ref, std::span<const fs::path> files,
+                               std::span<const AssetRef> dependencies)
+{
+	auto& node = m_nodes[ref];
+	unlink(ref, node);
+
+	for (auto& file : files) {
+		auto& fileDependents = m_fileDependents[file];
+		if (std::ranges::find(fileDependents, ref) == fileDependents.end()) {
+			fileDependents.push_back(ref);
+			node.files.push_back(file);
+		}
+	}
+
+	for (auto& dependency : dependencies) {
+		if (dependency == ref || std::ranges::find(node.dependencies, dependency) != node.dependencies.end()) {
+			continue;
+		}
+		node.dependencies.push_back(dependency);
+		m_nodes[dependency].dependents.push_back(ref);
+	}
+}
+
+void AssetDependencyGraph::remove(const AssetRef& ref)
+{
+	auto it = m_nodes.find(ref);
+	if (it == m_nodes.end()) {
+		return;
+	}
+
+	unlink(ref, it->second);
+
+	if (it->second.dependents.empty() && it->second.owners.empty()) {
+		m_nodes.erase(it);
+	}
+}
+
+void AssetDependencyGraph::retain(const AssetRef& ref, const void* owner)
+{
+	auto& owners = m_nodes[ref].owners;
+	if (std::ranges::find(owners, owner) == owners.end()) {
+		owners.push_back(owner);
+	}
+}
+
+void AssetDependencyGraph::release(const AssetRef& ref, const void* owner)
+{
+	auto it = m_nodes.find(ref);
+	if (it == m_nodes.end() || std::erase(it->second.owners, owner) == 0) {
+		return;
+	}
+
+	if (it->second.owners.empty()) {
+		remove(ref);
+	}
+}
+
+std::span<const fs::path> AssetDependencyGraph::files(const AssetRef& ref) const
+{
+	if (auto it = m_nodes.find(ref); it != m_nodes.end()) {
+		return it->second.files;
+	}
+	return {};
+}
+
+void AssetDependencyGraph::unlink(const AssetRef& ref, Node& node)
+{
+	for (auto& file : node.files) {
+		if (auto it = m_fileDependents.find(file); it != m_fileDependents.end()) {
+			std::erase(it->second, ref);
+			if (it->second.empty()) {
+				m_fileDependents.erase(it);
+			}
+		}
+	}
+	node.files.clear();
+
+	for (auto& dependency : node.dependencies) {
+		if (auto it = m_nodes.find(dependency); it != m_nodes.end()) {
+			std::erase(it->second.dependents, ref);
+			auto& dependencyNode = it->second;
+			if (dependencyNode.dependents.empty() && dependencyNode.files.empty() && dependencyNode.dependencies.empty()
+			    && dependencyNode.owners.empty()) {
+				m_nodes.erase(it);
+			}
+		}
+	}
+	node.dependencies.clear();
+}
+
+std::vector<AssetRef> AssetDependencyGraph::affectedBy(const std::unordered_set<fs::path>& modifiedFiles) const
+{
+	ANKER_PROFILE_ZONE();
+
+	// Collect nodes derived from the modified files, followed by everything
+	// depending on them.
+	std::unordered_set<AssetRef> affected;
+	std::vector<AssetRef> pending;
+
+	for (auto& file : modifiedFiles) {
+		if (auto it = m_fileDependents.find(file); it != m_fileDependents.end()) {
+			for (auto& ref : it->second) {
+				if (affected.insert(ref).second) {
+					pending.push_back(ref);
+				}
+			}
+		}
+	}
+
+	while (!pending.empty()) {
+		auto ref = pending.back();
+		pending.pop_back();
+
+		if (auto it = m_nodes.find(ref); it != m_nodes.end()) {
+			for (auto& dependent : it->second.dependents) {
+				if (affected.insert(dependent).second) {
+					pending.push_back(dependent);
+				}
+			}
+		}
+	}
+
+	// Post-order traversal along dependencies yields dependencies first.
+	// Cycles are broken arbitrarily.
+	std::vector<AssetRef> order;
+	order.reserve(affected.size());
+
+	std::unordered_set<AssetRef> visited;
+	auto visit = [&](auto& visit, const AssetRef& ref) -> void {
+		if (!visited.insert(ref).second) {
+			return;
+		}
+		if (auto it = m_nodes.find(ref); it != m_nodes.end()) {
+			for (auto& dependency : it->second.dependencies) {
+				if (affected.contains(dependency)) {
+					visit(visit, dependency);
+				}
+			}
+		}
+		order.push_back(ref);
+	};
+
+	for (auto& ref : affected) {
+		visit(visit, ref);
+	}
+
+	return order;
+}
+
+} // namespace Anker
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <anker/core/anker_asset_id.hpp>
+
+namespace Anker {
+
+// Identifies a node of the AssetDependencyGraph by type and id. The type is
+// not limited to assets of the AssetCache; anything derived from asset files,
+// e.g. the tile layers built from a tileset, can be a node.
+struct AssetRef {
+	entt::id_type type = 0;
+	AssetId id;
+
+	template <typename T>
+	static AssetRef of(AssetId id)
+	{
+		return {entt::type_hash<T>::value(), id};
+	}
+
+	bool operator==(const AssetRef&) const = default;
+};
+
+} // namespace Anker
+
+template <>
+struct std::hash<Anker::AssetRef> {
+	std::size_t operator()(const Anker::AssetRef& ref) const noexcept
+	{
+		return std::hash<Anker::u64>()(Anker::u64(ref.type) << 32 | ref.id.hash());
+	}
+};
+
+namespace Anker {
+
+// Tracks which files each node has been derived from and which other nodes it
+// depends on. Used for hot-reloading: given a set of modified files, the graph
+// yields every affected node, such that dependencies come before their
+// dependents.
+class AssetDependencyGraph {
+  public:
+	AssetDependencyGraph() = default;
+	AssetDependencyGraph(const AssetDependencyGraph&) = delete;
+	AssetDependencyGraph& operator=(const AssetDependencyGraph&) = delete;
+	AssetDependencyGraph(AssetDependencyGraph&&) noexcept = delete;
+	AssetDependencyGraph& operator=(AssetDependencyGraph&&) noexcept = delete;
+
+	// Replaces the files and dependencies previously set for the node.
+	void set(const AssetRef&, std::span<const fs::path> files, std::span<const AssetRef> dependencies = {});
+
+	// Removes the node's files and dependencies. Nodes depending on it are
+	// kept, so they are still notified should the node be added again.
+	void remove(const AssetRef&);
+
+	// Nodes can be owned, e.g. by the scenes derived from them. An owned node
+	// is removed once its last owner releases it.
+	void retain(const AssetRef&, const void* owner);
+	void release(const AssetRef&, const void* owner);
+
+	// Nodes affected by the given files, directly or transitively, in
+	// dependency order.
+	std::vector<AssetRef> affectedBy(const std::unordered_set<fs::path>& modifiedFiles) const;
+
+	// Files the node has been derived from, empty for unknown nodes.
+	std::span<const fs::path> files(const AssetRef&) const;
+
+	usize size() const { return m_nodes.size(); }
+
+  private:
+	struct Node {
+		std::vector<fs::path> files;
+		std::vector<AssetRef> dependencies;
+		std::vector<AssetRef> dependents;
+		std::vector<const void*> owners;
+	};
+
+	void unlink(const AssetRef&, Node&);
+
+	std::unordered_map<AssetRef, Node> m_nodes;
+	std::unordered_map<fs::path, std::vector<AssetRef>> m_fileDependents;
+};
+
+} // namespace Anker
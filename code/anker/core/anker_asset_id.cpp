@@ -0,0 +1,63 @@
+#include <anker/core/anker_asset_id.hpp>
+
+namespace Anker {
+
+// Strings are never removed from the table, hence pointers to them remain
+// valid. Access is synchronized as assets may be loaded from worker threads.
+struct AssetIdTable {
+	std::mutex mutex;
+	std::unordered_map<entt::id_type, std::string> strings;
+	std::unordered_map<fs::path, AssetId> paths;
+};
+
+static AssetIdTable& assetIdTable()
+{
+	static AssetIdTable table;
+	return table;
+}
+
+AssetId::AssetId(std::string_view identifier)
+{
+	if (!identifier.empty()) {
+		m_hash = entt::hashed_string::value(identifier.data(), identifier.size());
+		m_string = intern(m_hash, identifier).c_str();
+	}
+}
+
+void AssetId::intern() const
+{
+	if (!empty()) {
+		std::ignore = intern(m_hash, str());
+	}
+}
+
+const std::string& AssetId::intern(entt::id_type hash, std::string_view identifier)
+{
+	auto& table = assetIdTable();
+	std::scoped_lock lock(table.mutex);
+
+	auto [it, inserted] = table.strings.try_emplace(hash, identifier);
+	if (!inserted && it->second != identifier) {
+		ANKER_ERROR("AssetId collision: {} and {} share hash {:08x}", it->second, identifier, hash);
+	}
+	return it->second;
+}
+
+AssetId toAssetId(const fs::path& filepath)
+{
+	auto& table = assetIdTable();
+	{
+		std::scoped_lock lock(table.mutex);
+		if (auto it = table.paths.find(filepath); it != table.paths.end()) {
+			return it->second;
+		}
+	}
+
+	AssetId id(toIdentifier(filepath));
+
+	std::scoped_lock lock(table.mutex);
+	table.paths.try_emplace(filepath, id);
+	return id;
+}
+
+} // namespace Anker
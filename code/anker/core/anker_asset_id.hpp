@@ -0,0 +1,64 @@
+#pragma once
+
+namespace Anker {
+
+// AssetId is an interned asset identifier. Comparison and lookup only use the
+// hash, the identifier string is stored once in a global table.
+//
+// AssetIds constructed from hashed_string literals (e.g. "textures/player"_hs)
+// are computed at compile-time and refer to the literal, they do not touch the
+// table. Other strings are interned on construction, which takes a lock; hence
+// these constructors are explicit and meant for registering identifiers, e.g.
+// when loading a scene, rather than for lookups.
+//
+// Interning detects hash collisions; colliding identifiers are reported and
+// must be renamed. Literals are interned when their asset is first loaded, see
+// intern.
+class AssetId {
+  public:
+	AssetId() = default;
+	explicit AssetId(std::string_view identifier);
+	explicit AssetId(const char* identifier) : AssetId(std::string_view(identifier)) {}
+	explicit AssetId(const std::string& identifier) : AssetId(std::string_view(identifier)) {}
+
+	// Only for literals, the string must outlive the AssetId.
+	constexpr AssetId(entt::hashed_string identifier)
+	    : m_hash(identifier.size() > 0 ? identifier.value() : 0),
+	      m_string(identifier.size() > 0 ? identifier.data() : nullptr)
+	{}
+
+	entt::id_type hash() const { return m_hash; }
+
+	std::string_view str() const { return m_string ? std::string_view(m_string) : std::string_view(); }
+
+	bool empty() const { return m_hash == 0; }
+
+	bool operator==(const AssetId& other) const { return m_hash == other.m_hash; }
+
+	std::string toString() const { return std::string(str()); }
+
+	// Adds the identifier to the table, reporting collisions. Called by the
+	// AssetCache when loading an asset for the first time.
+	void intern() const;
+
+  private:
+	static const std::string& intern(entt::id_type hash, std::string_view identifier);
+
+	entt::id_type m_hash = 0;
+
+	// Null-terminated, either a literal or owned by the table.
+	const char* m_string = nullptr;
+};
+
+// Memoized toIdentifier, used when mapping modified files to assets.
+AssetId toAssetId(const fs::path&);
+
+} // namespace Anker
+
+template <>
+struct std::hash<Anker::AssetId> {
+	std::size_t operator()(const Anker::AssetId& id) const noexcept { return id.hash(); }
+};
+
+template <>
+struct fmt::formatter<Anker::AssetId> : Anker::ToStringFmtFormatter {};
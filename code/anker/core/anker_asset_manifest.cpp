@@ -0,0 +1,56 @@
+#include <anker/core/anker_asset_manifest.hpp>
+
+#include <anker/common/anker_serialize_binary.hpp>
+#include <anker/core/anker_derived_data_cache.hpp>
+
+namespace Anker {
+
+// Increment when the manifest's content changes, e.g. when recording
+// additional assets.
+const u32 AssetManifestVersion = 1;
+
+static DerivedDataKey assetManifestKey(std::string_view name)
+{
+	return DerivedDataCache::key("manifest", AssetManifestVersion, asBytes(std::span(name)));
+}
+
+u64 AssetManifest::totalBytes() const
+{
+	u64 total = 0;
+	for (auto& asset : assets) {
+		total += asset.bytes;
+	}
+	return total;
+}
+
+Status loadAssetManifest(AssetManifest& manifest, std::string_view name)
+{
+	ANKER_PROFILE_ZONE();
+
+	MappedFile file;
+	ANKER_TRY(g_derivedDataCache.load(file, assetManifestKey(name)));
+
+	BinaryReader read(file.data());
+	if (!read.header<AssetManifest>() || !read(manifest)) {
+		ANKER_WARN("{}: Invalid asset manifest", name);
+		return FormatError;
+	}
+
+	return Ok;
+}
+
+void storeAssetManifest(const AssetManifest& manifest, std::string_view name)
+{
+	ANKER_PROFILE_ZONE();
+
+	if (AssetManifest stored; loadAssetManifest(stored, name) && stored == manifest) {
+		return;
+	}
+
+	BinaryWriter write;
+	write.header<AssetManifest>();
+	write(manifest);
+	g_derivedDataCache.store(assetManifestKey(name), write.output());
+}
+
+} // namespace Anker
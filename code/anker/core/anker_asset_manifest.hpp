@@ -0,0 +1,49 @@
+#pragma once
+
+namespace Anker {
+
+struct AssetManifestEntry {
+	// Name of the AssetCache's cache, e.g. "Texture".
+	std::string type;
+	std::string identifier;
+
+	// Size of the asset when resident in the AssetCache.
+	u64 bytes = 0;
+
+	bool operator==(const AssetManifestEntry&) const = default;
+};
+
+// An AssetManifest lists the assets, and the files they are loaded from,
+// required by something, usually a map. It is recorded while loading (see
+// AssetManifestRecorder) and used to prefetch everything ahead of time, see
+// AssetCache::prefetch.
+struct AssetManifest {
+	// Assets in the order they have been requested.
+	std::vector<AssetManifestEntry> assets;
+
+	// Files in the order they have been read, without duplicates.
+	std::vector<std::string> files;
+
+	u64 totalBytes() const;
+
+	bool operator==(const AssetManifest&) const = default;
+};
+
+// Manifests are stored in the DerivedDataCache under the given name. Loading
+// fails if the cache is disabled or the manifest has not been recorded yet.
+// Storing is skipped when the stored manifest is identical.
+Status loadAssetManifest(AssetManifest&, std::string_view name);
+void storeAssetManifest(const AssetManifest&, std::string_view name);
+
+} // namespace Anker
+
+REFL_TYPE(Anker::AssetManifestEntry)
+REFL_FIELD(type)
+REFL_FIELD(identifier)
+REFL_FIELD(bytes)
+REFL_END
+
+REFL_TYPE(Anker::AssetManifest)
+REFL_FIELD(assets)
+REFL_FIELD(files)
+REFL_END
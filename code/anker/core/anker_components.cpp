@@ -1,5 +1,6 @@
 #include <anker/core/anker_components.hpp>
 
+#include <anker/core/anker_asset_cache.hpp>
 #include <anker/core/anker_entity_name.hpp>
 #include <anker/core/anker_scene_node.hpp>
 #include <anker/editor/anker_editor_camera.hpp>
@@ -9,6 +10,7 @@
 #include <anker/game/anker_player_camera_follower.hpp>
 #include <anker/game/anker_player_controller.hpp>
 #include <anker/graphics/anker_camera.hpp>
+#include <anker/graphics/anker_particle_emitter.hpp>
 #include <anker/graphics/anker_sprite.hpp>
 #include <anker/graphics/anker_tile_layer.hpp>
 #include <anker/physics/anker_physics_body.hpp>
@@ -21,6 +23,70 @@ concept HasTickFn = requires(Scene & s)
 	{Component::tick(float(), s)};
 };
 
+// Components can take over snapshotting of all their instances, e.g. to
+// restore references between instances.
+template <typename Component>
+concept HasSnapshotFns = requires(BinaryWriter & write, BinaryReader & read, entt::registry & reg)
+{
+	{Component::writeSnapshot(write, std::as_const(reg))};
+	{Component::readSnapshot(read, reg)};
+};
+
+template <typename Component>
+void writeComponentSnapshot(BinaryWriter& write, const entt::registry& reg)
+{
+	const usize countOffset = write.size();
+	write(u32(0));
+
+	u32 count = 0;
+	auto view = reg.view<Component>();
+	for (auto entity : view) {
+		write(entity);
+		if constexpr (!std::is_empty_v<Component>) {
+			write(view.template get<Component>(entity));
+		}
+		count++;
+	}
+
+	write.patch(countOffset, count);
+}
+
+template <typename Component>
+bool readComponentSnapshot(BinaryReader& read, entt::registry& reg)
+{
+	u32 count = 0;
+	ANKER_TRY(read(count));
+
+	// Existing instances are updated in place.
+	entt::sparse_set restored;
+	for (u32 i = 0; i < count; ++i) {
+		EntityID entity = entt::null;
+		ANKER_TRY(read(entity));
+		ANKER_TRY(reg.valid(entity));
+
+		if constexpr (std::is_empty_v<Component>) {
+			if (!reg.all_of<Component>(entity)) {
+				reg.emplace<Component>(entity);
+			}
+		} else {
+			ANKER_TRY(read(reg.get_or_emplace<Component>(entity)));
+		}
+
+		restored.emplace(entity);
+	}
+
+	// Instances added since the snapshot was taken are removed.
+	std::vector<EntityID> added;
+	for (auto entity : reg.view<Component>()) {
+		if (!restored.contains(entity)) {
+			added.push_back(entity);
+		}
+	}
+	reg.remove<Component>(added.begin(), added.end());
+
+	return true;
+}
+
 template <typename Component>
 constexpr ComponentInfo registerComponent(const char* name, ComponentFlags flags = ComponentFlag::None)
 {
@@ -46,6 +112,14 @@ constexpr ComponentInfo registerComponent(const char* name, ComponentFlags flags
 		};
 	}
 
+	if constexpr (HasSnapshotFns<Component>) {
+		info.writeSnapshot = &Component::writeSnapshot;
+		info.readSnapshot = &Component::readSnapshot;
+	} else if constexpr (Serializable<BinaryWriter, Component> && Serializable<BinaryReader, Component>) {
+		info.writeSnapshot = &writeComponentSnapshot<Component>;
+		info.readSnapshot = &readComponentSnapshot<Component>;
+	}
+
 	return info;
 }
 
@@ -61,6 +135,7 @@ constexpr std::array Components = {
     registerComponent<PlayerCameraFollower>("PlayerCameraFollower"),
     registerComponent<Follower>("Follower"),
     registerComponent<TileLayer>("TileLayer"),
+    registerComponent<ParticleEmitter>("ParticleEmitter"),
     registerComponent<EditorCamera>("EditorCamera"),
 };
 
@@ -22,6 +22,12 @@ struct ComponentInfo {
 	void (*removeFrom)(EntityHandle);
 	bool (*isPresentIn)(EntityCHandle);
 	void (*drawInspectorWidget)(InspectorWidgetDrawer&, EntityHandle);
+
+	// Writes / restores all instances of the component, used by scene
+	// snapshots. Not set for components that do not support binary
+	// serialization.
+	void (*writeSnapshot)(BinaryWriter&, const entt::registry&);
+	bool (*readSnapshot)(BinaryReader&, entt::registry&);
 };
 
 std::span<const ComponentInfo> components();
@@ -2,14 +2,25 @@
 
 namespace Anker {
 
+static thread_local DataLoadRecorder* t_dataLoadRecorder = nullptr;
+
 Status DataLoader::load(ByteBuffer& outBuffer, const fs::path& filepath) const
 {
+	// Missing files are recorded as well, they may be added later on.
+	for (auto* recorder = t_dataLoadRecorder; recorder; recorder = recorder->m_previous) {
+		recorder->add(filepath);
+	}
+
 	for (auto& source : m_sources) {
 		if (source->exists(filepath)) {
 			return source->load(outBuffer, filepath);
 		}
 	}
 	ANKER_ERROR("{}: Missing!", filepath);
+
+	for (auto& source : m_sources) {
+		source->watchMissing(filepath);
+	}
 	return ReadError;
 }
 
@@ -23,6 +34,16 @@ bool DataLoader::exists(const fs::path& filepath) const
 	return false;
 }
 
+void DataLoader::prefetch(const fs::path& filepath)
+{
+	for (auto& source : m_sources) {
+		if (source->exists(filepath)) {
+			source->prefetch(filepath);
+			return;
+		}
+	}
+}
+
 void DataLoader::addSource(IDataLoaderSource* source)
 {
 	ANKER_CHECK(source);
@@ -41,19 +62,26 @@ void DataLoader::clearSources()
 
 void DataLoader::tick()
 {
-	using namespace std::chrono_literals;
+	ANKER_PROFILE_ZONE();
 
 	m_modifiedFiles.clear();
 
-	// Query for modifications, but only every second, not every frame.
-	if (auto now = Clock::now(); now - m_lastModifiedFilesCheck > 1s) {
-		m_lastModifiedFilesCheck = now;
-
-		auto inserter = std::inserter(m_modifiedFiles, m_modifiedFiles.end());
-		for (auto& source : m_sources) {
-			source->modifiedFiles(inserter);
-		}
+	auto inserter = std::inserter(m_modifiedFiles, m_modifiedFiles.end());
+	for (auto& source : m_sources) {
+		source->modifiedFiles(inserter);
 	}
 }
 
+////////////////////////////////////////////////////////////
+
+DataLoadRecorder::DataLoadRecorder() : m_previous(t_dataLoadRecorder)
+{
+	t_dataLoadRecorder = this;
+}
+
+DataLoadRecorder::~DataLoadRecorder() noexcept
+{
+	t_dataLoadRecorder = m_previous;
+}
+
 } // namespace Anker
@@ -9,9 +9,19 @@ class IDataLoaderSource {
 
 	// Inserts the file paths of files that have been modified since the
 	// previous call to modifiedFiles. Implementation is optional. This is
-	// primarily used to enable hot-reloading for certain assets.
+	// primarily used to enable hot-reloading for certain assets. Called every
+	// frame, hence implementations should be cheap when nothing changed.
 	virtual void modifiedFiles(std::insert_iterator<std::unordered_set<fs::path>>) {}
 
+	// Hints that the file is going to be loaded soon. Implementations may read
+	// it ahead of time in the background. Implementation is optional.
+	virtual void prefetch(const fs::path&) {}
+
+	// Called when a file could not be loaded from any source. Implementations
+	// may report it via modifiedFiles once it has been added. Implementation
+	// is optional.
+	virtual void watchMissing(const fs::path&) const {}
+
 	~IDataLoaderSource() noexcept {}
 };
 
@@ -34,6 +44,10 @@ class DataLoader {
 	Status load(ByteBuffer& outBuffer, const fs::path&) const;
 	bool exists(const fs::path&) const;
 
+	// Forwards the hint to the source containing the file, see
+	// IDataLoaderSource::prefetch.
+	void prefetch(const fs::path&);
+
 	void addSource(IDataLoaderSource*);
 	void removeSource(IDataLoaderSource*);
 	void clearSources();
@@ -48,11 +62,34 @@ class DataLoader {
 	std::vector<IDataLoaderSource*> m_sources;
 
 	std::unordered_set<fs::path> m_modifiedFiles;
-
-	Clock::time_point m_lastModifiedFilesCheck{};
 };
 
 // Global loader for loading asset data.
 inline DataLoader g_assetDataLoader;
 
+// While alive, records the filepaths of all files loaded via any DataLoader on
+// the current thread. Used to track which files an asset has been derived
+// from. Recorders nest, files are recorded by all active recorders.
+class DataLoadRecorder {
+  public:
+	DataLoadRecorder();
+	DataLoadRecorder(const DataLoadRecorder&) = delete;
+	DataLoadRecorder& operator=(const DataLoadRecorder&) = delete;
+	DataLoadRecorder(DataLoadRecorder&&) noexcept = delete;
+	DataLoadRecorder& operator=(DataLoadRecorder&&) noexcept = delete;
+	~DataLoadRecorder() noexcept;
+
+	// Paths are normalized, matching DataLoader::modifiedFiles.
+	const std::vector<fs::path>& files() const { return m_files; }
+
+	// Records a file that has been loaded earlier, e.g. by a cached asset.
+	void add(const fs::path& filepath) { m_files.push_back(filepath.lexically_normal()); }
+
+  private:
+	friend class DataLoader;
+
+	std::vector<fs::path> m_files;
+	DataLoadRecorder* m_previous = nullptr;
+};
+
 } // namespace Anker
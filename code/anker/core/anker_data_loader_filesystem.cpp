@@ -1,8 +1,10 @@
 #include <anker/core/anker_data_loader_filesystem.hpp>
 
+#include <anker/common/anker_mapped_file.hpp>
+
 namespace Anker {
 
-DataLoaderFilesystem::DataLoaderFilesystem(const fs::path& root) : m_root(root)
+DataLoaderFilesystem::DataLoaderFilesystem(const fs::path& root) : m_root(root), m_watcher(root)
 {
 	if (!fs::exists(root)) {
 		ANKER_WARN("Source does not exist: {}", root);
@@ -10,6 +12,18 @@ DataLoaderFilesystem::DataLoaderFilesystem(const fs::path& root) : m_root(root)
 	}
 }
 
+DataLoaderFilesystem::~DataLoaderFilesystem() noexcept
+{
+	if (m_prefetchThread.joinable()) {
+		{
+			std::scoped_lock lock(m_prefetchMutex);
+			m_prefetchStop = true;
+		}
+		m_prefetchCondition.notify_one();
+		m_prefetchThread.join();
+	}
+}
+
 Status DataLoaderFilesystem::load(ByteBuffer& buffer, const fs::path& filepath) const
 {
 	ANKER_TRY(readFile(buffer, m_root / filepath));
@@ -18,8 +32,9 @@ Status DataLoaderFilesystem::load(ByteBuffer& buffer, const fs::path& filepath)
 	std::error_code lastWriteTimeError;
 	auto lastWrite = fs::last_write_time(m_root / filepath, lastWriteTimeError);
 	if (!lastWriteTimeError) {
-		m_lastWriteTimestamps[filepath] = lastWrite;
+		m_lastWriteTimestamps[filepath.lexically_normal()] = lastWrite;
 	}
+	m_missingFiles.erase(filepath.lexically_normal());
 
 	return Ok;
 }
@@ -30,6 +45,37 @@ bool DataLoaderFilesystem::exists(const fs::path& filepath) const
 }
 
 void DataLoaderFilesystem::modifiedFiles(std::insert_iterator<std::unordered_set<fs::path>> inserter)
+{
+	if (!m_watcher.active()) {
+		// Without notifications, query for modifications only every second,
+		// not every frame.
+		using namespace std::chrono_literals;
+		if (auto now = Clock::now(); now - m_lastTimestampCheck > 1s) {
+			m_lastTimestampCheck = now;
+			modifiedFilesByTimestamp(inserter);
+		}
+		return;
+	}
+
+	if (m_watcher.consumeOverflow()) {
+		while (m_watcher.pop()) {
+		}
+		modifiedFilesByTimestamp(inserter);
+		return;
+	}
+
+	while (auto filepath = m_watcher.pop()) {
+		// Only files that have been loaded, or failed to load, are of interest.
+		if (auto it = m_lastWriteTimestamps.find(*filepath); it != m_lastWriteTimestamps.end()) {
+			inserter = it->first;
+		} else if (auto missing = m_missingFiles.find(*filepath); missing != m_missingFiles.end()) {
+			inserter = *missing;
+			m_missingFiles.erase(missing);
+		}
+	}
+}
+
+void DataLoaderFilesystem::modifiedFilesByTimestamp(std::insert_iterator<std::unordered_set<fs::path>> inserter)
 {
 	for (const auto& [filepath, timestamp] : m_lastWriteTimestamps) {
 		std::error_code err;
@@ -37,6 +83,63 @@ void DataLoaderFilesystem::modifiedFiles(std::insert_iterator<std::unordered_set
 			inserter = filepath;
 		}
 	}
+
+	std::erase_if(m_missingFiles, [&](const fs::path& filepath) {
+		if (fs::exists(m_root / filepath)) {
+			inserter = filepath;
+			return true;
+		}
+		return false;
+	});
+}
+
+void DataLoaderFilesystem::watchMissing(const fs::path& filepath) const
+{
+	m_missingFiles.insert(filepath.lexically_normal());
+}
+
+void DataLoaderFilesystem::prefetch(const fs::path& filepath)
+{
+	{
+		std::scoped_lock lock(m_prefetchMutex);
+		if (!m_prefetchThread.joinable()) {
+			m_prefetchThread = std::thread([this] { runPrefetch(); });
+		}
+		m_prefetchQueue.push_back(filepath);
+	}
+	m_prefetchCondition.notify_one();
+}
+
+void DataLoaderFilesystem::runPrefetch()
+{
+	// Pages are at least this large on all supported platforms.
+	const usize PageSize = 4096;
+
+	while (true) {
+		fs::path filepath;
+		{
+			std::unique_lock lock(m_prefetchMutex);
+			m_prefetchCondition.wait(lock, [&] { return m_prefetchStop || !m_prefetchQueue.empty(); });
+			if (m_prefetchStop) {
+				return;
+			}
+			filepath = std::move(m_prefetchQueue.front());
+			m_prefetchQueue.pop_front();
+		}
+
+		ANKER_PROFILE_ZONE();
+
+		// Touching every page of the mapping pulls the file into the page
+		// cache without copying it.
+		MappedFile file;
+		if (file.open(m_root / filepath)) {
+			auto data = file.data();
+			[[maybe_unused]] volatile u8 sink = 0;
+			for (usize offset = 0; offset < data.size(); offset += PageSize) {
+				sink = data[offset];
+			}
+		}
+	}
 }
 
 } // namespace Anker
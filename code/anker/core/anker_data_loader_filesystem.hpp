@@ -1,12 +1,14 @@
 #pragma once
 
 #include <anker/core/anker_data_loader.hpp>
+#include <anker/platform/anker_file_watcher.hpp>
 
 namespace Anker {
 
 class DataLoaderFilesystem : public IDataLoaderSource {
   public:
 	explicit DataLoaderFilesystem(const fs::path& root);
+	~DataLoaderFilesystem() noexcept;
 
 	DataLoaderFilesystem(const DataLoaderFilesystem&) = delete;
 	DataLoaderFilesystem& operator=(const DataLoaderFilesystem&) = delete;
@@ -17,12 +19,38 @@ class DataLoaderFilesystem : public IDataLoaderSource {
 	bool exists(const fs::path&) const override;
 	void modifiedFiles(std::insert_iterator<std::unordered_set<fs::path>>) override;
 
+	// Files are read into the operating system's page cache by a background
+	// thread, which is started on first use.
+	void prefetch(const fs::path&) override;
+
+	void watchMissing(const fs::path&) const override;
+
   private:
+	void modifiedFilesByTimestamp(std::insert_iterator<std::unordered_set<fs::path>>);
+
+	void runPrefetch();
+
 	fs::path m_root;
 
+	// Modifications are reported by the watcher. Only if it is unavailable, or
+	// notifications got lost, timestamps are compared instead.
+	FileWatcher m_watcher;
+
 	// We record the modification timestamps of loaded files the check for
-	// changes.
+	// changes. Keys are normalized so they match the paths reported by the
+	// watcher.
 	mutable std::unordered_map<fs::path, fs::file_time_type> m_lastWriteTimestamps;
+
+	// Files that failed to load, reported once they have been added.
+	mutable std::unordered_set<fs::path> m_missingFiles;
+
+	Clock::time_point m_lastTimestampCheck{};
+
+	std::mutex m_prefetchMutex;
+	std::condition_variable m_prefetchCondition;
+	std::deque<fs::path> m_prefetchQueue;
+	bool m_prefetchStop = false;
+	std::thread m_prefetchThread;
 };
 
 } // namespace Anker
@@ -0,0 +1,76 @@
+#include <anker/core/anker_derived_data_cache.hpp>
+
+namespace Anker {
+
+DerivedDataKey DerivedDataCache::key(std::string_view kind, u32 version, std::span<const u8> source, u64 parameters)
+{
+	ANKER_PROFILE_ZONE();
+
+	u64 seed = hashBytes(asBytes(std::span(kind)), (u64(version) << 32) ^ parameters);
+	return {.kind = kind, .hash = hashBytes(source, seed)};
+}
+
+Status DerivedDataCache::load(MappedFile& file, const DerivedDataKey& key) const
+{
+	ANKER_PROFILE_ZONE();
+
+	if (!enabled || m_directory.empty()) {
+		return ReadError;
+	}
+
+	return file.open(filepath(key));
+}
+
+Status DerivedDataCache::open(std::ifstream& file, const DerivedDataKey& key) const
+{
+	if (!enabled || m_directory.empty()) {
+		return ReadError;
+	}
+
+	file.open(filepath(key), std::ios::binary);
+	return file ? Ok : ReadError;
+}
+
+void DerivedDataCache::store(const DerivedDataKey& key, std::span<const u8> data) const
+{
+	ANKER_PROFILE_ZONE();
+
+	if (!enabled || m_directory.empty()) {
+		return;
+	}
+
+	// Write to a temporary file first, so other processes never observe a
+	// partially written entry.
+	auto target = filepath(key);
+	auto temporary = fs::path(target).concat(".tmp");
+	if (!writeFile(data, temporary)) {
+		return;
+	}
+
+	std::error_code err;
+	fs::rename(temporary, target, err);
+	if (err) {
+		ANKER_WARN("{}: Failed to store derived data: {}", target, err.message());
+		fs::remove(temporary, err);
+	}
+}
+
+void DerivedDataCache::setDirectory(const fs::path& directory)
+{
+	std::error_code err;
+	fs::create_directories(directory, err);
+	if (err) {
+		ANKER_WARN("{}: Derived data cache unavailable: {}", directory, err.message());
+		m_directory.clear();
+		return;
+	}
+
+	m_directory = directory;
+}
+
+fs::path DerivedDataCache::filepath(const DerivedDataKey& key) const
+{
+	return m_directory / fmt::format("{}-{:016x}.bin", key.kind, key.hash);
+}
+
+} // namespace Anker
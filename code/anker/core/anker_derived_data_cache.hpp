@@ -0,0 +1,58 @@
+#pragma once
+
+#include <anker/common/anker_mapped_file.hpp>
+
+namespace Anker {
+
+// Identifies derived data by the kind of data, the decoder version, and the
+// content of the source the data was derived from. Parameters affecting the
+// decoder's output (e.g. a target size or format) are part of the key as well.
+struct DerivedDataKey {
+	std::string_view kind;
+	u64 hash = 0;
+};
+
+// The DerivedDataCache persists the output of expensive decoders on disk, for
+// example decoded images or packed font atlases. Since entries are keyed by
+// the content of their source, modified sources simply result in a cache miss;
+// no invalidation is required.
+//
+// Entries are memory mapped when loaded, so decoders can hand their data to
+// the GPU without an intermediate copy.
+//
+// Entries are never evicted. Deleting the directory is always safe.
+class DerivedDataCache {
+  public:
+	DerivedDataCache() = default;
+	DerivedDataCache(const DerivedDataCache&) = delete;
+	DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+	DerivedDataCache(DerivedDataCache&&) noexcept = delete;
+	DerivedDataCache& operator=(DerivedDataCache&&) noexcept = delete;
+
+	// The version must be incremented whenever the decoder's output changes.
+	static DerivedDataKey key(std::string_view kind, u32 version, std::span<const u8> source, u64 parameters = 0);
+
+	// Loading fails if the cache is disabled or no entry exists.
+	Status load(MappedFile&, const DerivedDataKey&) const;
+
+	// Opens an entry for reading parts of it, used for entries streamed
+	// rather than mapped as a whole.
+	Status open(std::ifstream&, const DerivedDataKey&) const;
+
+	void store(const DerivedDataKey&, std::span<const u8> data) const;
+
+	// The cache is disabled until a directory is set.
+	void setDirectory(const fs::path&);
+
+	bool enabled = true;
+
+  private:
+	fs::path filepath(const DerivedDataKey&) const;
+
+	fs::path m_directory;
+};
+
+// Global cache for derived asset data.
+inline DerivedDataCache g_derivedDataCache;
+
+} // namespace Anker
@@ -11,8 +11,10 @@ Engine::Engine()
       fontSystem(renderDevice),
       imguiSystem(renderDevice),
       assetCache(renderDevice, fontSystem),
+      audioSystem(assetCache),
       renderSystem(renderDevice, assetCache),
-      physicsSystem(renderSystem.gizmoRenderer)
+      physicsSystem(renderSystem.gizmoRenderer),
+      renderThread(renderDevice, renderSystem, imguiSystem)
 {
 	ANKER_INFO("Anker Initialized!");
 }
@@ -30,13 +32,19 @@ void Engine::tick()
 		return;
 	}
 
-	float dt = calculateDeltaTime();
+	float dt = fixedDeltaTime ? *fixedDeltaTime : calculateDeltaTime();
 
 	inputSystem.tick(dt);
 
+	g_assetDataLoader.tick();
+	audioSystem.tick();
 	assetCache.reloadModifiedAssets();
 
+	// Prefetched assets are loaded across multiple frames to avoid hitches.
+	assetCache.loadPrefetched(std::chrono::milliseconds(2));
+
 	imguiSystem.newFrame();
+	fontSystem.newFrame();
 
 	if (editor) {
 		editor->tick(dt, *activeScene);
@@ -55,16 +63,20 @@ void Engine::tick()
 
 	physicsSystem.tick(dt, *activeScene);
 
-	renderSystem.draw(*activeScene);
-	imguiSystem.draw();
-	renderDevice.present();
+	// The previous frame may still be drawn, extraction only touches the other
+	// packet.
+	auto& packet = renderThread.packet();
+	renderSystem.extract(*activeScene, packet);
+	imguiSystem.extract(packet.imgui);
+	renderThread.submit();
 }
 
 ScenePtr Engine::createScene()
 {
-	auto scene = std::make_unique<Scene>();
+	auto scene = std::make_shared<Scene>();
 
 	registerSceneNodeCallbacks(scene->registry);
+	registerSpatialIndexCallbacks(*scene);
 
 	physicsSystem.addPhysicsWorld(*scene);
 
@@ -73,12 +85,27 @@ ScenePtr Engine::createScene()
 	camera.emplace<Camera>();
 	scene->setActiveCamera(camera);
 
+	std::erase_if(m_scenes, [](auto& weakScene) { return weakScene.expired(); });
+	m_scenes.push_back(scene);
+
 	return scene;
 }
 
+std::vector<ScenePtr> Engine::scenes()
+{
+	std::vector<ScenePtr> result;
+	for (auto& weakScene : m_scenes) {
+		if (auto scene = weakScene.lock()) {
+			result.push_back(std::move(scene));
+		}
+	}
+	return result;
+}
+
 void Engine::onResize(Vec2i size)
 {
 	ANKER_INFO("onResize size={}", size);
+	renderThread.wait();
 	renderDevice.onResize(size);
 	renderSystem.onResize(size);
 }
@@ -99,6 +126,9 @@ void Engine::switchScene()
 	activeScene = nextScene;
 	nextScene.reset();
 
+	// Assets only used by the previous scene are no longer pinned.
+	assetCache.evictOverBudget();
+
 	if (activeScene) {
 		audioSystem.playMusic(activeScene->backgroundMusic);
 	}
@@ -10,6 +10,7 @@
 #include <anker/graphics/anker_font_system.hpp>
 #include <anker/graphics/anker_render_device.hpp>
 #include <anker/graphics/anker_render_system.hpp>
+#include <anker/graphics/anker_render_thread.hpp>
 #include <anker/physics/anker_physics_system.hpp>
 
 namespace Anker {
@@ -36,24 +37,35 @@ class Engine {
 
 	ScenePtr createScene();
 
+	// All scenes created by createScene that are still alive, including the
+	// active and next scene.
+	std::vector<ScenePtr> scenes();
+
 	void onResize(Vec2i size);
 
 	RenderDevice renderDevice;
 	FontSystem fontSystem;
 	ImguiSystem imguiSystem;
 	InputSystem inputSystem;
-	AudioSystem audioSystem;
 
 	AssetCache assetCache;
+	AudioSystem audioSystem;
 	RenderSystem renderSystem;
 
 	PhysicsSystem physicsSystem;
 
+	// Draws the previous frame while the current one is simulated.
+	RenderThread renderThread;
+
 	ScenePtr activeScene;
 	ScenePtr nextScene;
 
 	std::optional<EditorFramework> editor;
 
+	// When set, this delta-time is used for every tick instead of the measured
+	// frame time. Used for deterministic simulation, e.g. in benchmarks.
+	std::optional<float> fixedDeltaTime;
+
 	using Clock = std::chrono::steady_clock;
 
   private:
@@ -62,6 +74,8 @@ class Engine {
 	void switchScene();
 
 	Clock::time_point m_frameTimestamp = Clock::now();
+
+	std::vector<std::weak_ptr<Scene>> m_scenes;
 };
 
 inline std::optional<Engine> g_engine;
@@ -31,10 +31,37 @@ void ImguiSystem::newFrame()
 	ImGui::DockSpaceOverViewport(ImGui::GetMainViewport(), ImGuiDockNodeFlags_PassthruCentralNode);
 }
 
-void ImguiSystem::draw()
+void ImguiSystem::extract(ImguiSnapshot& snapshot)
 {
 	ImGui::Render();
-	m_renderDevice.imguiImplRender();
+	snapshot.capture(*ImGui::GetDrawData());
+}
+
+void ImguiSystem::draw(ImguiSnapshot& snapshot)
+{
+	if (auto* drawData = snapshot.drawData()) {
+		m_renderDevice.imguiImplRender(drawData);
+	}
+}
+
+////////////////////////////////////////////////////////////
+
+void ImguiSnapshot::capture(const ImDrawData& drawData)
+{
+	clear();
+
+	m_drawData = drawData;
+	for (auto& cmdList : m_drawData.CmdLists) {
+		cmdList = cmdList->CloneOutput();
+	}
+}
+
+void ImguiSnapshot::clear()
+{
+	for (auto* cmdList : m_drawData.CmdLists) {
+		IM_DELETE(cmdList);
+	}
+	m_drawData.Clear();
 }
 
 } // namespace Anker
@@ -4,6 +4,29 @@ namespace Anker {
 
 class RenderDevice;
 
+// Deep copy of ImGui's draw data, which is only valid until the next ImGui
+// frame begins. Allows for rendering a frame while the next one is built.
+class ImguiSnapshot {
+  public:
+	ImguiSnapshot() = default;
+	ImguiSnapshot(const ImguiSnapshot&) = delete;
+	ImguiSnapshot& operator=(const ImguiSnapshot&) = delete;
+	ImguiSnapshot(ImguiSnapshot&&) noexcept = delete;
+	ImguiSnapshot& operator=(ImguiSnapshot&&) noexcept = delete;
+	~ImguiSnapshot() noexcept { clear(); }
+
+	// Must be called on the thread building ImGui frames, as ImGui's
+	// allocations are tracked by its context.
+	void capture(const ImDrawData&);
+	void clear();
+
+	// Returns nullptr if nothing has been captured.
+	ImDrawData* drawData() { return m_drawData.Valid ? &m_drawData : nullptr; }
+
+  private:
+	ImDrawData m_drawData;
+};
+
 class ImguiSystem {
   public:
 	ImguiSystem(RenderDevice&);
@@ -15,7 +38,10 @@ class ImguiSystem {
 
 	void newFrame();
 
-	void draw();
+	// Ends the ImGui frame, capturing its draw data.
+	void extract(ImguiSnapshot&);
+
+	void draw(ImguiSnapshot&);
 
 private:
 	RenderDevice& m_renderDevice;
@@ -2,6 +2,7 @@
 
 #include <anker/audio/anker_audio_stream.hpp>
 #include <anker/core/anker_asset.hpp>
+#include <anker/core/anker_spatial_index.hpp>
 #include <anker/physics/anker_physics_system.hpp>
 
 namespace Anker {
@@ -25,10 +26,16 @@ class Scene {
 	EntityCHandle activeCamera() const;
 	void setActiveCamera(EntityID);
 
-	AssetPtr<AudioStream> backgroundMusic;
+	AssetHandle<AudioStream> backgroundMusic;
+
+	// Keeps the assets used by this scene loaded, see AssetCache.
+	AssetPins assetPins;
 
 	std::optional<PhysicsWorld> physicsWorld;
 
+	// Bounds of renderables, kept in sync by the RenderSystem.
+	SpatialIndex spatialIndex;
+
 	entt::registry registry;
 };
 
@@ -22,7 +22,11 @@ SceneNode::~SceneNode()
 		child->setParent(m_parent);
 	}
 
-	clearParent();
+	// Not using clearParent, the entity must not be marked as moved while it
+	// is being destroyed.
+	if (m_parent) {
+		std::erase(m_parent->m_children, this);
+	}
 }
 
 void SceneNode::setParent(SceneNode* newParent)
@@ -94,11 +98,105 @@ bool SceneNode::validateParentChildLink() const
 	return true;
 }
 
+void SceneNode::writeSnapshot(BinaryWriter& write, const entt::registry& reg)
+{
+	const usize countOffset = write.size();
+	write(u32(0));
+
+	u32 count = 0;
+	for (auto [entity, node] : reg.view<SceneNode>().each()) {
+		write(entity);
+		write(node.m_localTransform);
+
+		// Children are stored instead of the parent to retain their order.
+		write(u32(node.m_children.size()));
+		for (auto* child : node.m_children) {
+			write(child->m_entity.entity());
+		}
+
+		count++;
+	}
+
+	write.patch(countOffset, count);
+}
+
+bool SceneNode::readSnapshot(BinaryReader& read, entt::registry& reg)
+{
+	u32 count = 0;
+	ANKER_TRY(read(count));
+
+	std::vector<std::pair<SceneNode*, u32>> nodes;
+	nodes.reserve(count);
+	std::vector<EntityID> children;
+
+	entt::sparse_set restored;
+	for (u32 i = 0; i < count; ++i) {
+		EntityID entity = entt::null;
+		ANKER_TRY(read(entity));
+		ANKER_TRY(reg.valid(entity));
+
+		auto& node = reg.get_or_emplace<SceneNode>(entity);
+		ANKER_TRY(read(node.m_localTransform));
+
+		u32 childCount = 0;
+		ANKER_TRY(read(childCount));
+		ANKER_TRY(childCount < count);
+		for (u32 j = 0; j < childCount; ++j) {
+			ANKER_TRY(read(children.emplace_back()));
+		}
+
+		nodes.emplace_back(&node, childCount);
+		restored.emplace(entity);
+	}
+
+	// Nodes added since the snapshot was taken are removed.
+	std::vector<EntityID> added;
+	for (auto entity : reg.view<SceneNode>()) {
+		if (!restored.contains(entity)) {
+			added.push_back(entity);
+		}
+	}
+	reg.remove<SceneNode>(added.begin(), added.end());
+
+	// Links are rebuilt from scratch, bypassing setParent as all nodes are
+	// touched anyway.
+	for (auto [node, childCount] : nodes) {
+		node->m_parent = nullptr;
+		node->m_children.clear();
+		node->m_cachedParentTransform.reset();
+	}
+
+	auto child = children.begin();
+	for (auto [node, childCount] : nodes) {
+		for (u32 i = 0; i < childCount; ++i, ++child) {
+			auto* childNode = reg.try_get<SceneNode>(*child);
+			ANKER_TRY(childNode && !childNode->m_parent);
+			childNode->m_parent = node;
+			node->m_children.push_back(childNode);
+		}
+	}
+
+	for (auto entity : restored) {
+		reg.emplace_or_replace<TransformChangedTag>(entity);
+	}
+
+#if ANKER_CHECK_SCENE_NODE_INVARIANT_ENABLED
+	for (auto [node, childCount] : nodes) {
+		if (!node->validateParentChildLink()) {
+			ANKER_ERROR("Broken SceneNode invariant on {}", node->name());
+		}
+	}
+#endif
+
+	return true;
+}
+
 // Links an entity with its corresponding SceneNode. This function is used
 // automatically by the registry using the provide callback mechanism.
 void linkSceneNodeWithEntity(entt::registry& reg, entt::entity entity)
 {
 	reg.get<SceneNode>(entity).m_entity = {reg, entity};
+	reg.emplace_or_replace<TransformChangedTag>(entity);
 }
 
 void registerSceneNodeCallbacks(entt::registry& reg)
@@ -6,6 +6,11 @@
 
 namespace Anker {
 
+// Added to the entity of a SceneNode whose global transform changed, including
+// changes caused by a parent. Cleared by the RenderSystem once per frame, after
+// updating the SpatialIndex.
+struct TransformChangedTag {};
+
 // SceneNode represents a node in the scene graph. Apart from a local Transform,
 // it contains a parent pointer and pointer to its children.
 //
@@ -33,6 +38,7 @@ class SceneNode {
 	{
 		invalidateCachedParentTransformInChildren();
 		m_localTransform = transform;
+		markTransformChanged();
 	}
 
 	Transform2D parentTransform() const
@@ -68,10 +74,16 @@ class SceneNode {
 
 	bool validateParentChildLink() const;
 
+	// Used by scene snapshots. Local transforms and parent-child links of all
+	// nodes are restored.
+	static void writeSnapshot(BinaryWriter&, const entt::registry&);
+	static bool readSnapshot(BinaryReader&, entt::registry&);
+
   private:
 	void invalidateCachedParentTransform()
 	{
 		m_cachedParentTransform.reset();
+		markTransformChanged();
 		invalidateCachedParentTransformInChildren();
 	}
 
@@ -82,6 +94,14 @@ class SceneNode {
 		}
 	}
 
+	// Not linked with an entity during construction.
+	void markTransformChanged()
+	{
+		if (m_entity) {
+			m_entity.emplace_or_replace<TransformChangedTag>();
+		}
+	}
+
 	Transform2D m_localTransform;
 	mutable std::optional<Transform2D> m_cachedParentTransform;
 
@@ -0,0 +1,116 @@
+#include <anker/core/anker_scene_snapshot.hpp>
+
+#include <anker/core/anker_components.hpp>
+#include <anker/core/anker_scene.hpp>
+
+namespace Anker {
+
+constexpr u32 SceneSnapshotMagic = 'A' | 'N' << 8 | 'K' << 16 | 'S' << 24;
+
+static void writeEntities(BinaryWriter& write, const entt::registry& reg)
+{
+	const usize countOffset = write.size();
+	write(u32(0));
+
+	u32 count = 0;
+	reg.each([&](EntityID entity) {
+		write(entity);
+		count++;
+	});
+
+	write.patch(countOffset, count);
+}
+
+static bool readEntities(BinaryReader& read, entt::registry& reg)
+{
+	u32 count = 0;
+	ANKER_TRY(read(count));
+	ANKER_TRY(usize(count) * sizeof(EntityID) <= read.remaining());
+
+	std::vector<EntityID> entities(count);
+	ANKER_TRY(read.bytes(asBytesWritable(std::span(entities))));
+
+	// The entity list is validated before the registry is touched.
+	entt::sparse_set snapshotEntities;
+	for (auto entity : entities) {
+		ANKER_TRY(entity != entt::null && !snapshotEntities.contains(entity));
+		snapshotEntities.emplace(entity);
+	}
+
+	// Entities created since the snapshot was taken are destroyed. This
+	// includes entities occupying a recycled ID.
+	std::vector<EntityID> created;
+	reg.each([&](EntityID entity) {
+		if (!snapshotEntities.contains(entity)) {
+			created.push_back(entity);
+		}
+	});
+	reg.destroy(created.begin(), created.end());
+
+	// Entities destroyed since are re-created with their original ID.
+	for (auto entity : entities) {
+		if (!reg.valid(entity)) {
+			ANKER_TRY(reg.create(entity) == entity);
+		}
+	}
+
+	return true;
+}
+
+SceneSnapshot captureSceneSnapshot(const Scene& scene)
+{
+	ANKER_PROFILE_ZONE();
+
+	BinaryWriter write;
+	write(SceneSnapshotMagic);
+
+	writeEntities(write, scene.registry);
+	write(scene.activeCamera().entity());
+
+	for (auto& info : components()) {
+		if (info.writeSnapshot) {
+			write(info.id);
+			info.writeSnapshot(write, scene.registry);
+		}
+	}
+
+	return {write.takeOutput()};
+}
+
+Status restoreSceneSnapshot(Scene& scene, const SceneSnapshot& snapshot)
+{
+	ANKER_PROFILE_ZONE();
+
+	BinaryReader read(snapshot.data);
+
+	u32 magic = 0;
+	if (!read(magic) || magic != SceneSnapshotMagic) {
+		ANKER_ERROR("Invalid scene snapshot");
+		return FormatError;
+	}
+
+	if (!readEntities(read, scene.registry)) {
+		ANKER_ERROR("Restoring entities from scene snapshot failed");
+		return FormatError;
+	}
+
+	EntityID activeCamera = entt::null;
+	if (!read(activeCamera)) {
+		return FormatError;
+	}
+	scene.setActiveCamera(activeCamera);
+
+	for (auto& info : components()) {
+		if (info.readSnapshot) {
+			entt::id_type id = 0;
+			if (!read(id) || id != info.id || !info.readSnapshot(read, scene.registry)) {
+				ANKER_ERROR("Restoring {} from scene snapshot failed", info.name);
+				return FormatError;
+			}
+		}
+	}
+
+	return Ok;
+}
+
+} // namespace Anker
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Anker {
+
+class Scene;
+
+// A SceneSnapshot holds the state of a Scene in a compact buffer. This covers
+// all entities, components registered via ComponentInfo that support binary
+// serialization, the SceneNode hierarchy, and the state of physics bodies.
+//
+// Restoring rewinds the scene to the captured state. Entities created since
+// are destroyed, destroyed entities are re-created with their original IDs,
+// and components still present are updated in place. Snapshots are meant for
+// resetting maps and rewinding gameplay within a session; they are only valid
+// for the scene they were captured from. Data not owned by components, like
+// the GPU buffers of tile layers, is not captured.
+//
+// Malformed snapshots are rejected before the scene is modified, as far as the
+// header and entity list are concerned. A component that fails to restore
+// leaves the scene partially restored, callers should reload the map then.
+struct SceneSnapshot {
+	ByteBuffer data;
+};
+
+SceneSnapshot captureSceneSnapshot(const Scene&);
+
+Status restoreSceneSnapshot(Scene&, const SceneSnapshot&);
+
+} // namespace Anker
@@ -0,0 +1,123 @@
+#include <anker/core/anker_spatial_index.hpp>
+
+namespace Anker {
+
+struct SpatialIndex::Layer {
+	Vec2 parallax;
+	b2DynamicTree tree;
+
+	// Key by proxy id.
+	std::vector<u64> keys;
+};
+
+static b2AABB toAABB(const Rect2& rect)
+{
+	return {.lowerBound = rect.bottomLeftWorld(), .upperBound = rect.topRightWorld()};
+}
+
+SpatialIndex::SpatialIndex() = default;
+SpatialIndex::~SpatialIndex() noexcept = default;
+
+u32 SpatialIndex::layer(Vec2 parallax)
+{
+	for (auto [i, layer] : iter::enumerate(m_layers)) {
+		if (layer->parallax == parallax) {
+			return u32(i);
+		}
+	}
+
+	m_layers.push_back(std::make_unique<Layer>());
+	m_layers.back()->parallax = parallax;
+	return u32(m_layers.size() - 1);
+}
+
+void SpatialIndex::set(u64 key, const Rect2& bounds, Vec2 parallax)
+{
+	const u32 layerIndex = layer(parallax);
+
+	auto [it, inserted] = m_proxies.try_emplace(key);
+	auto& proxy = it->second;
+
+	if (!inserted && proxy.layer == layerIndex) {
+		if (proxy.bounds.offset != bounds.offset || proxy.bounds.size != bounds.size) {
+			// The displacement enlarges the AABB in the direction of movement.
+			m_layers[layerIndex]->tree.MoveProxy(proxy.id, toAABB(bounds), bounds.center() - proxy.bounds.center());
+			proxy.bounds = bounds;
+		}
+		return;
+	}
+
+	if (!inserted) {
+		m_layers[proxy.layer]->tree.DestroyProxy(proxy.id);
+	}
+
+	auto& layer = *m_layers[layerIndex];
+	proxy.layer = layerIndex;
+	proxy.id = layer.tree.CreateProxy(toAABB(bounds), nullptr);
+	proxy.bounds = bounds;
+
+	if (usize(proxy.id) >= layer.keys.size()) {
+		layer.keys.resize(usize(proxy.id) + 1);
+	}
+	layer.keys[usize(proxy.id)] = key;
+}
+
+void SpatialIndex::remove(u64 key)
+{
+	if (auto it = m_proxies.find(key); it != m_proxies.end()) {
+		m_layers[it->second.layer]->tree.DestroyProxy(it->second.id);
+		m_proxies.erase(it);
+	}
+}
+
+void SpatialIndex::markStale(u64 firstKey, u64 lastKey)
+{
+	m_stale.emplace_back(firstKey, lastKey);
+}
+
+void SpatialIndex::removeStale()
+{
+	for (auto [firstKey, lastKey] : m_stale) {
+		auto first = m_proxies.lower_bound(firstKey);
+		auto last = m_proxies.upper_bound(lastKey);
+		for (auto it = first; it != last; ++it) {
+			m_layers[it->second.layer]->tree.DestroyProxy(it->second.id);
+		}
+		m_proxies.erase(first, last);
+	}
+	m_stale.clear();
+}
+
+// Collects keys of overlapping proxies, see b2DynamicTree::Query.
+struct SpatialQuery {
+	const std::vector<u64>& keys;
+	std::vector<u64>& outKeys;
+
+	bool QueryCallback(i32 proxyId)
+	{
+		outKeys.push_back(keys[usize(proxyId)]);
+		return true;
+	}
+};
+
+void SpatialIndex::query(const Rect2& rect, std::vector<u64>& outKeys) const
+{
+	for (auto& layer : m_layers) {
+		SpatialQuery query = {layer->keys, outKeys};
+		layer->tree.Query(&query, toAABB(rect));
+	}
+}
+
+void SpatialIndex::queryView(const Rect2& view, Vec2 cameraPosition, std::vector<u64>& outKeys) const
+{
+	for (auto& layer : m_layers) {
+		// Inverse of applyParallax in the shaders.
+		Rect2 rect = view;
+		rect.offset -= (Vec2(1) - layer->parallax) * cameraPosition;
+
+		SpatialQuery query = {layer->keys, outKeys};
+		layer->tree.Query(&query, toAABB(rect));
+	}
+}
+
+} // namespace Anker
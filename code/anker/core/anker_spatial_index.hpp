@@ -0,0 +1,68 @@
+#pragma once
+
+namespace Anker {
+
+// SpatialIndex is a broadphase over world bounds of scene entities, answering
+// which entities are near a location or visible to a camera. Entities may
+// consist of multiple parts, e.g. the chunks of a TileLayer, each part being a
+// separate proxy.
+//
+// Proxies are kept in Box2D dynamic AABB trees, one per parallax factor, since
+// where an entity appears on screen depends on the camera position otherwise.
+// Moving a proxy within its enlarged AABB does not touch the tree.
+class SpatialIndex {
+  public:
+	SpatialIndex();
+	SpatialIndex(const SpatialIndex&) = delete;
+	SpatialIndex& operator=(const SpatialIndex&) = delete;
+	SpatialIndex(SpatialIndex&&) noexcept = delete;
+	SpatialIndex& operator=(SpatialIndex&&) noexcept = delete;
+	~SpatialIndex() noexcept;
+
+	// Keys are ordered by entity, then part.
+	static u64 key(EntityID entity, u32 part = 0) { return u64(entt::to_integral(entity)) << 32 | part; }
+	static EntityID entity(u64 key) { return EntityID(u32(key >> 32)); }
+	static u32 part(u64 key) { return u32(key); }
+
+	// Inserts the proxy, or moves it to the given bounds.
+	void set(u64 key, const Rect2& bounds, Vec2 parallax = Vec2(1));
+
+	void remove(u64 key);
+
+	// Marks the proxies with keys in [firstKey, lastKey] for removal, used for
+	// destroyed entities and removed components. Called from registry
+	// callbacks, hence the proxies are only removed by removeStale.
+	void markStale(u64 firstKey, u64 lastKey);
+	void removeStale();
+
+	// Appends the keys of proxies overlapping the given rectangle, parallax is
+	// not taken into account.
+	void query(const Rect2&, std::vector<u64>& outKeys) const;
+
+	// Appends the keys of proxies visible to a camera at the given position,
+	// where the view rectangle covers the screen for parallax factor 1.
+	void queryView(const Rect2& view, Vec2 cameraPosition, std::vector<u64>& outKeys) const;
+
+	u32 size() const { return u32(m_proxies.size()); }
+
+  private:
+	struct Layer;
+
+	// Returns the index of the layer, which is added if necessary.
+	u32 layer(Vec2 parallax);
+
+	struct Proxy {
+		u32 layer = 0;
+		i32 id = 0;
+		Rect2 bounds;
+	};
+
+	// Ordered, so all parts of an entity are removed at once.
+	std::map<u64, Proxy> m_proxies;
+
+	std::vector<std::unique_ptr<Layer>> m_layers;
+
+	std::vector<std::pair<u64, u64>> m_stale;
+};
+
+} // namespace Anker
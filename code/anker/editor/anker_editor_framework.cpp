@@ -9,7 +9,24 @@ void EditorFramework::tick(float dt, Scene& scene)
 {
 	const auto& actions = g_engine->inputSystem.actions();
 
-	// Reload the current map on button press.
+	// Capture the initial state of newly activated scenes, before they are
+	// ticked for the first time.
+	if (m_mapSnapshotScene.lock() != g_engine->activeScene) {
+		m_mapSnapshot = captureSceneSnapshot(scene);
+		m_mapSnapshotScene = g_engine->activeScene;
+	}
+
+	// Reset the current map to its initial state on button press.
+	if (actions.editorMapReset) {
+		if (not restoreSceneSnapshot(scene, m_mapSnapshot)) {
+			ANKER_WARN("Map reset failed, reloading instead");
+			if (std::string_view mapIdentifier = currentMapIdentifier(); !mapIdentifier.empty()) {
+				g_engine->nextScene = loadMap(mapIdentifier);
+			}
+		}
+	}
+
+	// Reload the current map from disk on button press.
 	if (actions.editorMapReload) {
 		if (std::string_view mapIdentifier = currentMapIdentifier(); !mapIdentifier.empty()) {
 			g_engine->nextScene = loadMap(mapIdentifier);
@@ -34,6 +51,14 @@ void EditorFramework::tick(float dt, Scene& scene)
 		ImGui::ToggleButton("Timescale", &timescale);
 		ImGui::ToggleButton("PhysDbg", &g_engine->physicsSystem.debugDraw);
 
+#if ANKER_PROFILE_BACKEND == ANKER_PROFILE_BACKEND_BUILTIN
+		if (ImGui::Button("Capture")) {
+			if (not Profiler::writeCapture("anker_profile.json")) {
+				ANKER_ERROR("Profiler capture failed");
+			}
+		}
+#endif
+
 		drawMapsMenuBarEntry();
 		ImGui::TextColored({0.6f, 0.6f, 0.6f, 1.0f}, "%s", std::string(currentMapIdentifier()).c_str());
 
@@ -54,6 +79,10 @@ void EditorFramework::drawMapsMenuBarEntry()
 				if (ImGui::MenuItem(mapIdentifier.c_str())) {
 					g_engine->nextScene = loadMap(mapIdentifier);
 				}
+				if (ImGui::IsItemHovered() && mapIdentifier != m_prefetchedMapIdentifier) {
+					prefetchMap(mapIdentifier);
+					m_prefetchedMapIdentifier = mapIdentifier;
+				}
 			}
 		}
 		ImGui::EndMenu();
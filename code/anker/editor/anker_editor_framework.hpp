@@ -1,6 +1,7 @@
 #pragma once
 
 #include <anker/editor/anker_editor_camera.hpp>
+#include <anker/core/anker_scene_snapshot.hpp>
 #include <anker/editor/anker_inspector.hpp>
 
 namespace Anker {
@@ -28,6 +29,14 @@ class EditorFramework {
 	// Tries to find the current map's identifier. Returns an empty view on failure.
 	std::string_view currentMapIdentifier() const;
 
+	// Snapshot of the current scene, captured when it became active. Used for
+	// resetting the map without reloading it.
+	SceneSnapshot m_mapSnapshot;
+	std::weak_ptr<Scene> m_mapSnapshotScene;
+
+	// The map hovered in the map menu is prefetched once.
+	std::string m_prefetchedMapIdentifier;
+
 	Inspector m_inspector;
 	EditorCameraSystem m_cameraSystem;
 };
@@ -67,6 +67,10 @@ void Inspector::tick(float, Scene& scene)
 			m_sceneGraphModification();
 			m_sceneGraphModification = nullptr;
 		}
+
+		ImGui::Separator();
+
+		drawAssetCacheStats();
 	}
 	ImGui::End();
 
@@ -230,6 +234,11 @@ void Inspector::drawComponentEditorWindow(EntityHandle entity, std::string_view
 		}
 	}
 
+	// Components are edited in place, the spatial index picks up any change.
+	if (entity.all_of<SceneNode>()) {
+		entity.emplace_or_replace<TransformChangedTag>();
+	}
+
 	ImGui::End();
 }
 
@@ -239,8 +248,9 @@ void Inspector::drawSelectionGizmo(EntityCHandle entity)
 		auto transform = node->globalTransform();
 
 		Rect2 rect;
-		if (auto* sprite = entity.try_get<Sprite>(); sprite && sprite->texture) {
-			rect.size = Vec2(sprite->texture->info.size) * sprite->textureRect.size / sprite->pixelToMeter;
+		auto* sprite = entity.try_get<Sprite>();
+		if (auto* texture = sprite ? g_engine->assetCache.get(sprite->texture) : nullptr) {
+			rect.size = Vec2(texture->info.size) * sprite->textureRect.size / sprite->pixelToMeter;
 			rect.size *= transform.scale;
 		} else {
 			rect.size = {0.25f, 0.25f};
@@ -251,4 +261,78 @@ void Inspector::drawSelectionGizmo(EntityCHandle entity)
 	}
 }
 
+void Inspector::drawAssetCacheStats()
+{
+	if (!ImGui::CollapsingHeader("Asset Cache")) {
+		return;
+	}
+
+	constexpr float MiB = 1024 * 1024;
+	constexpr usize Unlimited = std::numeric_limits<usize>::max();
+
+	auto& assetCache = g_engine->assetCache;
+
+	if (ImGui::BeginTable("AssetCacheStats", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+		for (auto* header : {"Type", "Count", "MiB", "Budget MiB", "Hits", "Misses", "Evictions"}) {
+			ImGui::TableSetupColumn(header);
+		}
+		ImGui::TableHeadersRow();
+
+		for (auto* stats : assetCache.allStats()) {
+			ImGui::PushID(stats->name);
+			ImGui::TableNextRow();
+
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats->name);
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", stats->count);
+
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", double(float(stats->bytes) / MiB));
+
+			// A budget of 0 means unlimited.
+			ImGui::TableNextColumn();
+			float budget = stats->budget == Unlimited ? 0 : float(stats->budget) / MiB;
+			ImGui::SetNextItemWidth(80);
+			if (ImGui::DragFloat("##Budget", &budget, 1.0f, 0.0f, 65536.0f, budget > 0 ? "%.0f" : "-")) {
+				stats->budget = budget > 0 ? usize(budget * MiB) : Unlimited;
+			}
+
+			for (u64 counter : {stats->hits, stats->misses, stats->evictions}) {
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(counter));
+			}
+
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	auto& spriteAtlas = assetCache.spriteAtlas();
+	ImGui::Text("Sprite Atlas: %u textures, %u pages, %.0f%% occupied", spriteAtlas.allocationCount(),
+	            spriteAtlas.pageCount(), double(spriteAtlas.occupancy() * 100.0f));
+
+	auto& spriteStats = g_engine->renderSystem.spriteRenderer().stats();
+	ImGui::Text("Sprites: %u drawn, %u texture changes", spriteStats.sprites, spriteStats.textureChanges);
+
+	auto& renderStats = g_engine->renderSystem.stats();
+	ImGui::Text("Culling: %u visible, %u culled", renderStats.visible, renderStats.culled);
+
+	for (auto mode : {GlyphMode::Bitmap, GlyphMode::Sdf}) {
+		auto glyphStats = g_engine->fontSystem.glyphCache(mode).stats();
+		ImGui::Text("%s Glyph Cache: %u glyphs, %u pages, %u evictions", mode == GlyphMode::Sdf ? "SDF" : "Bitmap",
+		            glyphStats.glyphs, glyphStats.pages, glyphStats.evictions);
+	}
+
+	if (ImGui::Button("Evict Over Budget")) {
+		assetCache.evictOverBudget();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clear Unused")) {
+		assetCache.clearUnused();
+	}
+}
+
 } // namespace Anker
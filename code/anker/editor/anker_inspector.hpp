@@ -37,6 +37,8 @@ class Inspector {
 
 	void drawSelectionGizmo(EntityCHandle);
 
+	void drawAssetCacheStats();
+
 	bool m_enabled = true;
 };
 
@@ -1,12 +1,12 @@
 #include <anker/editor/anker_inspector_widget_drawer.hpp>
 
-#include <anker/graphics/anker_render_device.hpp>
+#include <anker/core/anker_engine.hpp>
 
 namespace Anker {
 
-bool serialize(InspectorWidgetDrawer&, AssetPtr<VertexShader>& vertexShader)
+bool serialize(InspectorWidgetDrawer&, AssetHandle<VertexShader>& handle)
 {
-	if (vertexShader) {
+	if (auto* vertexShader = g_engine->assetCache.get(handle)) {
 		ImGui::Text("VertexShader: %s", vertexShader->info.name.c_str());
 	} else {
 		ImGui::Text("No VertexShader");
@@ -14,9 +14,9 @@ bool serialize(InspectorWidgetDrawer&, AssetPtr<VertexShader>& vertexShader)
 	return false;
 }
 
-bool serialize(InspectorWidgetDrawer&, AssetPtr<PixelShader>& pixelShader)
+bool serialize(InspectorWidgetDrawer&, AssetHandle<PixelShader>& handle)
 {
-	if (pixelShader) {
+	if (auto* pixelShader = g_engine->assetCache.get(handle)) {
 		ImGui::Text("PixelShader: %s", pixelShader->info.name.c_str());
 	} else {
 		ImGui::Text("No PixelShader");
@@ -24,9 +24,9 @@ bool serialize(InspectorWidgetDrawer&, AssetPtr<PixelShader>& pixelShader)
 	return false;
 }
 
-bool serialize(InspectorWidgetDrawer&, AssetPtr<Texture>& texture)
+bool serialize(InspectorWidgetDrawer&, AssetHandle<Texture>& handle)
 {
-	if (texture) {
+	if (auto* texture = g_engine->assetCache.get(handle)) {
 		ImGui::Text("Texture: %s", texture->info.name.c_str());
 	} else {
 		ImGui::Text("No Texture");
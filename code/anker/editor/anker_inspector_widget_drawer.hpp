@@ -233,14 +233,14 @@ class InspectorWidgetDrawer {
 };
 
 ////////////////////////////////////////////////////////////
-// AssetPtr support
+// AssetHandle support
 
 struct VertexShader;
 struct PixelShader;
 struct Texture;
 
-bool serialize(InspectorWidgetDrawer&, AssetPtr<VertexShader>&);
-bool serialize(InspectorWidgetDrawer&, AssetPtr<PixelShader>&);
-bool serialize(InspectorWidgetDrawer&, AssetPtr<Texture>&);
+bool serialize(InspectorWidgetDrawer&, AssetHandle<VertexShader>&);
+bool serialize(InspectorWidgetDrawer&, AssetHandle<PixelShader>&);
+bool serialize(InspectorWidgetDrawer&, AssetHandle<Texture>&);
 
 } // namespace Anker
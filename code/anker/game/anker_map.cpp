@@ -25,6 +25,644 @@ enum TileFlipFlag : TileId {
 };
 constexpr TileId FlipMask = FlipHorizontal | FlipVertical | FlipDiagonal;
 
+////////////////////////////////////////////////////////////
+// Map Description
+//
+// A .tmj file is parsed in a streaming fashion into the following description,
+// which is then used to populate the scene. Tiled writes object keys in
+// alphabetical order. Hence, a layer's name and type are only known after its
+// content has been parsed and tilesets are only known after all layers.
+//
+// Strings point into the (in-situ parsed) input buffer. Tile layer data is
+// decoded as soon as it is encountered.
+
+struct TmjObject {
+	int id = 0;
+	std::string_view name;
+	std::string_view templatePath;
+	Vec2 position;
+	Vec2 size;
+	float rotation = 0;
+	TileId gid = EmptyTile;
+	bool ellipse = false;
+	bool point = false;
+	std::optional<std::vector<Vec2>> polygon;
+	std::optional<std::vector<Vec2>> polyline;
+};
+
+struct TmjLayer {
+	int id = 0;
+	std::string_view type;
+	std::string_view name;
+	Vec2 offset;
+	std::string_view tintColor;
+	std::optional<float> opacity;
+	Vec2 parallax = Vec2(1);
+
+	// Tile layers
+	std::string_view encoding;
+	std::string_view compression;
+	std::optional<std::string> data; // decoded
+	u32 width = 0;
+	u32 height = 0;
+
+	// Object layers
+	std::vector<TmjObject> objects;
+
+	// Group layers
+	std::vector<TmjLayer> layers;
+};
+
+struct TmjTilesetReference {
+	std::string_view source;
+	TileId firstTileId = EmptyTile;
+};
+
+struct TmjProperty {
+	std::string_view name;
+	std::string_view value;
+};
+
+struct TmjMap {
+	std::string_view type;
+	Vec2 tileSize = {256, 256};
+	std::vector<TmjLayer> layers;
+	std::vector<TmjTilesetReference> tilesets;
+	std::vector<TmjProperty> properties;
+};
+
+// SAX handler building a TmjMap. The handler keeps a stack of contexts to know
+// where the current value belongs to. Unknown objects and arrays are skipped.
+class TmjHandler : public JsonStreamHandler<TmjHandler> {
+  public:
+	explicit TmjHandler(TmjMap& map) : m_map(map) {}
+
+	bool beginObject()
+	{
+		if (m_contexts.empty()) {
+			m_contexts.push_back(Context::Root);
+			return true;
+		}
+
+		switch (m_contexts.back()) {
+		case Context::Layers: {
+			auto& siblings = m_layers.empty() ? m_map.layers : m_layers.back()->layers;
+			m_layers.push_back(&siblings.emplace_back());
+			m_contexts.push_back(Context::Layer);
+			break;
+		}
+		case Context::Objects:
+			m_object = &m_layers.back()->objects.emplace_back();
+			m_contexts.push_back(Context::Object);
+			break;
+		case Context::Points:
+			m_point = &m_points->emplace_back();
+			m_contexts.push_back(Context::Point);
+			break;
+		case Context::Tilesets:
+			m_tileset = &m_map.tilesets.emplace_back();
+			m_contexts.push_back(Context::Tileset);
+			break;
+		case Context::Properties:
+			m_property = &m_map.properties.emplace_back();
+			m_contexts.push_back(Context::Property);
+			break;
+		default: m_contexts.push_back(Context::Skip); break;
+		}
+
+		return true;
+	}
+
+	bool endObject()
+	{
+		if (m_contexts.back() == Context::Layer) {
+			m_layers.pop_back();
+		}
+		m_contexts.pop_back();
+		return true;
+	}
+
+	bool beginArray()
+	{
+		Context context = Context::Skip;
+
+		if (!m_contexts.empty()) {
+			switch (m_contexts.back()) {
+			case Context::Root:
+				if (key() == "layers") {
+					context = Context::Layers;
+				} else if (key() == "tilesets") {
+					context = Context::Tilesets;
+				} else if (key() == "properties") {
+					context = Context::Properties;
+				}
+				break;
+			case Context::Layer:
+				if (key() == "layers") {
+					context = Context::Layers;
+				} else if (key() == "objects") {
+					context = Context::Objects;
+				}
+				break;
+			case Context::Object:
+				if (key() == "polygon") {
+					m_points = &m_object->polygon.emplace();
+					context = Context::Points;
+				} else if (key() == "polyline") {
+					m_points = &m_object->polyline.emplace();
+					context = Context::Points;
+				}
+				break;
+			default: break;
+			}
+		}
+
+		m_contexts.push_back(context);
+		return true;
+	}
+
+	bool endArray()
+	{
+		m_contexts.pop_back();
+		return true;
+	}
+
+	bool value(const JsonStreamValue& value)
+	{
+		if (m_contexts.empty()) {
+			return true;
+		}
+
+		switch (m_contexts.back()) {
+		case Context::Root:
+			if (key() == "type") {
+				read(value, m_map.type);
+			} else if (key() == "tilewidth") {
+				read(value, m_map.tileSize.x);
+			} else if (key() == "tileheight") {
+				read(value, m_map.tileSize.y);
+			}
+			break;
+		case Context::Layer: layerValue(*m_layers.back(), value); break;
+		case Context::Object: objectValue(*m_object, value); break;
+		case Context::Point:
+			if (key() == "x") {
+				read(value, m_point->x);
+			} else if (key() == "y") {
+				read(value, m_point->y);
+			}
+			break;
+		case Context::Tileset:
+			if (key() == "source") {
+				read(value, m_tileset->source);
+			} else if (key() == "firstgid") {
+				read(value, m_tileset->firstTileId);
+			}
+			break;
+		case Context::Property:
+			if (key() == "name") {
+				read(value, m_property->name);
+			} else if (key() == "value") {
+				read(value, m_property->value);
+			}
+			break;
+		default: break;
+		}
+
+		return true;
+	}
+
+  private:
+	enum class Context {
+		Root,
+		Layers,
+		Layer,
+		Objects,
+		Object,
+		Points,
+		Point,
+		Tilesets,
+		Tileset,
+		Properties,
+		Property,
+		Skip,
+	};
+
+	void layerValue(TmjLayer& layer, const JsonStreamValue& value)
+	{
+		auto k = key();
+		if (k == "data") {
+			// Encoding is only known later on, but only base64 encoding uses
+			// a string here.
+			if (std::string_view data; read(value, data)) {
+				layer.data = decodeBase64(data);
+			}
+		} else if (k == "id") {
+			read(value, layer.id);
+		} else if (k == "type") {
+			read(value, layer.type);
+		} else if (k == "name") {
+			read(value, layer.name);
+		} else if (k == "x") {
+			read(value, layer.offset.x);
+		} else if (k == "y") {
+			read(value, layer.offset.y);
+		} else if (k == "tintcolor") {
+			read(value, layer.tintColor);
+		} else if (k == "opacity") {
+			read(value, layer.opacity.emplace(1.0f));
+		} else if (k == "parallaxx") {
+			read(value, layer.parallax.x);
+		} else if (k == "parallaxy") {
+			read(value, layer.parallax.y);
+		} else if (k == "encoding") {
+			read(value, layer.encoding);
+		} else if (k == "compression") {
+			read(value, layer.compression);
+		} else if (k == "width") {
+			read(value, layer.width);
+		} else if (k == "height") {
+			read(value, layer.height);
+		}
+	}
+
+	void objectValue(TmjObject& object, const JsonStreamValue& value)
+	{
+		auto k = key();
+		if (k == "id") {
+			read(value, object.id);
+		} else if (k == "name") {
+			read(value, object.name);
+		} else if (k == "template") {
+			read(value, object.templatePath);
+		} else if (k == "x") {
+			read(value, object.position.x);
+		} else if (k == "y") {
+			read(value, object.position.y);
+		} else if (k == "width") {
+			read(value, object.size.x);
+		} else if (k == "height") {
+			read(value, object.size.y);
+		} else if (k == "rotation") {
+			read(value, object.rotation);
+		} else if (k == "gid") {
+			read(value, object.gid);
+		} else if (k == "ellipse") {
+			read(value, object.ellipse);
+		} else if (k == "point") {
+			read(value, object.point);
+		}
+	}
+
+	TmjMap& m_map;
+
+	std::vector<Context> m_contexts;
+
+	std::vector<TmjLayer*> m_layers;
+	TmjObject* m_object = nullptr;
+	std::vector<Vec2>* m_points = nullptr;
+	Vec2* m_point = nullptr;
+	TmjTilesetReference* m_tileset = nullptr;
+	TmjProperty* m_property = nullptr;
+};
+
+// SAX handler for .tsj files. Only top-level values are of interest.
+class TsjHandler : public JsonStreamHandler<TsjHandler> {
+  public:
+	bool beginObject() { return true; }
+	bool endObject() { return true; }
+	bool beginArray() { return true; }
+	bool endArray() { return true; }
+
+	bool value(const JsonStreamValue& value)
+	{
+		if (depth() != 1) {
+			return true;
+		}
+
+		if (key() == "image") {
+			read(value, image);
+		} else if (key() == "tilecount") {
+			read(value, tileCount);
+		} else if (key() == "columns") {
+			read(value, columns);
+		} else if (key() == "tilewidth") {
+			read(value, tileSize.x);
+		} else if (key() == "tileheight") {
+			read(value, tileSize.y);
+		}
+		return true;
+	}
+
+	std::string_view image;
+	u32 tileCount = 0;
+	u32 columns = 0;
+	Vec2u tileSize;
+};
+
+////////////////////////////////////////////////////////////
+// Tileset
+//
+// A Tileset is used to populate a TileLayer's vertex buffers. Specifically,
+// we need to get the texture coordinates for each tile.
+
+struct Tileset {
+	Rect2 textureCoordinates(u32 gid) const
+	{
+		ANKER_CHECK(gid >= firstTileId, {});
+		u32 index = gid - firstTileId;
+
+		ANKER_CHECK(index < tileCount.x * tileCount.y, {});
+		float x = float(index % tileCount.x);
+		float y = float(index / tileCount.x);
+
+		Vec2 texSize = Vec2(textureSize);
+
+		return Rect2(Vec2(tileSize) / texSize, //
+		             Vec2{x, y} * Vec2(tileSize) / texSize);
+	}
+
+	TileId firstTileId = 1;
+	Vec2u tileCount;
+	Vec2u tileSize;
+	AssetHandle<Texture> texture;
+	Vec2u textureSize;
+
+	// Source .tsj file, used to rebuild tile layers when it is modified.
+	fs::path filepath;
+};
+
+// The Tilesets used by a map are stored in the Scene's context, sorted in
+// reverse order for the linear lookup via global ids.
+struct MapTilesets {
+	std::vector<Tileset> tilesets;
+};
+
+// The dependency graph nodes of a map and its Tilesets are owned by the scenes
+// using them and removed once the last of these scenes is destroyed. Scenes
+// loading the same map, e.g. when it is reloaded, share nodes. Stored in the
+// Scene's context.
+class MapDependencyNodes {
+  public:
+	explicit MapDependencyNodes(AssetDependencyGraph& graph) : m_graph(graph) {}
+	MapDependencyNodes(const MapDependencyNodes&) = delete;
+	MapDependencyNodes& operator=(const MapDependencyNodes&) = delete;
+	MapDependencyNodes(MapDependencyNodes&&) noexcept = delete;
+	MapDependencyNodes& operator=(MapDependencyNodes&&) noexcept = delete;
+
+	~MapDependencyNodes() noexcept
+	{
+		for (auto& ref : m_refs) {
+			m_graph.release(ref, this);
+		}
+	}
+
+	void add(const AssetRef& ref)
+	{
+		if (std::ranges::find(m_refs, ref) == m_refs.end()) {
+			m_refs.push_back(ref);
+			m_graph.retain(ref, this);
+		}
+	}
+
+  private:
+	AssetDependencyGraph& m_graph;
+	std::vector<AssetRef> m_refs;
+};
+
+// Kept alongside each TileLayer loaded from a map, so its vertex buffers can be
+// rebuilt when a Tileset is modified.
+struct TileLayerSource {
+	std::string name;
+	std::vector<TileId> tiles;
+	u32 width = 0;
+};
+
+// Given a global id (without flip bits), this function returns the index of
+// the corresponding Tileset.
+static u32 findTilesetIndex(std::span<const Tileset> tilesets, TileId gid)
+{
+	auto iter = std::ranges::find_if(tilesets, [=](auto& tileset) { return gid >= tileset.firstTileId; });
+	return u32(std::distance(tilesets.begin(), iter));
+}
+
+// Loads the .tsj file; firstTileId is not touched. The .tsj file and texture
+// are recorded as dependencies of the Tileset, see reloadTileset.
+static Status loadTileset(Tileset& tileset, const fs::path& filepath, Scene& scene, AssetCache& assetCache)
+{
+	// Recorded even on failure, so fixing the file triggers a reload.
+	std::vector<fs::path> files;
+	std::vector<AssetRef> dependencies;
+	auto ref = AssetRef::of<Tileset>(toAssetId(filepath));
+	scene.registry.ctx().get<MapDependencyNodes>().add(ref);
+	ANKER_DEFER(assetCache.dependencyGraph().set(ref, files, dependencies));
+
+	ByteBuffer tsjData;
+	{
+		DataLoadRecorder recorder;
+		Status loadStatus = g_assetDataLoader.load(tsjData, filepath);
+		files = recorder.files();
+		ANKER_TRY(loadStatus);
+	}
+
+	TsjHandler tsj;
+	ANKER_TRY(JsonStreamReader::parse(tsjData, tsj, filepath.string()));
+
+	if (tsj.image.empty() || tsj.tileCount == 0 || tsj.columns == 0 || tsj.tileSize.x == 0 || tsj.tileSize.y == 0) {
+		ANKER_ERROR("{}: Invalid format", filepath);
+		return FormatError;
+	}
+
+	tileset.tileCount = {tsj.columns, tsj.tileCount / tsj.columns};
+	tileset.tileSize = tsj.tileSize;
+	tileset.filepath = filepath;
+
+	auto imageId = toAssetId(fs::path(filepath).replace_filename(tsj.image));
+	// Reloads replace the pin of the previous texture, see reloadTileset.
+	tileset.texture = assetCache.repin(scene.assetPins, tileset.texture, assetCache.loadTexture(imageId));
+	if (auto* texture = assetCache.get(tileset.texture)) {
+		tileset.textureSize = texture->info.size;
+	}
+	dependencies.push_back(AssetRef::of<Texture>(imageId));
+
+	return Ok;
+}
+
+using TileLayerVertices = std::vector<TileLayerRenderer::Vertex>;
+
+// TileLayers are split into chunks of tiles, which are culled individually.
+const u32 TileLayerChunkSize = 16;
+
+static void loadTileLayerVertices(std::vector<TileLayerVertices>& verticesPerPart, std::span<const Tileset> tilesets,
+                                  std::span<const TileId> tiles, u32 width, const Rect2u& chunk)
+{
+	for (u32 y = chunk.offset.y; y < chunk.offset.y + chunk.size.y; ++y) {
+		for (u32 x = chunk.offset.x; x < chunk.offset.x + chunk.size.x; ++x) {
+			const usize tileIndex = usize(y) * width + x;
+			const TileId tile = tiles[tileIndex];
+			if (tile == EmptyTile) {
+				continue;
+			}
+
+			// The tile number consists of a global id and flip bits.
+			const TileId gid = tile & ~FlipMask;
+
+			// From the global id, we can determine the Tileset used for this
+			// specific tile.
+			const u32 tilesetIndex = findTilesetIndex(tilesets, gid);
+
+			const Rect2 pos = Rect2(Vec2(1), {float(x), -float(y) - 1.0f});
+
+			const Rect2 texCoordinates = tilesets[tilesetIndex].textureCoordinates(gid);
+			Vec2 uvTopLeft = texCoordinates.topLeft();
+			Vec2 uvTopRight = texCoordinates.topRight();
+			Vec2 uvBottomLeft = texCoordinates.bottomLeft();
+			Vec2 uvBottomRight = texCoordinates.bottomRight();
+
+			if (tile & FlipVertical) {
+				std::swap(uvTopLeft, uvBottomLeft);
+				std::swap(uvTopRight, uvBottomRight);
+			}
+			if (tile & FlipHorizontal) {
+				std::swap(uvTopLeft, uvTopRight);
+				std::swap(uvBottomLeft, uvBottomRight);
+			}
+			if (tile & FlipDiagonal) {
+				std::swap(uvTopRight, uvBottomLeft);
+			}
+
+			verticesPerPart[tilesetIndex].insert(
+			    verticesPerPart[tilesetIndex].end(),
+			    {
+			        TileLayerRenderer::Vertex{.position = pos.topLeftWorld(), .uv = uvTopLeft},
+			        TileLayerRenderer::Vertex{.position = pos.bottomLeftWorld(), .uv = uvBottomLeft},
+			        TileLayerRenderer::Vertex{.position = pos.topRightWorld(), .uv = uvTopRight},
+			        TileLayerRenderer::Vertex{.position = pos.topRightWorld(), .uv = uvTopRight},
+			        TileLayerRenderer::Vertex{.position = pos.bottomLeftWorld(), .uv = uvBottomLeft},
+			        TileLayerRenderer::Vertex{.position = pos.bottomRightWorld(), .uv = uvBottomRight},
+			    });
+		}
+	}
+}
+
+// Creates a vertex buffer per chunk and Tileset, and pairs it with the
+// corresponding texture.
+static Status createTileLayerParts(std::vector<TileLayerPart>& parts, std::span<const Tileset> tilesets,
+                                   const TileLayerSource& source, RenderDevice& renderDevice)
+{
+	const u32 width = source.width;
+	const u32 height = width ? u32(source.tiles.size()) / width : 0;
+
+	std::vector<TileLayerVertices> verticesPerPart(tilesets.size());
+
+	for (u32 chunkY = 0; chunkY < height; chunkY += TileLayerChunkSize) {
+		for (u32 chunkX = 0; chunkX < width; chunkX += TileLayerChunkSize) {
+			const Vec2u chunkSize = {std::min(TileLayerChunkSize, width - chunkX),
+			                         std::min(TileLayerChunkSize, height - chunkY)};
+			const Rect2u chunk(chunkSize, {chunkX, chunkY});
+
+			for (auto& vertices : verticesPerPart) {
+				vertices.clear();
+			}
+			loadTileLayerVertices(verticesPerPart, tilesets, source.tiles, width, chunk);
+
+			for (auto [vertices, tileset] : iter::zip(verticesPerPart, tilesets)) {
+				if (vertices.empty()) {
+					continue;
+				}
+
+				GpuBuffer vertexBuffer;
+				vertexBuffer.info = {
+				    .name = "TileLayer Vertex Buffer " + source.name,
+				    .bindFlags = GpuBindFlag::VertexBuffer,
+				};
+				ANKER_TRY(renderDevice.createBuffer(vertexBuffer, vertices));
+
+				parts.push_back({
+				    .vertexBuffer = vertexBuffer,
+				    .texture = tileset.texture,
+				    .bounds = Rect2(Vec2(chunk.size), {float(chunkX), -float(chunkY + chunk.size.y)}),
+				});
+			}
+		}
+	}
+
+	return Ok;
+}
+
+// Unnamed tile objects are decoration that never moves. Instead of an entity
+// with a Sprite each, they are merged into a TileLayer, kept alongside this
+// source for rebuilding it when a Tileset is modified.
+struct StaticObject {
+	Transform2D transform; // Layer space, flips are negative scale
+	TileId gid = EmptyTile;
+};
+
+struct StaticObjectsSource {
+	std::string name;
+	std::vector<StaticObject> objects;
+	float tileSize = 256;
+};
+
+// Parts take consecutive objects, since a part is drawn at once and objects
+// may overlap. The limit keeps parts small enough for culling.
+const u32 StaticObjectsPerPart = 64;
+
+// Creates a vertex buffer per run of consecutive objects using the same
+// Tileset, and pairs it with the corresponding texture.
+static Status createStaticObjectParts(std::vector<TileLayerPart>& parts, std::span<const Tileset> tilesets,
+                                      const StaticObjectsSource& source, RenderDevice& renderDevice)
+{
+	TileLayerVertices vertices;
+
+	for (usize first = 0; first < source.objects.size();) {
+		const u32 tilesetIndex = findTilesetIndex(tilesets, source.objects[first].gid);
+		const auto& tileset = tilesets[tilesetIndex];
+
+		// Same quad as the Sprite of a tile object, see TmjLoader::loadObject.
+		const Vec2 size = Vec2(tileset.tileSize) / source.tileSize;
+		const Rect2 rect(size, size * -0.5f);
+
+		vertices.clear();
+		Vec2 min = Vec2(std::numeric_limits<float>::max());
+		Vec2 max = Vec2(std::numeric_limits<float>::lowest());
+
+		usize last = first;
+		for (; last < source.objects.size() && last - first < StaticObjectsPerPart; ++last) {
+			const auto& object = source.objects[last];
+			if (findTilesetIndex(tilesets, object.gid) != tilesetIndex) {
+				break;
+			}
+
+			for (auto vertex : Vertex2D::makeQuad(rect, tileset.textureCoordinates(object.gid))) {
+				vertex.position = object.transform * vertex.position;
+				min = {std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y)};
+				max = {std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y)};
+				vertices.push_back(vertex);
+			}
+		}
+
+		GpuBuffer vertexBuffer;
+		vertexBuffer.info = {
+		    .name = "TileLayer Vertex Buffer " + source.name,
+		    .bindFlags = GpuBindFlag::VertexBuffer,
+		};
+		ANKER_TRY(renderDevice.createBuffer(vertexBuffer, vertices));
+
+		parts.push_back({
+		    .vertexBuffer = vertexBuffer,
+		    .texture = tileset.texture,
+		    .bounds = Rect2(max - min, min),
+		});
+
+		first = last;
+	}
+
+	return Ok;
+}
+
+////////////////////////////////////////////////////////////
+
 // The loader for .tmj files. This loader should not be exposed, instead a
 // addMapToScene function is the primary interface for map loading. This is only
 // implemented as a class to make the implementation more readable.
@@ -50,29 +688,38 @@ class TmjLoader {
 
 		auto filepath = std::string{identifier} + ".tmj";
 
+		// The map description references the input buffer, hence the buffer
+		// must outlive it.
 		ByteBuffer tmjData;
-		ANKER_TRY(g_assetDataLoader.load(tmjData, filepath));
-		ANKER_TRY(m_tmjReader.parse(tmjData, filepath));
+		{
+			DataLoadRecorder recorder;
+			Status loadStatus = g_assetDataLoader.load(tmjData, filepath);
+			auto ref = AssetRef::of<MapIdentifier>(AssetId(identifier));
+			m_scene.registry.ctx().get<MapDependencyNodes>().add(ref);
+			m_assetCache.dependencyGraph().set(ref, recorder.files());
+			ANKER_TRY(loadStatus);
+		}
 
-		if (std::string type; !m_tmjReader.field("type", type) || type != "map") {
+		TmjMap map;
+		TmjHandler handler(map);
+		ANKER_TRY(JsonStreamReader::parse(tmjData, handler, filepath));
+
+		if (map.type != "map") {
 			ANKER_ERROR("{}: Not a map", identifier);
 			return FormatError;
 		}
 
-		{
-			Vec2 tileSize = {256, 256};
-			m_tmjReader.field("tilewidth", tileSize.x);
-			m_tmjReader.field("tileheight", tileSize.y);
-			if (tileSize.x != tileSize.y) {
-				ANKER_ERROR("{}: Tiles must be quadratic. tileSize={}", identifier, tileSize);
-				return FormatError;
-			}
-			m_tileSize = tileSize.x;
+		if (map.tileSize.x != map.tileSize.y) {
+			ANKER_ERROR("{}: Tiles must be quadratic. tileSize={}", identifier, map.tileSize);
+			return FormatError;
 		}
+		m_tileSize = map.tileSize.x;
+
+		ANKER_TRY(loadTilesets(map.tilesets));
+		ANKER_TRY(loadLayers(map.layers));
+		ANKER_TRY(loadProperties(map.properties));
 
-		ANKER_TRY(loadTilesets());
-		ANKER_TRY(loadLayers());
-		ANKER_TRY(loadProperties());
+		m_scene.registry.ctx().emplace<MapTilesets>(m_tilesets);
 
 		return Ok;
 	}
@@ -80,59 +727,23 @@ class TmjLoader {
   private:
 	////////////////////////////////////////////////////////////
 	// Tileset
-	//
-	// A Tileset is used to populate a TileLayer's vertex buffers. Specifically,
-	// we need to get the texture coordinates for each tile.
 
-	struct Tileset {
-		Rect2 textureCoordinates(u32 gid) const
-		{
-			ANKER_CHECK(gid >= firstTileId, {});
-			u32 index = gid - firstTileId;
-
-			ANKER_CHECK(index < tileCount.x * tileCount.y, {});
-			float x = float(index % tileCount.x);
-			float y = float(index / tileCount.x);
-
-			Vec2 texSize = Vec2(texture->info.size);
-
-			return Rect2(Vec2(tileSize) / texSize, //
-			             Vec2{x, y} * Vec2(tileSize) / texSize);
-		}
-
-		TileId firstTileId = 1;
-		Vec2u tileCount;
-		Vec2u tileSize;
-		AssetPtr<Texture> texture;
-	};
-
-	Status loadTilesets()
+	Status loadTilesets(std::span<const TmjTilesetReference> tilesetReferences)
 	{
-		Status status;
-
-		m_tmjReader.forEach("tilesets", [&](u32 tilesetIndex) {
-			if (not status) {
-				return;
+		for (auto [tilesetIndex, tilesetReference] : iter::enumerate(tilesetReferences)) {
+			if (tilesetReference.source.empty() || tilesetReference.firstTileId == EmptyTile) {
+				ANKER_ERROR("{}: Tileset {}: Invalid format", m_tmjIdentifier, tilesetIndex);
+				return FormatError;
 			}
 
 			Tileset tileset;
+			tileset.firstTileId = tilesetReference.firstTileId;
 
-			std::string source;
-			bool formatOk = m_tmjReader.field("source", source) //
-			             && m_tmjReader.field("firstgid", tileset.firstTileId);
-			if (!formatOk) {
-				ANKER_ERROR("{}: Tileset {}: Invalid format", m_tmjIdentifier, tilesetIndex);
-				status = FormatError;
-				return;
-			}
-
-			fs::path tilesetFilepath = fs::path(m_tmjIdentifier).replace_filename(source);
-			if (status = loadTileset(tileset, tilesetFilepath); !status) {
-				return;
-			}
+			fs::path tilesetFilepath = fs::path(m_tmjIdentifier).replace_filename(tilesetReference.source);
+			ANKER_TRY(loadTileset(tileset, tilesetFilepath, m_scene, m_assetCache));
 
 			m_tilesets.emplace_back(std::move(tileset));
-		});
+		}
 
 		// Sorting the Tilesets in reverse order for the linear lookup we need
 		// later on when using global ids.
@@ -141,288 +752,202 @@ class TmjLoader {
 		return Ok;
 	}
 
-	Status loadTileset(Tileset& tileset, const fs::path& filepath)
-	{
-		ByteBuffer tsjData;
-		ANKER_TRY(g_assetDataLoader.load(tsjData, filepath));
-
-		JsonReader tsjReader;
-		ANKER_TRY(tsjReader.parse(tsjData, filepath.string()));
-
-		std::string image;
-		u32 tileCountTotal = 0;
-		bool formatOk = tsjReader.field("image", image)                  //
-		             && tsjReader.field("tilecount", tileCountTotal)     //
-		             && tsjReader.field("columns", tileset.tileCount.x)  //
-		             && tsjReader.field("tilewidth", tileset.tileSize.x) //
-		             && tsjReader.field("tileheight", tileset.tileSize.y);
-		if (!formatOk) {
-			ANKER_ERROR("{}: Invalid format", filepath);
-			return FormatError;
-		}
-
-		tileset.tileCount.y = tileCountTotal / tileset.tileCount.x;
-
-		auto imageIdentifier = toIdentifier(fs::path(filepath).replace_filename(image));
-		tileset.texture = m_assetCache.loadTexture(imageIdentifier);
-
-		return Ok;
-	}
-
 	////////////////////////////////////////////////////////////
 
-	Status loadLayers()
+	Status loadLayers(std::span<const TmjLayer> layers)
 	{
-		Status status;
-
-		m_tmjReader.forEach("layers", [&](u32) {
-			if (not status) {
-				return;
-			}
-
+		for (auto& layer : layers) {
 			// Load common layer parameters
 
-			std::string type;
-			if (!m_tmjReader.field("type", type)) {
+			if (layer.type.empty()) {
 				ANKER_ERROR("{}: Missing type field", m_tmjIdentifier);
-				status = FormatError;
-				return;
-			}
-
-			std::string layerName;
-			m_tmjReader.field("name", layerName);
-			if (layerName.empty()) {
-				layerName = "Map Layer";
+				return FormatError;
 			}
 
-			Vec2 layerOffset;
-			m_tmjReader.field("x", layerOffset.x);
-			m_tmjReader.field("y", layerOffset.y);
-			layerOffset = convertCoordinates(layerOffset);
+			std::string layerName = layer.name.empty() ? "Map Layer" : std::string(layer.name);
 
 			m_layerSceneNode = &m_scene //
 			                        .createEntity(layerName)
-			                        .emplace<SceneNode>(Transform2D(layerOffset), m_layerSceneNode);
+			                        .emplace<SceneNode>(Transform2D(convertCoordinates(layer.offset)), m_layerSceneNode);
 			ANKER_DEFER(m_layerSceneNode = m_layerSceneNode->parent());
 
 			Vec4 color = Vec4(1);
-			if (std::string colorHtml; m_tmjReader.field("tintcolor", colorHtml)) {
-				colorFromHtml(color, colorHtml);
+			if (!layer.tintColor.empty()) {
+				colorFromHtml(color, layer.tintColor);
+			}
+			if (layer.opacity) {
+				color.w = *layer.opacity;
 			}
-			m_tmjReader.field("opacity", color.w);
 			m_colorStack.push_back(color);
 			ANKER_DEFER(m_colorStack.pop_back());
 
-			Vec2 parallax = Vec2(1);
-			m_tmjReader.field("parallaxx", parallax.x);
-			m_tmjReader.field("parallaxy", parallax.y);
-			m_parallaxStack.push_back(parallax);
+			m_parallaxStack.push_back(layer.parallax);
 			ANKER_DEFER(m_parallaxStack.pop_back());
 
 			// Dispatch
 
-			if (type == "tilelayer") {
-				status = loadTileLayer();
-			} else if (type == "objectgroup") {
+			if (layer.type == "tilelayer") {
+				ANKER_TRY(loadTileLayer(layer));
+			} else if (layer.type == "objectgroup") {
 				if (layerName.starts_with("Collision")) {
-					status = loadCollisionLayer();
+					ANKER_TRY(loadCollisionLayer(layer));
 				} else {
-					loadObjectLayer();
+					ANKER_TRY(loadObjectLayer(layer));
 				}
-			} else if (type == "group") {
-				status = loadLayers();
+			} else if (layer.type == "group") {
+				ANKER_TRY(loadLayers(layer.layers));
 			} else {
-				ANKER_ERROR("{}: Unknown layer type: {}", m_tmjIdentifier, type);
-				status = FormatError;
+				ANKER_ERROR("{}: Unknown layer type: {}", m_tmjIdentifier, layer.type);
+				return FormatError;
 			}
-		});
+		}
 
-		return status;
+		return Ok;
 	}
 
-	using TileLayerVertices = std::vector<TileLayerRenderer::Vertex>;
-
-	Status loadTileLayer()
+	Status loadTileLayer(const TmjLayer& layer)
 	{
-		std::string name;
-		m_tmjReader.field("name", name);
-
-		std::string encoding, compression;
-		m_tmjReader.field("encoding", encoding);
-		m_tmjReader.field("compression", compression);
-
-		if (encoding != "base64" || !compression.empty()) {
+		if (layer.encoding != "base64" || !layer.compression.empty()) {
 			ANKER_ERROR("{}: Not using base64 (uncompressed)", m_tmjIdentifier);
 			return FormatError;
 		}
 
-		std::string data;
-		if (!m_tmjReader.field("data", data)) {
+		if (!layer.data) {
 			ANKER_ERROR("{}: Missing data field (chunked maps are not supported yet)", m_tmjIdentifier);
 			return FormatError;
 		}
-		data = decodeBase64(data);
-
-		u32 width = 0, height = 0;
-		m_tmjReader.field("width", width);
-		m_tmjReader.field("height", height);
 
 		// We re-interpret the data buffer as buffer of TileIds.
-		std::span<const TileId> tiles = std::span(reinterpret_cast<TileId*>(data.data()), //
-		                                          data.size() / sizeof(TileId));
-		if (tiles.size() != width * height) {
+		std::span<const TileId> tiles = std::span(reinterpret_cast<const TileId*>(layer.data->data()), //
+		                                          layer.data->size() / sizeof(TileId));
+		if (tiles.size() != layer.width * layer.height) {
 			ANKER_ERROR("{}: data length does not match layer dimensions tileCount={} width={} height={}",
-			            m_tmjIdentifier, tiles.size(), width, height);
+			            m_tmjIdentifier, tiles.size(), layer.width, layer.height);
 			return FormatError;
 		}
 
-		std::vector<TileLayerVertices> verticesPerPart(m_tilesets.size());
-		loadTileLayerVertices(verticesPerPart, tiles, width);
+		std::string name(layer.name);
 
 		auto entity = m_scene.createEntity(name);
 		entity.emplace<SceneNode>(Transform2D{}, m_layerSceneNode);
 
+		auto& source = entity.emplace<TileLayerSource>(TileLayerSource{
+		    .name = name,
+		    .tiles = {tiles.begin(), tiles.end()},
+		    .width = layer.width,
+		});
+
 		auto& tileLayer = entity.emplace<TileLayer>();
 		tileLayer.color = calcColor();
 		tileLayer.parallax = calcParallax();
 
-		// Create vertex buffers and pair them with their corresponding texture.
-		for (auto [vertices, tileset] : iter::zip(verticesPerPart, m_tilesets)) {
-			if (vertices.empty()) {
+		return createTileLayerParts(tileLayer.parts, m_tilesets, source, m_assetCache.renderDevice());
+	}
+
+	Status loadObjectLayer(const TmjLayer& layer)
+	{
+		std::vector<StaticObject> staticObjects;
+
+		for (auto& object : layer.objects) {
+			// Named objects remain entities, so they can be looked up.
+			if (object.templatePath.empty() && object.name.empty() && object.gid != EmptyTile) {
+				staticObjects.push_back({.transform = objectTransform(object), .gid = object.gid & ~FlipMask});
 				continue;
 			}
 
-			GpuBuffer vertexBuffer;
-			vertexBuffer.info = {
-			    .name = "TileLayer Vertex Buffer " + name,
-			    .bindFlags = GpuBindFlag::VertexBuffer,
-			};
-			ANKER_TRY(m_assetCache.renderDevice().createBuffer(vertexBuffer, vertices));
+			// Entities are drawn in between static objects, which are split
+			// up to keep the draw order.
+			ANKER_TRY(loadStaticObjects(layer, staticObjects));
+			staticObjects.clear();
 
-			tileLayer.parts.push_back({vertexBuffer, tileset.texture});
+			if (!object.templatePath.empty()) {
+				if (object.templatePath.starts_with("entities/")) {
+					loadEntity(object);
+				} else {
+					ANKER_ERROR("{}: Tiled templates not yet supported tpl={}", m_tmjIdentifier, object.templatePath);
+				}
+			} else {
+				loadObject(object);
+			}
 		}
 
-		return Ok;
+		return loadStaticObjects(layer, staticObjects);
 	}
 
-	void loadTileLayerVertices(std::vector<TileLayerVertices>& verticesPerPart, //
-	                           std::span<const TileId> tiles, u32 width)
+	Status loadStaticObjects(const TmjLayer& layer, std::span<const StaticObject> objects)
 	{
-		for (auto [tileIndex, tile] : iter::enumerate(tiles)) {
-			if (tile == EmptyTile) {
-				continue;
-			}
-
-			// The tile number consists of a global id and flip bits.
-			const TileId gid = tile & ~FlipMask;
-
-			// From the global id, we can determine the Tileset used for this
-			// specific tile.
-			const u32 tilesetIndex = findTilesetIndex(gid);
+		if (objects.empty()) {
+			return Ok;
+		}
 
-			const Rect2 pos = Rect2(Vec2(1), {float(tileIndex % width), -float(tileIndex / width) - 1.0f});
+		std::string name(layer.name);
 
-			const Rect2 texCoordinates = m_tilesets[tilesetIndex].textureCoordinates(gid);
-			Vec2 uvTopLeft = texCoordinates.topLeft();
-			Vec2 uvTopRight = texCoordinates.topRight();
-			Vec2 uvBottomLeft = texCoordinates.bottomLeft();
-			Vec2 uvBottomRight = texCoordinates.bottomRight();
+		auto entity = m_scene.createEntity(name);
+		entity.emplace<SceneNode>(Transform2D{}, m_layerSceneNode);
 
-			if (tile & FlipVertical) {
-				std::swap(uvTopLeft, uvBottomLeft);
-				std::swap(uvTopRight, uvBottomRight);
-			}
-			if (tile & FlipHorizontal) {
-				std::swap(uvTopLeft, uvTopRight);
-				std::swap(uvBottomLeft, uvBottomRight);
-			}
-			if (tile & FlipDiagonal) {
-				std::swap(uvTopRight, uvBottomLeft);
-			}
+		auto& source = entity.emplace<StaticObjectsSource>(StaticObjectsSource{
+		    .name = name,
+		    .objects = {objects.begin(), objects.end()},
+		    .tileSize = m_tileSize,
+		});
 
-			verticesPerPart[tilesetIndex].insert(
-			    verticesPerPart[tilesetIndex].end(),
-			    {
-			        TileLayerRenderer::Vertex{.position = pos.topLeftWorld(), .uv = uvTopLeft},
-			        TileLayerRenderer::Vertex{.position = pos.bottomLeftWorld(), .uv = uvBottomLeft},
-			        TileLayerRenderer::Vertex{.position = pos.topRightWorld(), .uv = uvTopRight},
-			        TileLayerRenderer::Vertex{.position = pos.topRightWorld(), .uv = uvTopRight},
-			        TileLayerRenderer::Vertex{.position = pos.bottomLeftWorld(), .uv = uvBottomLeft},
-			        TileLayerRenderer::Vertex{.position = pos.bottomRightWorld(), .uv = uvBottomRight},
-			    });
-		}
-	}
+		auto& tileLayer = entity.emplace<TileLayer>();
+		tileLayer.color = calcColor();
+		tileLayer.parallax = calcParallax();
 
-	void loadObjectLayer()
-	{
-		m_tmjReader.forEach("objects", [&](u32) {
-			if (std::string tpl; m_tmjReader.field("template", tpl)) {
-				if (tpl.starts_with("entities/")) {
-					loadEntity(tpl);
-				} else {
-					ANKER_ERROR("{}: Tiled templates not yet supported tpl={}", m_tmjIdentifier, tpl);
-				}
-			} else {
-				loadObject();
-			}
-		});
+		return createStaticObjectParts(tileLayer.parts, m_tilesets, source, m_assetCache.renderDevice());
 	}
 
-	void loadEntity(std::string_view tpl)
+	void loadEntity(const TmjObject& object)
 	{
-		Vec2 position;
-		m_tmjReader.field("x", position.x);
-		m_tmjReader.field("y", position.y);
+		Vec2 position = object.position;
 		position.x += m_tileSize / 2.0f;
 		position.y -= m_tileSize / 2.0f;
 		position = convertCoordinates(position);
 
-		if (tpl.ends_with("/player.tj")) {
+		if (object.templatePath.ends_with("/player.tj")) {
 			spawnPlayer(m_scene, position, m_layerSceneNode);
 		} else {
-			ANKER_ERROR("{}: Unknown entity: {}", m_tmjIdentifier, tpl);
+			ANKER_ERROR("{}: Unknown entity: {}", m_tmjIdentifier, object.templatePath);
 		}
 	}
 
-	void loadObject()
+	// Transform of a tile object's Sprite, flips are applied via scale.
+	Transform2D objectTransform(const TmjObject& object) const
 	{
-		std::string objectName;
-		m_tmjReader.field("name", objectName);
-
 		Transform2D transform;
-		m_tmjReader.field("rotation", transform.rotation);
-		transform.rotation = -transform.rotation * Deg2Rad;
-		m_tmjReader.field("width", transform.scale.x);
-		m_tmjReader.field("height", transform.scale.y);
-		transform.scale /= m_tileSize; // pixel -> meter
+		transform.rotation = -object.rotation * Deg2Rad;
+		transform.scale = object.size / m_tileSize; // pixel -> meter
 
 		// Rotation pivot in Tiled is the bottom left corner of an object.
 		// However, our rotation pivot is the object's center.
 		transform.position = transform.scale / 2.0f;
 		transform.position.rotate(transform.rotation);
+		transform.position += convertCoordinates(object.position);
 
-		Vec2 offset;
-		m_tmjReader.field("x", offset.x);
-		m_tmjReader.field("y", offset.y);
-		transform.position += convertCoordinates(offset);
+		if (object.gid & FlipHorizontal) {
+			transform.scale.x *= -1.0f;
+		}
+		if (object.gid & FlipVertical) {
+			transform.scale.y *= -1.0f;
+		}
+
+		return transform;
+	}
 
-		TileId tile = 0;
-		m_tmjReader.field("gid", tile);
+	void loadObject(const TmjObject& object)
+	{
+		const TileId tile = object.gid;
 		ANKER_CHECK(tile != 0); // TODO
 
 		// The tile number consists of a global id and flip bits.
 		const TileId gid = tile & ~FlipMask;
 
-		if (tile & FlipHorizontal) {
-			transform.scale.x *= -1.0f;
-		}
-		if (tile & FlipVertical) {
-			transform.scale.y *= -1.0f;
-		}
+		const Transform2D transform = objectTransform(object);
 
-		const auto& tileset = m_tilesets[findTilesetIndex(gid)];
+		const auto& tileset = m_tilesets[findTilesetIndex(m_tilesets, gid)];
 
-		auto entity = m_scene.createEntity(objectName);
+		auto entity = m_scene.createEntity(object.name);
 		entity.emplace<SceneNode>(transform, m_layerSceneNode);
 		entity.emplace<Sprite>(Sprite{
 		    .color = calcColor(),
@@ -434,36 +959,29 @@ class TmjLoader {
 		});
 	}
 
-	Status loadCollisionLayer()
+	Status loadCollisionLayer(const TmjLayer& layer)
 	{
-		bool platforms = false;
-		if (std::string layerName; m_tmjReader.field("name", layerName) && layerName.ends_with("Platforms")) {
-			platforms = true;
-		}
-
-		int id = 0;
-		m_tmjReader.field("id", id);
+		const bool platforms = layer.name.ends_with("Platforms");
+		const int id = layer.id;
 
-		m_tmjReader.forEach("objects", [&](u32) {
-			if (m_tmjReader.hasKey("ellipse")) {
+		for (auto& object : layer.objects) {
+			if (object.ellipse) {
 				ANKER_WARN("{}: Ellipse collider not supported. id={}", m_tmjIdentifier, id);
-				return;
+				continue;
 			}
-			if (m_tmjReader.hasKey("point")) {
+			if (object.point) {
 				ANKER_WARN("{}: Point collider not supported. id={}", m_tmjIdentifier, id);
-				return;
+				continue;
 			}
-			if (float rotation; m_tmjReader.field("rotation", rotation) && rotation != 0) {
+			if (object.rotation != 0) {
 				ANKER_WARN("{}: Collider rotation not supported. id={}", m_tmjIdentifier, id);
-				return;
+				continue;
 			}
 
 			auto entity = m_scene.createEntity("Collider");
 
 			Transform2D transform;
-			m_tmjReader.field("x", transform.position.x);
-			m_tmjReader.field("y", transform.position.y);
-			transform.position = convertCoordinates(transform.position);
+			transform.position = convertCoordinates(object.position);
 
 			entity.emplace<SceneNode>(transform, m_layerSceneNode);
 
@@ -472,28 +990,25 @@ class TmjLoader {
 
 			b2Fixture* fixture = nullptr;
 
-			if (m_tmjReader.hasKey("polygon")) {
+			if (object.polygon) {
 				std::vector<b2Vec2> vertices;
-				m_tmjReader.forEach("polygon", [&](u32) {
-					Vec2 vertex;
-					m_tmjReader.field("x", vertex.x);
-					m_tmjReader.field("y", vertex.y);
+				for (Vec2 vertex : *object.polygon) {
 					vertices.push_back(convertCoordinates(vertex));
-				});
+				}
 
 				b2ChainShape shape;
 				shape.CreateLoop(vertices.data(), int32(vertices.size()));
 
 				fixture = physicsBody->CreateFixture(&shape, 0);
-			} else if (m_tmjReader.hasKey("polyline")) {
+			} else if (object.polyline) {
 				std::vector<b2Vec2> vertices;
-				m_tmjReader.forEach("polyline", [&](u32) {
-					Vec2 vertex;
-					m_tmjReader.field("x", vertex.x);
-					m_tmjReader.field("y", vertex.y);
+				for (Vec2 vertex : *object.polyline) {
 					vertices.push_back(convertCoordinates(vertex));
-				});
-				ANKER_CHECK(vertices.size() >= 2);
+				}
+				if (vertices.size() < 2) {
+					ANKER_ERROR("{}: Polyline collider requires at least 2 vertices. id={}", m_tmjIdentifier, id);
+					continue;
+				}
 
 				// ghost vertices
 				Vec2 prev = *vertices.begin() + (*(vertices.begin() + 1) - *vertices.begin());
@@ -504,13 +1019,11 @@ class TmjLoader {
 
 				fixture = physicsBody->CreateFixture(&shape, 0);
 			} else {
-				Vec2 boxSize;
-				m_tmjReader.field("width", boxSize.x);
-				m_tmjReader.field("height", boxSize.y);
+				Vec2 boxSize = object.size;
 
 				if (boxSize.x == 0 && boxSize.y == 0) {
 					ANKER_ERROR("{}: Invalid size for collider. id={}", m_tmjIdentifier, id);
-					return;
+					continue;
 				}
 
 				std::vector<b2Vec2> vertices;
@@ -527,7 +1040,7 @@ class TmjLoader {
 
 			if (!fixture) {
 				ANKER_ERROR("{}: Could not create fixture for collider. id={}", m_tmjIdentifier, id);
-				return;
+				continue;
 			}
 
 			b2Filter filter;
@@ -536,19 +1049,11 @@ class TmjLoader {
 				filter.categoryBits = PhysicsLayers::MapPlatforms;
 			}
 			fixture->SetFilterData(filter);
-		});
+		}
 
 		return Ok;
 	}
 
-	// Given a global id (without flip bits), this function returns the index of
-	// the corresponding Tileset.
-	u32 findTilesetIndex(u32 gid) const
-	{
-		auto iter = std::ranges::find_if(m_tilesets, [=](auto& tileset) { return gid >= tileset.firstTileId; });
-		return u32(std::distance(m_tilesets.begin(), iter));
-	}
-
 	Vec2 convertCoordinates(Vec2 v) const
 	{
 		v /= m_tileSize; // pixel -> meter
@@ -568,24 +1073,24 @@ class TmjLoader {
 
 	////////////////////////////////////////////////////////////
 
-	Status loadProperties()
+	Status loadProperties(std::span<const TmjProperty> properties)
 	{
 		Status status;
-		m_tmjReader.forEach("properties", [&](uint32_t) {
-			std::string name;
-			if (!m_tmjReader.field("name", name)) {
-				return;
+		for (auto& property : properties) {
+			if (property.name.empty()) {
+				continue;
 			}
 
-			if (name == "backgroundMusic") {
-				if (std::string identifier; m_tmjReader.field("value", identifier) && !identifier.empty()) {
-					m_scene.backgroundMusic = m_assetCache.loadAudioStream(identifier);
+			if (property.name == "backgroundMusic") {
+				if (!property.value.empty()) {
+					m_scene.backgroundMusic =
+					    m_assetCache.pin(m_scene.assetPins, m_assetCache.loadAudioStream(AssetId(property.value)));
 				}
 			} else {
-				ANKER_ERROR("{}: Unknown property: {}", m_tmjIdentifier, name);
+				ANKER_ERROR("{}: Unknown property: {}", m_tmjIdentifier, property.name);
 				status = FormatError;
 			}
-		});
+		}
 		return status;
 	}
 
@@ -595,8 +1100,6 @@ class TmjLoader {
 	AssetCache& m_assetCache;
 	std::string_view m_tmjIdentifier;
 
-	JsonReader m_tmjReader;
-
 	std::vector<Tileset> m_tilesets;
 
 	// While traversing the tree of layers we build a corresponding scene graph.
@@ -610,11 +1113,97 @@ class TmjLoader {
 	std::vector<Vec4> m_colorStack;
 };
 
+////////////////////////////////////////////////////////////
+// Hot Reload
+//
+// A modified .tsj file only rebuilds the tile layers and static objects using
+// the Tileset, in every loaded scene. A modified .tmj file reloads the whole
+// map, like the editor does.
+
+static void reloadSceneTileset(Scene& scene, AssetId id)
+{
+	auto* mapTilesets = scene.registry.ctx().find<MapTilesets>();
+	if (!mapTilesets) {
+		return;
+	}
+
+	auto& tilesets = mapTilesets->tilesets;
+	auto it = std::ranges::find_if(tilesets, [&](auto& tileset) { return toAssetId(tileset.filepath) == id; });
+	if (it == tilesets.end()) {
+		return;
+	}
+
+	// The previous Tileset is kept when loading fails.
+	Tileset tileset = *it;
+	if (not loadTileset(tileset, tileset.filepath, scene, g_engine->assetCache)) {
+		return;
+	}
+	*it = std::move(tileset);
+
+	u32 tilesetIndex = u32(std::distance(tilesets.begin(), it));
+
+	for (auto [entity, tileLayer, source] : scene.registry.view<TileLayer, TileLayerSource>().each()) {
+		bool usesTileset = std::ranges::any_of(source.tiles, [&](TileId tile) {
+			return tile != EmptyTile && findTilesetIndex(tilesets, tile & ~FlipMask) == tilesetIndex;
+		});
+		if (!usesTileset) {
+			continue;
+		}
+
+		std::vector<TileLayerPart> parts;
+		if (createTileLayerParts(parts, tilesets, source, g_engine->renderDevice)) {
+			// Patched, so the spatial index picks up the new parts.
+			scene.registry.patch<TileLayer>(entity, [&](TileLayer& layer) { layer.parts = std::move(parts); });
+		}
+	}
+
+	for (auto [entity, tileLayer, source] : scene.registry.view<TileLayer, StaticObjectsSource>().each()) {
+		bool usesTileset = std::ranges::any_of(source.objects, [&](const StaticObject& object) {
+			return findTilesetIndex(tilesets, object.gid) == tilesetIndex;
+		});
+		if (!usesTileset) {
+			continue;
+		}
+
+		std::vector<TileLayerPart> parts;
+		if (createStaticObjectParts(parts, tilesets, source, g_engine->renderDevice)) {
+			// Patched, so the spatial index picks up the new parts.
+			scene.registry.patch<TileLayer>(entity, [&](TileLayer& layer) { layer.parts = std::move(parts); });
+		}
+	}
+}
+
+static void reloadTileset(AssetId id)
+{
+	for (auto& scene : g_engine->scenes()) {
+		reloadSceneTileset(*scene, id);
+	}
+}
+
+static void reloadMap(AssetId id)
+{
+	auto& scene = g_engine->activeScene;
+	if (!scene) {
+		return;
+	}
+
+	auto* mapIdentifier = scene->registry.ctx().find<MapIdentifier>();
+	if (mapIdentifier && AssetId(mapIdentifier->identifier) == id) {
+		g_engine->nextScene = loadMap(id.str());
+	}
+}
+
+////////////////////////////////////////////////////////////
+
 Status addMapToScene(Scene& scene, std::string_view identifier)
 {
 	ANKER_PROFILE_ZONE_T(identifier);
 
+	g_engine->assetCache.setReloadHandler<Tileset>(reloadTileset);
+	g_engine->assetCache.setReloadHandler<MapIdentifier>(reloadMap);
+
 	scene.registry.ctx().emplace<MapIdentifier>(std::string{identifier});
+	scene.registry.ctx().emplace<MapDependencyNodes>(g_engine->assetCache.dependencyGraph());
 
 	TmjLoader loader(scene, g_engine->assetCache);
 	return loader.load(identifier);
@@ -624,7 +1213,16 @@ ScenePtr loadMap(std::string_view mapIdentifier)
 {
 	ScenePtr scene = g_engine->createScene();
 
-	if (not addMapToScene(*scene, mapIdentifier)) {
+	AssetManifest manifest;
+	bool loaded = false;
+	{
+		AssetManifestRecorder manifestRecorder(g_engine->assetCache, manifest);
+		loaded = bool(addMapToScene(*scene, mapIdentifier));
+	}
+
+	if (loaded) {
+		storeAssetManifest(manifest, mapIdentifier);
+	} else {
 		ANKER_ERROR("Failed to load map: {}", mapIdentifier);
 	}
 
@@ -644,4 +1242,19 @@ ScenePtr loadMap(std::string_view mapIdentifier)
 	return scene;
 }
 
+void prefetchMap(std::string_view mapIdentifier)
+{
+	ANKER_PROFILE_ZONE_T(mapIdentifier);
+
+	AssetManifest manifest;
+	if (not loadAssetManifest(manifest, mapIdentifier)) {
+		g_assetDataLoader.prefetch(std::string{mapIdentifier} + ".tmj");
+		return;
+	}
+
+	ANKER_INFO("Prefetching {}: {} assets, {} files, {} KiB", mapIdentifier, manifest.assets.size(),
+	           manifest.files.size(), manifest.totalBytes() / 1024);
+	g_engine->assetCache.prefetch(manifest);
+}
+
 } // namespace Anker
@@ -14,7 +14,15 @@ struct MapIdentifier {
 // scene. Also sets MapIdentifier.
 Status addMapToScene(Scene&, std::string_view identifier);
 
-// Creates a new scene with map data added.
+// Creates a new scene with map data added. The assets used by the map are
+// recorded in a manifest for prefetchMap.
 ScenePtr loadMap(std::string_view mapIdentifier);
 
+// Reads the files and loads the assets of the given map in the background, so
+// a subsequent loadMap finds everything resident. Use this ahead of a map
+// transition, e.g. when the player approaches a door. Only maps which have
+// been loaded before have a manifest; otherwise, only the map file itself is
+// prefetched.
+void prefetchMap(std::string_view mapIdentifier);
+
 } // namespace Anker
@@ -15,12 +15,17 @@ using PlayerTag = entt::tag<"Player"_hs>;
 
 inline EntityHandle spawnPlayer(Scene& scene, Vec2 position, SceneNode* parent = nullptr)
 {
+	auto& assetCache = g_engine->assetCache;
+
 	EntityHandle player = scene.createEntity("Player");
 	player.emplace<PlayerTag>();
 	player.emplace<SceneNode>(Transform2D(position), parent);
+
+	auto texture = assetCache.loadSpriteTexture("textures/player"_hs);
 	player.emplace<Sprite>(Sprite{
 	    .offset = {-0.5f, -0.5f},
-	    .texture = g_engine->assetCache.loadTexture("textures/player"),
+	    .texture = assetCache.pin(scene.assetPins, texture.texture),
+	    .textureRect = texture.rect,
 	});
 
 	{
@@ -7,7 +7,9 @@
 
 namespace Anker {
 
-PlayerController::PlayerController() : m_bonk(g_engine->assetCache.loadAudioTrack("sounds/bonk")) {}
+PlayerController::PlayerController()
+    : m_bonk(g_engine->assetCache.pin(m_assetPins, g_engine->assetCache.loadAudioTrack("sounds/bonk"_hs)))
+{}
 
 void PlayerController::tick(float dt, Scene& scene)
 {
@@ -197,4 +199,37 @@ void PlayerController::tickFalling(float dt)
 	}
 }
 
+void serialize(BinaryWriter& write, const PlayerController& controller)
+{
+	write(controller.moveParam);
+	write(controller.m_isGrounded);
+	write(controller.m_jumpsLeft);
+	write(controller.m_coyoteTimeLeft);
+	write(controller.m_dashesLeft);
+	write(controller.m_dashTimeLeft);
+	write(controller.m_dashCooldownLeft);
+	write(controller.m_dashBackwards);
+	write(controller.m_dashDirection);
+	write(controller.m_dropThroughTimeLeft);
+	write(controller.m_velocity);
+	write(controller.m_lookDirection);
+}
+
+bool serialize(BinaryReader& read, PlayerController& controller)
+{
+	ANKER_TRY(read(controller.moveParam));
+	ANKER_TRY(read(controller.m_isGrounded));
+	ANKER_TRY(read(controller.m_jumpsLeft));
+	ANKER_TRY(read(controller.m_coyoteTimeLeft));
+	ANKER_TRY(read(controller.m_dashesLeft));
+	ANKER_TRY(read(controller.m_dashTimeLeft));
+	ANKER_TRY(read(controller.m_dashCooldownLeft));
+	ANKER_TRY(read(controller.m_dashBackwards));
+	ANKER_TRY(read(controller.m_dashDirection));
+	ANKER_TRY(read(controller.m_dropThroughTimeLeft));
+	ANKER_TRY(read(controller.m_velocity));
+	ANKER_TRY(read(controller.m_lookDirection));
+	return true;
+}
+
 } // namespace Anker
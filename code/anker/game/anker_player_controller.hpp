@@ -51,9 +51,18 @@ class PlayerController {
 	Vec2 m_velocity;
 	Vec2 m_lookDirection = Vec2::WorldRight;
 
-	AssetPtr<AudioTrack> m_bonk;
+	AssetPins m_assetPins;
+	AssetHandle<AudioTrack> m_bonk;
+
+	friend void serialize(BinaryWriter&, const PlayerController&);
+	friend bool serialize(BinaryReader&, PlayerController&);
 };
 
+// Binary serialization includes the internal movement state, used by scene
+// snapshots.
+void serialize(BinaryWriter&, const PlayerController&);
+bool serialize(BinaryReader&, PlayerController&);
+
 inline bool serialize(InspectorWidgetDrawer draw, PlayerController& controller)
 {
 	ImGui::Text("Velocity %f %f", controller.velocity().x, controller.velocity().y);
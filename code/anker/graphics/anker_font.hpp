@@ -1,53 +1,57 @@
 #pragma once
 
-#include <anker/graphics/anker_render_device.hpp>
-
 namespace Anker {
 
+// Font file together with its stb_truetype state, see FontSystem.
+struct FontData;
+
+// A Font does not contain any rasterized glyphs. Glyphs are rasterized on
+// demand, for the requested size, by the FontSystem.
 class Font {
   public:
-	struct CharData {
-		Rect2 texRect;      // Glyph location in texture
-		Rect2 visRect;      // Glyph offset for rendering
-		float xAdvance = 0; // Horizontal offset to the next character
-	};
-
-	const CharData& charData(char c) const
-	{
-		if (!inRange(c)) {
-			c = ' ';
-		}
-		return m_charData[c - CharStart];
-	}
-
-	float kern(char a, char b) const
+	// Horizontal offset between the 2 glyphs, in pixels.
+	float kern(u32 glyphA, u32 glyphB, float pixelSize) const
 	{
-		if (inRange(a) && inRange(b)) {
-			return m_scale * m_kerningTable[(a - CharStart) * CharCount + (b - CharStart)];
+		const u32 glyphs = glyphA << 16 | glyphB;
+		auto it = std::ranges::lower_bound(m_kerningTable, glyphs, {}, &KerningPair::glyphs);
+		if (it != m_kerningTable.end() && it->glyphs == glyphs) {
+			return scale(pixelSize) * float(it->advance);
 		} else {
 			return 0;
 		}
 	}
 
-	float scale() const { return m_scale; }
+	// Conversion factor from font units to pixels.
+	float scale(float pixelSize) const { return pixelSize * m_scale; }
+
+	// Distance between consecutive baselines, in pixels.
+	float lineHeight(float pixelSize) const { return scale(pixelSize) * m_lineHeight; }
 
-	const Texture& texture() const { return m_texture; }
+	u32 id() const { return m_id; }
+
+	usize byteSize() const { return m_fileSize + m_kerningTable.size() * sizeof(KerningPair); }
 
   private:
-	// We only support the 96 printable ASCII characters for now, starting with
-	// SPACE at char 32.
-	static constexpr unsigned CharStart = 32;
-	static constexpr unsigned CharEnd = 128;
-	static constexpr unsigned CharCount = CharEnd - CharStart;
-	static bool inRange(int c) { return CharStart <= c && c <= CharEnd; }
+	struct KerningPair {
+		u32 glyphs = 0; // First glyph index in the upper 16 bits
+		i32 advance = 0;
+	};
 
-	std::array<CharData, CharCount> m_charData{};
+	// Shared among copies; missing fonts are replaced by a copy of the system
+	// font.
+	std::shared_ptr<const FontData> m_data;
+	usize m_fileSize = 0;
 
-	std::array<int, CharCount * CharCount> m_kerningTable{};
+	// Only pairs with a kerning value are stored, sorted by glyphs.
+	std::vector<KerningPair> m_kerningTable;
 
+	// Font units to pixels, for a pixel size of 1.
 	float m_scale = 0;
 
-	Texture m_texture;
+	// In font units, includes the line gap.
+	float m_lineHeight = 0;
+
+	u32 m_id = 0;
 
 	friend class FontSystem;
 };
@@ -1,100 +1,329 @@
 #include <anker/graphics/anker_font_system.hpp>
 
-#include <stb_rect_pack.h>
 #include <stb_truetype.h>
 
+#include <anker/common/anker_worker_pool.hpp>
 #include <anker/core/anker_data_loader.hpp>
+#include <anker/core/anker_derived_data_cache.hpp>
 #include <anker/graphics/anker_render_device.hpp>
 
 namespace Anker {
 
-FontSystem::FontSystem(RenderDevice& renderDevice) : m_renderDevice(renderDevice)
+struct FontData {
+	ByteBuffer file;
+	stbtt_fontinfo info{};
+};
+
+// Glyph pages are small, memory is expected to scale with the glyphs in use,
+// not with the size of the font.
+const Vec2u GlyphPageSize = {512, 512};
+const u32 GlyphPageBudget = 4;
+
+// Larger glyphs would occupy a significant part of a page.
+const u32 MaxGlyphPixelSize = 256;
+
+// SDF glyphs serve all sizes, a single page typically suffices.
+const u32 SdfGlyphPageBudget = 2;
+
+// Distance field parameters, see stbtt_GetGlyphSDF. The field extends 4 pixels
+// beyond the outline, the outline itself is at 0.5.
+const int SdfPadding = 4;
+const u8 SdfOnEdge = 128;
+const float SdfPixelDistanceScale = float(SdfOnEdge) / float(SdfPadding);
+
+// Increment when the output of generateSdfGlyphs changes, this invalidates the
+// derived data of all fonts.
+const u32 SdfDecoderVersion = 1;
+
+FontSystem::FontSystem(RenderDevice& renderDevice)
+    : m_renderDevice(renderDevice),
+      m_glyphCache(renderDevice, GlyphPageSize, GlyphPageBudget),
+      m_sdfGlyphCache(renderDevice, GlyphPageSize, SdfGlyphPageBudget)
 {
 	if (not loadFont(m_systemFont, "fonts/Roboto")) {
 		ANKER_FATAL("Failed to load system font");
 	}
 }
 
-Status FontSystem::loadFontFromTTF(Font& font, std::span<const u8> fontData)
+Status FontSystem::loadFontFromTTF(Font& font, ByteBuffer&& fontData)
 {
-	stbtt_fontinfo info;
-	if (!stbtt_InitFont(&info, fontData.data(), 0)) {
+	auto data = std::make_shared<FontData>();
+	data->file = std::move(fontData);
+
+	if (!stbtt_InitFont(&data->info, data->file.data(), 0)) {
 		ANKER_ERROR("stbtt_InitFont failed");
 		return FontError;
 	}
 
-	const float fontHeight = 32;
-	font.m_scale = stbtt_ScaleForPixelHeight(&info, fontHeight);
+	font.m_scale = stbtt_ScaleForPixelHeight(&data->info, 1);
+
+	int ascent = 0, descent = 0, lineGap = 0;
+	stbtt_GetFontVMetrics(&data->info, &ascent, &descent, &lineGap);
+	font.m_lineHeight = float(ascent - descent + lineGap);
+
+	// Kerning tables are sparse, only pairs listed by the font are stored.
+	font.m_kerningTable.clear();
+	if (data->info.kern) {
+		std::vector<stbtt_kerningentry> entries(usize(stbtt_GetKerningTableLength(&data->info)));
+		stbtt_GetKerningTable(&data->info, entries.data(), int(entries.size()));
+
+		font.m_kerningTable.reserve(entries.size());
+		for (auto& entry : entries) {
+			if (entry.advance != 0) {
+				font.m_kerningTable.push_back({
+				    .glyphs = u32(entry.glyph1) << 16 | u32(entry.glyph2),
+				    .advance = entry.advance,
+				});
+			}
+		}
+
+		std::ranges::sort(font.m_kerningTable, {}, &Font::KerningPair::glyphs);
+	}
+
+	// Reloaded fonts get a new id, glyphs of the previous version are evicted
+	// from the glyph cache eventually.
+	font.m_fileSize = data->file.size();
+	font.m_data = std::move(data);
+	font.m_id = m_nextFontId++;
+
+	return Ok;
+}
+
+Status FontSystem::loadFont(Font& font, std::string_view identifier)
+{
+	ANKER_PROFILE_ZONE_T(identifier);
+
+	ByteBuffer fontData;
+	if (g_assetDataLoader.load(fontData, std::string{identifier} + ".ttf")) {
+		if (loadFontFromTTF(font, std::move(fontData))) {
+			return Ok;
+		}
+	}
+
+	return ReadError;
+}
+
+////////////////////////////////////////////////////////////
+
+struct RasterizedGlyph {
+	Glyph glyph;
+	Vec2u size;
+	std::vector<u8> bitmap;
+};
+
+static RasterizedGlyph rasterizeGlyph(const stbtt_fontinfo& info, float scale, char32_t codepoint, GlyphMode mode)
+{
+	const int index = stbtt_FindGlyphIndex(&info, int(codepoint));
+
+	int advance = 0;
+	stbtt_GetGlyphHMetrics(&info, index, &advance, nullptr);
 
-	const Vec2u texSize = font.m_texture.info.size;
+	RasterizedGlyph result;
+	result.glyph.xAdvance = scale * float(advance);
+	result.glyph.index = u32(index);
 
-	std::vector<u8> bitmap(texSize.x * texSize.y);
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
 
-	// Render glyphs to bitmap and populate the font's charData.
-	{
-		stbtt_pack_context packContext;
-		if (!stbtt_PackBegin(&packContext, bitmap.data(), texSize.x, texSize.y, 0, 8, nullptr)) {
-			ANKER_ERROR("stbtt_PackBegin failed");
-			return FontError;
+	if (mode == GlyphMode::Sdf) {
+		// Returns nullptr for glyphs without outline, e.g. SPACE.
+		int width = 0, height = 0;
+		u8* sdf = stbtt_GetGlyphSDF(&info, scale, index, SdfPadding, SdfOnEdge, SdfPixelDistanceScale, //
+		                            &width, &height, &x0, &y0);
+		if (sdf) {
+			x1 = x0 + width;
+			y1 = y0 + height;
+			result.bitmap.assign(sdf, sdf + usize(width) * usize(height));
+			stbtt_FreeSDF(sdf, nullptr);
+		}
+	} else {
+		stbtt_GetGlyphBitmapBox(&info, index, scale, scale, &x0, &y0, &x1, &y1);
+		result.bitmap.resize(usize(std::max(x1 - x0, 0)) * usize(std::max(y1 - y0, 0)));
+		if (!result.bitmap.empty()) {
+			stbtt_MakeGlyphBitmap(&info, result.bitmap.data(), x1 - x0, y1 - y0, x1 - x0, scale, scale, index);
 		}
+	}
+
+	if (!result.bitmap.empty()) {
+		result.size = Vec2u(u32(x1 - x0), u32(y1 - y0));
+		result.glyph.visRect = Rect2::fromPoints(Vec2(float(x0), float(-y0)), Vec2(float(x1), float(-y1)));
+	}
+
+	return result;
+}
+
+static std::vector<RasterizedGlyph> generateSdfGlyphs(const stbtt_fontinfo& info, float scale,
+                                                      std::span<const char32_t> codepoints)
+{
+	ANKER_PROFILE_ZONE();
 
-		std::vector<stbtt_packedchar> charData(font.m_charData.size());
+	std::vector<RasterizedGlyph> glyphs(codepoints.size());
+	g_workerPool.parallelFor(codepoints.size(), [&](usize i) {
+		glyphs[i] = rasterizeGlyph(info, scale, codepoints[i], GlyphMode::Sdf);
+	});
+	return glyphs;
+}
 
-		stbtt_PackSetOversampling(&packContext, 2, 2);
+// Serialized form of an SDF glyph in derived data, followed by the bitmaps of
+// all glyphs.
+struct SdfGlyphRecord {
+	char32_t codepoint = 0;
+	Vec2u size;
+	Rect2 visRect;
+	float xAdvance = 0;
+	u32 index = 0;
+};
 
-		stbtt_PackFontRange(&packContext, fontData.data(), //
-		                    0, fontHeight, font.CharStart, //
-		                    int(charData.size()), charData.data());
+static std::optional<std::vector<RasterizedGlyph>> readSdfGlyphs(std::span<const u8> derivedData,
+                                                                 std::span<const char32_t> codepoints)
+{
+	BinaryReader read(derivedData);
 
-		stbtt_PackEnd(&packContext);
+	std::vector<SdfGlyphRecord> records;
+	std::span<const u8> bitmaps;
+	if (!read(records) || !read(bitmaps) || records.size() != codepoints.size()) {
+		return std::nullopt;
+	}
 
-		std::ranges::transform(charData, font.m_charData.begin(), [&](auto& c) {
-			return Font::CharData{
-			    .texRect = Rect2::fromPoints(Vec2(c.x0, c.y0) / Vec2(texSize), //
-			                                 Vec2(c.x1, c.y1) / Vec2(texSize)),
-			    .visRect = Rect2::fromPoints({c.xoff, -c.yoff}, {c.xoff2, -c.yoff2}),
-			    .xAdvance = c.xadvance,
-			};
+	std::vector<RasterizedGlyph> glyphs;
+	glyphs.reserve(records.size());
+
+	usize offset = 0;
+	for (auto [record, codepoint] : iter::zip(records, codepoints)) {
+		const usize size = usize(record.size.x) * record.size.y;
+		if (record.codepoint != codepoint || size > bitmaps.size() - offset) {
+			return std::nullopt;
+		}
+
+		const auto bitmap = bitmaps.subspan(offset, size);
+		glyphs.push_back({
+		    .glyph = {.texRect = {}, .visRect = record.visRect, .xAdvance = record.xAdvance, .index = record.index},
+		    .size = record.size,
+		    .bitmap = {bitmap.begin(), bitmap.end()},
+		});
+		offset += size;
+	}
+
+	return glyphs;
+}
+
+static void writeSdfGlyphs(BinaryWriter& write, std::span<const char32_t> codepoints,
+                           std::span<const RasterizedGlyph> glyphs)
+{
+	std::vector<SdfGlyphRecord> records;
+	ByteBuffer bitmaps;
+	for (auto [codepoint, glyph] : iter::zip(codepoints, glyphs)) {
+		records.push_back({
+		    .codepoint = codepoint,
+		    .size = glyph.size,
+		    .visRect = glyph.glyph.visRect,
+		    .xAdvance = glyph.glyph.xAdvance,
+		    .index = glyph.glyph.index,
 		});
+		bitmaps.insert(bitmaps.end(), glyph.bitmap.begin(), glyph.bitmap.end());
 	}
 
-	font.m_texture.info.format = TextureFormat::R8_UNORM;
-	font.m_texture.info.bindFlags = GpuBindFlag::Shader;
-	std::array texInit = {TextureInit{.data = bitmap.data(), .rowPitch = texSize.x}};
-	ANKER_TRY(m_renderDevice.createTexture(font.m_texture, texInit));
+	write(records);
+	write(std::span<const u8>(bitmaps));
+}
 
-	// We copy over the kerning table so the can release the loaded font data.
-	if (info.kern) {
-		std::vector<stbtt_kerningentry> entries(stbtt_GetKerningTableLength(&info));
-		stbtt_GetKerningTable(&info, entries.data(), int(entries.size()));
+////////////////////////////////////////////////////////////
 
-		for (auto& entry : entries) {
-			if (font.inRange(entry.glyph1) && font.inRange(entry.glyph2)) {
-				auto index1 = entry.glyph1 - font.CharStart;
-				auto index2 = entry.glyph2 - font.CharStart;
-				font.m_kerningTable[index1 * font.CharCount + index2] = entry.advance;
-			}
+const Glyph& FontSystem::glyph(const Font& font, char32_t codepoint, u32 pixelSize, GlyphMode mode)
+{
+	static const Glyph EmptyGlyph = {.texRect = {}, .visRect = {}, .page = GlyphCache::NoPage};
+	ANKER_CHECK(font.m_data, EmptyGlyph);
+
+	if (mode == GlyphMode::Sdf) {
+		loadSdfCharset(font);
+		pixelSize = SdfPixelSize;
+	} else {
+		pixelSize = std::clamp(pixelSize, 1u, MaxGlyphPixelSize);
+	}
+
+	auto& glyphCache = this->glyphCache(mode);
+
+	const u64 key = GlyphCache::key(font.m_id, pixelSize, codepoint);
+	if (auto* glyph = glyphCache.find(key)) {
+		return *glyph;
+	}
+
+	ANKER_PROFILE_ZONE();
+
+	auto rasterized = rasterizeGlyph(font.m_data->info, font.scale(float(pixelSize)), codepoint, mode);
+	return glyphCache.insert(key, rasterized.glyph, rasterized.size, rasterized.bitmap);
+}
+
+void FontSystem::prepareSdfGlyphs(const Font& font, std::span<const char32_t> codepoints)
+{
+	ANKER_CHECK(font.m_data);
+
+	loadSdfCharset(font);
+
+	std::vector<char32_t> missing;
+	for (char32_t codepoint : codepoints) {
+		if (!m_sdfGlyphCache.find(GlyphCache::key(font.m_id, SdfPixelSize, codepoint))) {
+			missing.push_back(codepoint);
 		}
 	}
 
-	return Ok;
+	std::ranges::sort(missing);
+	missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+	if (missing.empty()) {
+		return;
+	}
+
+	auto glyphs = generateSdfGlyphs(font.m_data->info, font.scale(float(SdfPixelSize)), missing);
+	for (auto [codepoint, glyph] : iter::zip(missing, glyphs)) {
+		m_sdfGlyphCache.insert(GlyphCache::key(font.m_id, SdfPixelSize, codepoint), glyph.glyph, glyph.size,
+		                       glyph.bitmap);
+	}
 }
 
-Status FontSystem::loadFont(Font& font, std::string_view identifier)
+void FontSystem::loadSdfCharset(const Font& font)
 {
-	ANKER_PROFILE_ZONE_T(identifier);
+	if (!m_sdfCharsetFonts.insert(font.m_id).second) {
+		return;
+	}
 
-	font.m_texture.info.name = identifier;
-	font.m_texture.info.size = {512, 512};
+	ANKER_PROFILE_ZONE();
 
-	ByteBuffer fontData;
-	if (g_assetDataLoader.load(fontData, std::string{identifier} + ".ttf")) {
-		if (loadFontFromTTF(font, fontData)) {
-			return Ok;
+	// Printable ASCII and Latin-1 Supplement.
+	std::vector<char32_t> codepoints;
+	for (char32_t c = 0x20; c <= 0xFF; ++c) {
+		if (c < 0x7F || c >= 0xA0) {
+			codepoints.push_back(c);
 		}
 	}
 
-	return ReadError;
+	auto derivedDataKey = DerivedDataCache::key("sdf", SdfDecoderVersion, font.m_data->file, SdfPixelSize);
+
+	std::optional<std::vector<RasterizedGlyph>> glyphs;
+	if (MappedFile derivedData; g_derivedDataCache.load(derivedData, derivedDataKey)) {
+		glyphs = readSdfGlyphs(derivedData.data(), codepoints);
+		if (!glyphs) {
+			ANKER_WARN("Invalid SDF derived data, generating again");
+		}
+	}
+
+	if (!glyphs) {
+		glyphs = generateSdfGlyphs(font.m_data->info, font.scale(float(SdfPixelSize)), codepoints);
+
+		BinaryWriter write;
+		writeSdfGlyphs(write, codepoints, *glyphs);
+		g_derivedDataCache.store(derivedDataKey, write.output());
+	}
+
+	for (auto [codepoint, glyph] : iter::zip(codepoints, *glyphs)) {
+		m_sdfGlyphCache.insert(GlyphCache::key(font.m_id, SdfPixelSize, codepoint), glyph.glyph, glyph.size,
+		                       glyph.bitmap);
+	}
+}
+
+void FontSystem::clearGlyphCaches()
+{
+	m_glyphCache.clear();
+	m_sdfGlyphCache.clear();
+	m_sdfCharsetFonts.clear();
 }
 
 } // namespace Anker
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <anker/graphics/anker_font.hpp>
+#include <anker/graphics/anker_glyph_cache.hpp>
 
 namespace Anker {
 
@@ -18,11 +19,49 @@ class FontSystem {
 
 	const Font& systemFont() const { return m_systemFont; }
 
+	// Rasterizes the glyph on first use. Codepoints missing from the font
+	// result in the font's replacement glyph. The returned reference is valid
+	// until the end of the frame.
+	//
+	// SDF glyphs are generated once at SdfPixelSize, regardless of the given
+	// pixel size, and scale to any size.
+	const Glyph& glyph(const Font&, char32_t codepoint, u32 pixelSize, GlyphMode = GlyphMode::Bitmap);
+
+	static constexpr u32 SdfPixelSize = 32;
+
+	// Generates missing SDF glyphs in parallel on the worker pool. The font's
+	// base character set (printable ASCII and Latin-1) is generated on first
+	// use and kept in the derived data cache.
+	void prepareSdfGlyphs(const Font&, std::span<const char32_t> codepoints);
+
+	GlyphCache& glyphCache(GlyphMode mode) { return mode == GlyphMode::Sdf ? m_sdfGlyphCache : m_glyphCache; }
+	const GlyphCache& glyphCache(GlyphMode mode) const
+	{
+		return mode == GlyphMode::Sdf ? m_sdfGlyphCache : m_glyphCache;
+	}
+
+	void clearGlyphCaches();
+
+	void newFrame()
+	{
+		m_glyphCache.newFrame();
+		m_sdfGlyphCache.newFrame();
+	}
+
   private:
-	Status loadFontFromTTF(Font& font, std::span<const u8> fontData);
+	Status loadFontFromTTF(Font& font, ByteBuffer&& fontData);
+	void loadSdfCharset(const Font&);
 
 	RenderDevice& m_renderDevice;
 
+	GlyphCache m_glyphCache;
+	GlyphCache m_sdfGlyphCache;
+
+	// Fonts whose SDF base character set has been loaded.
+	std::unordered_set<u32> m_sdfCharsetFonts;
+
+	u32 m_nextFontId = 1;
+
 	Font m_systemFont;
 };
 
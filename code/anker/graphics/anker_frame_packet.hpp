@@ -0,0 +1,47 @@
+#pragma once
+
+#include <anker/core/anker_imgui_system.hpp>
+#include <anker/graphics/anker_gizmo_renderer.hpp>
+#include <anker/graphics/anker_particle_renderer.hpp>
+#include <anker/graphics/anker_post_process_renderer.hpp>
+#include <anker/graphics/anker_sprite_renderer.hpp>
+#include <anker/graphics/anker_text_renderer.hpp>
+#include <anker/graphics/anker_tile_layer_renderer.hpp>
+
+namespace Anker {
+
+// A FramePacket holds everything needed to draw a frame, extracted from the
+// scene by RenderSystem::extract. Drawing it touches neither the registry nor
+// the AssetCache, hence the RenderThread can draw one packet while the next
+// frame is simulated and extracted into another.
+//
+// GPU resources are referenced via ShaderViewRef / GpuBufferRef, keeping them
+// alive in case their asset or component is destroyed before the packet has
+// been drawn. Packets are reused across frames to avoid allocations.
+struct FramePacket {
+	// The scene is only drawn with an active camera.
+	bool hasCamera = false;
+
+	Mat3 view = Mat3Id;
+	Vec2 cameraPosition;
+
+	enum class DrawKind { Sprite, TileLayer, Particles };
+	struct DrawItem {
+		DrawKind kind = DrawKind::Sprite;
+		u32 index = 0; // Into the renderer's packet
+	};
+
+	// Sprites, TileLayers, and ParticleEmitters in scene graph order.
+	std::vector<DrawItem> drawItems;
+
+	SpriteRenderer::Packet sprites;
+	TileLayerRenderer::Packet tileLayers;
+	ParticleRenderer::Packet particles;
+	TextRenderer::Packet text;
+	PostProcessRenderer::Packet postProcess;
+	GizmoRenderer::Packet gizmos;
+
+	ImguiSnapshot imgui;
+};
+
+} // namespace Anker
@@ -4,36 +4,25 @@
 
 namespace Anker {
 
-GizmoRenderer::GizmoRenderer(RenderDevice& renderDevice, AssetCache& assetCache) : m_renderDevice(renderDevice)
+GizmoRenderer::GizmoRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
 	const std::array shaderInputDescription{
-	    D3D11_INPUT_ELEMENT_DESC{
-	        .SemanticName = "POSITION",
-	        .Format = DXGI_FORMAT_R32G32_FLOAT,
-	        .AlignedByteOffset = offsetof(GizmoRenderer::Vertex, position),
-	        .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+	    VertexInput{
+	        .semantic = "POSITION",
+	        .format = VertexFormat::Float2,
+	        .offset = offsetof(GizmoRenderer::Vertex, position),
 	    },
-	    D3D11_INPUT_ELEMENT_DESC{
-	        .SemanticName = "COLOR",
-	        .Format = DXGI_FORMAT_R32G32B32A32_FLOAT,
-	        .AlignedByteOffset = offsetof(GizmoRenderer::Vertex, color),
-	        .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+	    VertexInput{
+	        .semantic = "COLOR",
+	        .format = VertexFormat::Float4,
+	        .offset = offsetof(GizmoRenderer::Vertex, color),
 	    },
 	};
 
-	m_vertexShader = assetCache.loadVertexShader("shaders/gizmo.vs", shaderInputDescription);
-	m_pixelShader = assetCache.loadPixelShader("shaders/gizmo.ps");
-
-	m_vertexBuffer.info = {
-	    .name = "GizmoRenderer Vertex Buffer",
-	    .size = 1024 * sizeof(Vertex),
-	    .stride = sizeof(Vertex),
-	    .bindFlags = GpuBindFlag::VertexBuffer,
-	    .flags = GpuBufferFlag::CpuWriteable,
-	};
-	if (not m_renderDevice.createBuffer(m_vertexBuffer)) {
-		ANKER_FATAL("Failed to create GizmoRenderer Vertex Buffer");
-	}
+	m_vertexShader =
+	    assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/gizmo.vs"_hs, shaderInputDescription));
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/gizmo.ps"_hs));
 }
 
 void GizmoRenderer::addPoint(const Vec2& point, const Vec4& color)
@@ -73,26 +62,34 @@ void GizmoRenderer::addGrid(float size, Vec4 color)
 	}
 }
 
-void GizmoRenderer::draw()
+void GizmoRenderer::extract(Packet& packet)
+{
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+	packet.pixelShader = *m_assetCache.get(m_pixelShader);
+
+	// Swapping hands the packet's previous allocations back for reuse.
+	std::swap(packet.verticesForLines, m_verticesForLines);
+	std::swap(packet.verticesForTriangles, m_verticesForTriangles);
+	m_verticesForLines.clear();
+	m_verticesForTriangles.clear();
+}
+
+void GizmoRenderer::draw(const Packet& packet)
 {
-	if (m_verticesForLines.empty() && m_verticesForTriangles.empty()) {
+	if (packet.verticesForLines.empty() && packet.verticesForTriangles.empty()) {
 		return;
 	}
 
-	m_renderDevice.bindVertexShader(*m_vertexShader);
-	m_renderDevice.bindPixelShader(*m_pixelShader);
+	m_renderDevice.bindVertexShader(packet.vertexShader);
+	m_renderDevice.bindPixelShader(packet.pixelShader);
 	m_renderDevice.setRasterizer({.depthClip = false});
 
-	if (!m_verticesForLines.empty()) {
-		m_renderDevice.fillBuffer(m_vertexBuffer, m_verticesForLines);
-		m_renderDevice.draw(m_vertexBuffer, u32(m_verticesForLines.size()), Topology::LineList);
-		m_verticesForLines.clear();
+	if (!packet.verticesForLines.empty()) {
+		m_renderDevice.draw(m_renderDevice.uploadVertices(packet.verticesForLines), Topology::LineList);
 	}
 
-	if (!m_verticesForTriangles.empty()) {
-		m_renderDevice.fillBuffer(m_vertexBuffer, m_verticesForTriangles);
-		m_renderDevice.draw(m_vertexBuffer, u32(m_verticesForTriangles.size()), Topology::TriangleList);
-		m_verticesForTriangles.clear();
+	if (!packet.verticesForTriangles.empty()) {
+		m_renderDevice.draw(m_renderDevice.uploadVertices(packet.verticesForTriangles), Topology::TriangleList);
 	}
 }
 
@@ -8,7 +8,7 @@ namespace Anker {
 class AssetCache;
 
 // Render system used to draw debug gizmos. Gizmos need to be re-added each
-// frame --- internal state is cleared after draw.
+// frame --- internal state is cleared on extract.
 class GizmoRenderer {
   public:
 	GizmoRenderer(RenderDevice&, AssetCache&);
@@ -27,19 +27,30 @@ class GizmoRenderer {
 
 	void addGrid(float size, Vec4 color = {0.2f, 0.2f, 0.2f, 1});
 
-	void draw();
-
-  private:
 	struct Vertex {
 		Vec2 position;
 		Vec4 color;
 	};
 
+	struct Packet {
+		VertexShader vertexShader;
+		PixelShader pixelShader;
+		std::vector<Vertex> verticesForLines;
+		std::vector<Vertex> verticesForTriangles;
+	};
+
+	// Moves the gizmos added since the last call into the packet.
+	void extract(Packet&);
+
+	void draw(const Packet&);
+
+  private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
 
-	AssetPtr<VertexShader> m_vertexShader;
-	AssetPtr<PixelShader> m_pixelShader;
-	GpuBuffer m_vertexBuffer;
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
+	AssetHandle<PixelShader> m_pixelShader;
 
 	std::vector<Vertex> m_verticesForLines;
 	std::vector<Vertex> m_verticesForTriangles;
@@ -0,0 +1,171 @@
+#include <anker/graphics/anker_glyph_cache.hpp>
+
+namespace Anker {
+
+// Each glyph is surrounded by a transparent border, so bilinear filtering does
+// not pick up neighbouring glyphs.
+const u32 GlyphPadding = 1;
+
+// Shelf heights are rounded up, so glyphs of similar size share a shelf.
+const u32 ShelfGranularity = 4;
+
+GlyphCache::GlyphCache(RenderDevice& renderDevice, Vec2u pageSize, u32 pageBudget)
+    : m_renderDevice(renderDevice), m_pageSize(pageSize), m_pageBudget(pageBudget)
+{
+}
+
+const Glyph* GlyphCache::find(u64 key)
+{
+	auto it = m_glyphs.find(key);
+	if (it == m_glyphs.end()) {
+		return nullptr;
+	}
+
+	if (it->second.page != NoPage) {
+		m_pages[it->second.page].lastUsed = m_frame;
+	}
+
+	return &it->second;
+}
+
+const Glyph& GlyphCache::insert(u64 key, Glyph glyph, Vec2u bitmapSize, std::span<const u8> bitmap)
+{
+	ANKER_PROFILE_ZONE();
+
+	glyph.page = NoPage;
+	glyph.texRect = {};
+
+	if (bitmapSize.x > 0 && bitmapSize.y > 0) {
+		const Vec2u slotSize = bitmapSize + Vec2u(2 * GlyphPadding);
+
+		if (auto allocation = allocate(slotSize)) {
+			auto [page, slot] = *allocation;
+
+			// The whole slot is uploaded, clearing whatever an evicted glyph
+			// left behind.
+			std::vector<u8> pixels(usize(slotSize.x) * slotSize.y);
+			for (u32 y = 0; y < bitmapSize.y; ++y) {
+				std::copy_n(bitmap.data() + y * bitmapSize.x, bitmapSize.x,
+				            pixels.data() + (y + GlyphPadding) * slotSize.x + GlyphPadding);
+			}
+			m_renderDevice.updateTexture(m_pages[page].texture, slot, {.data = pixels.data(), .rowPitch = slotSize.x});
+
+			Rect2u rect(bitmapSize, slot.offset + Vec2u(GlyphPadding));
+			glyph.texRect = Rect2(Vec2(rect.size) / Vec2(m_pageSize), Vec2(rect.offset) / Vec2(m_pageSize));
+			glyph.page = page;
+			m_pages[page].lastUsed = m_frame;
+		} else {
+			ANKER_WARN("Glyph of size {} exceeds glyph cache page", bitmapSize);
+		}
+	}
+
+	return m_glyphs[key] = glyph;
+}
+
+void GlyphCache::clear()
+{
+	m_glyphs.clear();
+	for (auto& page : m_pages) {
+		page.shelves.clear();
+		page.height = 0;
+	}
+	m_evictions++;
+}
+
+usize GlyphCache::byteSize() const
+{
+	usize bytes = m_glyphs.size() * (sizeof(u64) + sizeof(Glyph));
+	for (auto& page : m_pages) {
+		bytes += textureByteSize(page.texture.info);
+	}
+	return bytes;
+}
+
+std::optional<Rect2u> GlyphCache::allocate(u32 pageIndex, Vec2u size)
+{
+	auto& page = m_pages[pageIndex];
+
+	// Best fit: the flattest shelf with enough room.
+	Shelf* best = nullptr;
+	for (auto& shelf : page.shelves) {
+		if (shelf.height >= size.y && shelf.width + size.x <= m_pageSize.x) {
+			if (!best || shelf.height < best->height) {
+				best = &shelf;
+			}
+		}
+	}
+
+	// Avoid wasting tall shelves on small glyphs while there is room left for
+	// a new shelf.
+	const u32 shelfHeight = std::min((size.y + ShelfGranularity - 1) / ShelfGranularity * ShelfGranularity, //
+	                                 m_pageSize.y);
+	if ((!best || best->height > 2 * shelfHeight) && page.height + shelfHeight <= m_pageSize.y) {
+		best = &page.shelves.emplace_back(Shelf{.y = page.height, .height = shelfHeight});
+		page.height += shelfHeight;
+	}
+
+	if (!best) {
+		return std::nullopt;
+	}
+
+	Rect2u rect(size, Vec2u(best->width, best->y));
+	best->width += size.x;
+	return rect;
+}
+
+std::optional<std::pair<u32, Rect2u>> GlyphCache::allocate(Vec2u size)
+{
+	if (size.x > m_pageSize.x || size.y > m_pageSize.y) {
+		return std::nullopt;
+	}
+
+	for (u32 pageIndex = 0; pageIndex < m_pages.size(); ++pageIndex) {
+		if (auto rect = allocate(pageIndex, size)) {
+			return std::pair{pageIndex, *rect};
+		}
+	}
+
+	// All pages are full. Evict the least recently used page, unless it is
+	// still in use by the current or the previous frame.
+	if (m_pages.size() >= m_pageBudget) {
+		auto lru = std::ranges::min_element(m_pages, {}, &Page::lastUsed);
+		if (lru != m_pages.end() && lru->lastUsed + 1 < m_frame) {
+			u32 pageIndex = u32(lru - m_pages.begin());
+			evict(pageIndex);
+			return std::pair{pageIndex, *allocate(pageIndex, size)};
+		}
+	}
+
+	addPage();
+	return std::pair{u32(m_pages.size() - 1), *allocate(u32(m_pages.size() - 1), size)};
+}
+
+void GlyphCache::addPage()
+{
+	auto& page = m_pages.emplace_back();
+	page.texture.info = {
+	    .name = fmt::format("GlyphCache Page {}", m_pages.size() - 1),
+	    .size = m_pageSize,
+	    .format = TextureFormat::R8_UNORM,
+	};
+
+	std::vector<u8> pixels(usize(m_pageSize.x) * m_pageSize.y);
+	if (not m_renderDevice.createTexture(page.texture, std::array{TextureInit{pixels.data(), m_pageSize.x}})) {
+		ANKER_FATAL("Failed to create {}", page.texture.info.name);
+	}
+}
+
+void GlyphCache::evict(u32 pageIndex)
+{
+	ANKER_PROFILE_ZONE();
+
+	std::erase_if(m_glyphs, [&](auto& entry) { return entry.second.page == pageIndex; });
+
+	auto& page = m_pages[pageIndex];
+	page.shelves.clear();
+	page.height = 0;
+
+	m_evictions++;
+}
+
+} // namespace Anker
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <anker/graphics/anker_render_device.hpp>
+
+namespace Anker {
+
+// Bitmap glyphs are rasterized for a specific pixel size. SDF glyphs store a
+// signed distance field instead, which can be rendered at any size.
+enum class GlyphMode {
+	Bitmap,
+	Sdf,
+};
+
+struct Glyph {
+	Rect2 texRect;      // Glyph location in its page
+	Rect2 visRect;      // Glyph offset for rendering, in pixels
+	float xAdvance = 0; // Horizontal offset to the next glyph, in pixels
+	u32 index = 0;      // Glyph index within the font, used for kerning
+	u32 page = 0;       // See GlyphCache::NoPage
+};
+
+// The GlyphCache stores rasterized glyphs in shelf-packed atlas pages. Glyphs
+// are added on demand, hence memory scales with the glyphs actually used.
+//
+// Once the page budget is exhausted, the least recently used page is evicted
+// as a whole. Pages used during the current or the previous frame, which may
+// still be drawn by the RenderThread, are never evicted, the cache exceeds its
+// budget instead.
+class GlyphCache {
+  public:
+	GlyphCache(RenderDevice&, Vec2u pageSize, u32 pageBudget);
+	GlyphCache(const GlyphCache&) = delete;
+	GlyphCache& operator=(const GlyphCache&) = delete;
+	GlyphCache(GlyphCache&&) noexcept = delete;
+	GlyphCache& operator=(GlyphCache&&) noexcept = delete;
+
+	// Page of glyphs without a bitmap.
+	static constexpr u32 NoPage = ~0u;
+
+	static u64 key(u32 font, u32 pixelSize, char32_t codepoint)
+	{
+		return u64(font) << 48 | u64(pixelSize) << 32 | u64(codepoint);
+	}
+
+	// Returns nullptr on a cache miss. Marks the glyph's page as used.
+	const Glyph* find(u64 key);
+
+	// Adds a glyph together with its tightly packed 8-bit bitmap. Glyphs
+	// without a bitmap (e.g. SPACE) do not occupy a page. The returned
+	// reference is valid until the end of the frame.
+	const Glyph& insert(u64 key, Glyph, Vec2u bitmapSize, std::span<const u8> bitmap);
+
+	const Texture& pageTexture(u32 page) const { return m_pages[page].texture; }
+
+	// Keeps the page from being evicted, for users holding on to glyphs across
+	// frames.
+	void markUsed(u32 page) { m_pages[page].lastUsed = m_frame; }
+
+	void newFrame() { m_frame++; }
+
+	// Evicts all glyphs.
+	void clear();
+
+	struct Stats {
+		u32 glyphs = 0;
+		u32 pages = 0;
+		u32 evictions = 0;
+	};
+	Stats stats() const { return {u32(m_glyphs.size()), u32(m_pages.size()), m_evictions}; }
+
+	// Incremented whenever glyphs are evicted. Users caching texture
+	// coordinates must discard them when this changes.
+	u32 generation() const { return m_evictions; }
+
+	usize byteSize() const;
+
+  private:
+	struct Shelf {
+		u32 y = 0;
+		u32 height = 0;
+		u32 width = 0; // Occupied width
+	};
+
+	struct Page {
+		Texture texture;
+		std::vector<Shelf> shelves;
+		u32 height = 0; // Occupied height
+		u64 lastUsed = 0;
+	};
+
+	std::optional<Rect2u> allocate(u32 pageIndex, Vec2u size);
+	std::optional<std::pair<u32, Rect2u>> allocate(Vec2u size);
+	void addPage();
+	void evict(u32 pageIndex);
+
+	RenderDevice& m_renderDevice;
+
+	Vec2u m_pageSize;
+	u32 m_pageBudget = 0;
+
+	std::vector<Page> m_pages;
+	std::unordered_map<u64, Glyph> m_glyphs;
+
+	u64 m_frame = 1;
+	u32 m_evictions = 0;
+};
+
+} // namespace Anker
@@ -0,0 +1,24 @@
+#include <anker/graphics/anker_gpu_types.hpp>
+
+namespace Anker {
+
+usize textureByteSize(const TextureInfo& info)
+{
+	usize bitsPerPixel = 0;
+	switch (info.format) {
+	case TextureFormat::R16G16B16A16_UNORM: bitsPerPixel = 64; break;
+	case TextureFormat::R8G8B8A8_UNORM: bitsPerPixel = 32; break;
+	case TextureFormat::D32_FLOAT: bitsPerPixel = 32; break;
+	case TextureFormat::R8_UNORM: bitsPerPixel = 8; break;
+	case TextureFormat::BC7_UNORM: bitsPerPixel = 8; break;
+	}
+
+	usize pixels = 0;
+	for (u32 level = 0; level < info.mipLevels; ++level) {
+		pixels += usize(std::max(info.size.x >> level, 1u)) * std::max(info.size.y >> level, 1u);
+	}
+
+	return pixels * info.arraySize * bitsPerPixel / 8;
+}
+
+} // namespace Anker
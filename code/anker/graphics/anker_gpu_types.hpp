@@ -0,0 +1,143 @@
+#pragma once
+
+namespace Anker {
+
+// Descriptions of GPU resources and pipeline state, independent of the
+// graphics API.
+
+enum class GpuBindFlag {
+	None = 0,
+	ConstantBuffer = 1 << 0,
+	VertexBuffer = 1 << 1,
+	IndexBuffer = 1 << 2,
+	Shader = 1 << 3,
+	RenderTarget = 1 << 4,
+	DepthStencil = 1 << 5,
+};
+ANKER_ENUM_FLAGS(GpuBindFlag)
+
+////////////////////////////////////////////////////////////
+// Topology
+
+enum class Topology {
+	LineList = 2,
+	TriangleList = 4,
+	TriangleStrip = 5,
+};
+
+////////////////////////////////////////////////////////////
+// GPU Buffers
+
+enum class GpuBufferFlag {
+	None = 0,
+	CpuWriteable = 1 << 0,
+	Structured = 1 << 1,
+};
+ANKER_ENUM_FLAGS(GpuBufferFlag)
+
+struct GpuBufferInfo {
+	std::string name;
+	u32 size = 0;
+	u32 stride = 1;
+	GpuBindFlags bindFlags;
+	GpuBufferFlags flags = {};
+
+	u32 elementCount() const { return size / stride; }
+};
+
+////////////////////////////////////////////////////////////
+// Vertex Inputs
+
+// Values match DXGI_FORMAT.
+enum class VertexFormat {
+	Float4 = 2,
+	Float2 = 16,
+	Float = 41,
+};
+
+// An attribute read by the vertex shader, like D3D11_INPUT_ELEMENT_DESC. All
+// attributes are read from the vertex buffer bound to slot 0.
+struct VertexInput {
+	const char* semantic = nullptr;
+	u32 semanticIndex = 0;
+	VertexFormat format = VertexFormat::Float2;
+	u32 offset = 0; // Bytes
+
+	// Advances once per instance instead of once per vertex.
+	bool perInstance = false;
+};
+
+////////////////////////////////////////////////////////////
+// Samplers
+
+enum class FilterMode { Point, Linear };
+enum class TexAddressMode { Wrap = 1, Mirror = 2, Clamp = 3, Border = 4, MirrorOnce = 5 };
+
+enum class CompareFunc {
+	Never = 1,
+	Less = 2,
+	Equal = 3,
+	LessEqual = 4,
+	Greater = 5,
+	NotEqual = 6,
+	GreaterEqual = 7,
+	Always = 8,
+};
+
+struct SamplerDesc {
+	FilterMode filterMode = FilterMode::Point;
+	TexAddressMode addressModeU = TexAddressMode::Border;
+	TexAddressMode addressModeV = TexAddressMode::Border;
+	TexAddressMode addressModeW = TexAddressMode::Border;
+	CompareFunc compareFunc = CompareFunc::Never;
+
+	friend auto operator<=>(const SamplerDesc&, const SamplerDesc&) = default;
+};
+
+////////////////////////////////////////////////////////////
+// Textures
+
+enum class TextureFormat {
+	R16G16B16A16_UNORM = 11,
+	R8G8B8A8_UNORM = 28,
+	D32_FLOAT = 40,
+	R8_UNORM = 61,
+	BC7_UNORM = 98,
+};
+
+enum class TextureFlag {
+	None = 0,
+	CpuWriteable = 1 << 0,
+	Cubemap = 1 << 1,
+};
+ANKER_ENUM_FLAGS(TextureFlag)
+
+struct TextureInfo {
+	std::string name;
+	Vec2u size;
+	u32 mipLevels = 1;
+	u32 arraySize = 1;
+	TextureFormat format = TextureFormat::R8G8B8A8_UNORM;
+	GpuBindFlags bindFlags = GpuBindFlag::Shader;
+	TextureFlags flags = {};
+};
+
+// Approximate amount of GPU memory occupied by a texture.
+usize textureByteSize(const TextureInfo&);
+
+struct TextureInit {
+	const u8* data;
+	u32 rowPitch;
+};
+
+////////////////////////////////////////////////////////////
+// Rasterizer
+
+struct RasterizerDesc {
+	bool wireframe = false;
+	bool depthClip = true;
+
+	friend auto operator<=>(const RasterizerDesc&, const RasterizerDesc&) = default;
+};
+
+} // namespace Anker
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <anker/core/anker_asset.hpp>
+#include <anker/graphics/anker_text_mesh.hpp>
+
+namespace Anker {
+
+class Font;
+
+// Text attached to a scene node, e.g. HUD text or debug overlays. The mesh is
+// only laid out again when the text, font, or layout changes.
+struct Label {
+	std::string text;
+	AssetHandle<Font> font; // The system font is used if not set
+	TextLayout layout;
+
+	TextMesh mesh;
+};
+
+} // namespace Anker
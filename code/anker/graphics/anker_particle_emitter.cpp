@@ -0,0 +1,402 @@
+#include <anker/graphics/anker_particle_emitter.hpp>
+
+#include <anker/core/anker_scene.hpp>
+#include <anker/core/anker_scene_node.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ANKER_PARTICLES_SSE2
+#endif
+
+namespace Anker {
+
+// Avoids division by zero for a lifetime variance exceeding the lifetime.
+const float MinParticleLifetime = 0.001f;
+
+////////////////////////////////////////////////////////////
+// Pool
+
+static std::array<std::vector<float>*, 11> poolArrays(ParticlePool& pool)
+{
+	return {
+	    &pool.positionX, &pool.positionY, &pool.velocityX, &pool.velocityY, &pool.age,    &pool.invLifetime,
+	    &pool.size,      &pool.colorR,    &pool.colorG,    &pool.colorB,    &pool.colorA,
+	};
+}
+
+static u32 paddedCount(u32 count)
+{
+	return (count + ParticlePool::Lanes - 1) / ParticlePool::Lanes * ParticlePool::Lanes;
+}
+
+void ParticlePool::resize(u32 newCapacity)
+{
+	newCapacity = paddedCount(newCapacity);
+	for (auto* array : poolArrays(*this)) {
+		array->resize(newCapacity, 0.0f);
+	}
+	count = std::min(count, newCapacity);
+}
+
+// Swaps dead particles with the last live one.
+static void removeDeadParticles(ParticlePool& pool)
+{
+	const auto arrays = poolArrays(pool);
+
+	u32 i = 0;
+	while (i < pool.count) {
+		if (pool.age[i] < 1.0f) {
+			++i;
+			continue;
+		}
+
+		const u32 last = --pool.count;
+		for (auto* array : arrays) {
+			(*array)[i] = (*array)[last];
+		}
+	}
+}
+
+static void updateBounds(ParticlePool& pool)
+{
+	if (pool.count == 0) {
+		pool.bounds = {};
+		return;
+	}
+
+	Vec2 min = {pool.positionX[0], pool.positionY[0]};
+	Vec2 max = min;
+
+	u32 i = 0;
+
+#ifdef ANKER_PARTICLES_SSE2
+	if (pool.count >= ParticlePool::Lanes) {
+		__m128 minX = _mm_loadu_ps(&pool.positionX[0]);
+		__m128 minY = _mm_loadu_ps(&pool.positionY[0]);
+		__m128 maxX = minX;
+		__m128 maxY = minY;
+
+		// Lanes beyond count are stale, only full groups are processed here.
+		for (i = ParticlePool::Lanes; i + ParticlePool::Lanes <= pool.count; i += ParticlePool::Lanes) {
+			const __m128 x = _mm_loadu_ps(&pool.positionX[i]);
+			const __m128 y = _mm_loadu_ps(&pool.positionY[i]);
+			minX = _mm_min_ps(minX, x);
+			minY = _mm_min_ps(minY, y);
+			maxX = _mm_max_ps(maxX, x);
+			maxY = _mm_max_ps(maxY, y);
+		}
+
+		std::array<float, ParticlePool::Lanes> lanes;
+		_mm_storeu_ps(lanes.data(), minX);
+		min.x = std::ranges::min(lanes);
+		_mm_storeu_ps(lanes.data(), minY);
+		min.y = std::ranges::min(lanes);
+		_mm_storeu_ps(lanes.data(), maxX);
+		max.x = std::ranges::max(lanes);
+		_mm_storeu_ps(lanes.data(), maxY);
+		max.y = std::ranges::max(lanes);
+	}
+#endif
+
+	for (; i < pool.count; ++i) {
+		min = {std::min(min.x, pool.positionX[i]), std::min(min.y, pool.positionY[i])};
+		max = {std::max(max.x, pool.positionX[i]), std::max(max.y, pool.positionY[i])};
+	}
+
+	pool.bounds = Rect2::fromPoints(min, max);
+}
+
+////////////////////////////////////////////////////////////
+// Integration
+
+// Padded lanes are integrated as well, their values are ignored.
+
+static void integrateVelocity(ParticlePool& pool, Vec2 deltaVelocity, float damping)
+{
+	const u32 count = paddedCount(pool.count);
+
+#ifdef ANKER_PARTICLES_SSE2
+	const __m128 deltaX = _mm_set1_ps(deltaVelocity.x);
+	const __m128 deltaY = _mm_set1_ps(deltaVelocity.y);
+	const __m128 damp = _mm_set1_ps(damping);
+
+	for (u32 i = 0; i < count; i += ParticlePool::Lanes) {
+		const __m128 vx = _mm_loadu_ps(&pool.velocityX[i]);
+		const __m128 vy = _mm_loadu_ps(&pool.velocityY[i]);
+		_mm_storeu_ps(&pool.velocityX[i], _mm_mul_ps(_mm_add_ps(vx, deltaX), damp));
+		_mm_storeu_ps(&pool.velocityY[i], _mm_mul_ps(_mm_add_ps(vy, deltaY), damp));
+	}
+#else
+	for (u32 i = 0; i < count; ++i) {
+		pool.velocityX[i] = (pool.velocityX[i] + deltaVelocity.x) * damping;
+		pool.velocityY[i] = (pool.velocityY[i] + deltaVelocity.y) * damping;
+	}
+#endif
+}
+
+// Start values and deltas of the attributes interpolated over the lifetime.
+struct ParticleGradient {
+	float size = 0;
+	float sizeDelta = 0;
+	Vec4 color;
+	Vec4 colorDelta;
+};
+
+static void integratePosition(ParticlePool& pool, float dt, const ParticleGradient& gradient)
+{
+	const u32 count = paddedCount(pool.count);
+
+#ifdef ANKER_PARTICLES_SSE2
+	const __m128 dt4 = _mm_set1_ps(dt);
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	const __m128 size = _mm_set1_ps(gradient.size);
+	const __m128 sizeDelta = _mm_set1_ps(gradient.sizeDelta);
+	const std::array color = {
+	    _mm_set1_ps(gradient.color.x),
+	    _mm_set1_ps(gradient.color.y),
+	    _mm_set1_ps(gradient.color.z),
+	    _mm_set1_ps(gradient.color.w),
+	};
+	const std::array colorDelta = {
+	    _mm_set1_ps(gradient.colorDelta.x),
+	    _mm_set1_ps(gradient.colorDelta.y),
+	    _mm_set1_ps(gradient.colorDelta.z),
+	    _mm_set1_ps(gradient.colorDelta.w),
+	};
+	const std::array colorArrays = {&pool.colorR, &pool.colorG, &pool.colorB, &pool.colorA};
+
+	for (u32 i = 0; i < count; i += ParticlePool::Lanes) {
+		const __m128 vx = _mm_loadu_ps(&pool.velocityX[i]);
+		const __m128 vy = _mm_loadu_ps(&pool.velocityY[i]);
+		const __m128 x = _mm_add_ps(_mm_loadu_ps(&pool.positionX[i]), _mm_mul_ps(vx, dt4));
+		const __m128 y = _mm_add_ps(_mm_loadu_ps(&pool.positionY[i]), _mm_mul_ps(vy, dt4));
+		_mm_storeu_ps(&pool.positionX[i], x);
+		_mm_storeu_ps(&pool.positionY[i], y);
+
+		const __m128 invLifetime = _mm_loadu_ps(&pool.invLifetime[i]);
+		const __m128 age = _mm_add_ps(_mm_loadu_ps(&pool.age[i]), _mm_mul_ps(invLifetime, dt4));
+		_mm_storeu_ps(&pool.age[i], age);
+
+		const __m128 t = _mm_min_ps(age, one);
+		_mm_storeu_ps(&pool.size[i], _mm_add_ps(size, _mm_mul_ps(sizeDelta, t)));
+		for (usize c = 0; c < colorArrays.size(); ++c) {
+			_mm_storeu_ps(&(*colorArrays[c])[i], _mm_add_ps(color[c], _mm_mul_ps(colorDelta[c], t)));
+		}
+	}
+#else
+	for (u32 i = 0; i < count; ++i) {
+		pool.positionX[i] += pool.velocityX[i] * dt;
+		pool.positionY[i] += pool.velocityY[i] * dt;
+		pool.age[i] += pool.invLifetime[i] * dt;
+
+		const float t = std::min(pool.age[i], 1.0f);
+		pool.size[i] = gradient.size + gradient.sizeDelta * t;
+		pool.colorR[i] = gradient.color.x + gradient.colorDelta.x * t;
+		pool.colorG[i] = gradient.color.y + gradient.colorDelta.y * t;
+		pool.colorB[i] = gradient.color.z + gradient.colorDelta.z * t;
+		pool.colorA[i] = gradient.color.w + gradient.colorDelta.w * t;
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////
+// Collision
+
+// Collects the fixture children overlapping the region the particles can
+// reach this step. Particles then only cast rays against these candidates,
+// instead of each traversing the broadphase.
+class ParticleFixtureQuery : public b2QueryCallback {
+  public:
+	struct Candidate {
+		const b2Fixture* fixture = nullptr;
+		i32 childIndex = 0;
+		b2AABB aabb;
+	};
+
+	explicit ParticleFixtureQuery(const b2AABB& aabb) : m_aabb(aabb) {}
+
+	bool ReportFixture(b2Fixture* fixture) override
+	{
+		if (fixture->IsSensor()) {
+			return true;
+		}
+
+		// Chains report once for all their edges.
+		for (i32 child = 0; child < fixture->GetShape()->GetChildCount(); ++child) {
+			const b2AABB& aabb = fixture->GetAABB(child);
+			if (b2TestOverlap(aabb, m_aabb)) {
+				candidates.push_back({fixture, child, aabb});
+			}
+		}
+		return true;
+	}
+
+	std::vector<Candidate> candidates;
+
+  private:
+	b2AABB m_aabb;
+};
+
+// Runs between velocity and position integration. Particles hitting a fixture
+// have their velocity reflected, their position is set such that the
+// following position integration ends the step on the reflected path.
+static void collideParticles(ParticlePool& pool, const b2World& physicsWorld, float dt, float restitution)
+{
+	ANKER_PROFILE_ZONE();
+
+	if (pool.count == 0) {
+		return;
+	}
+
+	// Swept bounds of all particles.
+	b2AABB sweptBounds;
+	sweptBounds.lowerBound = {pool.positionX[0], pool.positionY[0]};
+	sweptBounds.upperBound = sweptBounds.lowerBound;
+	for (u32 i = 0; i < pool.count; ++i) {
+		const b2Vec2 from = {pool.positionX[i], pool.positionY[i]};
+		const b2Vec2 to = from + dt * b2Vec2(pool.velocityX[i], pool.velocityY[i]);
+		sweptBounds.lowerBound = b2Min(sweptBounds.lowerBound, b2Min(from, to));
+		sweptBounds.upperBound = b2Max(sweptBounds.upperBound, b2Max(from, to));
+	}
+
+	ParticleFixtureQuery query(sweptBounds);
+	physicsWorld.QueryAABB(&query, sweptBounds);
+	if (query.candidates.empty()) {
+		return;
+	}
+
+	for (u32 i = 0; i < pool.count; ++i) {
+		const b2Vec2 from = {pool.positionX[i], pool.positionY[i]};
+		const b2Vec2 velocity = {pool.velocityX[i], pool.velocityY[i]};
+		const b2Vec2 to = from + dt * velocity;
+
+		b2AABB segment;
+		segment.lowerBound = b2Min(from, to);
+		segment.upperBound = b2Max(from, to);
+
+		b2RayCastInput input = {.p1 = from, .p2 = to, .maxFraction = 1.0f};
+		b2Vec2 normal;
+		bool hit = false;
+
+		for (auto& candidate : query.candidates) {
+			if (!b2TestOverlap(candidate.aabb, segment)) {
+				continue;
+			}
+
+			b2RayCastOutput output;
+			if (candidate.fixture->RayCast(&output, input, candidate.childIndex)) {
+				input.maxFraction = output.fraction;
+				normal = output.normal;
+				hit = true;
+			}
+		}
+
+		if (!hit) {
+			continue;
+		}
+
+		const b2Vec2 normalVelocity = b2Dot(velocity, normal) * normal;
+		const b2Vec2 reflected = velocity - normalVelocity - restitution * normalVelocity;
+
+		const b2Vec2 contact = from + input.maxFraction * dt * velocity + b2_linearSlop * normal;
+		const b2Vec2 position = contact - input.maxFraction * dt * reflected;
+
+		pool.positionX[i] = position.x;
+		pool.positionY[i] = position.y;
+		pool.velocityX[i] = reflected.x;
+		pool.velocityY[i] = reflected.y;
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Emitter
+
+// xorshift32, sufficient for visual variation.
+static float randomFloat(u32& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return float(state >> 8) / float(1 << 24);
+}
+
+// Uniform in [-1, 1).
+static float randomSigned(u32& state)
+{
+	return randomFloat(state) * 2.0f - 1.0f;
+}
+
+void ParticleEmitter::tick(float dt, Scene& scene)
+{
+	ANKER_PROFILE_ZONE();
+
+	const b2World* physicsWorld = scene.physicsWorld ? &*scene.physicsWorld : nullptr;
+
+	for (auto [_, node, emitter] : scene.registry.view<SceneNode, ParticleEmitter>().each()) {
+		emitter.spawn(dt, node.globalTransform().position);
+		emitter.simulate(dt, physicsWorld);
+	}
+}
+
+void ParticleEmitter::simulate(float dt, const b2World* physicsWorld)
+{
+	const float damping = std::max(1.0f - drag * dt, 0.0f);
+	integrateVelocity(pool, acceleration * dt, damping);
+
+	if (collide && physicsWorld) {
+		collideParticles(pool, *physicsWorld, dt, restitution);
+	}
+
+	const ParticleGradient gradient = {
+	    .size = size,
+	    .sizeDelta = sizeEnd - size,
+	    .color = color,
+	    .colorDelta = colorEnd - color,
+	};
+	integratePosition(pool, dt, gradient);
+
+	removeDeadParticles(pool);
+	updateBounds(pool);
+}
+
+void ParticleEmitter::spawn(float dt, Vec2 position)
+{
+	const u32 limit = u32(std::max(maxParticles, 0));
+	if (pool.capacity() != paddedCount(limit)) {
+		pool.resize(limit);
+	}
+	pool.count = std::min(pool.count, limit);
+
+	if (!emitting) {
+		spawnAccumulator = 0.0f;
+		return;
+	}
+
+	// Negative rates can be entered in the inspector.
+	spawnAccumulator += std::max(rate, 0.0f) * dt;
+	u32 spawnCount = u32(spawnAccumulator);
+	spawnAccumulator -= float(spawnCount);
+	spawnCount = std::min(spawnCount, limit - pool.count);
+
+	for (u32 n = 0; n < spawnCount; ++n) {
+		const u32 i = pool.count++;
+
+		pool.positionX[i] = position.x + spawnExtent.x * randomSigned(randomState);
+		pool.positionY[i] = position.y + spawnExtent.y * randomSigned(randomState);
+		pool.velocityX[i] = velocity.x + velocityVariance.x * randomSigned(randomState);
+		pool.velocityY[i] = velocity.y + velocityVariance.y * randomSigned(randomState);
+
+		const float particleLifetime = lifetime + lifetimeVariance * randomSigned(randomState);
+		pool.age[i] = 0.0f;
+		pool.invLifetime[i] = 1.0f / std::max(particleLifetime, MinParticleLifetime);
+
+		pool.size[i] = size;
+		pool.colorR[i] = color.x;
+		pool.colorG[i] = color.y;
+		pool.colorB[i] = color.z;
+		pool.colorA[i] = color.w;
+	}
+}
+
+} // namespace Anker
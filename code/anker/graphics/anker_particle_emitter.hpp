@@ -0,0 +1,115 @@
+#pragma once
+
+#include <anker/core/anker_asset.hpp>
+
+namespace Anker {
+
+class Scene;
+struct Texture;
+
+// Particles are stored as structure of arrays, such that the update processes
+// ParticlePool::Lanes particles at once using SIMD. Arrays are padded to a
+// multiple of Lanes; values beyond count are stale but finite.
+struct ParticlePool {
+	static constexpr u32 Lanes = 4;
+
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+
+	// Normalized age, the particle dies when reaching 1.
+	std::vector<float> age;
+	std::vector<float> invLifetime;
+
+	std::vector<float> size;
+	std::vector<float> colorR;
+	std::vector<float> colorG;
+	std::vector<float> colorB;
+	std::vector<float> colorA;
+
+	u32 count = 0;
+
+	// World bounds of all particle positions, not accounting for their size.
+	Rect2 bounds;
+
+	u32 capacity() const { return u32(positionX.size()); }
+
+	// Live particles beyond the new capacity are dropped.
+	void resize(u32 capacity);
+};
+
+// ParticleEmitter spawns particles at the node's position, which are then
+// simulated in world space. Particles of an emitter are drawn in a single
+// instanced draw, see ParticleRenderer.
+struct ParticleEmitter {
+	bool emitting = true;
+
+	// Particles per second.
+	float rate = 50.0f;
+	int maxParticles = 1000;
+
+	// Seconds, variance is applied uniformly in both directions.
+	float lifetime = 1.0f;
+	float lifetimeVariance = 0.0f;
+
+	// Half extent of the rectangle particles are spawned in.
+	Vec2 spawnExtent;
+
+	Vec2 velocity = Vec2::WorldUp;
+	Vec2 velocityVariance = Vec2(0.5f);
+	Vec2 acceleration;
+
+	// Fraction of the velocity lost per second.
+	float drag = 0.0f;
+
+	// Interpolated over the particle's lifetime.
+	float size = 0.1f;
+	float sizeEnd = 0.1f;
+	Vec4 color = Vec4(1);
+	Vec4 colorEnd = Vec4(1, 1, 1, 0);
+
+	Vec2 parallax = Vec2(1);
+	AssetHandle<Texture> texture;
+
+	// Particles bounce off non-sensor fixtures of the scene's PhysicsWorld.
+	bool collide = false;
+	float restitution = 0.5f;
+
+	// Runtime state, not reflected.
+	ParticlePool pool;
+	float spawnAccumulator = 0.0f;
+	u32 randomState = 0x9e3779b9;
+
+	// Spawns and simulates particles of all emitters.
+	static void tick(float, Scene&);
+
+	// Advances the emitter's particles, without spawning new ones.
+	void simulate(float dt, const b2World* physicsWorld = nullptr);
+
+	// Spawns particles according to rate, at the given position.
+	void spawn(float dt, Vec2 position);
+};
+
+} // namespace Anker
+
+REFL_TYPE(Anker::ParticleEmitter)
+REFL_FIELD(emitting)
+REFL_FIELD(rate)
+REFL_FIELD(maxParticles)
+REFL_FIELD(lifetime)
+REFL_FIELD(lifetimeVariance)
+REFL_FIELD(spawnExtent)
+REFL_FIELD(velocity)
+REFL_FIELD(velocityVariance)
+REFL_FIELD(acceleration)
+REFL_FIELD(drag)
+REFL_FIELD(size)
+REFL_FIELD(sizeEnd)
+REFL_FIELD(color, Anker::Attr::Color())
+REFL_FIELD(colorEnd, Anker::Attr::Color())
+REFL_FIELD(parallax)
+REFL_FIELD(texture, Anker::Attr::Inline())
+REFL_FIELD(collide)
+REFL_FIELD(restitution, Anker::Attr::Slider(0.0f, 1.0f))
+REFL_END
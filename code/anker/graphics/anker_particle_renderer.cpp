@@ -0,0 +1,199 @@
+#include <anker/graphics/anker_particle_renderer.hpp>
+
+#include <anker/core/anker_asset_cache.hpp>
+#include <anker/core/anker_scene_node.hpp>
+#include <anker/graphics/anker_particle_emitter.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ANKER_PARTICLES_SSE2
+#endif
+
+namespace Anker {
+
+struct ParticleRendererConstantBuffer {
+	Vec2 parallax = Vec2(1);
+	u32 textured = 0;
+	u32 _pad = 0;
+};
+static_assert(sizeof(ParticleRendererConstantBuffer) % 16 == 0, "Constant Buffer size must be 16-byte aligned");
+
+const std::array<VertexInput, 3> ParticleRenderer::Instance::ShaderInputs = {
+    VertexInput{
+        .semantic = "POSITION",
+        .format = VertexFormat::Float2,
+        .offset = offsetof(Instance, position),
+        .perInstance = true,
+    },
+    VertexInput{
+        .semantic = "PSIZE",
+        .format = VertexFormat::Float,
+        .offset = offsetof(Instance, size),
+        .perInstance = true,
+    },
+    VertexInput{
+        .semantic = "COLOR",
+        .format = VertexFormat::Float4,
+        .offset = offsetof(Instance, color),
+        .perInstance = true,
+    },
+};
+
+// Two triangles per particle, generated from SV_VertexID.
+const u32 ParticleVertexCount = 6;
+
+ParticleRenderer::ParticleRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
+{
+	m_vertexShader =
+	    assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/particle.vs"_hs, Instance::ShaderInputs));
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/particle.ps"_hs));
+}
+
+void ParticleRenderer::newFrame(Packet& packet)
+{
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+	packet.pixelShader = *m_assetCache.get(m_pixelShader);
+	packet.draws.clear();
+	packet.instances.clear();
+}
+
+// Particles are culled by position, hence the rectangle is extended by the
+// largest particle radius.
+static float particleRadius(const ParticleEmitter& emitter)
+{
+	return std::max(std::abs(emitter.size), std::abs(emitter.sizeEnd)) / 2.0f;
+}
+
+bool ParticleRenderer::extract(const SceneNode* node, const Rect2& view, Vec2 cameraPosition, Packet& packet)
+{
+	auto* emitter = node->entity().try_get<ParticleEmitter>();
+	if (!emitter || emitter->pool.count == 0) {
+		return false;
+	}
+
+	// Without compiled shaders, see assets/Rakefile, particles are skipped.
+	if (!packet.vertexShader.shader || !packet.pixelShader.shader) {
+		return false;
+	}
+
+	const float radius = particleRadius(*emitter);
+
+	Rect2 rect = view;
+	rect.offset -= (Vec2(1) - emitter->parallax) * cameraPosition + Vec2(radius);
+	rect.size += Vec2(2 * radius);
+
+	const u32 firstInstance = u32(packet.instances.size());
+	const u32 instanceCount = cull(emitter->pool, rect, packet.instances);
+	if (instanceCount == 0) {
+		return false;
+	}
+
+	ShaderViewRef texture;
+	if (auto* loaded = m_assetCache.get(emitter->texture)) {
+		texture = loaded->shaderView;
+	}
+
+	packet.draws.push_back({
+	    .parallax = emitter->parallax,
+	    .texture = std::move(texture),
+	    .firstInstance = firstInstance,
+	    .instanceCount = instanceCount,
+	});
+	return true;
+}
+
+void ParticleRenderer::draw(const Packet& packet, u32 drawIndex)
+{
+	ANKER_PROFILE_ZONE();
+
+	auto& draw = packet.draws[drawIndex];
+
+	m_renderDevice.bindVertexShader(packet.vertexShader);
+	m_renderDevice.bindPixelShader(packet.pixelShader);
+
+	{
+		ParticleRendererConstantBuffer cb = {
+		    .parallax = draw.parallax,
+		    .textured = draw.texture ? 1u : 0u,
+		};
+		auto constants = m_renderDevice.uploadConstants(cb);
+		m_renderDevice.bindBufferVS(1, constants);
+		m_renderDevice.bindBufferPS(1, constants);
+	}
+
+	auto instances =
+	    m_renderDevice.uploadVertices(std::span(packet.instances).subspan(draw.firstInstance, draw.instanceCount));
+
+	m_renderDevice.bindTexturePS(0, draw.texture);
+	m_renderDevice.drawInstanced(instances, ParticleVertexCount);
+	m_renderDevice.unbindTexturePS(0);
+}
+
+u32 ParticleRenderer::cull(const ParticlePool& pool, const Rect2& rect, std::vector<Instance>& instances)
+{
+	ANKER_PROFILE_ZONE();
+
+	const usize first = instances.size();
+	instances.resize(first + pool.count);
+	Instance* out = instances.data() + first;
+
+	const Vec2 min = rect.topLeft();
+	const Vec2 max = rect.bottomRight();
+
+	auto append = [&](u32 i) {
+		*out++ = {
+		    .position = {pool.positionX[i], pool.positionY[i]},
+		    .size = pool.size[i],
+		    .color = {pool.colorR[i], pool.colorG[i], pool.colorB[i], pool.colorA[i]},
+		};
+	};
+
+#ifdef ANKER_PARTICLES_SSE2
+	const __m128 minX = _mm_set1_ps(min.x);
+	const __m128 minY = _mm_set1_ps(min.y);
+	const __m128 maxX = _mm_set1_ps(max.x);
+	const __m128 maxY = _mm_set1_ps(max.y);
+
+	// Padded lanes beyond count are masked out.
+	for (u32 i = 0; i < pool.count; i += ParticlePool::Lanes) {
+		const __m128 x = _mm_loadu_ps(&pool.positionX[i]);
+		const __m128 y = _mm_loadu_ps(&pool.positionY[i]);
+		const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x, minX), _mm_cmple_ps(x, maxX)),
+		                                 _mm_and_ps(_mm_cmpge_ps(y, minY), _mm_cmple_ps(y, maxY)));
+
+		u32 mask = u32(_mm_movemask_ps(inside));
+		if (const u32 remaining = pool.count - i; remaining < ParticlePool::Lanes) {
+			mask &= (1u << remaining) - 1;
+		}
+
+		while (mask) {
+			append(i + u32(std::countr_zero(mask)));
+			mask &= mask - 1;
+		}
+	}
+#else
+	for (u32 i = 0; i < pool.count; ++i) {
+		if (min.x <= pool.positionX[i] && pool.positionX[i] <= max.x //
+		    && min.y <= pool.positionY[i] && pool.positionY[i] <= max.y) {
+			append(i);
+		}
+	}
+#endif
+
+	const u32 count = u32(out - (instances.data() + first));
+	instances.resize(first + count);
+	return count;
+}
+
+Rect2 ParticleRenderer::bounds(const ParticleEmitter& emitter)
+{
+	const float radius = particleRadius(emitter);
+
+	Rect2 bounds = emitter.pool.bounds;
+	bounds.offset -= Vec2(radius);
+	bounds.size += Vec2(2 * radius);
+	return bounds;
+}
+
+} // namespace Anker
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <anker/core/anker_asset.hpp>
+#include <anker/graphics/anker_render_device.hpp>
+
+namespace Anker {
+
+class AssetCache;
+class SceneNode;
+struct ParticleEmitter;
+struct ParticlePool;
+
+// Draws the particles of each ParticleEmitter with a single instanced draw.
+// The quad of a particle is generated in the vertex shader, the instance
+// buffer only holds the visible particles.
+class ParticleRenderer {
+  public:
+	ParticleRenderer(RenderDevice&, AssetCache&);
+	ParticleRenderer(const ParticleRenderer&) = delete;
+	ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+	ParticleRenderer(ParticleRenderer&&) noexcept = delete;
+	ParticleRenderer& operator=(ParticleRenderer&&) noexcept = delete;
+
+	struct Instance {
+		Vec2 position;
+		float size = 0;
+		Vec4 color;
+
+		static const std::array<VertexInput, 3> ShaderInputs;
+	};
+
+	struct Packet {
+		VertexShader vertexShader;
+		PixelShader pixelShader;
+
+		struct Draw {
+			Vec2 parallax = Vec2(1);
+			ShaderViewRef texture; // Null draws round particles
+			u32 firstInstance = 0;
+			u32 instanceCount = 0;
+		};
+		std::vector<Draw> draws;
+		std::vector<Instance> instances;
+	};
+
+	// Clears the packet, called at the start of every frame's extraction.
+	void newFrame(Packet&);
+
+	// Appends the particles of the node's ParticleEmitter visible to a camera
+	// at the given position, see SpatialIndex::queryView. Returns false if
+	// there is nothing to draw.
+	bool extract(const SceneNode*, const Rect2& view, Vec2 cameraPosition, Packet&);
+
+	void draw(const Packet&, u32 drawIndex);
+
+	// Appends the particles overlapping the rectangle as instances, parallax is
+	// not taken into account. Returns the number of appended instances.
+	static u32 cull(const ParticlePool&, const Rect2&, std::vector<Instance>&);
+
+	// World bounds of the emitter's particles, including their size.
+	static Rect2 bounds(const ParticleEmitter&);
+
+  private:
+	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
+
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
+	AssetHandle<PixelShader> m_pixelShader;
+};
+
+} // namespace Anker
@@ -5,7 +5,7 @@
 namespace Anker {
 
 PostProcessRenderer::PostProcessRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
-    : ScreenRenderer(renderDevice, assetCache), m_renderDevice(renderDevice)
+    : ScreenRenderer(renderDevice, assetCache), m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
 	m_constantBuffer.info = {
 	    .name = "PostProcessing Constant Buffer",
@@ -18,19 +18,26 @@ PostProcessRenderer::PostProcessRenderer(RenderDevice& renderDevice, AssetCache&
 		ANKER_FATAL("Failed to create PostProcessing Constant Buffer");
 	}
 
-	m_pixelShader = assetCache.loadPixelShader("shaders/post_process.ps");
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/post_process.ps"_hs));
 }
 
-void PostProcessRenderer::draw(const PostProcessParams& params)
+void PostProcessRenderer::extract(const PostProcessParams& params, Packet& packet) const
+{
+	ScreenRenderer::extract(packet.screen);
+	packet.pixelShader = *m_assetCache.get(m_pixelShader);
+	packet.params = params;
+}
+
+void PostProcessRenderer::draw(const Packet& packet)
 {
 	ANKER_PROFILE_ZONE();
 
-	m_renderDevice.bindPixelShader(*m_pixelShader);
+	m_renderDevice.bindPixelShader(packet.pixelShader);
 
-	m_renderDevice.fillBuffer(m_constantBuffer, std::array{params});
+	m_renderDevice.fillBuffer(m_constantBuffer, std::array{packet.params});
 	m_renderDevice.bindBufferPS(0, m_constantBuffer);
 
-	ScreenRenderer::draw();
+	ScreenRenderer::draw(packet.screen);
 }
 
 } // namespace Anker
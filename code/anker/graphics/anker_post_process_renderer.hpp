@@ -17,12 +17,22 @@ class PostProcessRenderer : ScreenRenderer {
 	PostProcessRenderer(PostProcessRenderer&&) noexcept = delete;
 	PostProcessRenderer& operator=(PostProcessRenderer&&) noexcept = delete;
 
-	void draw(const PostProcessParams&);
+	struct Packet {
+		ScreenRenderer::Packet screen;
+		PixelShader pixelShader;
+		PostProcessParams params;
+	};
+
+	void extract(const PostProcessParams&, Packet&) const;
+
+	void draw(const Packet&);
 
   private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
 
-	AssetPtr<PixelShader> m_pixelShader;
+	AssetPins m_assetPins;
+	AssetHandle<PixelShader> m_pixelShader;
 	GpuBuffer m_constantBuffer;
 };
 
@@ -1,40 +1,47 @@
 #pragma once
 
+#include <anker/graphics/anker_gpu_types.hpp>
+#include <anker/graphics/anker_upload_ring.hpp>
+
 namespace Anker {
 
-enum class GpuBindFlag {
-	None = 0,
-	ConstantBuffer = 1 << 0,
-	VertexBuffer = 1 << 1,
-	IndexBuffer = 1 << 2,
-	Shader = 1 << 3,
-	RenderTarget = 1 << 4,
-	DepthStencil = 1 << 5,
-};
-ANKER_ENUM_FLAGS(GpuBindFlag)
+// Resources hold the handles of the backend, which is Direct3D 11, or a
+// software rasterizer in headless builds. Ref types keep a resource alive
+// beyond its owner, e.g. for draws of a FramePacket.
 
 ////////////////////////////////////////////////////////////
 // Shaders
 
-enum class Topology {
-	LineList = 2,
-	TriangleList = 4,
-	TriangleStrip = 5,
+struct VertexShaderInfo {
+	std::string name;
+	std::vector<VertexInput> inputs;
 };
 
-struct VertexShaderInfo {
+struct PixelShaderInfo {
 	std::string name;
-	std::vector<D3D11_INPUT_ELEMENT_DESC> inputs;
 };
 
+#if ANKER_HEADLESS
+
+// The engine's shaders mirrored in C++, see anker_render_device_software.cpp .
+struct SoftwareShader;
+
 struct VertexShader {
 	VertexShaderInfo info;
-	ComPtr<ID3D11VertexShader> shader;
-	ComPtr<ID3D11InputLayout> inputLayout;
+	const SoftwareShader* shader = nullptr;
 };
 
-struct PixelShaderInfo {
-	std::string name;
+struct PixelShader {
+	PixelShaderInfo info;
+	const SoftwareShader* shader = nullptr;
+};
+
+#else
+
+struct VertexShader {
+	VertexShaderInfo info;
+	ComPtr<ID3D11VertexShader> shader;
+	ComPtr<ID3D11InputLayout> inputLayout;
 };
 
 struct PixelShader {
@@ -42,91 +49,71 @@ struct PixelShader {
 	ComPtr<ID3D11PixelShader> shader;
 };
 
+#endif
+
 ////////////////////////////////////////////////////////////
 // GPU Buffers
 
-enum class GpuBufferFlag {
-	None = 0,
-	CpuWriteable = 1 << 0,
-	Structured = 1 << 1,
-};
-ANKER_ENUM_FLAGS(GpuBufferFlag)
+#if ANKER_HEADLESS
 
-struct GpuBufferInfo {
-	std::string name;
-	u32 size = 0;
-	u32 stride = 1;
-	GpuBindFlags bindFlags;
-	GpuBufferFlags flags;
+using GpuBufferRef = std::shared_ptr<const ByteBuffer>;
 
-	u32 elementCount() const { return size / stride; }
+struct GpuBuffer {
+	GpuBufferInfo info;
+	std::shared_ptr<ByteBuffer> buffer;
 };
 
+#else
+
+using GpuBufferRef = ComPtr<ID3D11Buffer>;
+
 struct GpuBuffer {
 	GpuBufferInfo info;
 	ComPtr<ID3D11Buffer> buffer;
 };
 
-////////////////////////////////////////////////////////////
-// Samplers
-
-enum class FilterMode { Point, Linear };
-enum class TexAddressMode { Wrap = 1, Mirror = 2, Clamp = 3, Border = 4, MirrorOnce = 5 };
-
-enum class CompareFunc {
-	Never = 1,
-	Less = 2,
-	Equal = 3,
-	LessEqual = 4,
-	Greater = 5,
-	NotEqual = 6,
-	GreaterEqual = 7,
-	Always = 8,
-};
+#endif
 
-struct SamplerDesc {
-	FilterMode filterMode = FilterMode::Point;
-	TexAddressMode addressModeU = TexAddressMode::Border;
-	TexAddressMode addressModeV = TexAddressMode::Border;
-	TexAddressMode addressModeW = TexAddressMode::Border;
-	CompareFunc compareFunc = CompareFunc::Never;
+// A range of one of RenderDevice's upload buffers. It is valid until the
+// upload buffer wraps around, which can happen on any later upload of the same
+// kind. Hence, bind or draw it right away.
+struct GpuBufferRange {
+	const GpuBuffer* buffer = nullptr;
+	u32 offset = 0; // Bytes
+	u32 size = 0;
+	u32 stride = 1;
 
-	friend auto operator<=>(const SamplerDesc&, const SamplerDesc&) = default;
+	u32 elementCount() const { return size / stride; }
 };
 
 ////////////////////////////////////////////////////////////
 // Textures
 
-enum class TextureFormat {
-	R16G16B16A16_UNORM = 11,
-	R8G8B8A8_UNORM = 28,
-	D32_FLOAT = 40,
-	R8_UNORM = 61,
-	BC7_UNORM = 98,
-};
-
-enum class TextureFlag {
-	None = 0,
-	CpuWriteable = 1 << 0,
-	Cubemap = 1 << 1,
-};
-ANKER_ENUM_FLAGS(TextureFlag)
+#if ANKER_HEADLESS
 
-struct TextureInfo {
-	std::string name;
+// Pixels are stored as RGBA floats in any format, the format determines the
+// conversion on upload and the precision of render target writes. Only the
+// first mip level and array slice are stored.
+struct SoftwareImage {
 	Vec2u size;
-	u32 mipLevels = 1;
-	u32 arraySize = 1;
 	TextureFormat format = TextureFormat::R8G8B8A8_UNORM;
-	GpuBindFlags bindFlags = GpuBindFlag::Shader;
-	TextureFlags flags;
+	std::vector<Vec4> pixels;
+
+	const Vec4& pixel(u32 x, u32 y) const { return pixels[usize(y) * size.x + x]; }
 };
 
-struct TextureInit {
-	const u8* data;
-	u32 rowPitch;
+using ShaderViewRef = std::shared_ptr<const SoftwareImage>;
+
+struct Texture {
+	TextureInfo info;
+	std::shared_ptr<SoftwareImage> texture;
+	ShaderViewRef shaderView; // Same image, if bound with GpuBindFlag::Shader
 };
 
+#else
+
+using ShaderViewRef = ComPtr<ID3D11ShaderResourceView>;
+
 struct Texture {
 	TextureInfo info;
 	ComPtr<ID3D11Texture2D> texture;
@@ -135,15 +122,7 @@ struct Texture {
 	ComPtr<ID3D11DepthStencilView> depthView;
 };
 
-////////////////////////////////////////////////////////////
-// Rasterizer
-
-struct RasterizerDesc {
-	bool wireframe = false;
-	bool depthClip = true;
-
-	friend auto operator<=>(const RasterizerDesc&, const RasterizerDesc&) = default;
-};
+#endif
 
 ////////////////////////////////////////////////////////////
 // Render Device
@@ -154,6 +133,12 @@ struct RasterizerDesc {
 // use GPU resources.
 //
 // We also manage the swap-chain and related buffers / views.
+//
+// Headless builds rasterize on the CPU instead, without window or GPU, such
+// that frames can be compared against golden images. Draws are queued and
+// rasterized on flush, which happens when the render target changes and on
+// present. Triangles are binned into screen tiles, tiles are rasterized in
+// parallel on the g_workerPool.
 class RenderDevice {
   public:
 	RenderDevice();
@@ -172,7 +157,7 @@ class RenderDevice {
 	Status createBuffer(GpuBuffer& buffer, Spannable auto const& init)
 	{
 		auto initView = std::span(init);
-		buffer.info.stride = sizeof(decltype(initView)::value_type);
+		buffer.info.stride = sizeof(typename decltype(initView)::value_type);
 		return createBuffer(buffer, std::span<const u8>(asBytes(initView)));
 	}
 
@@ -182,18 +167,19 @@ class RenderDevice {
 	template <typename T = u8>
 	T* mapBuffer(GpuBuffer& buffer)
 	{
-		return static_cast<T*>(mapResource(buffer.buffer.Get()));
+		return static_cast<T*>(mapResource(buffer));
 	}
 	void unmapBuffer(GpuBuffer&);
 
 	void fillBuffer(GpuBuffer& buffer, Spannable auto const& data)
 	{
 		auto dataView = std::span(data);
-		ANKER_CHECK(buffer.info.stride == sizeof(decltype(dataView)::value_type));
+		ANKER_CHECK(buffer.info.stride == sizeof(typename decltype(dataView)::value_type));
 
-		// Automatically grow buffer as needed.
+		// Automatically grow buffer as needed, geometrically to avoid
+		// recreating it repeatedly.
 		if (buffer.info.size < dataView.size_bytes()) {
-			buffer.info.size = u32(dataView.size_bytes());
+			buffer.info.size = std::max(u32(dataView.size_bytes()), buffer.info.size * 2);
 			if (not createBuffer(buffer)) {
 				ANKER_FATAL("Failed to grow {}", buffer.info.name);
 			}
@@ -204,6 +190,32 @@ class RenderDevice {
 		unmapBuffer(buffer);
 	}
 
+	////////////////////////////////////////////////////////////
+	// Transient Uploads
+
+	// Data that changes every draw, like sprite quads and their constants, is
+	// sub-allocated from large per-frame upload buffers instead of using a
+	// small buffer per renderer.
+
+	GpuBufferRange uploadVertices(Spannable auto const& vertices)
+	{
+		auto view = std::span(vertices);
+		return upload(m_vertexUploadBuffer, m_vertexUploadRing, asBytes(view),
+		              sizeof(typename decltype(view)::value_type), VertexUploadAlignment);
+	}
+
+	template <typename T>
+	GpuBufferRange uploadConstants(const T& constants)
+	{
+		static_assert(sizeof(T) % 16 == 0, "Constant Buffer size must be 16-byte aligned");
+		return upload(m_constantUploadBuffer, m_constantUploadRing, asBytes(std::span(&constants, 1)), sizeof(T),
+		              ConstantUploadAlignment);
+	}
+
+	// Binds a range of the constant upload buffer.
+	void bindBufferVS(u32 slot, const GpuBufferRange&);
+	void bindBufferPS(u32 slot, const GpuBufferRange&);
+
 	////////////////////////////////////////////////////////////
 	// Shaders
 
@@ -221,13 +233,21 @@ class RenderDevice {
 	// Creates a texture according to texture.info .
 	Status createTexture(Texture&, std::span<const TextureInit> = {});
 
+	// Copies pixels into the given region of the texture's first mip level.
+	// Not supported for CpuWriteable textures, use mapTexture instead. May be
+	// called while the RenderThread is drawing, see lockContext.
+	void updateTexture(Texture&, const Rect2u& region, const TextureInit&);
+
 	void bindTexturePS(u32 slot, const Texture&, const SamplerDesc& = {});
+
+	// Binds the fallback texture if the view is null.
+	void bindTexturePS(u32 slot, const ShaderViewRef&, const SamplerDesc& = {});
 	void unbindTexturePS(u32 slot);
 
 	template <typename T = u8>
 	T* mapTexture(const Texture& texture, u32* outRowPitch)
 	{
-		return static_cast<T*>(mapResource(texture.texture.Get(), outRowPitch));
+		return static_cast<T*>(mapResource(texture, outRowPitch));
 	}
 	void unmapTexture(const Texture&);
 
@@ -254,10 +274,20 @@ class RenderDevice {
 	void draw(u32 vertexCount, Topology = Topology::TriangleList);
 	void draw(const GpuBuffer& vertexBuffer, Topology = Topology::TriangleList);
 	void draw(const GpuBuffer& vertexBuffer, u32 vertexCount, Topology = Topology::TriangleList);
+	void draw(const GpuBuffer& vertexBuffer, u32 vertexCount, u32 firstVertex, Topology = Topology::TriangleList);
 	void draw(const GpuBuffer& vertexBuffer, const GpuBuffer& indexBuffer, u32 indexCount,
 	          Topology = Topology::TriangleList);
 
+	// For vertex buffers referenced beyond the lifetime of their GpuBuffer,
+	// e.g. by a FramePacket.
+	void draw(const GpuBufferRef& vertexBuffer, u32 stride, u32 vertexCount, Topology = Topology::TriangleList);
+
+	void draw(const GpuBufferRange& vertices, Topology = Topology::TriangleList);
+	void draw(const GpuBufferRange& vertices, u32 vertexCount, u32 firstVertex, Topology = Topology::TriangleList);
+
 	void drawInstanced(u32 vertexCount, u32 instanceCount);
+	// Instances are bound to slot 0, vertices are generated by the shader.
+	void drawInstanced(const GpuBufferRange& instances, u32 vertexCount, Topology = Topology::TriangleList);
 	void drawInstanced(const GpuBuffer& vertexBuffer, u32 vertexCount,         //
 	                   const GpuBuffer& instanceDataBuffer, u32 instanceCount, //
 	                   Topology = Topology::TriangleList);
@@ -272,25 +302,147 @@ class RenderDevice {
 	void imguiImplInit();
 	void imguiImplShutdown();
 	void imguiImplNewFrame();
-	void imguiImplRender();
+	void imguiImplRender(ImDrawData*);
 
 	////////////////////////////////////////////////////////////
 
+	// Ends the frame, upload buffers are grown if the frame's uploads did not
+	// fit.
 	void present();
 
+	// Synchronize present with the display's refresh rate.
+	bool vsync = true;
+
 	void onResize(Vec2i size);
 
 	const Texture& backBuffer() const { return m_backBuffer; }
 
 	const Texture& fallbackTexture() const { return m_fallbackTexture; }
 
+	// The immediate context is not thread-safe. The RenderThread holds this
+	// lock while drawing, the simulation thread only uses the context for
+	// texture updates, which lock it as well.
+	std::unique_lock<std::mutex> lockContext() { return std::unique_lock(m_contextMutex); }
+
+#if !ANKER_HEADLESS
 	// Avoid directly accessing these if possible:
 	ID3D11Device* device() { return m_device.Get(); }
 	ID3D11DeviceContext* context() { return m_context.Get(); }
+#endif
 
   private:
 	void createMainRenderTarget();
 
+	void* mapResource(GpuBuffer&);
+	void* mapResource(const Texture&, u32* outRowPitch);
+
+	// Initial sizes of the upload buffers, grown as needed.
+	static constexpr u32 VertexUploadCapacity = 1 << 20;
+	static constexpr u32 ConstantUploadCapacity = 256 << 10;
+
+	// Offsets of constant buffer bindings are in multiples of 16 constants.
+	static constexpr u32 VertexUploadAlignment = 16;
+	static constexpr u32 ConstantUploadAlignment = 256;
+
+	GpuBufferRange upload(GpuBuffer&, UploadRing&, std::span<const u8> data, u32 stride, u32 alignment);
+	void createUploadBuffer(GpuBuffer&, u32 size);
+
+	std::mutex m_contextMutex;
+
+	Texture m_backBuffer;
+	Texture m_fallbackTexture;
+
+	GpuBuffer m_vertexUploadBuffer;
+	UploadRing m_vertexUploadRing;
+	GpuBuffer m_constantUploadBuffer;
+	UploadRing m_constantUploadRing;
+
+#if ANKER_HEADLESS
+	static constexpr u32 MaxSlots = 2;
+
+	// POSITION, TEXCOORD, COLOR, and PSIZE, see ShaderSemantic.
+	static constexpr u32 MaxVertexInputs = 4;
+
+	// Input data of a draw, in the layout of the bound vertex shader's inputs.
+	struct DrawInputs {
+		std::span<const u8> vertices;
+		u32 vertexStride = 0;
+		std::span<const u8> instances;
+		u32 instanceStride = 0;
+		std::vector<u32> indices; // Empty for non-indexed draws
+		u32 vertexCount = 0;
+		u32 instanceCount = 1;
+	};
+
+	struct DrawState {
+		const SoftwareShader* pixelShader = nullptr;
+		ShaderViewRef texture;
+		SamplerDesc sampler;
+		bool alphaBlending = false;
+
+		// Copy of the constant buffer read by the pixel shader.
+		std::array<u8, 128> constants{};
+	};
+
+	struct Triangle {
+		// Edge functions, positive inside, relative to an origin on the edge.
+		std::array<glm::vec2, 3> edgeCoefficients;
+		std::array<glm::vec2, 3> edgeOrigins;
+		std::array<bool, 3> edgeTopLeft{};
+
+		// Interpolated attributes, relative to the first vertex.
+		glm::vec2 origin;
+		std::array<glm::vec4, 2> attributes;
+		std::array<glm::vec4, 2> attributesDx;
+		std::array<glm::vec4, 2> attributesDy;
+
+		Vec2i min;
+		Vec2i max;
+		u32 draw = 0;
+	};
+
+	// Output of the vertex shader, texture coordinates and color.
+	struct ShadedVertex {
+		glm::vec2 position; // Pixels
+		std::array<glm::vec4, 2> attributes;
+	};
+
+	void queueDraw(const DrawInputs&, Topology);
+	void queueTriangle(const ShadedVertex&, const ShadedVertex&, const ShadedVertex&);
+	void queueLine(const ShadedVertex&, const ShadedVertex&);
+
+	enum class BlockCoverage { None, Partial, Full };
+	static BlockCoverage classifyBlock(const Triangle&, i32 x0, i32 y0, i32 x1, i32 y1);
+	static u32 coverage4(const Triangle&, i32 x, i32 y);
+
+	// Rasterizes all queued draws.
+	void flush();
+	void rasterizeTile(u32 tile);
+
+	const SoftwareShader* m_vertexShader = nullptr;
+	const SoftwareShader* m_pixelShader = nullptr;
+
+	// Inputs of the bound vertex shader by semantic, unused ones have none.
+	std::array<VertexInput, MaxVertexInputs> m_vertexInputs{};
+
+	std::array<GpuBufferRange, MaxSlots> m_constantsVS{};
+	std::array<GpuBufferRange, MaxSlots> m_constantsPS{};
+	ShaderViewRef m_texture;
+	SamplerDesc m_sampler;
+	bool m_alphaBlending = false;
+
+	std::shared_ptr<SoftwareImage> m_renderTarget;
+
+	// Pixels are written in the texture's format, and decoded on unmap.
+	std::map<const SoftwareImage*, ByteBuffer> m_mappedTextures;
+
+	std::vector<DrawState> m_draws;
+	std::vector<Triangle> m_triangles;
+
+	// Triangle indices per tile, in submission order.
+	Vec2u m_tileCount;
+	std::vector<std::vector<u32>> m_tileTriangles;
+#else
 	ID3D11SamplerState* samplerStateFromDesc(const SamplerDesc&);
 	std::map<SamplerDesc, ComPtr<ID3D11SamplerState>> m_samplerStates;
 
@@ -302,15 +454,33 @@ class RenderDevice {
 
 	ComPtr<ID3D11Device> m_device;
 	ComPtr<ID3D11DeviceContext> m_context;
+	ComPtr<ID3D11DeviceContext1> m_context1;
 	ComPtr<IDXGIDevice3> m_dxgiDevice;
 	ComPtr<IDXGIAdapter> m_dxgiAdapter;
 	ComPtr<IDXGIFactory> m_dxgiFactory;
 	ComPtr<IDXGISwapChain> m_dxgiSwapchain;
 
 	ComPtr<ID3D11BlendState> m_alphaBlendState;
+#endif
+};
 
-	Texture m_backBuffer;
-	Texture m_fallbackTexture;
+#if ANKER_HEADLESS
+
+struct ImageDifference {
+	u32 differingPixels = 0;
+	float maxDifference = 0;
 };
 
+// Converts to 8-bit RGBA, e.g. the back buffer.
+Status writePng(const Texture&, const fs::path&);
+
+// Reads 8-bit RGBA, e.g. a golden image.
+Status readPng(Texture&, const fs::path&);
+
+// Pixels differ if any channel differs by more than the tolerance. Textures of
+// different size differ in every pixel.
+ImageDifference compareImages(const Texture&, const Texture&, float tolerance = 1.0f / 255.0f);
+
+#endif
+
 } // namespace Anker
@@ -0,0 +1,711 @@
+#include <anker/graphics/anker_render_device.hpp>
+
+#if !ANKER_HEADLESS
+
+#include <imgui_impl_dx11.h>
+
+#include <anker/core/anker_data_loader.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+namespace Anker {
+
+const auto ShaderFileExtension = ".fxo";
+
+static D3D11_SAMPLER_DESC convertSamplerDesc(const SamplerDesc& desc)
+{
+	auto filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+	switch (desc.filterMode) {
+	case FilterMode::Point: filter = D3D11_FILTER_MIN_MAG_MIP_POINT; break;
+	case FilterMode::Linear: filter = D3D11_FILTER_MINIMUM_MIN_MAG_MIP_LINEAR; break;
+	}
+
+	return {
+	    .Filter = filter,
+	    .AddressU = D3D11_TEXTURE_ADDRESS_MODE(desc.addressModeU),
+	    .AddressV = D3D11_TEXTURE_ADDRESS_MODE(desc.addressModeV),
+	    .AddressW = D3D11_TEXTURE_ADDRESS_MODE(desc.addressModeW),
+	    .ComparisonFunc = D3D11_COMPARISON_FUNC(desc.compareFunc),
+	};
+}
+
+RenderDevice::RenderDevice()
+    : m_vertexUploadRing(VertexUploadCapacity), m_constantUploadRing(ConstantUploadCapacity)
+{
+	const D3D_FEATURE_LEVEL levels[] = {
+	    D3D_FEATURE_LEVEL_11_0,
+	    D3D_FEATURE_LEVEL_11_1,
+	};
+
+	const auto deviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT //
+	                       | D3D11_CREATE_DEVICE_DEBUG;
+
+	HRESULT hresult = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, 0, deviceFlags, levels, ARRAYSIZE(levels),
+	                                    D3D11_SDK_VERSION, &m_device, nullptr, &m_context);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("D3D11CreateDevice failed: {}", win32ErrorMessage(hresult));
+	}
+
+	m_device.As(&m_dxgiDevice);
+
+	// Binding sub-ranges of the constant upload buffer requires Direct3D 11.1.
+	{
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+		hresult = m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+		if (FAILED(hresult) || !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer) {
+			ANKER_FATAL("Constant buffer offsetting not supported");
+		}
+
+		hresult = m_context.As(&m_context1);
+		if (FAILED(hresult)) {
+			ANKER_FATAL("ID3D11DeviceContext1 not available: {}", win32ErrorMessage(hresult));
+		}
+	}
+
+	hresult = m_dxgiDevice->GetAdapter(&m_dxgiAdapter);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("IDXGIDevice::GetAdapter failed: {}", win32ErrorMessage(hresult));
+	}
+
+	hresult = m_dxgiAdapter->GetParent(IID_PPV_ARGS(&m_dxgiFactory));
+	if (FAILED(hresult)) {
+		ANKER_FATAL("IDXGIObject::GetParent failed: {}", win32ErrorMessage(hresult));
+	}
+
+	DXGI_SWAP_CHAIN_DESC swapchainDesc{
+	    // BGRA format is preferred as this format is common among display
+	    // controllers.
+	    .BufferDesc = {.Format = DXGI_FORMAT_B8G8R8A8_UNORM},
+
+	    .SampleDesc = {.Count = 1},
+	    .BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT,
+	    .BufferCount = 2,
+	    .OutputWindow = Platform::nativeWindow(),
+	    .Windowed = true,
+	    .SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD,
+	    .Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING,
+	};
+
+	hresult = m_dxgiFactory->CreateSwapChain(m_device.Get(), &swapchainDesc, &m_dxgiSwapchain);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("IDXGIFactory::CreateSwapChain failed: {}", win32ErrorMessage(hresult));
+	}
+
+	createMainRenderTarget();
+
+	setRasterizer();
+
+	m_vertexUploadBuffer.info = {
+	    .name = "Vertex Upload Buffer",
+	    .bindFlags = GpuBindFlag::VertexBuffer,
+	    .flags = GpuBufferFlag::CpuWriteable,
+	};
+	createUploadBuffer(m_vertexUploadBuffer, m_vertexUploadRing.capacity());
+
+	m_constantUploadBuffer.info = {
+	    .name = "Constant Upload Buffer",
+	    .bindFlags = GpuBindFlag::ConstantBuffer,
+	    .flags = GpuBufferFlag::CpuWriteable,
+	};
+	createUploadBuffer(m_constantUploadBuffer, m_constantUploadRing.capacity());
+
+	if (not loadTexture(m_fallbackTexture, "fallback/fallback_texture")) {
+		ANKER_ERROR("Fallback texture could not be loaded!");
+	}
+}
+
+Status RenderDevice::createBuffer(GpuBuffer& buffer, std::span<const u8> init)
+{
+	buffer.info.size = std::max(buffer.info.size, u32(init.size()));
+	ANKER_CHECK(buffer.info.size != 0, InvalidArgumentError);
+
+	buffer.buffer.Reset();
+
+	D3D11_BUFFER_DESC desc{
+	    .ByteWidth = buffer.info.size,
+	    .Usage = D3D11_USAGE_DEFAULT,
+	};
+
+	if (buffer.info.bindFlags & GpuBindFlag::ConstantBuffer) {
+		desc.BindFlags |= D3D11_BIND_CONSTANT_BUFFER;
+	}
+	if (buffer.info.bindFlags & GpuBindFlag::VertexBuffer) {
+		desc.BindFlags |= D3D11_BIND_VERTEX_BUFFER;
+	}
+	if (buffer.info.bindFlags & GpuBindFlag::IndexBuffer) {
+		desc.BindFlags |= D3D11_BIND_INDEX_BUFFER;
+	}
+
+	if (buffer.info.flags & GpuBufferFlag::CpuWriteable) {
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.CPUAccessFlags |= D3D11_CPU_ACCESS_WRITE;
+	}
+	if (buffer.info.flags & GpuBufferFlag::Structured) {
+		desc.StructureByteStride = buffer.info.stride;
+		desc.MiscFlags |= D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	}
+
+	const D3D11_SUBRESOURCE_DATA dxInit{.pSysMem = init.data()};
+
+	HRESULT hresult = m_device->CreateBuffer(&desc, init.empty() ? nullptr : &dxInit, &buffer.buffer);
+	if (FAILED(hresult)) {
+		ANKER_ERROR("{}: CreateBuffer failed: {}", buffer.info.name, win32ErrorMessage(hresult));
+		return GraphicsError;
+	}
+
+	buffer.buffer->SetPrivateData(WKPDID_D3DDebugObjectName, UINT(buffer.info.name.size()), buffer.info.name.data());
+	return Ok;
+}
+
+void RenderDevice::bindBufferVS(u32 slot, const GpuBuffer& buffer)
+{
+	m_context->VSSetConstantBuffers(slot, 1, buffer.buffer.GetAddressOf());
+}
+
+void RenderDevice::bindBufferPS(u32 slot, const GpuBuffer& buffer)
+{
+	m_context->PSSetConstantBuffers(slot, 1, buffer.buffer.GetAddressOf());
+}
+
+void* RenderDevice::mapResource(GpuBuffer& buffer)
+{
+	return mapResource(buffer.buffer.Get());
+}
+
+void RenderDevice::unmapBuffer(GpuBuffer& buffer)
+{
+	unmapResource(buffer.buffer.Get());
+}
+
+void RenderDevice::bindBufferVS(u32 slot, const GpuBufferRange& range)
+{
+	const UINT firstConstant = range.offset / 16;
+	const UINT constantCount = (range.size + ConstantUploadAlignment - 1) / ConstantUploadAlignment * 16;
+	m_context1->VSSetConstantBuffers1(slot, 1, range.buffer->buffer.GetAddressOf(), &firstConstant, &constantCount);
+}
+
+void RenderDevice::bindBufferPS(u32 slot, const GpuBufferRange& range)
+{
+	const UINT firstConstant = range.offset / 16;
+	const UINT constantCount = (range.size + ConstantUploadAlignment - 1) / ConstantUploadAlignment * 16;
+	m_context1->PSSetConstantBuffers1(slot, 1, range.buffer->buffer.GetAddressOf(), &firstConstant, &constantCount);
+}
+
+GpuBufferRange RenderDevice::upload(GpuBuffer& buffer, UploadRing& ring, std::span<const u8> data, u32 stride,
+                                    u32 alignment)
+{
+	// Bound constant ranges are a multiple of the alignment, which must not
+	// exceed the buffer.
+	const u32 size = (u32(data.size()) + alignment - 1) & ~(alignment - 1);
+
+	auto allocation = ring.allocate(size, alignment);
+	if (!allocation) {
+		// The only case where an upload buffer is recreated mid-frame.
+		ANKER_WARN("{}: Upload of {} bytes exceeds capacity", buffer.info.name, size);
+		ring.grow(size);
+		createUploadBuffer(buffer, ring.capacity());
+		allocation = ring.allocate(size, alignment);
+	}
+
+	// No-overwrite lets the GPU continue reading earlier ranges of the buffer.
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	const auto mapType = allocation->discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	HRESULT hresult = m_context->Map(buffer.buffer.Get(), 0, mapType, 0, &mappedResource);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("ID3D11DeviceContext::Map failed: {}", win32ErrorMessage(hresult));
+	}
+	std::ranges::copy(data, static_cast<u8*>(mappedResource.pData) + allocation->offset);
+	m_context->Unmap(buffer.buffer.Get(), 0);
+
+	return {.buffer = &buffer, .offset = allocation->offset, .size = u32(data.size()), .stride = stride};
+}
+
+Status RenderDevice::loadVertexShader(VertexShader& vertexShader, std::string_view identifier)
+{
+	ANKER_PROFILE_ZONE_T(identifier);
+
+	vertexShader.info.name = identifier;
+	vertexShader.shader.Reset();
+	vertexShader.inputLayout.Reset();
+
+	ByteBuffer binary;
+	ANKER_TRY(g_assetDataLoader.load(binary, std::string{identifier} + ShaderFileExtension));
+
+	HRESULT hresult = m_device->CreateVertexShader(binary.data(), binary.size(), nullptr, &vertexShader.shader);
+	if (FAILED(hresult)) {
+		ANKER_ERROR("{}: CreateVertexShader failed: {}", identifier, win32ErrorMessage(hresult));
+		return GraphicsError;
+	}
+
+	if (!vertexShader.info.inputs.empty()) {
+		std::vector<D3D11_INPUT_ELEMENT_DESC> elements;
+		for (const auto& input : vertexShader.info.inputs) {
+			elements.push_back({
+			    .SemanticName = input.semantic,
+			    .SemanticIndex = input.semanticIndex,
+			    .Format = DXGI_FORMAT(input.format),
+			    .AlignedByteOffset = input.offset,
+			    .InputSlotClass = input.perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA,
+			    .InstanceDataStepRate = input.perInstance ? 1u : 0u,
+			});
+		}
+
+		hresult = m_device->CreateInputLayout(elements.data(), UINT(elements.size()), binary.data(), binary.size(),
+		                                      &vertexShader.inputLayout);
+		if (FAILED(hresult)) {
+			ANKER_ERROR("{}: CreateInputLayout failed: {}", identifier, win32ErrorMessage(hresult));
+			return GraphicsError;
+		}
+	}
+
+	vertexShader.shader->SetPrivateData(WKPDID_D3DDebugObjectName, UINT(identifier.size()), identifier.data());
+
+	return Ok;
+}
+
+Status RenderDevice::loadPixelShader(PixelShader& pixelShader, std::string_view identifier)
+{
+	ANKER_PROFILE_ZONE_T(identifier);
+
+	pixelShader.info.name = identifier;
+	pixelShader.shader.Reset();
+
+	ByteBuffer binary;
+	ANKER_TRY(g_assetDataLoader.load(binary, std::string{identifier} + ShaderFileExtension));
+
+	HRESULT hresult = m_device->CreatePixelShader(binary.data(), binary.size(), nullptr, &pixelShader.shader);
+	if (FAILED(hresult)) {
+		ANKER_ERROR("{}: CreatePixelShader failed: {}", identifier, win32ErrorMessage(hresult));
+		return GraphicsError;
+	}
+
+	pixelShader.shader->SetPrivateData(WKPDID_D3DDebugObjectName, UINT(identifier.size()), identifier.data());
+
+	return Ok;
+}
+
+void RenderDevice::bindVertexShader(const VertexShader& vertexShader)
+{
+	m_context->IASetInputLayout(vertexShader.inputLayout.Get());
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	m_context->VSSetShader(vertexShader.shader.Get(), nullptr, 0);
+}
+
+void RenderDevice::bindPixelShader(const PixelShader& pixelShader)
+{
+	m_context->PSSetShader(pixelShader.shader.Get(), nullptr, 0);
+}
+
+Status RenderDevice::createTexture(Texture& texture, std::span<const TextureInit> inits)
+{
+	ANKER_CHECK(texture.info.size != Vec2u(0), InvalidArgumentError);
+
+	D3D11_TEXTURE2D_DESC desc{
+	    .Width = texture.info.size.x,
+	    .Height = texture.info.size.y,
+	    .MipLevels = texture.info.mipLevels,
+	    .ArraySize = texture.info.arraySize,
+	    .Format = static_cast<DXGI_FORMAT>(texture.info.format),
+	    .SampleDesc = {.Count = 1},
+	    .Usage = D3D11_USAGE_DEFAULT,
+	};
+
+	if (texture.info.bindFlags & GpuBindFlag::Shader) {
+		desc.BindFlags |= D3D11_BIND_SHADER_RESOURCE;
+	}
+	if (texture.info.bindFlags & GpuBindFlag::RenderTarget) {
+		desc.BindFlags |= D3D11_BIND_RENDER_TARGET;
+	}
+	if (texture.info.bindFlags & GpuBindFlag::DepthStencil) {
+		desc.BindFlags |= D3D11_BIND_DEPTH_STENCIL;
+	}
+
+	if (texture.info.flags & TextureFlag::CpuWriteable) {
+		desc.Usage = D3D11_USAGE_DYNAMIC;
+		desc.CPUAccessFlags |= D3D11_CPU_ACCESS_WRITE;
+	}
+	if (texture.info.flags & TextureFlag::Cubemap) {
+		desc.MiscFlags |= D3D11_RESOURCE_MISC_TEXTURECUBE;
+	}
+
+	std::vector<D3D11_SUBRESOURCE_DATA> dxInits;
+	for (const auto& init : inits) {
+		dxInits.push_back(D3D11_SUBRESOURCE_DATA{
+		    .pSysMem = init.data,
+		    .SysMemPitch = init.rowPitch,
+		});
+	}
+
+	HRESULT hresult = m_device->CreateTexture2D(&desc, dxInits.empty() ? nullptr : dxInits.data(), &texture.texture);
+	if (FAILED(hresult)) {
+		ANKER_ERROR("{}: CreateTexture2D failed: {}", texture.info.name, win32ErrorMessage(hresult));
+		return GraphicsError;
+	}
+
+	if (desc.BindFlags & D3D11_BIND_SHADER_RESOURCE) {
+		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc{
+		    .Format = desc.Format,
+		    .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+		    .Texture2D = {.MipLevels = UINT(-1)},
+		};
+
+		if (texture.info.flags & TextureFlag::Cubemap) {
+			viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+			viewDesc.TextureCube = {.MipLevels = desc.MipLevels};
+		}
+
+		hresult = m_device->CreateShaderResourceView(texture.texture.Get(), &viewDesc, &texture.shaderView);
+		if (FAILED(hresult)) {
+			ANKER_ERROR("{}: CreateShaderResourceView failed: {}", texture.info.name, win32ErrorMessage(hresult));
+			return GraphicsError;
+		}
+	}
+
+	if (desc.BindFlags & D3D11_BIND_RENDER_TARGET) {
+		hresult = m_device->CreateRenderTargetView(texture.texture.Get(), nullptr, &texture.renderTargetView);
+		if (FAILED(hresult)) {
+			ANKER_ERROR("{}: CreateRenderTargetView failed: {}", texture.info.name, win32ErrorMessage(hresult));
+			return GraphicsError;
+		}
+	}
+
+	if (desc.BindFlags & D3D11_BIND_DEPTH_STENCIL) {
+		const D3D11_DEPTH_STENCIL_VIEW_DESC viewDesc{
+		    .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
+		};
+		hresult = m_device->CreateDepthStencilView(texture.texture.Get(), &viewDesc, &texture.depthView);
+		if (FAILED(hresult)) {
+			ANKER_ERROR("{}: CreateDepthStencilView failed: {}", texture.info.name, win32ErrorMessage(hresult));
+			return GraphicsError;
+		}
+	}
+
+	texture.texture->SetPrivateData(WKPDID_D3DDebugObjectName, //
+	                                UINT(texture.info.name.size()), texture.info.name.data());
+	return Ok;
+}
+
+void RenderDevice::bindTexturePS(u32 slot, const ShaderViewRef& shaderView, const SamplerDesc& samplerDesc)
+{
+	auto* samplerState = samplerStateFromDesc(samplerDesc);
+	m_context->PSSetSamplers(slot, 1, &samplerState);
+
+	if (shaderView) {
+		m_context->PSSetShaderResources(slot, 1, shaderView.GetAddressOf());
+	} else {
+		m_context->PSSetShaderResources(slot, 1, m_fallbackTexture.shaderView.GetAddressOf());
+	}
+}
+
+void RenderDevice::unbindTexturePS(u32 slot)
+{
+	ID3D11ShaderResourceView* none = nullptr;
+	m_context->PSSetShaderResources(slot, 1, &none);
+}
+
+void* RenderDevice::mapResource(const Texture& texture, u32* outRowPitch)
+{
+	return mapResource(texture.texture.Get(), outRowPitch);
+}
+
+void RenderDevice::unmapTexture(const Texture& texture)
+{
+	unmapResource(texture.texture.Get());
+}
+
+void RenderDevice::updateTexture(Texture& texture, const Rect2u& region, const TextureInit& init)
+{
+	ANKER_CHECK(!(texture.info.flags & TextureFlag::CpuWriteable));
+	ANKER_CHECK(region.offset.x + region.size.x <= texture.info.size.x);
+	ANKER_CHECK(region.offset.y + region.size.y <= texture.info.size.y);
+
+	D3D11_BOX box{
+	    .left = region.offset.x,
+	    .top = region.offset.y,
+	    .front = 0,
+	    .right = region.offset.x + region.size.x,
+	    .bottom = region.offset.y + region.size.y,
+	    .back = 1,
+	};
+
+	std::scoped_lock lock(m_contextMutex);
+	m_context->UpdateSubresource(texture.texture.Get(), 0, &box, init.data, init.rowPitch, 0);
+}
+
+void RenderDevice::setRasterizer(const RasterizerDesc& desc)
+{
+	auto* r = rasterizerStateFromDesc(desc);
+	m_context->RSSetState(r);
+}
+
+void RenderDevice::setRenderTarget(const Texture& target, const Texture* depth)
+{
+	m_context->OMSetRenderTargets(1, target.renderTargetView.GetAddressOf(), //
+	                              depth ? depth->depthView.Get() : nullptr);
+}
+
+void RenderDevice::clearRenderTarget(const Texture& target, const Texture* depth, const Vec3& clearColor)
+{
+	m_context->ClearRenderTargetView(target.renderTargetView.Get(), &clearColor.x);
+	if (depth) {
+		m_context->ClearDepthStencilView(depth->depthView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+	}
+}
+
+void RenderDevice::enableAlphaBlending()
+{
+	if (!m_alphaBlendState) {
+		D3D11_BLEND_DESC blendStateDesc{};
+		blendStateDesc.RenderTarget[0] = {
+		    .BlendEnable = true,
+		    .SrcBlend = D3D11_BLEND_SRC_ALPHA,
+		    .DestBlend = D3D11_BLEND_INV_SRC_ALPHA,
+		    .BlendOp = D3D11_BLEND_OP_ADD,
+		    .SrcBlendAlpha = D3D11_BLEND_ONE,
+		    .DestBlendAlpha = D3D11_BLEND_ZERO,
+		    .BlendOpAlpha = D3D11_BLEND_OP_ADD,
+		    .RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL,
+		};
+		m_device->CreateBlendState(&blendStateDesc, &m_alphaBlendState);
+	}
+
+	m_context->OMSetBlendState(m_alphaBlendState.Get(), 0, 0xffffffff);
+}
+
+void RenderDevice::bindRenderTargetPS(u32 slot, const Texture& texture, const SamplerDesc& samplerDesc)
+{
+	auto* samplerState = samplerStateFromDesc(samplerDesc);
+	m_context->PSSetSamplers(slot, 1, &samplerState);
+	m_context->PSSetShaderResources(slot, 1, texture.shaderView.GetAddressOf());
+}
+
+void RenderDevice::draw(u32 vertexCount, Topology topology)
+{
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->Draw(vertexCount, 0);
+}
+
+void RenderDevice::draw(const GpuBuffer& vertexBuffer, u32 vertexCount, u32 firstVertex, Topology topology)
+{
+	UINT offset = 0;
+	m_context->IASetVertexBuffers(0, 1, vertexBuffer.buffer.GetAddressOf(), &vertexBuffer.info.stride, &offset);
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->Draw(vertexCount, firstVertex);
+}
+
+void RenderDevice::draw(const GpuBuffer& vertexBuffer, const GpuBuffer& indexBuffer, u32 indexCount, Topology topology)
+{
+	UINT offset = 0;
+	m_context->IASetVertexBuffers(0, 1, vertexBuffer.buffer.GetAddressOf(), &vertexBuffer.info.stride, &offset);
+	m_context->IASetIndexBuffer(indexBuffer.buffer.Get(),                                                   //
+	                            indexBuffer.info.stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, //
+	                            0);
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->DrawIndexed(indexCount, 0, 0);
+}
+
+void RenderDevice::draw(const GpuBufferRef& vertexBuffer, u32 stride, u32 vertexCount, Topology topology)
+{
+	UINT offset = 0;
+	m_context->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->Draw(vertexCount, 0);
+}
+
+void RenderDevice::draw(const GpuBufferRange& vertices, u32 vertexCount, u32 firstVertex, Topology topology)
+{
+	m_context->IASetVertexBuffers(0, 1, vertices.buffer->buffer.GetAddressOf(), &vertices.stride, &vertices.offset);
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->Draw(vertexCount, firstVertex);
+}
+
+void RenderDevice::drawInstanced(u32 vertexCount, u32 instanceCount)
+{
+	m_context->DrawInstanced(vertexCount, instanceCount, 0, 0);
+}
+
+void RenderDevice::drawInstanced(const GpuBufferRange& instances, u32 vertexCount, Topology topology)
+{
+	m_context->IASetVertexBuffers(0, 1, instances.buffer->buffer.GetAddressOf(), &instances.stride, &instances.offset);
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->DrawInstanced(vertexCount, instances.elementCount(), 0, 0);
+}
+
+void RenderDevice::drawInstanced(const GpuBuffer& vertexBuffer, u32 vertexCount,     //
+                                 const GpuBuffer& instanceBuffer, u32 instanceCount, //
+                                 Topology topology)
+{
+	std::array buffers{vertexBuffer.buffer.Get(), instanceBuffer.buffer.Get()};
+	std::array strides{vertexBuffer.info.stride, instanceBuffer.info.stride};
+	std::array offsets{0u, 0u};
+	m_context->IASetVertexBuffers(0, 2, buffers.data(), strides.data(), offsets.data());
+
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->DrawInstanced(vertexCount, instanceCount, 0, 0);
+}
+
+void RenderDevice::drawInstanced(const GpuBuffer& vertexBuffer,                      //
+                                 const GpuBuffer& indexBuffer, u32 indexCount,       //
+                                 const GpuBuffer& instanceBuffer, u32 instanceCount, //
+                                 Topology topology)
+{
+	std::array buffers{vertexBuffer.buffer.Get(), instanceBuffer.buffer.Get()};
+	std::array strides{vertexBuffer.info.stride, instanceBuffer.info.stride};
+	std::array offsets{0u, 0u};
+	m_context->IASetVertexBuffers(0, 2, buffers.data(), strides.data(), offsets.data());
+
+	m_context->IASetIndexBuffer(indexBuffer.buffer.Get(),                                                   //
+	                            indexBuffer.info.stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, //
+	                            0);
+
+	m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(topology));
+	m_context->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
+}
+
+void RenderDevice::imguiImplInit()
+{
+	ImGui_ImplDX11_Init(m_device.Get(), m_context.Get());
+}
+
+void RenderDevice::imguiImplShutdown()
+{
+	ImGui_ImplDX11_Shutdown();
+}
+
+void RenderDevice::imguiImplNewFrame()
+{
+	ImGui_ImplDX11_NewFrame();
+}
+
+void RenderDevice::imguiImplRender(ImDrawData* drawData)
+{
+	ImGui_ImplDX11_RenderDrawData(drawData);
+}
+
+void RenderDevice::present()
+{
+	m_dxgiSwapchain->Present(vsync ? 1 : 0, 0);
+	// m_dxgiSwapchain->Present(0, DXGI_PRESENT_ALLOW_TEARING);
+
+	// Growing between frames, nothing refers to the upload buffers.
+	if (m_vertexUploadRing.endFrame()) {
+		createUploadBuffer(m_vertexUploadBuffer, m_vertexUploadRing.capacity());
+	}
+	if (m_constantUploadRing.endFrame()) {
+		createUploadBuffer(m_constantUploadBuffer, m_constantUploadRing.capacity());
+	}
+}
+
+void RenderDevice::onResize(Vec2i)
+{
+	// Need to release reference to backBuffer before resizing swap chain.
+	m_backBuffer.texture.Reset();
+	m_backBuffer.renderTargetView.Reset();
+
+	HRESULT hresult = m_dxgiSwapchain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("IDXGISwapChain::ResizeBuffers failed: {}", win32ErrorMessage(hresult));
+	}
+
+	createMainRenderTarget();
+}
+
+void RenderDevice::createMainRenderTarget()
+{
+	// Grab back buffer from swap chain
+	HRESULT hresult = m_dxgiSwapchain->GetBuffer(0, IID_ID3D11Texture2D, &m_backBuffer.texture);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("IDXGISwapChain::GetBuffer failed: {}", win32ErrorMessage(hresult));
+	}
+
+	// Update TextureInfo
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		m_backBuffer.texture->GetDesc(&desc);
+
+		m_backBuffer.info = TextureInfo{
+		    .name = "Back Buffer",
+		    .size = {desc.Width, desc.Height},
+		    .mipLevels = desc.MipLevels,
+		    .arraySize = desc.ArraySize,
+		    .format = TextureFormat(desc.Format),
+		};
+	}
+
+	// Setup back buffer view
+	hresult = m_device->CreateRenderTargetView(m_backBuffer.texture.Get(), nullptr, &m_backBuffer.renderTargetView);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("ID3D11Device::CreateRenderTargetView failed: {}", win32ErrorMessage(hresult));
+	}
+
+	// Set Viewport
+	const D3D11_VIEWPORT viewportParams{
+	    .Width = float(m_backBuffer.info.size.x),
+	    .Height = float(m_backBuffer.info.size.y),
+	    .MaxDepth = 1,
+	};
+	m_context->RSSetViewports(1, &viewportParams);
+}
+
+ID3D11SamplerState* RenderDevice::samplerStateFromDesc(const SamplerDesc& desc)
+{
+	if (auto it = m_samplerStates.find(desc); it != m_samplerStates.end()) {
+		return it->second.Get();
+	}
+
+	ComPtr<ID3D11SamplerState> sampler;
+	const auto d3d11Desc = convertSamplerDesc(desc);
+	HRESULT hresult = m_device->CreateSamplerState(&d3d11Desc, &sampler);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("ID3D11Device::CreateSamplerState failed: {}", win32ErrorMessage(hresult));
+	}
+
+	m_samplerStates[desc] = sampler;
+	return sampler.Get();
+}
+
+ID3D11RasterizerState* RenderDevice::rasterizerStateFromDesc(const RasterizerDesc& desc)
+{
+	if (auto it = m_rasterizerStates.find(desc); it != m_rasterizerStates.end()) {
+		return it->second.Get();
+	}
+
+	ComPtr<ID3D11RasterizerState> rasterizer;
+	const D3D11_RASTERIZER_DESC d3d11Desc{
+	    .FillMode = desc.wireframe ? D3D11_FILL_WIREFRAME : D3D11_FILL_SOLID,
+	    .CullMode = D3D11_CULL_NONE,
+	    .DepthClipEnable = desc.depthClip,
+	};
+	HRESULT hresult = m_device->CreateRasterizerState(&d3d11Desc, &rasterizer);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("ID3D11Device::CreateRasterizerState failed: {}", win32ErrorMessage(hresult));
+	}
+
+	m_rasterizerStates[desc] = rasterizer;
+	return rasterizer.Get();
+}
+
+void* RenderDevice::mapResource(ID3D11Resource* resource, u32* outRowPitch, u32* outDepthPitch)
+{
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	HRESULT hresult = m_context->Map(resource, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+	if (FAILED(hresult)) {
+		ANKER_FATAL("ID3D11DeviceContext::Map failed: {}", win32ErrorMessage(hresult));
+	}
+	if (outRowPitch) {
+		*outRowPitch = mappedResource.RowPitch;
+	}
+	if (outDepthPitch) {
+		*outDepthPitch = mappedResource.DepthPitch;
+	}
+	return mappedResource.pData;
+}
+
+void RenderDevice::unmapResource(ID3D11Resource* resource)
+{
+	m_context->Unmap(resource, 0);
+}
+
+} // namespace Anker
+
+#endif
@@ -0,0 +1,1367 @@
+#include <anker/graphics/anker_render_device.hpp>
+
+#if ANKER_HEADLESS
+
+#include <stb_image_write.h>
+
+#include <anker/common/anker_image_utils.hpp>
+#include <anker/common/anker_worker_pool.hpp>
+#include <anker/graphics/anker_post_process_params.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ANKER_SOFTWARE_RASTERIZER_SSE2
+#endif
+
+namespace Anker {
+
+// Tiles are small enough to balance work across threads and large enough to
+// keep binning cheap.
+const i32 TileSize = 64;
+
+// Tiles are rasterized in blocks, which are tested against the triangle as a
+// whole first.
+const i32 BlockSize = 8;
+
+// Vertices are snapped to the sub-pixel grid of D3D11, which avoids cracks and
+// makes results independent of where a primitive is located.
+const float SubPixelPrecision = 256.0f;
+
+////////////////////////////////////////////////////////////
+// Shaders
+
+enum class ShaderProgram { Sprite, Text, TextSdf, Gizmo, Screen, PostProcess, Particle };
+
+// The engine's shaders mirrored in C++, identified like their compiled
+// counterparts. Constant buffers are bound to the same slots.
+struct SoftwareShader {
+	std::string_view identifier;
+	ShaderProgram program;
+};
+
+// sprite.hlsl and map.hlsl are identical.
+const std::array SoftwareShaders = {
+    SoftwareShader{"shaders/sprite.vs", ShaderProgram::Sprite},
+    SoftwareShader{"shaders/sprite.ps", ShaderProgram::Sprite},
+    SoftwareShader{"shaders/map.vs", ShaderProgram::Sprite},
+    SoftwareShader{"shaders/map.ps", ShaderProgram::Sprite},
+    SoftwareShader{"shaders/text.vs", ShaderProgram::Text},
+    SoftwareShader{"shaders/text.ps", ShaderProgram::Text},
+    SoftwareShader{"shaders/text_sdf.ps", ShaderProgram::TextSdf},
+    SoftwareShader{"shaders/gizmo.vs", ShaderProgram::Gizmo},
+    SoftwareShader{"shaders/gizmo.ps", ShaderProgram::Gizmo},
+    SoftwareShader{"shaders/screen.vs", ShaderProgram::Screen},
+    SoftwareShader{"shaders/post_process.ps", ShaderProgram::PostProcess},
+    SoftwareShader{"shaders/particle.vs", ShaderProgram::Particle},
+    SoftwareShader{"shaders/particle.ps", ShaderProgram::Particle},
+};
+
+static Status findSoftwareShader(const SoftwareShader*& outShader, std::string_view identifier)
+{
+	for (auto& shader : SoftwareShaders) {
+		if (shader.identifier == identifier) {
+			outShader = &shader;
+			return Ok;
+		}
+	}
+
+	ANKER_ERROR("{}: No software version of this shader", identifier);
+	return NotImplementedError;
+}
+
+// Vertex inputs read by the mirrored vertex shaders.
+enum class ShaderSemantic { Position, Texcoord, Color, Size };
+const std::array ShaderSemanticNames = {"POSITION", "TEXCOORD", "COLOR", "PSIZE"};
+
+// Mirrors of the constant buffers, see scene_cb.h.hlsl, sprite.hlsl, map.hlsl,
+// and particle.hlsl .
+struct SceneConstants {
+	Mat4 view = Mat4Id;
+	Vec2 cameraPosition;
+	Vec2 _pad;
+};
+
+struct SpriteConstants {
+	Mat4 transform = Mat4Id;
+	Vec4 color = Vec4(1);
+	Vec2 parallax = Vec2(1);
+	Vec2 _pad;
+};
+
+struct ParticleConstants {
+	Vec2 parallax = Vec2(1);
+	u32 textured = 0;
+	u32 _pad = 0;
+};
+
+// Unbound constant buffers read as defaults, e.g. sprites without constants are
+// drawn opaque white.
+template <typename T>
+static T readConstants(const GpuBufferRange& range)
+{
+	T constants;
+	if (range.buffer && range.buffer->buffer && range.size >= sizeof(T)
+	    && range.offset + sizeof(T) <= range.buffer->buffer->size()) {
+		std::memcpy(&constants, range.buffer->buffer->data() + range.offset, sizeof(T));
+	}
+	return constants;
+}
+
+template <typename T>
+static T readConstants(std::span<const u8> bytes)
+{
+	static_assert(sizeof(T) <= 128, "Constant buffer exceeds DrawState::constants");
+	T constants;
+	std::memcpy(&constants, bytes.data(), sizeof(T));
+	return constants;
+}
+
+template <typename T>
+static void writeConstants(std::span<u8> bytes, const T& constants)
+{
+	static_assert(sizeof(T) <= 128, "Constant buffer exceeds DrawState::constants");
+	std::memcpy(bytes.data(), &constants, sizeof(T));
+}
+
+// Missing components read as in D3D11.
+static glm::vec4 readVertexInput(const VertexInput& input, std::span<const u8> element)
+{
+	glm::vec4 value = {0, 0, 0, 1};
+	if (!input.semantic) {
+		return value;
+	}
+
+	usize components = 1;
+	switch (input.format) {
+	case VertexFormat::Float4: components = 4; break;
+	case VertexFormat::Float2: components = 2; break;
+	case VertexFormat::Float: components = 1; break;
+	}
+	if (input.offset + components * sizeof(float) <= element.size()) {
+		std::memcpy(&value.x, element.data() + input.offset, components * sizeof(float));
+	}
+	return value;
+}
+
+////////////////////////////////////////////////////////////
+// Formats
+
+static glm::vec4 decodePixel(TextureFormat format, const u8* src)
+{
+	switch (format) {
+	case TextureFormat::R8G8B8A8_UNORM: return glm::vec4(src[0], src[1], src[2], src[3]) / 255.0f;
+	case TextureFormat::R8_UNORM: return {float(src[0]) / 255.0f, 0, 0, 1};
+	case TextureFormat::R16G16B16A16_UNORM: {
+		std::array<u16, 4> channels{};
+		std::memcpy(channels.data(), src, sizeof(channels));
+		return glm::vec4(channels[0], channels[1], channels[2], channels[3]) / 65535.0f;
+	}
+	case TextureFormat::D32_FLOAT: {
+		float depth = 0;
+		std::memcpy(&depth, src, sizeof(depth));
+		return {depth, 0, 0, 1};
+	}
+	case TextureFormat::BC7_UNORM: break;
+	}
+	return {};
+}
+
+static u32 bytesPerPixel(TextureFormat format)
+{
+	switch (format) {
+	case TextureFormat::R16G16B16A16_UNORM: return 8;
+	case TextureFormat::R8G8B8A8_UNORM: return 4;
+	case TextureFormat::D32_FLOAT: return 4;
+	case TextureFormat::R8_UNORM: return 1;
+	case TextureFormat::BC7_UNORM: return 0;
+	}
+	return 0;
+}
+
+// Render targets store what the GPU format can represent.
+static float quantizationSteps(TextureFormat format)
+{
+	switch (format) {
+	case TextureFormat::R16G16B16A16_UNORM: return 65535.0f;
+	case TextureFormat::R8G8B8A8_UNORM: return 255.0f;
+	case TextureFormat::R8_UNORM: return 255.0f;
+	case TextureFormat::D32_FLOAT: return 0;
+	case TextureFormat::BC7_UNORM: return 0;
+	}
+	return 0;
+}
+
+// Rounds to the nearest step, values are in [0, 1].
+static glm::vec4 quantize(glm::vec4 value, float steps)
+{
+	// Adding 2^23 leaves no fraction bits, the addition rounds.
+	const float RoundingOffset = 8388608.0f;
+	return ((value * steps + RoundingOffset) - RoundingOffset) / steps;
+}
+
+static void decodePixels(SoftwareImage& image, const Rect2u& region, const TextureInit& init)
+{
+	const u32 stride = bytesPerPixel(image.format);
+	for (u32 y = 0; y < region.size.y; ++y) {
+		const u8* src = init.data + usize(y) * init.rowPitch;
+		Vec4* dst = &image.pixels[usize(region.offset.y + y) * image.size.x + region.offset.x];
+		for (u32 x = 0; x < region.size.x; ++x) {
+			dst[x] = decodePixel(image.format, src + usize(x) * stride);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Sampling
+
+static i32 addressTexel(i32 texel, i32 size, TexAddressMode mode)
+{
+	switch (mode) {
+	case TexAddressMode::Wrap: return (texel % size + size) % size;
+	case TexAddressMode::Mirror: {
+		const i32 period = (texel % (2 * size) + 2 * size) % (2 * size);
+		return period < size ? period : 2 * size - 1 - period;
+	}
+	case TexAddressMode::Clamp: return std::clamp(texel, 0, size - 1);
+	case TexAddressMode::Border: return texel >= 0 && texel < size ? texel : -1;
+	case TexAddressMode::MirrorOnce: return std::clamp(texel < 0 ? -texel - 1 : texel, 0, size - 1);
+	}
+	return -1;
+}
+
+// Avoids a call to floor, which is not an instruction before SSE4.1 .
+static i32 floorToInt(float value)
+{
+	const i32 truncated = i32(value);
+	return float(truncated) > value ? truncated - 1 : truncated;
+}
+
+static glm::vec4 fetch(const SoftwareImage& image, const SamplerDesc& sampler, i32 x, i32 y)
+{
+	if (u32(x) < image.size.x && u32(y) < image.size.y) {
+		return image.pixel(u32(x), u32(y));
+	}
+
+	x = addressTexel(x, i32(image.size.x), sampler.addressModeU);
+	y = addressTexel(y, i32(image.size.y), sampler.addressModeV);
+	if (x < 0 || y < 0) {
+		return glm::vec4(0); // Border color
+	}
+	return image.pixel(u32(x), u32(y));
+}
+
+static glm::vec4 sample(const SoftwareImage* image, const SamplerDesc& sampler, glm::vec2 uv)
+{
+	// Unbound textures read as 0.
+	if (!image || image->pixels.empty()) {
+		return glm::vec4(0);
+	}
+
+	const glm::vec2 size = {float(image->size.x), float(image->size.y)};
+
+	if (sampler.filterMode == FilterMode::Point) {
+		const glm::vec2 texel = uv * size;
+		return fetch(*image, sampler, floorToInt(texel.x), floorToInt(texel.y));
+	}
+
+	const glm::vec2 position = uv * size - 0.5f;
+	const i32 x = floorToInt(position.x);
+	const i32 y = floorToInt(position.y);
+	const glm::vec2 t = position - glm::vec2(float(x), float(y));
+
+	const glm::vec4 p00 = fetch(*image, sampler, x, y);
+	const glm::vec4 p10 = fetch(*image, sampler, x + 1, y);
+	const glm::vec4 p01 = fetch(*image, sampler, x, y + 1);
+	const glm::vec4 p11 = fetch(*image, sampler, x + 1, y + 1);
+
+	const glm::vec4 top = p00 + (p10 - p00) * t.x;
+	const glm::vec4 bottom = p01 + (p11 - p01) * t.x;
+	return top + (bottom - top) * t.y;
+}
+
+////////////////////////////////////////////////////////////
+// Shader Functions
+
+// See common.h.hlsl .
+static glm::vec2 applyParallax(glm::vec2 factor, glm::vec2 position, glm::vec2 cameraPosition)
+{
+	return position + (glm::vec2(1) - factor) * cameraPosition;
+}
+
+// See screen.hlsl .
+static glm::vec2 screenVertexUv(u32 id)
+{
+	return {float(id & 2), float((id << 1) & 2)};
+}
+
+// See particle.hlsl .
+static glm::vec2 particleCorner(u32 id)
+{
+	return {float((0x34u >> id) & 1), float((0x29u >> id) & 1)};
+}
+
+// See post_process.hlsl . White balancing is linear, hence it is combined into
+// a single matrix once per draw.
+static glm::mat3 whiteBalanceMatrix(float temperature, float tint)
+{
+	const float t1 = temperature * 10 / 6;
+	const float t2 = tint * 10 / 6;
+
+	// CIE xy chromaticity of the reference white point.
+	const float x = 0.31271f - t1 * (t1 < 0 ? 0.1f : 0.05f);
+	const float standardIlluminantY = 2.87f * x - 3 * x * x - 0.27509507f;
+	const float y = standardIlluminantY + t2 * 0.05f;
+
+	const glm::vec3 w1 = {0.949237f, 1.03542f, 1.08728f}; // D65 white point
+
+	// CIExyToLMS
+	const float Y = 1;
+	const float X = Y * x / y;
+	const float Z = Y * (1 - x - y) / y;
+	const float L = 0.7328f * X + 0.4296f * Y - 0.1624f * Z;
+	const float M = -0.7036f * X + 1.6975f * Y + 0.0061f * Z;
+	const float S = 0.0030f * X + 0.0136f * Y + 0.9834f * Z;
+	const glm::vec3 w2 = {L, M, S};
+
+	const glm::vec3 balance = w1 / w2;
+
+	// LIN_2_LMS_MAT and LMS_2_LIN_MAT, glm takes columns, HLSL rows.
+	const glm::mat3 linToLms = glm::transpose(glm::mat3( //
+	    3.90405e-1f, 5.49941e-1f, 8.92632e-3f,           //
+	    7.08416e-2f, 9.63172e-1f, 1.35775e-3f,           //
+	    2.31082e-2f, 1.28021e-1f, 9.36245e-1f));
+	const glm::mat3 lmsToLin = glm::transpose(glm::mat3( //
+	    2.85847e+0f, -1.62879e+0f, -2.48910e-2f,         //
+	    -2.10182e-1f, 1.15820e+0f, 3.24281e-4f,          //
+	    -4.18120e-2f, -1.18169e-1f, 1.06867e+0f));
+
+	const glm::mat3 balanceLms = {balance.x, 0, 0, 0, balance.y, 0, 0, 0, balance.z};
+
+	return lmsToLin * balanceLms * linToLms;
+}
+
+static glm::vec3 uncharted2TonemapOp(glm::vec3 x)
+{
+	const float A = 0.15f;
+	const float B = 0.50f;
+	const float C = 0.10f;
+	const float D = 0.20f;
+	const float E = 0.02f;
+	const float F = 0.30f;
+	return ((x * (A * x + C * B) + D * E) / (x * (A * x + B) + D * F)) - E / F;
+}
+
+static glm::vec4 postProcess(glm::vec4 input, const PostProcessParams& params, const glm::mat3& whiteBalance)
+{
+	glm::vec3 color = input;
+
+	color *= params.exposure;
+	color = whiteBalance * color;
+	color = params.contrast * (color - 0.5f) + 0.5f + params.brightness;
+	color *= glm::vec3(params.colorFilter);
+
+	const float luminance = glm::dot(color, glm::vec3(0.299f, 0.587f, 0.114f));
+	color = glm::mix(glm::vec3(luminance), color, params.saturation);
+
+	if (params.toneMapping == ToneMapping::Uncharted2) {
+		color = uncharted2TonemapOp(2.0f * color) / uncharted2TonemapOp(glm::vec3(11.2f));
+	} else if (params.toneMapping == ToneMapping::ACES) {
+		color = (color * (2.51f * color + 0.03f)) / (color * (2.43f * color + 0.59f) + 0.14f);
+	}
+
+	color = glm::clamp(color, 0.0f, 1.0f);
+	if (params.gamma != 1.0f) {
+		color = glm::pow(color, glm::vec3(1.0f / params.gamma));
+	}
+	return {color, 1};
+}
+
+////////////////////////////////////////////////////////////
+
+RenderDevice::RenderDevice()
+    : m_vertexUploadRing(VertexUploadCapacity), m_constantUploadRing(ConstantUploadCapacity)
+{
+	createMainRenderTarget();
+
+	m_vertexUploadBuffer.info = {
+	    .name = "Vertex Upload Buffer",
+	    .bindFlags = GpuBindFlag::VertexBuffer,
+	    .flags = GpuBufferFlag::CpuWriteable,
+	};
+	createUploadBuffer(m_vertexUploadBuffer, m_vertexUploadRing.capacity());
+
+	m_constantUploadBuffer.info = {
+	    .name = "Constant Upload Buffer",
+	    .bindFlags = GpuBindFlag::ConstantBuffer,
+	    .flags = GpuBufferFlag::CpuWriteable,
+	};
+	createUploadBuffer(m_constantUploadBuffer, m_constantUploadRing.capacity());
+
+	if (not loadTexture(m_fallbackTexture, "fallback/fallback_texture")) {
+		ANKER_ERROR("Fallback texture could not be loaded!");
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Buffers
+
+Status RenderDevice::createBuffer(GpuBuffer& buffer, std::span<const u8> init)
+{
+	buffer.info.size = std::max(buffer.info.size, u32(init.size()));
+	ANKER_CHECK(buffer.info.size != 0, InvalidArgumentError);
+
+	// Draws referencing the previous buffer keep it.
+	buffer.buffer = std::make_shared<ByteBuffer>(buffer.info.size);
+	std::ranges::copy(init, buffer.buffer->begin());
+
+	return Ok;
+}
+
+void RenderDevice::bindBufferVS(u32 slot, const GpuBuffer& buffer)
+{
+	bindBufferVS(slot, {.buffer = &buffer, .size = buffer.info.size, .stride = buffer.info.stride});
+}
+
+void RenderDevice::bindBufferPS(u32 slot, const GpuBuffer& buffer)
+{
+	bindBufferPS(slot, {.buffer = &buffer, .size = buffer.info.size, .stride = buffer.info.stride});
+}
+
+void* RenderDevice::mapResource(GpuBuffer& buffer)
+{
+	// Like D3D11_MAP_WRITE_DISCARD, draws referencing the buffer via
+	// GpuBufferRef keep the previous contents. Queued draws do not refer to
+	// buffers, vertices and constants are processed when the draw is queued.
+	if (buffer.buffer.use_count() > 1) {
+		buffer.buffer = std::make_shared<ByteBuffer>(buffer.info.size);
+	}
+	return buffer.buffer->data();
+}
+
+void RenderDevice::unmapBuffer(GpuBuffer&) {}
+
+// Constants are read when a draw is queued, hence the range must stay valid
+// until then, like for D3D11.
+void RenderDevice::bindBufferVS(u32 slot, const GpuBufferRange& range)
+{
+	ANKER_CHECK(slot < MaxSlots);
+	m_constantsVS[slot] = range;
+}
+
+void RenderDevice::bindBufferPS(u32 slot, const GpuBufferRange& range)
+{
+	ANKER_CHECK(slot < MaxSlots);
+	m_constantsPS[slot] = range;
+}
+
+GpuBufferRange RenderDevice::upload(GpuBuffer& buffer, UploadRing& ring, std::span<const u8> data, u32 stride,
+                                    u32 alignment)
+{
+	const u32 size = (u32(data.size()) + alignment - 1) & ~(alignment - 1);
+
+	auto allocation = ring.allocate(size, alignment);
+	if (!allocation) {
+		// The only case where an upload buffer is recreated mid-frame.
+		ANKER_WARN("{}: Upload of {} bytes exceeds capacity", buffer.info.name, size);
+		ring.grow(size);
+		createUploadBuffer(buffer, ring.capacity());
+		allocation = ring.allocate(size, alignment);
+	}
+
+	// Written in place, earlier ranges have been consumed by their draws.
+	std::ranges::copy(data, buffer.buffer->begin() + allocation->offset);
+
+	return {.buffer = &buffer, .offset = allocation->offset, .size = u32(data.size()), .stride = stride};
+}
+
+////////////////////////////////////////////////////////////
+// Shaders
+
+Status RenderDevice::loadVertexShader(VertexShader& vertexShader, std::string_view identifier)
+{
+	vertexShader.info.name = identifier;
+	vertexShader.shader = nullptr;
+
+	return findSoftwareShader(vertexShader.shader, identifier);
+}
+
+Status RenderDevice::loadPixelShader(PixelShader& pixelShader, std::string_view identifier)
+{
+	pixelShader.info.name = identifier;
+	pixelShader.shader = nullptr;
+
+	return findSoftwareShader(pixelShader.shader, identifier);
+}
+
+void RenderDevice::bindVertexShader(const VertexShader& vertexShader)
+{
+	m_vertexShader = vertexShader.shader;
+
+	m_vertexInputs = {};
+	for (auto& input : vertexShader.info.inputs) {
+		for (u32 i = 0; i < ShaderSemanticNames.size(); ++i) {
+			if (input.semanticIndex == 0 && std::string_view(input.semantic) == ShaderSemanticNames[i]) {
+				m_vertexInputs[i] = input;
+			}
+		}
+	}
+}
+
+void RenderDevice::bindPixelShader(const PixelShader& pixelShader)
+{
+	m_pixelShader = pixelShader.shader;
+}
+
+////////////////////////////////////////////////////////////
+// Textures
+
+Status RenderDevice::createTexture(Texture& texture, std::span<const TextureInit> inits)
+{
+	ANKER_CHECK(texture.info.size != Vec2u(0), InvalidArgumentError);
+
+	if (bytesPerPixel(texture.info.format) == 0) {
+		ANKER_ERROR("{}: Texture format not supported", texture.info.name);
+		return NotImplementedError;
+	}
+
+	// Queued draws keep sampling the previous image.
+	auto image = std::make_shared<SoftwareImage>();
+	image->size = texture.info.size;
+	image->format = texture.info.format;
+	image->pixels.assign(usize(image->size.x) * image->size.y, Vec4(0));
+
+	if (!inits.empty()) {
+		decodePixels(*image, Rect2u(image->size), inits[0]);
+	}
+
+	texture.texture = image;
+	texture.shaderView = nullptr;
+	if (texture.info.bindFlags & GpuBindFlag::Shader) {
+		texture.shaderView = image;
+	}
+
+	return Ok;
+}
+
+void RenderDevice::updateTexture(Texture& texture, const Rect2u& region, const TextureInit& init)
+{
+	ANKER_CHECK(!(texture.info.flags & TextureFlag::CpuWriteable));
+	ANKER_CHECK(region.offset.x + region.size.x <= texture.info.size.x);
+	ANKER_CHECK(region.offset.y + region.size.y <= texture.info.size.y);
+
+	// Queued draws are flushed before the RenderThread releases the lock.
+	std::scoped_lock lock(m_contextMutex);
+	decodePixels(*texture.texture, region, init);
+}
+
+void RenderDevice::bindTexturePS(u32 slot, const ShaderViewRef& shaderView, const SamplerDesc& samplerDesc)
+{
+	// All mirrored shaders use a single texture.
+	ANKER_CHECK(slot == 0);
+	m_texture = shaderView ? shaderView : m_fallbackTexture.shaderView;
+	m_sampler = samplerDesc;
+}
+
+void RenderDevice::unbindTexturePS(u32 slot)
+{
+	ANKER_CHECK(slot == 0);
+	m_texture = nullptr;
+}
+
+void* RenderDevice::mapResource(const Texture& texture, u32* outRowPitch)
+{
+	const u32 rowPitch = texture.info.size.x * bytesPerPixel(texture.info.format);
+	if (outRowPitch) {
+		*outRowPitch = rowPitch;
+	}
+
+	auto& pixels = m_mappedTextures[texture.texture.get()];
+	pixels.assign(usize(rowPitch) * texture.info.size.y, 0);
+	return pixels.data();
+}
+
+void RenderDevice::unmapTexture(const Texture& texture)
+{
+	auto it = m_mappedTextures.find(texture.texture.get());
+	ANKER_CHECK(it != m_mappedTextures.end());
+
+	const TextureInit init = {
+	    .data = it->second.data(),
+	    .rowPitch = texture.info.size.x * bytesPerPixel(texture.info.format),
+	};
+	decodePixels(*texture.texture, Rect2u(texture.info.size), init);
+	m_mappedTextures.erase(it);
+}
+
+////////////////////////////////////////////////////////////
+// Rasterizer
+
+// There is no depth buffer, and wireframe is not supported.
+void RenderDevice::setRasterizer(const RasterizerDesc&) {}
+
+////////////////////////////////////////////////////////////
+// Blending
+
+void RenderDevice::enableAlphaBlending()
+{
+	m_alphaBlending = true;
+}
+
+////////////////////////////////////////////////////////////
+// Render Target
+
+void RenderDevice::setRenderTarget(const Texture& target, const Texture*)
+{
+	if (m_renderTarget == target.texture) {
+		return;
+	}
+
+	flush();
+
+	m_renderTarget = target.texture;
+	m_tileCount = (target.info.size + Vec2u(u32(TileSize) - 1)) / Vec2u(u32(TileSize));
+	m_tileTriangles.resize(usize(m_tileCount.x) * m_tileCount.y);
+}
+
+void RenderDevice::clearRenderTarget(const Texture& target, const Texture*, const Vec3& clearColor)
+{
+	flush();
+
+	std::ranges::fill(target.texture->pixels, Vec4(clearColor.x, clearColor.y, clearColor.z, 1));
+}
+
+void RenderDevice::bindRenderTargetPS(u32 slot, const Texture& texture, const SamplerDesc& samplerDesc)
+{
+	bindTexturePS(slot, texture.shaderView, samplerDesc);
+}
+
+////////////////////////////////////////////////////////////
+
+static std::span<const u8> bufferBytes(const GpuBuffer& buffer)
+{
+	return buffer.buffer ? std::span<const u8>(*buffer.buffer) : std::span<const u8>();
+}
+
+static std::span<const u8> bufferBytes(const GpuBufferRange& range)
+{
+	ANKER_CHECK(range.buffer && range.offset + range.size <= bufferBytes(*range.buffer).size(), {});
+	return bufferBytes(*range.buffer).subspan(range.offset, range.size);
+}
+
+static std::vector<u32> readIndices(const GpuBuffer& indexBuffer, u32 indexCount)
+{
+	auto bytes = bufferBytes(indexBuffer);
+	const u32 stride = indexBuffer.info.stride == 2 ? 2 : 4;
+	ANKER_CHECK(usize(indexCount) * stride <= bytes.size(), {});
+
+	std::vector<u32> indices(indexCount);
+	for (u32 i = 0; i < indexCount; ++i) {
+		if (stride == 2) {
+			u16 index = 0;
+			std::memcpy(&index, bytes.data() + usize(i) * stride, sizeof(index));
+			indices[i] = index;
+		} else {
+			std::memcpy(&indices[i], bytes.data() + usize(i) * stride, sizeof(u32));
+		}
+	}
+	return indices;
+}
+
+void RenderDevice::draw(u32 vertexCount, Topology topology)
+{
+	queueDraw({.vertices = {}, .instances = {}, .indices = {}, .vertexCount = vertexCount}, topology);
+}
+
+void RenderDevice::draw(const GpuBuffer& vertexBuffer, u32 vertexCount, u32 firstVertex, Topology topology)
+{
+	auto vertices = bufferBytes(vertexBuffer);
+	ANKER_CHECK(usize(firstVertex) * vertexBuffer.info.stride <= vertices.size());
+
+	queueDraw(
+	    {
+	        .vertices = vertices.subspan(usize(firstVertex) * vertexBuffer.info.stride),
+	        .vertexStride = vertexBuffer.info.stride,
+	        .instances = {},
+	        .indices = {},
+	        .vertexCount = vertexCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::draw(const GpuBuffer& vertexBuffer, const GpuBuffer& indexBuffer, u32 indexCount, Topology topology)
+{
+	queueDraw(
+	    {
+	        .vertices = bufferBytes(vertexBuffer),
+	        .vertexStride = vertexBuffer.info.stride,
+	        .instances = {},
+	        .indices = readIndices(indexBuffer, indexCount),
+	        .vertexCount = indexCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::draw(const GpuBufferRef& vertexBuffer, u32 stride, u32 vertexCount, Topology topology)
+{
+	ANKER_CHECK(vertexBuffer);
+
+	queueDraw(
+	    {
+	        .vertices = *vertexBuffer,
+	        .vertexStride = stride,
+	        .instances = {},
+	        .indices = {},
+	        .vertexCount = vertexCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::draw(const GpuBufferRange& vertices, u32 vertexCount, u32 firstVertex, Topology topology)
+{
+	auto bytes = bufferBytes(vertices);
+	ANKER_CHECK(usize(firstVertex) * vertices.stride <= bytes.size());
+
+	queueDraw(
+	    {
+	        .vertices = bytes.subspan(usize(firstVertex) * vertices.stride),
+	        .vertexStride = vertices.stride,
+	        .instances = {},
+	        .indices = {},
+	        .vertexCount = vertexCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::drawInstanced(u32 vertexCount, u32 instanceCount)
+{
+	queueDraw({.vertices = {}, .instances = {}, .indices = {}, .vertexCount = vertexCount, .instanceCount = instanceCount},
+	          Topology::TriangleList);
+}
+
+void RenderDevice::drawInstanced(const GpuBufferRange& instances, u32 vertexCount, Topology topology)
+{
+	queueDraw(
+	    {
+	        .vertices = {},
+	        .instances = bufferBytes(instances),
+	        .instanceStride = instances.stride,
+	        .indices = {},
+	        .vertexCount = vertexCount,
+	        .instanceCount = instances.elementCount(),
+	    },
+	    topology);
+}
+
+void RenderDevice::drawInstanced(const GpuBuffer& vertexBuffer, u32 vertexCount,     //
+                                 const GpuBuffer& instanceBuffer, u32 instanceCount, //
+                                 Topology topology)
+{
+	queueDraw(
+	    {
+	        .vertices = bufferBytes(vertexBuffer),
+	        .vertexStride = vertexBuffer.info.stride,
+	        .instances = bufferBytes(instanceBuffer),
+	        .instanceStride = instanceBuffer.info.stride,
+	        .indices = {},
+	        .vertexCount = vertexCount,
+	        .instanceCount = instanceCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::drawInstanced(const GpuBuffer& vertexBuffer,                      //
+                                 const GpuBuffer& indexBuffer, u32 indexCount,       //
+                                 const GpuBuffer& instanceBuffer, u32 instanceCount, //
+                                 Topology topology)
+{
+	queueDraw(
+	    {
+	        .vertices = bufferBytes(vertexBuffer),
+	        .vertexStride = vertexBuffer.info.stride,
+	        .instances = bufferBytes(instanceBuffer),
+	        .instanceStride = instanceBuffer.info.stride,
+	        .indices = readIndices(indexBuffer, indexCount),
+	        .vertexCount = indexCount,
+	        .instanceCount = instanceCount,
+	    },
+	    topology);
+}
+
+void RenderDevice::queueDraw(const DrawInputs& inputs, Topology topology)
+{
+	ANKER_PROFILE_ZONE();
+
+	ANKER_CHECK(m_renderTarget);
+
+	// Like D3D11, draws without shaders draw nothing.
+	if (!m_vertexShader || !m_pixelShader) {
+		return;
+	}
+
+	// Elements read by the vertex shader must be within their buffers.
+	u32 vertexElements = inputs.vertexCount;
+	for (u32 index : inputs.indices) {
+		vertexElements = std::max(vertexElements, index + 1);
+	}
+	for (auto& input : m_vertexInputs) {
+		if (!input.semantic) {
+			continue;
+		}
+		if (input.perInstance) {
+			ANKER_CHECK(usize(inputs.instanceCount) * inputs.instanceStride <= inputs.instances.size());
+		} else {
+			ANKER_CHECK(usize(vertexElements) * inputs.vertexStride <= inputs.vertices.size());
+		}
+	}
+
+	DrawState state = {
+	    .pixelShader = m_pixelShader,
+	    .texture = m_texture,
+	    .sampler = m_sampler,
+	    .alphaBlending = m_alphaBlending,
+	};
+
+	switch (m_pixelShader->program) {
+	case ShaderProgram::Sprite:
+		writeConstants(state.constants, readConstants<SpriteConstants>(m_constantsPS[1]));
+		break;
+	case ShaderProgram::Particle:
+		writeConstants(state.constants, readConstants<ParticleConstants>(m_constantsPS[1]));
+		break;
+	case ShaderProgram::PostProcess:
+		writeConstants(state.constants, readConstants<PostProcessParams>(m_constantsPS[0]));
+		break;
+	default: break;
+	}
+
+	// Vertex Shader
+	const auto scene = readConstants<SceneConstants>(m_constantsVS[0]);
+	const auto sprite = readConstants<SpriteConstants>(m_constantsVS[1]);
+	const auto particle = readConstants<ParticleConstants>(m_constantsVS[1]);
+	const Mat3 view = Mat3(scene.view);
+	const Mat3 transform = Mat3(sprite.transform);
+	const glm::vec2 targetSize = Vec2(m_renderTarget->size);
+
+	auto input = [&](ShaderSemantic semantic, u32 vertex, u32 instance) {
+		const auto& vertexInput = m_vertexInputs[usize(semantic)];
+		if (!vertexInput.semantic) {
+			return glm::vec4(0, 0, 0, 1);
+		}
+		if (vertexInput.perInstance) {
+			return readVertexInput(vertexInput, inputs.instances.subspan(usize(instance) * inputs.instanceStride));
+		}
+		return readVertexInput(vertexInput, inputs.vertices.subspan(usize(vertex) * inputs.vertexStride));
+	};
+
+	auto shadeVertex = [&](u32 vertex, u32 instance) {
+		const glm::vec2 position = input(ShaderSemantic::Position, vertex, instance);
+
+		glm::vec2 clip(0);
+		ShadedVertex out = {};
+		switch (m_vertexShader->program) {
+		case ShaderProgram::Sprite: {
+			const glm::vec3 transformed = transform * glm::vec3(position, 1);
+			const glm::vec2 parallaxed =
+			    applyParallax(sprite.parallax, glm::vec2(transformed), scene.cameraPosition);
+			clip = glm::vec2(view * glm::vec3(parallaxed, transformed.z));
+			out.attributes[0] = input(ShaderSemantic::Texcoord, vertex, instance);
+			break;
+		}
+		case ShaderProgram::Text:
+			clip = glm::vec2(view * glm::vec3(position, 1));
+			out.attributes[0] = input(ShaderSemantic::Texcoord, vertex, instance);
+			break;
+		case ShaderProgram::Gizmo:
+			clip = glm::vec2(view * glm::vec3(position, 1));
+			out.attributes[1] = input(ShaderSemantic::Color, vertex, instance);
+			break;
+		case ShaderProgram::Screen: {
+			const glm::vec2 uv = screenVertexUv(vertex);
+			clip = uv * glm::vec2(2, -2) + glm::vec2(-1, 1);
+			out.attributes[0] = {uv, 0, 0};
+			break;
+		}
+		case ShaderProgram::Particle: {
+			const glm::vec2 corner = particleCorner(vertex);
+			const float size = input(ShaderSemantic::Size, vertex, instance).x;
+			const glm::vec2 parallaxed =
+			    applyParallax(particle.parallax, position + (corner - 0.5f) * size, scene.cameraPosition);
+			clip = glm::vec2(view * glm::vec3(parallaxed, 1));
+			out.attributes[0] = {corner.x, 1 - corner.y, 0, 0};
+			out.attributes[1] = input(ShaderSemantic::Color, vertex, instance);
+			break;
+		}
+		case ShaderProgram::TextSdf:
+		case ShaderProgram::PostProcess: break; // Pixel shaders only
+		}
+
+		// Viewport transform, +Y is down in pixels.
+		const glm::vec2 pixel = glm::vec2(clip.x + 1, 1 - clip.y) * 0.5f * targetSize;
+		out.position = glm::round(pixel * SubPixelPrecision) / SubPixelPrecision;
+		return out;
+	};
+
+	const u32 drawIndex = u32(m_draws.size());
+	m_draws.push_back(state);
+
+	const usize triangleCount = m_triangles.size();
+
+	std::vector<ShadedVertex> shaded(inputs.vertexCount);
+	for (u32 instance = 0; instance < inputs.instanceCount; ++instance) {
+		for (u32 i = 0; i < inputs.vertexCount; ++i) {
+			shaded[i] = shadeVertex(inputs.indices.empty() ? i : inputs.indices[i], instance);
+		}
+
+		switch (topology) {
+		case Topology::TriangleList:
+			for (u32 i = 0; i + 2 < inputs.vertexCount; i += 3) {
+				queueTriangle(shaded[i], shaded[i + 1], shaded[i + 2]);
+			}
+			break;
+		case Topology::TriangleStrip:
+			for (u32 i = 0; i + 2 < inputs.vertexCount; ++i) {
+				queueTriangle(shaded[i], shaded[i + 1], shaded[i + 2]);
+			}
+			break;
+		case Topology::LineList:
+			for (u32 i = 0; i + 1 < inputs.vertexCount; i += 2) {
+				queueLine(shaded[i], shaded[i + 1]);
+			}
+			break;
+		}
+	}
+
+	for (usize i = triangleCount; i < m_triangles.size(); ++i) {
+		m_triangles[i].draw = drawIndex;
+	}
+}
+
+void RenderDevice::queueTriangle(const ShadedVertex& v0, const ShadedVertex& v1, const ShadedVertex& v2)
+{
+	const std::array<glm::vec2, 3> p = {v0.position, v1.position, v2.position};
+
+	// Edge i is opposite of vertex i.
+	Triangle triangle;
+	std::array<float, 3> edgeAtVertex{};
+	for (u32 i = 0; i < 3; ++i) {
+		const glm::vec2 from = p[(i + 1) % 3];
+		const glm::vec2 to = p[(i + 2) % 3];
+		triangle.edgeCoefficients[i] = {from.y - to.y, to.x - from.x};
+		triangle.edgeOrigins[i] = from;
+		edgeAtVertex[i] = glm::dot(triangle.edgeCoefficients[i], p[i] - from);
+	}
+
+	// Twice the signed area. There is no culling, both windings are drawn.
+	const float area = edgeAtVertex[0];
+	if (area == 0) {
+		return;
+	}
+	if (area < 0) {
+		for (auto& coefficients : triangle.edgeCoefficients) {
+			coefficients = -coefficients;
+		}
+	}
+
+	// Top-left rule, pixels on shared edges are drawn exactly once. +Y is down.
+	for (u32 i = 0; i < 3; ++i) {
+		const glm::vec2 c = triangle.edgeCoefficients[i];
+		triangle.edgeTopLeft[i] = c.x > 0 || (c.x == 0 && c.y > 0);
+	}
+
+	// Barycentric weights are the edge functions divided by the area, hence
+	// attributes form a plane.
+	const float invArea = 1.0f / std::abs(area);
+	const std::array<const ShadedVertex*, 3> vertices = {&v0, &v1, &v2};
+	for (u32 a = 0; a < triangle.attributes.size(); ++a) {
+		glm::vec4 dx(0), dy(0);
+		for (u32 i = 0; i < 3; ++i) {
+			dx += triangle.edgeCoefficients[i].x * invArea * vertices[i]->attributes[a];
+			dy += triangle.edgeCoefficients[i].y * invArea * vertices[i]->attributes[a];
+		}
+		triangle.attributes[a] = v0.attributes[a];
+		triangle.attributesDx[a] = dx;
+		triangle.attributesDy[a] = dy;
+	}
+	triangle.origin = p[0];
+
+	const glm::vec2 min = glm::min(p[0], glm::min(p[1], p[2]));
+	const glm::vec2 max = glm::max(p[0], glm::max(p[1], p[2]));
+	const Vec2u targetSize = m_renderTarget->size;
+	triangle.min = Vec2i(std::max(i32(std::floor(min.x)), 0), std::max(i32(std::floor(min.y)), 0));
+	triangle.max = Vec2i(std::min(i32(std::ceil(max.x)), i32(targetSize.x)),
+	                     std::min(i32(std::ceil(max.y)), i32(targetSize.y)));
+	if (triangle.min.x >= triangle.max.x || triangle.min.y >= triangle.max.y) {
+		return;
+	}
+
+	m_triangles.push_back(triangle);
+}
+
+void RenderDevice::queueLine(const ShadedVertex& v0, const ShadedVertex& v1)
+{
+	// Lines are drawn as quads, one pixel wide.
+	const glm::vec2 from = v0.position;
+	const glm::vec2 to = v1.position;
+	if (from == to) {
+		return;
+	}
+
+	const glm::vec2 direction = glm::normalize(to - from);
+	const glm::vec2 normal = glm::vec2(-direction.y, direction.x) * 0.5f;
+
+	const ShadedVertex a = {.position = from + normal, .attributes = v0.attributes};
+	const ShadedVertex b = {.position = from - normal, .attributes = v0.attributes};
+	const ShadedVertex c = {.position = to + normal, .attributes = v1.attributes};
+	const ShadedVertex d = {.position = to - normal, .attributes = v1.attributes};
+	queueTriangle(a, b, c);
+	queueTriangle(c, b, d);
+}
+
+////////////////////////////////////////////////////////////
+
+void RenderDevice::flush()
+{
+	if (m_triangles.empty()) {
+		m_draws.clear();
+		return;
+	}
+
+	ANKER_PROFILE_ZONE();
+
+	// Binning
+	for (u32 i = 0; i < m_triangles.size(); ++i) {
+		auto& triangle = m_triangles[i];
+		for (i32 y = triangle.min.y / TileSize; y <= (triangle.max.y - 1) / TileSize; ++y) {
+			for (i32 x = triangle.min.x / TileSize; x <= (triangle.max.x - 1) / TileSize; ++x) {
+				m_tileTriangles[usize(y) * m_tileCount.x + usize(x)].push_back(i);
+			}
+		}
+	}
+
+	g_workerPool.parallelFor(m_tileTriangles.size(), [&](usize tile) { rasterizeTile(u32(tile)); });
+
+	for (auto& tile : m_tileTriangles) {
+		tile.clear();
+	}
+	m_triangles.clear();
+	m_draws.clear();
+}
+
+static bool insideEdge(float e, bool topLeft)
+{
+	return e > 0 || (e == 0 && topLeft);
+}
+
+// Edge functions are linear, their extremes within a block are found at its
+// corners.
+RenderDevice::BlockCoverage RenderDevice::classifyBlock(const Triangle& triangle, i32 x0, i32 y0, i32 x1, i32 y1)
+{
+	const glm::vec2 lo = {float(x0) + 0.5f, float(y0) + 0.5f};
+	const glm::vec2 hi = {float(x1) - 0.5f, float(y1) - 0.5f};
+
+	bool full = true;
+	for (u32 i = 0; i < 3; ++i) {
+		const glm::vec2 c = triangle.edgeCoefficients[i];
+		const glm::vec2 origin = triangle.edgeOrigins[i];
+
+		const glm::vec2 maxCorner = {c.x > 0 ? hi.x : lo.x, c.y > 0 ? hi.y : lo.y};
+		const glm::vec2 minCorner = {c.x > 0 ? lo.x : hi.x, c.y > 0 ? lo.y : hi.y};
+
+		if (!insideEdge(glm::dot(c, maxCorner - origin), triangle.edgeTopLeft[i])) {
+			return BlockCoverage::None;
+		}
+		full = full && insideEdge(glm::dot(c, minCorner - origin), triangle.edgeTopLeft[i]);
+	}
+
+	return full ? BlockCoverage::Full : BlockCoverage::Partial;
+}
+
+// Returns a bit per pixel, for 4 consecutive pixels of a row starting at x,
+// which are covered by the triangle.
+u32 RenderDevice::coverage4(const Triangle& triangle, i32 x, i32 y)
+{
+	const auto& coefficients = triangle.edgeCoefficients;
+	const auto& origins = triangle.edgeOrigins;
+	const auto& topLeft = triangle.edgeTopLeft;
+
+	u32 mask = 0xF;
+
+#ifdef ANKER_SOFTWARE_RASTERIZER_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	for (u32 i = 0; i < 3; ++i) {
+		const __m128 dx = _mm_add_ps(_mm_set1_ps(float(x) - origins[i].x), offsets);
+		const float dy = float(y) + 0.5f - origins[i].y;
+		const __m128 e = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(coefficients[i].x), dx), //
+		                            _mm_set1_ps(coefficients[i].y * dy));
+		const __m128 inside = topLeft[i] ? _mm_cmpge_ps(e, zero) : _mm_cmpgt_ps(e, zero);
+		mask &= u32(_mm_movemask_ps(inside));
+	}
+#else
+	for (u32 i = 0; i < 3; ++i) {
+		const float dy = float(y) + 0.5f - origins[i].y;
+		for (u32 j = 0; j < 4; ++j) {
+			const float dx = float(x) + float(j) + 0.5f - origins[i].x;
+			if (!insideEdge(coefficients[i].x * dx + coefficients[i].y * dy, topLeft[i])) {
+				mask &= ~(1u << j);
+			}
+		}
+	}
+#endif
+
+	return mask;
+}
+
+void RenderDevice::rasterizeTile(u32 tile)
+{
+	auto& triangles = m_tileTriangles[tile];
+	if (triangles.empty()) {
+		return;
+	}
+
+	auto& target = *m_renderTarget;
+	const float steps = quantizationSteps(target.format);
+
+	const i32 tileX = i32(tile % m_tileCount.x) * TileSize;
+	const i32 tileY = i32(tile / m_tileCount.x) * TileSize;
+
+	for (u32 index : triangles) {
+		const auto& triangle = m_triangles[index];
+		const auto& state = m_draws[triangle.draw];
+		const auto program = state.pixelShader->program;
+		const SoftwareImage* texture = state.texture.get();
+
+		const i32 x0 = std::max(triangle.min.x, tileX);
+		const i32 x1 = std::min(triangle.max.x, tileX + TileSize);
+		const i32 y0 = std::max(triangle.min.y, tileY);
+		const i32 y1 = std::min(triangle.max.y, tileY + TileSize);
+
+		const auto sprite = readConstants<SpriteConstants>(state.constants);
+		const auto particle = readConstants<ParticleConstants>(state.constants);
+		const auto params = readConstants<PostProcessParams>(state.constants);
+		const glm::mat3 whiteBalance = program == ShaderProgram::PostProcess
+		                                   ? whiteBalanceMatrix(params.temperature, params.tint)
+		                                   : glm::mat3(1);
+
+		auto shadePixel = [&](i32 x, i32 y) {
+			const glm::vec2 offset = glm::vec2(float(x) + 0.5f, float(y) + 0.5f) - triangle.origin;
+			const glm::vec2 uv =
+			    triangle.attributes[0] + offset.x * triangle.attributesDx[0] + offset.y * triangle.attributesDy[0];
+			const glm::vec4 vertexColor =
+			    triangle.attributes[1] + offset.x * triangle.attributesDx[1] + offset.y * triangle.attributesDy[1];
+
+			// Pixel Shader
+			glm::vec4 color(0);
+			switch (program) {
+			case ShaderProgram::Sprite: color = sample(texture, state.sampler, uv) * glm::vec4(sprite.color); break;
+			case ShaderProgram::Text: color = {1, 0, 1, sample(texture, state.sampler, uv).x}; break;
+			case ShaderProgram::TextSdf: {
+				// fwidth from the neighbouring pixels' texture coordinates.
+				const float d = sample(texture, state.sampler, uv).x;
+				const float dx = sample(texture, state.sampler, uv + glm::vec2(triangle.attributesDx[0])).x;
+				const float dy = sample(texture, state.sampler, uv + glm::vec2(triangle.attributesDy[0])).x;
+				const float w = std::max(std::abs(dx - d) + std::abs(dy - d), 1e-4f);
+				color = {1, 0, 1, glm::smoothstep(0.5f - w, 0.5f + w, d)};
+				break;
+			}
+			case ShaderProgram::Gizmo: color = vertexColor; break;
+			case ShaderProgram::PostProcess:
+				color = postProcess(sample(texture, state.sampler, uv), params, whiteBalance);
+				break;
+			case ShaderProgram::Particle:
+				if (particle.textured) {
+					color = sample(texture, state.sampler, uv) * vertexColor;
+				} else {
+					const float alpha = glm::clamp(1 - glm::length(uv * 2.0f - 1.0f), 0.0f, 1.0f);
+					color = {glm::vec3(vertexColor), vertexColor.w * alpha};
+				}
+				break;
+			case ShaderProgram::Screen: break; // Vertex shader only
+			}
+
+			// Output Merger, UNORM targets clamp before blending.
+			Vec4& dst = target.pixels[usize(y) * target.size.x + usize(x)];
+			if (steps > 0) {
+				color = glm::clamp(color, 0.0f, 1.0f);
+			}
+			if (state.alphaBlending) {
+				const glm::vec3 rgb = glm::vec3(color) * color.w + glm::vec3(glm::vec4(dst)) * (1 - color.w);
+				color = {rgb, color.w};
+			}
+			if (steps > 0) {
+				color = quantize(color, steps);
+			}
+			dst = color;
+		};
+
+		// Blocks entirely inside the triangle skip the coverage test, blocks
+		// entirely outside are skipped.
+		for (i32 blockY = y0; blockY < y1; blockY += BlockSize) {
+			for (i32 blockX = x0; blockX < x1; blockX += BlockSize) {
+				const i32 blockX1 = std::min(blockX + BlockSize, x1);
+				const i32 blockY1 = std::min(blockY + BlockSize, y1);
+
+				const auto coverage = classifyBlock(triangle, blockX, blockY, blockX1, blockY1);
+				if (coverage == BlockCoverage::None) {
+					continue;
+				}
+
+				for (i32 y = blockY; y < blockY1; ++y) {
+					if (coverage == BlockCoverage::Full) {
+						for (i32 x = blockX; x < blockX1; ++x) {
+							shadePixel(x, y);
+						}
+						continue;
+					}
+
+					for (i32 x = blockX; x < blockX1; x += 4) {
+						u32 mask = coverage4(triangle, x, y);
+						if (blockX1 - x < 4) {
+							mask &= (1u << (blockX1 - x)) - 1;
+						}
+						for (; mask; mask &= mask - 1) {
+							shadePixel(x + std::countr_zero(mask), y);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+// ImGui
+
+void RenderDevice::imguiImplInit()
+{
+	// Headless runs do not persist window settings.
+	ImGui::GetIO().IniFilename = nullptr;
+}
+
+void RenderDevice::imguiImplShutdown() {}
+
+// Without renderer backend, the font atlas must be built for ImGui::NewFrame .
+void RenderDevice::imguiImplNewFrame()
+{
+	if (auto* fonts = ImGui::GetIO().Fonts; !fonts->IsBuilt()) {
+		fonts->Build();
+	}
+}
+
+// ImGui is not drawn headless, golden images only contain the scene.
+void RenderDevice::imguiImplRender(ImDrawData*) {}
+
+////////////////////////////////////////////////////////////
+
+void RenderDevice::present()
+{
+	flush();
+
+	// Growing between frames, nothing refers to the upload buffers.
+	if (m_vertexUploadRing.endFrame()) {
+		createUploadBuffer(m_vertexUploadBuffer, m_vertexUploadRing.capacity());
+	}
+	if (m_constantUploadRing.endFrame()) {
+		createUploadBuffer(m_constantUploadBuffer, m_constantUploadRing.capacity());
+	}
+}
+
+void RenderDevice::onResize(Vec2i)
+{
+	flush();
+	createMainRenderTarget();
+}
+
+// The back buffer has the size of the (virtual) window.
+void RenderDevice::createMainRenderTarget()
+{
+	m_backBuffer.info = TextureInfo{
+	    .name = "Back Buffer",
+	    .size = Vec2u(Platform::windowSize()),
+	    .format = TextureFormat::R8G8B8A8_UNORM,
+	    .bindFlags = GpuBindFlag::RenderTarget,
+	};
+	if (not createTexture(m_backBuffer)) {
+		ANKER_FATAL("Failed to create Back Buffer");
+	}
+}
+
+////////////////////////////////////////////////////////////
+
+Status writePng(const Texture& texture, const fs::path& filepath)
+{
+	ANKER_CHECK(texture.texture, InvalidArgumentError);
+	const auto& image = *texture.texture;
+
+	std::vector<u8> pixels(usize(image.size.x) * image.size.y * 4);
+	for (usize i = 0; i < image.pixels.size(); ++i) {
+		const glm::vec4 color = glm::round(glm::clamp(glm::vec4(image.pixels[i]), 0.0f, 1.0f) * 255.0f);
+		pixels[i * 4 + 0] = u8(color.x);
+		pixels[i * 4 + 1] = u8(color.y);
+		pixels[i * 4 + 2] = u8(color.z);
+		pixels[i * 4 + 3] = u8(color.w);
+	}
+
+	const int width = int(image.size.x);
+	if (!stbi_write_png(filepath.string().c_str(), width, int(image.size.y), 4, pixels.data(), width * 4)) {
+		ANKER_ERROR("{}: Writing PNG failed", filepath);
+		return WriteError;
+	}
+
+	return Ok;
+}
+
+Status readPng(Texture& texture, const fs::path& filepath)
+{
+	Image image(filepath);
+	if (!image) {
+		ANKER_ERROR("{}: Reading PNG failed", filepath);
+		return ReadError;
+	}
+
+	texture.info = {
+	    .name = filepath.string(),
+	    .size = Vec2u(u32(image.width()), u32(image.height())),
+	    .format = TextureFormat::R8G8B8A8_UNORM,
+	};
+
+	auto pixels = std::make_shared<SoftwareImage>();
+	pixels->size = texture.info.size;
+	pixels->format = texture.info.format;
+	pixels->pixels.resize(usize(pixels->size.x) * pixels->size.y);
+	decodePixels(*pixels, Rect2u(pixels->size), {.data = image.pixels(), .rowPitch = u32(image.rowPitch())});
+
+	texture.texture = pixels;
+	texture.shaderView = pixels;
+	return Ok;
+}
+
+ImageDifference compareImages(const Texture& a, const Texture& b, float tolerance)
+{
+	ANKER_CHECK(a.texture && b.texture, ImageDifference{.maxDifference = 1});
+	const auto& pixelsA = a.texture->pixels;
+	const auto& pixelsB = b.texture->pixels;
+
+	if (a.texture->size != b.texture->size) {
+		return {
+		    .differingPixels = u32(std::max(pixelsA.size(), pixelsB.size())),
+		    .maxDifference = 1,
+		};
+	}
+
+	ImageDifference result;
+	for (auto [pa, pb] : iter::zip(pixelsA, pixelsB)) {
+		const glm::vec4 difference = glm::abs(glm::vec4(pa) - glm::vec4(pb));
+		const float maxDifference = std::max({difference.x, difference.y, difference.z, difference.w});
+		if (maxDifference > tolerance) {
+			result.differingPixels++;
+		}
+		result.maxDifference = std::max(result.maxDifference, maxDifference);
+	}
+	return result;
+}
+
+} // namespace Anker
+
+#endif
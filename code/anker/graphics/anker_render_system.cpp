@@ -1,9 +1,13 @@
 #include <anker/graphics/anker_render_system.hpp>
 
+#include <anker/core/anker_asset_cache.hpp>
 #include <anker/core/anker_entity_name.hpp>
 #include <anker/core/anker_scene.hpp>
 #include <anker/core/anker_scene_node.hpp>
 #include <anker/graphics/anker_camera.hpp>
+#include <anker/graphics/anker_frame_packet.hpp>
+#include <anker/graphics/anker_label.hpp>
+#include <anker/graphics/anker_particle_emitter.hpp>
 #include <anker/graphics/anker_sprite.hpp>
 #include <anker/graphics/anker_tile_layer.hpp>
 
@@ -16,11 +20,77 @@ struct SceneConstantBuffer {
 };
 static_assert(sizeof(SceneConstantBuffer) % 16 == 0, "Constant Buffer size must be 16-byte aligned");
 
+// SpatialIndex parts of a Sprite and ParticleEmitter, TileLayer chunks use
+// their part index.
+const u32 SpritePart = ~0u;
+const u32 ParticlesPart = ~1u;
+
+// Axis-aligned bounds of the transformed rectangle.
+static Rect2 transformBounds(const Transform2D& transform, const Rect2& rect)
+{
+	const std::array corners = {
+	    transform * rect.topLeft(),
+	    transform * rect.topRight(),
+	    transform * rect.bottomLeft(),
+	    transform * rect.bottomRight(),
+	};
+
+	Vec2 min = corners[0];
+	Vec2 max = corners[0];
+	for (auto corner : corners) {
+		min = {std::min(min.x, corner.x), std::min(min.y, corner.y)};
+		max = {std::max(max.x, corner.x), std::max(max.y, corner.y)};
+	}
+	return Rect2(max - min, min);
+}
+
+// Added or replaced renderables are updated like moved ones.
+static void markRenderableChanged(entt::registry& reg, EntityID entity)
+{
+	reg.emplace_or_replace<TransformChangedTag>(entity);
+}
+
+template <u32 FirstPart, u32 LastPart>
+static void removeRenderable(entt::registry& reg, EntityID entity)
+{
+	reg.ctx().get<SpatialIndex>().markStale(SpatialIndex::key(entity, FirstPart), SpatialIndex::key(entity, LastPart));
+}
+
+// Chunks may be dropped when a TileLayer is replaced, all are added again.
+static void replaceTileLayer(entt::registry& reg, EntityID entity)
+{
+	removeRenderable<0, ParticlesPart - 1>(reg, entity);
+	markRenderableChanged(reg, entity);
+}
+
+void registerSpatialIndexCallbacks(Scene& scene)
+{
+	auto& reg = scene.registry;
+
+	// Adding an alias for when we don't have access to the Scene object.
+	reg.ctx().emplace<SpatialIndex&>(scene.spatialIndex);
+
+	reg.on_construct<Sprite>().connect<&markRenderableChanged>();
+	reg.on_update<Sprite>().connect<&markRenderableChanged>();
+	reg.on_destroy<Sprite>().connect<&removeRenderable<SpritePart, SpritePart>>();
+
+	reg.on_construct<TileLayer>().connect<&markRenderableChanged>();
+	reg.on_update<TileLayer>().connect<&replaceTileLayer>();
+	reg.on_destroy<TileLayer>().connect<&removeRenderable<0, ParticlesPart - 1>>();
+
+	reg.on_destroy<ParticleEmitter>().connect<&removeRenderable<ParticlesPart, ParticlesPart>>();
+
+	// Renderables without a SceneNode are not drawn.
+	reg.on_destroy<SceneNode>().connect<&removeRenderable<0, SpritePart>>();
+}
+
 RenderSystem::RenderSystem(RenderDevice& renderDevice, AssetCache& assetCache)
     : gizmoRenderer(renderDevice, assetCache),
       m_renderDevice(renderDevice),
+      m_assetCache(assetCache),
       m_tileLayerRenderer(renderDevice, assetCache),
       m_spriteRenderer(renderDevice, assetCache),
+      m_particleRenderer(renderDevice, assetCache),
       m_postProcessRenderer(renderDevice, assetCache),
       m_textRenderer(renderDevice, assetCache)
 {
@@ -48,29 +118,29 @@ RenderSystem::RenderSystem(RenderDevice& renderDevice, AssetCache& assetCache)
 	m_renderDevice.enableAlphaBlending();
 }
 
-void RenderSystem::draw(const Scene& scene)
+void RenderSystem::extract(Scene& scene, FramePacket& packet)
 {
 	ANKER_PROFILE_ZONE();
 
+	// Gizmos are extracted in any case, since they are cleared on extract.
+	gizmoRenderer.extract(packet.gizmos);
+
+	packet.hasCamera = false;
+	packet.drawItems.clear();
+
 	auto camera = scene.activeCamera();
 	if (!camera) {
 		ANKER_WARN("No active camera");
-		m_renderDevice.setRenderTarget(m_renderDevice.backBuffer());
-		m_renderDevice.clearRenderTarget(m_renderDevice.backBuffer());
 		return;
 	}
 
 	auto [cameraNode, cameraParams] = camera.try_get<SceneNode, Camera>();
 	if (!cameraNode || !cameraParams) {
 		ANKER_WARN("Invalid active camera");
-		m_renderDevice.setRenderTarget(m_renderDevice.backBuffer());
-		m_renderDevice.clearRenderTarget(m_renderDevice.backBuffer());
 		return;
 	}
 
 	{
-		SceneConstantBuffer sceneCb;
-
 		Mat3 view = Mat3(cameraNode->globalTransform());
 		view = scale(view, glm::vec2(cameraParams->distance));
 
@@ -83,9 +153,61 @@ void RenderSystem::draw(const Scene& scene)
 			view = scale(view, {aspectRatio, 1.0f});
 		}
 
-		sceneCb.view = inverse(view);
-		sceneCb.cameraPosition = cameraNode->globalTransform().position;
+		packet.hasCamera = true;
+		packet.view = inverse(view);
+		packet.cameraPosition = cameraNode->globalTransform().position;
+
+		// The view maps clip space to world space.
+		m_viewBounds = transformBounds(Transform2D(view), Rect2(Vec2(2), Vec2(-1)));
+	}
+
+	////////////////////////////////////////////////////////////
+	// Culling
+
+	updateSpatialIndex(scene);
+
+	m_visible.clear();
+	scene.spatialIndex.queryView(m_viewBounds, cameraNode->globalTransform().position, m_visible);
+	std::ranges::sort(m_visible);
+
+	m_stats = {
+	    .visible = u32(m_visible.size()),
+	    .culled = scene.spatialIndex.size() - u32(m_visible.size()),
+	};
 
+	////////////////////////////////////////////////////////////
+	// Extraction
+
+	m_spriteRenderer.newFrame(packet.sprites);
+	m_tileLayerRenderer.newFrame(packet.tileLayers);
+	m_particleRenderer.newFrame(packet.particles);
+
+	for (auto [_, node] : scene.registry.view<SceneNode>().each()) {
+		if (!node.hasParent()) {
+			extractSceneNodeRecursive(scene, &node, packet);
+		}
+	}
+
+	m_textRenderer.extract(packet.text);
+	m_postProcessRenderer.extract(cameraParams->postProcessParams, packet.postProcess);
+}
+
+void RenderSystem::draw(const FramePacket& packet)
+{
+	ANKER_PROFILE_ZONE();
+
+	if (!packet.hasCamera) {
+		m_renderDevice.setRenderTarget(m_renderDevice.backBuffer());
+		m_renderDevice.clearRenderTarget(m_renderDevice.backBuffer());
+		return;
+	}
+
+	{
+		SceneConstantBuffer sceneCb = {
+		    .view = packet.view,
+		    .cameraPosition = packet.cameraPosition,
+		    ._pad = {},
+		};
 		m_renderDevice.fillBuffer(m_sceneConstantBuffer, std::array{sceneCb});
 		m_renderDevice.bindBufferVS(0, m_sceneConstantBuffer);
 		m_renderDevice.bindBufferPS(0, m_sceneConstantBuffer);
@@ -100,12 +222,23 @@ void RenderSystem::draw(const Scene& scene)
 	m_renderDevice.clearRenderTarget(m_sceneRenderTarget, nullptr, clearColor);
 	m_renderDevice.setRenderTarget(m_sceneRenderTarget);
 
-	for (auto [_, node] : scene.registry.view<SceneNode>().each()) {
-		if (!node.hasParent()) {
-			drawSceneNodeRecursive(scene, &node);
+	for (auto& item : packet.drawItems) {
+		switch (item.kind) {
+		case FramePacket::DrawKind::Sprite:
+			m_spriteRenderer.draw(packet.sprites, item.index);
+			break;
+		case FramePacket::DrawKind::TileLayer:
+			m_tileLayerRenderer.draw(packet.tileLayers, item.index);
+			break;
+		case FramePacket::DrawKind::Particles:
+			m_particleRenderer.draw(packet.particles, item.index);
+			break;
 		}
 	}
 
+	// Text is batched across all labels, hence drawn on top of the scene.
+	m_textRenderer.draw(packet.text);
+
 	////////////////////////////////////////////////////////////
 	// Post Processing
 
@@ -113,10 +246,10 @@ void RenderSystem::draw(const Scene& scene)
 	m_renderDevice.clearRenderTarget(m_renderDevice.backBuffer());
 
 	m_renderDevice.bindTexturePS(0, m_sceneRenderTarget);
-	m_postProcessRenderer.draw(cameraParams->postProcessParams);
+	m_postProcessRenderer.draw(packet.postProcess);
 	m_renderDevice.unbindTexturePS(0);
 
-	gizmoRenderer.draw();
+	gizmoRenderer.draw(packet.gizmos);
 }
 
 void RenderSystem::onResize(Vec2i)
@@ -127,17 +260,86 @@ void RenderSystem::onResize(Vec2i)
 	}
 }
 
-void RenderSystem::drawSceneNodeRecursive(const Scene& scene, const SceneNode* node)
+void RenderSystem::updateSpatialIndex(Scene& scene)
 {
+	ANKER_PROFILE_ZONE();
+
+	auto& index = scene.spatialIndex;
+
+	// Destroyed entities and removed components, see
+	// registerSpatialIndexCallbacks.
+	index.removeStale();
+
+	// Only moved, added, or replaced renderables are updated. Sprites without a
+	// texture are not drawn, their proxy is removed.
+	for (auto [entity, node, sprite] : scene.registry.view<SceneNode, Sprite, TransformChangedTag>().each()) {
+		if (auto* texture = m_assetCache.get(sprite.texture)) {
+			auto bounds = transformBounds(node.globalTransform(), SpriteRenderer::spriteRect(sprite, *texture));
+			index.set(SpatialIndex::key(entity, SpritePart), bounds, sprite.parallax);
+		} else {
+			index.remove(SpatialIndex::key(entity, SpritePart));
+		}
+	}
+
+	for (auto [entity, node, layer] : scene.registry.view<SceneNode, TileLayer, TransformChangedTag>().each()) {
+		const Transform2D transform = node.globalTransform();
+		for (auto [partIndex, part] : iter::enumerate(layer.parts)) {
+			auto bounds = transformBounds(transform, part.bounds);
+			index.set(SpatialIndex::key(entity, u32(partIndex)), bounds, layer.parallax);
+		}
+	}
+
+	scene.registry.clear<TransformChangedTag>();
+
+	// Particles move on their own, hence emitters are updated every frame.
+	// Emitters without live particles are not drawn, their proxy is removed.
+	for (auto [entity, _, emitter] : scene.registry.view<SceneNode, ParticleEmitter>().each()) {
+		const u64 key = SpatialIndex::key(entity, ParticlesPart);
+		if (emitter.pool.count > 0) {
+			index.set(key, ParticleRenderer::bounds(emitter), emitter.parallax);
+		} else {
+			index.remove(key);
+		}
+	}
+}
+
+void RenderSystem::extractSceneNodeRecursive(const Scene& scene, const SceneNode* node, FramePacket& packet)
+{
+	const EntityID entity = node->entity().entity();
+
 	if (node->entity().all_of<Sprite>()) {
-		m_spriteRenderer.draw(scene, node);
+		if (std::ranges::binary_search(m_visible, SpatialIndex::key(entity, SpritePart))) {
+			if (m_spriteRenderer.extract(scene, node, packet.sprites)) {
+				packet.drawItems.push_back({FramePacket::DrawKind::Sprite, u32(packet.sprites.draws.size() - 1)});
+			}
+		}
+	}
+	if (auto* layer = node->entity().try_get<TileLayer>()) {
+		auto first = std::ranges::lower_bound(m_visible, SpatialIndex::key(entity, 0));
+		auto last = std::ranges::lower_bound(m_visible, SpatialIndex::key(entity, u32(layer->parts.size())));
+
+		m_visibleParts.clear();
+		for (auto it = first; it != last; ++it) {
+			m_visibleParts.push_back(SpatialIndex::part(*it));
+		}
+		if (m_tileLayerRenderer.extract(scene, node, m_visibleParts, packet.tileLayers)) {
+			packet.drawItems.push_back({FramePacket::DrawKind::TileLayer, u32(packet.tileLayers.draws.size() - 1)});
+		}
+	}
+	if (node->entity().all_of<ParticleEmitter>()) {
+		if (std::ranges::binary_search(m_visible, SpatialIndex::key(entity, ParticlesPart))) {
+			if (m_particleRenderer.extract(node, m_viewBounds, packet.cameraPosition, packet.particles)) {
+				packet.drawItems.push_back({FramePacket::DrawKind::Particles, u32(packet.particles.draws.size() - 1)});
+			}
+		}
 	}
-	if (node->entity().all_of<TileLayer>()) {
-		m_tileLayerRenderer.draw(scene, node);
+	// Labels are not culled, their bounds are only known once laid out.
+	if (node->entity().all_of<Label>()) {
+		m_textRenderer.queue(scene, node);
 	}
 
 	for (auto* child : node->children()) {
-		drawSceneNodeRecursive(scene, child);
+		extractSceneNodeRecursive(scene, child, packet);
 	}
 }
 
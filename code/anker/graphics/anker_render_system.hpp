@@ -1,6 +1,7 @@
 #pragma once
 
 #include <anker/graphics/anker_gizmo_renderer.hpp>
+#include <anker/graphics/anker_particle_renderer.hpp>
 #include <anker/graphics/anker_post_process_renderer.hpp>
 #include <anker/graphics/anker_render_device.hpp>
 #include <anker/graphics/anker_sprite_renderer.hpp>
@@ -12,6 +13,7 @@ namespace Anker {
 class AssetCache;
 class Scene;
 class SceneNode;
+struct FramePacket;
 
 class RenderSystem {
   public:
@@ -21,25 +23,57 @@ class RenderSystem {
 	RenderSystem(RenderSystem&&) noexcept = delete;
 	RenderSystem& operator=(RenderSystem&&) noexcept = delete;
 
-	void draw(const Scene&);
+	// Updates the scene's SpatialIndex and extracts the entities visible to
+	// the active camera into the packet. Runs on the simulation thread.
+	void extract(Scene&, FramePacket&);
+
+	// Draws an extracted frame, see RenderThread.
+	void draw(const FramePacket&);
 
 	void onResize(Vec2i size);
 
 	GizmoRenderer gizmoRenderer;
 
+	const SpriteRenderer& spriteRenderer() const { return m_spriteRenderer; }
+
+	struct Stats {
+		// Sprites, TileLayer chunks, and ParticleEmitters.
+		u32 visible = 0;
+		u32 culled = 0;
+	};
+
+	const Stats& stats() const { return m_stats; }
+
   private:
-	void drawSceneNodeRecursive(const Scene&, const SceneNode*);
+	void updateSpatialIndex(Scene&);
+
+	void extractSceneNodeRecursive(const Scene&, const SceneNode*, FramePacket&);
 
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
 
 	TileLayerRenderer m_tileLayerRenderer;
 	SpriteRenderer m_spriteRenderer;
+	ParticleRenderer m_particleRenderer;
 	PostProcessRenderer m_postProcessRenderer;
 
 	TextRenderer m_textRenderer;
 
 	GpuBuffer m_sceneConstantBuffer;
 	Texture m_sceneRenderTarget;
+
+	// Sorted SpatialIndex keys of the current frame.
+	std::vector<u64> m_visible;
+	std::vector<u32> m_visibleParts;
+
+	// World rectangle covered by the active camera's view.
+	Rect2 m_viewBounds;
+
+	Stats m_stats;
 };
 
+// Keeps the scene's SpatialIndex informed about removed renderables and marks
+// added or replaced ones for an update, see TransformChangedTag.
+void registerSpatialIndexCallbacks(Scene&);
+
 } // namespace Anker
@@ -0,0 +1,76 @@
+#include <anker/graphics/anker_render_thread.hpp>
+
+#include <anker/core/anker_imgui_system.hpp>
+#include <anker/graphics/anker_render_device.hpp>
+#include <anker/graphics/anker_render_system.hpp>
+
+namespace Anker {
+
+RenderThread::RenderThread(RenderDevice& renderDevice, RenderSystem& renderSystem, ImguiSystem& imguiSystem)
+    : m_renderDevice(renderDevice), m_renderSystem(renderSystem), m_imguiSystem(imguiSystem)
+{
+	m_thread = std::thread([this] { run(); });
+}
+
+RenderThread::~RenderThread() noexcept
+{
+	wait();
+
+	{
+		std::scoped_lock lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	m_thread.join();
+}
+
+void RenderThread::submit()
+{
+	ANKER_PROFILE_ZONE();
+
+	wait();
+
+	{
+		std::scoped_lock lock(m_mutex);
+		m_submitted = &m_packets[m_extractIndex];
+	}
+	m_wake.notify_all();
+
+	m_extractIndex = u32((m_extractIndex + 1) % m_packets.size());
+}
+
+void RenderThread::wait()
+{
+	std::unique_lock lock(m_mutex);
+	m_done.wait(lock, [&] { return !m_submitted; });
+}
+
+void RenderThread::run()
+{
+	std::unique_lock lock(m_mutex);
+	while (true) {
+		m_wake.wait(lock, [&] { return m_stop || m_submitted; });
+		if (m_stop) {
+			return;
+		}
+
+		auto& packet = *m_submitted;
+
+		lock.unlock();
+		{
+			ANKER_PROFILE_ZONE_N("RenderThread::render");
+
+			auto contextLock = m_renderDevice.lockContext();
+			m_renderSystem.draw(packet);
+			m_imguiSystem.draw(packet.imgui);
+			m_renderDevice.present();
+		}
+		lock.lock();
+
+		m_submitted = nullptr;
+		m_done.notify_all();
+	}
+}
+
+} // namespace Anker
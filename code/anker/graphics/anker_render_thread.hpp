@@ -0,0 +1,54 @@
+#pragma once
+
+#include <anker/graphics/anker_frame_packet.hpp>
+
+namespace Anker {
+
+class ImguiSystem;
+class RenderDevice;
+class RenderSystem;
+
+// The RenderThread draws and presents FramePackets, while the simulation
+// thread extracts the next frame into the other one of two packets. Hence,
+// simulation runs at most one frame ahead of rendering.
+class RenderThread {
+  public:
+	RenderThread(RenderDevice&, RenderSystem&, ImguiSystem&);
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+	RenderThread(RenderThread&&) noexcept = delete;
+	RenderThread& operator=(RenderThread&&) noexcept = delete;
+	~RenderThread() noexcept;
+
+	// The packet to extract the next frame into, it is not accessed by the
+	// render thread until submitted.
+	FramePacket& packet() { return m_packets[m_extractIndex]; }
+
+	// Waits for the previous frame to be presented, then hands the packet over
+	// to the render thread.
+	void submit();
+
+	// Blocks until the submitted packet has been presented. Required before
+	// modifying resources used for rendering, e.g. when resizing.
+	void wait();
+
+  private:
+	void run();
+
+	RenderDevice& m_renderDevice;
+	RenderSystem& m_renderSystem;
+	ImguiSystem& m_imguiSystem;
+
+	std::array<FramePacket, 2> m_packets;
+	u32 m_extractIndex = 0;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	FramePacket* m_submitted = nullptr;
+	bool m_stop = false;
+
+	std::thread m_thread;
+};
+
+} // namespace Anker
@@ -4,14 +4,20 @@
 
 namespace Anker {
 
-ScreenRenderer::ScreenRenderer(RenderDevice& renderDevice, AssetCache& assetCache) : m_renderDevice(renderDevice)
+ScreenRenderer::ScreenRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
-	m_vertexShader = assetCache.loadVertexShader("shaders/screen.vs", {});
+	m_vertexShader = assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/screen.vs"_hs, {}));
 }
 
-void ScreenRenderer::draw()
+void ScreenRenderer::extract(Packet& packet) const
 {
-	m_renderDevice.bindVertexShader(*m_vertexShader);
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+}
+
+void ScreenRenderer::draw(const Packet& packet)
+{
+	m_renderDevice.bindVertexShader(packet.vertexShader);
 	m_renderDevice.draw(3);
 }
 
@@ -15,12 +15,20 @@ class ScreenRenderer {
 	ScreenRenderer(ScreenRenderer&&) noexcept = delete;
 	ScreenRenderer& operator=(ScreenRenderer&&) noexcept = delete;
 
-	void draw();
+	struct Packet {
+		VertexShader vertexShader;
+	};
+
+	void extract(Packet&) const;
+
+	void draw(const Packet&);
 
   private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
 
-	AssetPtr<VertexShader> m_vertexShader;
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
 };
 
 } // namespace Anker
@@ -9,11 +9,11 @@ struct Texture;
 struct Sprite {
 	Vec4 color = Vec4(1);
 	Vec2 parallax = Vec2(1);
-	Vec2 offset;
+	Vec2 offset = Vec2(0);
 	bool flipX = false;
 	bool flipY = false;
 	float pixelToMeter = 256.0f;
-	AssetPtr<Texture> texture;
+	AssetHandle<Texture> texture;
 	Rect2 textureRect = Rect2::fromPoints({0, 0}, {1, 1});
 };
 
@@ -17,67 +17,85 @@ struct SpriteRendererConstantBuffer {
 };
 static_assert(sizeof(SpriteRendererConstantBuffer) % 16 == 0, "Constant Buffer size must be 16-byte aligned");
 
-SpriteRenderer::SpriteRenderer(RenderDevice& renderDevice, AssetCache& assetCache) : m_renderDevice(renderDevice)
+SpriteRenderer::SpriteRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
-	m_vertexShader = assetCache.loadVertexShader("shaders/sprite.vs", Vertex2D::ShaderInputs);
-	m_pixelShader = assetCache.loadPixelShader("shaders/sprite.ps");
-
-	m_constantBuffer.info = {
-	    .name = "SpriteRenderer Constant Buffer",
-	    .size = sizeof(SpriteRendererConstantBuffer),
-	    .stride = sizeof(SpriteRendererConstantBuffer),
-	    .bindFlags = GpuBindFlag::ConstantBuffer,
-	    .flags = GpuBufferFlag::CpuWriteable,
-	};
-	if (not m_renderDevice.createBuffer(m_constantBuffer)) {
-		ANKER_FATAL("Failed to create SpriteRenderer Constant Buffer");
+	m_vertexShader =
+	    assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/sprite.vs"_hs, Vertex2D::ShaderInputs));
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/sprite.ps"_hs));
+}
+
+void SpriteRenderer::newFrame(Packet& packet)
+{
+	m_previousStats = std::exchange(m_stats, {});
+	m_previousTexture = nullptr;
+
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+	packet.pixelShader = *m_assetCache.get(m_pixelShader);
+	packet.draws.clear();
+}
+
+bool SpriteRenderer::extract(const Scene&, const SceneNode* node, Packet& packet)
+{
+	auto* sprite = node->entity().try_get<Sprite>();
+	if (!sprite) {
+		return false;
 	}
 
-	m_vertexBuffer.info = {
-	    .name = "SpriteRenderer Vertex Buffer",
-	    .size = 6 * sizeof(Vertex2D),
-	    .stride = sizeof(Vertex2D),
-	    .bindFlags = GpuBindFlag::VertexBuffer,
-	    .flags = GpuBufferFlag::CpuWriteable,
-	};
-	if (not m_renderDevice.createBuffer(m_vertexBuffer)) {
-		ANKER_FATAL("Failed to create SpriteRenderer Vertex Buffer");
+	auto* texture = m_assetCache.get(sprite->texture);
+	if (!texture) {
+		return false;
 	}
+
+	m_stats.sprites++;
+	if (texture != m_previousTexture) {
+		m_stats.textureChanges++;
+		m_previousTexture = texture;
+	}
+
+	packet.draws.push_back({
+	    .transform = Mat3(node->globalTransform()),
+	    .color = sprite->color,
+	    .parallax = sprite->parallax,
+	    .quad = Vertex2D::makeQuad(spriteRect(*sprite, *texture), sprite->textureRect, sprite->flipX, sprite->flipY),
+	    .texture = texture->shaderView,
+	});
+	return true;
 }
 
-void SpriteRenderer::draw(const Scene&, const SceneNode* node)
+void SpriteRenderer::draw(const Packet& packet, u32 drawIndex)
 {
 	ANKER_PROFILE_ZONE();
 
-	auto* sprite = node->entity().try_get<Sprite>();
-	if (!sprite || !sprite->texture) {
-		return;
-	}
+	auto& draw = packet.draws[drawIndex];
 
-	m_renderDevice.bindVertexShader(*m_vertexShader);
-	m_renderDevice.bindPixelShader(*m_pixelShader);
+	m_renderDevice.bindVertexShader(packet.vertexShader);
+	m_renderDevice.bindPixelShader(packet.pixelShader);
 
 	{
 		SpriteRendererConstantBuffer cb = {
-		    .transform = Mat3(node->globalTransform()),
-		    .color = sprite->color,
-		    .parallax = sprite->parallax,
+		    .transform = draw.transform,
+		    .color = draw.color,
+		    .parallax = draw.parallax,
 		};
-		m_renderDevice.fillBuffer(m_constantBuffer, std::array{cb});
-		m_renderDevice.bindBufferVS(1, m_constantBuffer);
-		m_renderDevice.bindBufferPS(1, m_constantBuffer);
+		auto constants = m_renderDevice.uploadConstants(cb);
+		m_renderDevice.bindBufferVS(1, constants);
+		m_renderDevice.bindBufferPS(1, constants);
 	}
 
-	Rect2 spriteRect;
-	spriteRect.size = Vec2(sprite->texture->info.size) * sprite->textureRect.size / sprite->pixelToMeter;
-	spriteRect.offset = spriteRect.size * sprite->offset;
+	auto vertices = m_renderDevice.uploadVertices(draw.quad);
 
-	m_renderDevice.fillBuffer(m_vertexBuffer, Vertex2D::makeQuad(spriteRect, sprite->textureRect, //
-	                                                             sprite->flipX, sprite->flipY));
-
-	m_renderDevice.bindTexturePS(0, *sprite->texture);
-	m_renderDevice.draw(m_vertexBuffer);
+	m_renderDevice.bindTexturePS(0, draw.texture);
+	m_renderDevice.draw(vertices);
 	m_renderDevice.unbindTexturePS(0);
 }
 
+Rect2 SpriteRenderer::spriteRect(const Sprite& sprite, const Texture& texture)
+{
+	Rect2 rect;
+	rect.size = Vec2(texture.info.size) * sprite.textureRect.size / sprite.pixelToMeter;
+	rect.offset = rect.size * sprite.offset;
+	return rect;
+}
+
 } // namespace Anker
@@ -2,12 +2,14 @@
 
 #include <anker/core/anker_asset.hpp>
 #include <anker/graphics/anker_render_device.hpp>
+#include <anker/graphics/anker_vertex.hpp>
 
 namespace Anker {
 
 class AssetCache;
 class Scene;
 class SceneNode;
+struct Sprite;
 
 class SpriteRenderer {
   public:
@@ -17,15 +19,54 @@ class SpriteRenderer {
 	SpriteRenderer(SpriteRenderer&&) noexcept = delete;
 	SpriteRenderer& operator=(SpriteRenderer&&) noexcept = delete;
 
-	void draw(const Scene&, const SceneNode*);
+	struct Packet {
+		VertexShader vertexShader;
+		PixelShader pixelShader;
+
+		struct Draw {
+			Mat3 transform = Mat3Id;
+			Vec4 color = Vec4(1);
+			Vec2 parallax = Vec2(1);
+			std::array<Vertex2D, 6> quad;
+			ShaderViewRef texture;
+		};
+		std::vector<Draw> draws;
+	};
+
+	// Clears the packet, called at the start of every frame's extraction.
+	void newFrame(Packet&);
+
+	// Appends the node's Sprite to the packet. Returns false if there is
+	// nothing to draw, e.g. the texture is not loaded.
+	bool extract(const Scene&, const SceneNode*, Packet&);
+
+	void draw(const Packet&, u32 drawIndex);
+
+	// The sprite's quad in local space.
+	static Rect2 spriteRect(const Sprite&, const Texture&);
+
+	struct Stats {
+		u32 sprites = 0;
+
+		// Number of times consecutive sprites used different textures. Sprites
+		// in between could share a draw call, see AssetCache::loadSpriteTexture.
+		u32 textureChanges = 0;
+	};
+
+	// Counters of the previous frame.
+	const Stats& stats() const { return m_previousStats; }
 
   private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
+
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
+	AssetHandle<PixelShader> m_pixelShader;
 
-	AssetPtr<VertexShader> m_vertexShader;
-	AssetPtr<PixelShader> m_pixelShader;
-	GpuBuffer m_constantBuffer;
-	GpuBuffer m_vertexBuffer;
+	Stats m_stats;
+	Stats m_previousStats;
+	const Texture* m_previousTexture = nullptr;
 };
 
 } // namespace Anker
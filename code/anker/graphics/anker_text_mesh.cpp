@@ -0,0 +1,170 @@
+#include <anker/graphics/anker_text_mesh.hpp>
+
+#include <anker/graphics/anker_font_system.hpp>
+
+namespace Anker {
+
+// Glyph indices are 16-bit, see Font::kern.
+constexpr u32 NoGlyph = ~0u;
+
+void TextMesh::update(FontSystem& fontSystem, const Font& font, std::string_view text, const TextLayout& layout)
+{
+	const u32 generation = fontSystem.glyphCache(layout.mode).generation();
+
+	if (m_fontId == font.id() && m_layout == layout && m_glyphCacheGeneration == generation && m_text == text) {
+		return;
+	}
+
+	m_text = text;
+	m_layout = layout;
+	m_fontId = font.id();
+
+	build(fontSystem, font);
+
+	// Layouting may have evicted glyphs used by other meshes, but not the ones
+	// used by this mesh.
+	m_glyphCacheGeneration = fontSystem.glyphCache(m_layout.mode).generation();
+}
+
+void TextMesh::build(FontSystem& fontSystem, const Font& font)
+{
+	ANKER_PROFILE_ZONE();
+
+	m_vertices.clear();
+	m_batches.clear();
+	m_size = {};
+
+	const GlyphMode mode = m_layout.mode;
+	const u32 pixelSize = mode == GlyphMode::Sdf ? FontSystem::SdfPixelSize : m_layout.pixelSize;
+	const float pixelScale = m_layout.size / float(pixelSize);
+	const float lineHeight = font.lineHeight(float(pixelSize));
+	const float maxWidth = m_layout.maxWidth / pixelScale;
+
+	// SDF glyphs are generated up front, so they can be generated in parallel.
+	if (mode == GlyphMode::Sdf) {
+		std::vector<char32_t> codepoints;
+		for (std::string_view remaining = m_text; !remaining.empty();) {
+			codepoints.push_back(Utf8::popFront(remaining));
+		}
+		fontSystem.prepareSdfGlyphs(font, codepoints);
+	}
+
+	// Glyphs are placed in pixels first, lines are aligned once complete.
+	struct PlacedGlyph {
+		Vec2 position;
+		Rect2 visRect;
+		Rect2 texRect;
+		u32 page = 0;
+	};
+	std::vector<PlacedGlyph> glyphs;
+
+	struct Line {
+		usize begin = 0;
+		usize end = 0;
+		float width = 0;
+	};
+	std::vector<Line> lines;
+
+	float x = 0;
+	float lineWidth = 0; // Excluding trailing spaces
+	usize lineBegin = 0;
+	u32 previousGlyph = NoGlyph;
+
+	// Start of the last word on the current line, where it may be wrapped.
+	// Wrap points at or before lineBegin are unset.
+	struct WrapPoint {
+		usize begin = 0;
+		float x = 0;
+		float lineWidth = 0;
+	};
+	WrapPoint wrap;
+
+	auto endLine = [&](usize end, float width) {
+		lines.push_back({.begin = lineBegin, .end = end, .width = width});
+		lineBegin = end;
+		wrap = {};
+		previousGlyph = NoGlyph;
+	};
+
+	for (std::string_view remaining = m_text; !remaining.empty();) {
+		const char32_t codepoint = Utf8::popFront(remaining);
+
+		if (codepoint == '\n') {
+			endLine(glyphs.size(), lineWidth);
+			x = lineWidth = 0;
+			continue;
+		}
+
+		auto& glyph = fontSystem.glyph(font, codepoint, pixelSize, mode);
+
+		if (previousGlyph != NoGlyph) {
+			x += font.kern(previousGlyph, glyph.index, float(pixelSize));
+		}
+		previousGlyph = glyph.index;
+
+		if (codepoint == ' ') {
+			x += glyph.xAdvance;
+			wrap = {.begin = glyphs.size(), .x = x, .lineWidth = lineWidth};
+			continue;
+		}
+
+		// The current word is moved to a new line. Words wider than a line are
+		// not broken up.
+		if (maxWidth > 0 && x + glyph.visRect.topRightWorld().x > maxWidth && wrap.begin > lineBegin) {
+			const WrapPoint word = wrap;
+			endLine(word.begin, word.lineWidth);
+			for (usize i = word.begin; i < glyphs.size(); ++i) {
+				glyphs[i].position -= Vec2(word.x, lineHeight);
+			}
+			x -= word.x;
+			previousGlyph = glyph.index;
+		}
+
+		if (glyph.page != GlyphCache::NoPage) {
+			glyphs.push_back({
+			    .position = {x, -lineHeight * float(lines.size())},
+			    .visRect = glyph.visRect,
+			    .texRect = glyph.texRect,
+			    .page = glyph.page,
+			});
+		}
+
+		x += glyph.xAdvance;
+		lineWidth = x;
+	}
+	endLine(glyphs.size(), lineWidth);
+
+	for (auto& line : lines) {
+		float offset = 0;
+		if (m_layout.alignment == TextAlignment::Center) {
+			offset = -line.width / 2;
+		} else if (m_layout.alignment == TextAlignment::Right) {
+			offset = -line.width;
+		}
+
+		for (usize i = line.begin; i < line.end; ++i) {
+			glyphs[i].position.x += offset;
+		}
+
+		m_size.x = std::max(m_size.x, line.width * pixelScale);
+	}
+	m_size.y = lineHeight * float(lines.size()) * pixelScale;
+
+	// One batch per glyph cache page.
+	std::ranges::stable_sort(glyphs, {}, &PlacedGlyph::page);
+
+	m_vertices.reserve(glyphs.size() * 6);
+	for (auto& glyph : glyphs) {
+		if (m_batches.empty() || m_batches.back().page != glyph.page) {
+			m_batches.push_back({.page = glyph.page, .firstVertex = u32(m_vertices.size())});
+		}
+
+		Rect2 rect(glyph.visRect.size * pixelScale, (glyph.position + glyph.visRect.offset) * pixelScale);
+		auto quad = Vertex2D::makeQuad(rect, glyph.texRect);
+		m_vertices.insert(m_vertices.end(), quad.begin(), quad.end());
+
+		m_batches.back().vertexCount += u32(quad.size());
+	}
+}
+
+} // namespace Anker
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <anker/graphics/anker_glyph_cache.hpp>
+#include <anker/graphics/anker_vertex.hpp>
+
+namespace Anker {
+
+class Font;
+class FontSystem;
+
+enum class TextAlignment {
+	Left,
+	Center,
+	Right,
+};
+
+struct TextLayout {
+	float size = 2;     // Height of a line in world units
+	u32 pixelSize = 32; // Size at which glyphs are rasterized, unused for SDF glyphs
+	GlyphMode mode = GlyphMode::Bitmap;
+	TextAlignment alignment = TextAlignment::Left;
+	float maxWidth = 0; // Lines are wrapped at spaces, 0 disables wrapping
+
+	friend bool operator==(const TextLayout&, const TextLayout&) = default;
+};
+
+// A TextMesh holds the laid out glyph quads of a UTF-8 string. The layout is
+// only computed again when the string, font, or layout parameters change, or
+// when glyphs were evicted from the FontSystem's glyph cache.
+//
+// Vertices are in local space; the first line's baseline starts at the origin
+// and subsequent lines go downwards. Quads are grouped by glyph cache page.
+class TextMesh {
+  public:
+	void update(FontSystem&, const Font&, std::string_view text, const TextLayout&);
+
+	struct Batch {
+		u32 page = 0;
+		u32 firstVertex = 0;
+		u32 vertexCount = 0;
+	};
+
+	std::span<const Vertex2D> vertices() const { return m_vertices; }
+	std::span<const Batch> batches() const { return m_batches; }
+
+	// Batches refer to the pages of the glyph cache for this mode.
+	GlyphMode mode() const { return m_layout.mode; }
+
+	// Extent of the laid out lines, in world units.
+	Vec2 size() const { return m_size; }
+
+  private:
+	void build(FontSystem&, const Font&);
+
+	std::string m_text;
+	TextLayout m_layout;
+	u32 m_fontId = 0;
+	u32 m_glyphCacheGeneration = 0;
+
+	std::vector<Vertex2D> m_vertices;
+	std::vector<Batch> m_batches;
+	Vec2 m_size;
+};
+
+} // namespace Anker
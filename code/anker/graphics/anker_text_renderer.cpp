@@ -1,86 +1,117 @@
 #include <anker/graphics/anker_text_renderer.hpp>
 
 #include <anker/core/anker_asset_cache.hpp>
-#include <anker/graphics/anker_font.hpp>
-#include <anker/graphics/anker_vertex.hpp>
+#include <anker/core/anker_scene_node.hpp>
+#include <anker/graphics/anker_font_system.hpp>
+#include <anker/graphics/anker_label.hpp>
 
 namespace Anker {
 
-TextRenderer::TextRenderer(RenderDevice& renderDevice, AssetCache& assetCache) : m_renderDevice(renderDevice)
+TextRenderer::TextRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
-	m_vertexShader = assetCache.loadVertexShader("shaders/text.vs", Vertex2D::ShaderInputs);
-	m_pixelShader = assetCache.loadPixelShader("shaders/text.ps");
-
-	m_vertexBuffer.info = {
-	    .name = "TextRenderer Vertex Buffer",
-	    .size = 1024 * sizeof(Vertex2D),
-	    .stride = sizeof(Vertex2D),
-	    .bindFlags = GpuBindFlag::VertexBuffer,
-	    .flags = GpuBufferFlag::CpuWriteable,
-	};
-	if (not m_renderDevice.createBuffer(m_vertexBuffer)) {
-		ANKER_FATAL("Failed to create TextRenderer Vertex Buffer");
-	}
+	m_vertexShader =
+	    assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/text.vs"_hs, Vertex2D::ShaderInputs));
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/text.ps"_hs));
+	m_sdfPixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/text_sdf.ps"_hs));
 }
 
-void TextRenderer::draw(const Font& font, std::string_view text)
+void TextRenderer::queue(const Scene&, const SceneNode* node)
 {
 	ANKER_PROFILE_ZONE();
 
-	std::vector<Vertex2D> vertices;
+	auto* label = node->entity().try_get<Label>();
+	if (!label) {
+		return;
+	}
+
+	auto& fontSystem = m_assetCache.fontSystem();
+
+	const Font* font = m_assetCache.get(label->font);
+	if (!font) {
+		font = &fontSystem.systemFont();
+	}
+
+	label->mesh.update(fontSystem, *font, label->text, label->layout);
+	queue(label->mesh, node->globalTransform());
+}
+
+void TextRenderer::queue(const TextMesh& mesh, const Transform2D& transform)
+{
+	auto& glyphCache = m_assetCache.fontSystem().glyphCache(mesh.mode());
+	auto& pages = m_pageVertices[usize(mesh.mode())];
 
-	Vec2 cursor = {0, 0};
+	for (auto& batch : mesh.batches()) {
+		// Queued glyphs must survive glyph cache updates until drawn.
+		glyphCache.markUsed(batch.page);
 
-	for (unsigned i = 0; i < text.size(); ++i) {
-		auto& charData = font.charData(text[i]);
+		if (batch.page >= pages.size()) {
+			pages.resize(batch.page + 1);
+		}
 
-		if (i != 0) {
-			cursor.x += font.kern(text[i - 1], text[i]);
+		auto& pageVertices = pages[batch.page];
+		for (auto& vertex : mesh.vertices().subspan(batch.firstVertex, batch.vertexCount)) {
+			pageVertices.push_back({.position = transform * vertex.position, .uv = vertex.uv});
 		}
+	}
+}
 
-		vertices.insert(    //
-		    vertices.end(), //
-		    {
-		        Vertex2D{
-		            .position = cursor + charData.visRect.topLeftWorld(),
-		            .uv = charData.texRect.topLeft(),
-		        },
-		        Vertex2D{
-		            .position = cursor + charData.visRect.bottomLeftWorld(),
-		            .uv = charData.texRect.bottomLeft(),
-		        },
-		        Vertex2D{
-		            .position = cursor + charData.visRect.topRightWorld(),
-		            .uv = charData.texRect.topRight(),
-		        },
-		        Vertex2D{
-		            .position = cursor + charData.visRect.topRightWorld(),
-		            .uv = charData.texRect.topRight(),
-		        },
-		        Vertex2D{
-		            .position = cursor + charData.visRect.bottomLeftWorld(),
-		            .uv = charData.texRect.bottomLeft(),
-		        },
-		        Vertex2D{
-		            .position = cursor + charData.visRect.bottomRightWorld(),
-		            .uv = charData.texRect.bottomRight(),
-		        },
-		    });
-
-		cursor.x += charData.xAdvance;
+void TextRenderer::extract(Packet& packet)
+{
+	ANKER_PROFILE_ZONE();
+
+	packet.batches.clear();
+	packet.vertices.clear();
+
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+
+	for (auto mode : {GlyphMode::Bitmap, GlyphMode::Sdf}) {
+		// Without the SDF shader, SDF glyphs are drawn like bitmap glyphs,
+		// which looks blurry but keeps the text legible.
+		auto* pixelShader = m_assetCache.get(mode == GlyphMode::Sdf ? m_sdfPixelShader : m_pixelShader);
+		if (!pixelShader->shader) {
+			pixelShader = m_assetCache.get(m_pixelShader);
+		}
+		packet.pixelShaders[usize(mode)] = *pixelShader;
+
+		auto& glyphCache = m_assetCache.fontSystem().glyphCache(mode);
+		auto& pages = m_pageVertices[usize(mode)];
+
+		for (u32 page = 0; page < pages.size(); ++page) {
+			auto& pageVertices = pages[page];
+			if (pageVertices.empty()) {
+				continue;
+			}
+
+			packet.batches.push_back({
+			    .mode = mode,
+			    .page = glyphCache.pageTexture(page).shaderView,
+			    .firstVertex = u32(packet.vertices.size()),
+			    .vertexCount = u32(pageVertices.size()),
+			});
+			packet.vertices.insert(packet.vertices.end(), pageVertices.begin(), pageVertices.end());
+			pageVertices.clear();
+		}
 	}
+}
+
+void TextRenderer::draw(const Packet& packet)
+{
+	ANKER_PROFILE_ZONE();
 
-	for (auto& v : vertices) {
-		v.position /= 16;
+	if (packet.vertices.empty()) {
+		return;
 	}
 
-	m_renderDevice.fillBuffer(m_vertexBuffer, vertices);
+	auto vertices = m_renderDevice.uploadVertices(packet.vertices);
 
-	m_renderDevice.bindVertexShader(*m_vertexShader);
-	m_renderDevice.bindPixelShader(*m_pixelShader);
+	m_renderDevice.bindVertexShader(packet.vertexShader);
 
-	m_renderDevice.bindTexturePS(0, font.texture());
-	m_renderDevice.draw(m_vertexBuffer, u32(vertices.size()));
+	for (auto& batch : packet.batches) {
+		m_renderDevice.bindPixelShader(packet.pixelShaders[usize(batch.mode)]);
+		m_renderDevice.bindTexturePS(0, batch.page);
+		m_renderDevice.draw(vertices, batch.vertexCount, batch.firstVertex);
+	}
 	m_renderDevice.unbindTexturePS(0);
 }
 
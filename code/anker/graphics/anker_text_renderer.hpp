@@ -1,12 +1,17 @@
 #pragma once
 
 #include <anker/core/anker_asset.hpp>
+#include <anker/graphics/anker_glyph_cache.hpp>
 #include <anker/graphics/anker_render_device.hpp>
+#include <anker/graphics/anker_vertex.hpp>
 
 namespace Anker {
 
-class Font;
 class AssetCache;
+class Scene;
+class SceneNode;
+class TextMesh;
+struct Transform2D;
 
 class TextRenderer {
   public:
@@ -16,14 +21,44 @@ class TextRenderer {
 	TextRenderer(TextRenderer&&) noexcept = delete;
 	TextRenderer& operator=(TextRenderer&&) noexcept = delete;
 
-	void draw(const Font&, std::string_view text);
+	// Updates the node's Label mesh, if necessary, and queues it.
+	void queue(const Scene&, const SceneNode*);
+
+	// Queued text is not drawn until extracted.
+	void queue(const TextMesh&, const Transform2D&);
+
+	struct Packet {
+		VertexShader vertexShader;
+		std::array<PixelShader, 2> pixelShaders; // By GlyphMode
+
+		struct Batch {
+			GlyphMode mode = GlyphMode::Bitmap;
+			ShaderViewRef page;
+			u32 firstVertex = 0;
+			u32 vertexCount = 0;
+		};
+		std::vector<Batch> batches;
+		std::vector<Vertex2D> vertices;
+	};
+
+	// Moves all queued text into the packet, batched per glyph cache page.
+	void extract(Packet&);
+
+	// Uploads all text at once, and draws it with one draw call per batch.
+	void draw(const Packet&);
 
   private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
+
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
+	AssetHandle<PixelShader> m_pixelShader;
+	AssetHandle<PixelShader> m_sdfPixelShader;
 
-	AssetPtr<VertexShader> m_vertexShader;
-	AssetPtr<PixelShader> m_pixelShader;
-	GpuBuffer m_vertexBuffer;
+	// Queued vertices by glyph mode and glyph cache page. Kept across frames
+	// to avoid allocations.
+	std::array<std::vector<std::vector<Vertex2D>>, 2> m_pageVertices;
 };
 
 } // namespace Anker
@@ -0,0 +1,81 @@
+#include <anker/graphics/anker_texture_atlas.hpp>
+
+#include <stb_rect_pack.h>
+
+namespace Anker {
+
+// The packing context refers to its nodes, hence pages are heap allocated and
+// never moved.
+struct TextureAtlas::Page {
+	stbrp_context context;
+	std::vector<stbrp_node> nodes;
+};
+
+TextureAtlas::TextureAtlas(Vec2u pageSize, u32 padding) : m_pageSize(pageSize), m_padding(padding) {}
+
+TextureAtlas::~TextureAtlas() noexcept = default;
+
+std::optional<TextureAtlas::Allocation> TextureAtlas::allocate(Vec2u size)
+{
+	ANKER_CHECK(size.x > 0 && size.y > 0, std::nullopt);
+
+	if (size.x > m_pageSize.x || size.y > m_pageSize.y) {
+		return std::nullopt;
+	}
+
+	// Pages are only appended, earlier pages are likely full.
+	for (u32 pageIndex = pageCount(); pageIndex-- > 0;) {
+		if (auto allocation = allocate(pageIndex, size)) {
+			return allocation;
+		}
+	}
+
+	auto& page = *m_pages.emplace_back(std::make_unique<Page>());
+	page.nodes.resize(m_pageSize.x);
+	stbrp_init_target(&page.context, int(m_pageSize.x), int(m_pageSize.y), page.nodes.data(), int(page.nodes.size()));
+
+	return allocate(pageCount() - 1, size);
+}
+
+std::optional<TextureAtlas::Allocation> TextureAtlas::allocate(u32 pageIndex, Vec2u size)
+{
+	// Padding is added to the right and bottom, so neighbouring allocations
+	// are separated by a gap. The page's border takes care of the remaining
+	// edges. Allocations touching the page's right or bottom edge do not need
+	// padding, hence it is clamped.
+	stbrp_rect rect{
+	    .id = 0,
+	    .w = int(std::min(size.x + m_padding, m_pageSize.x)),
+	    .h = int(std::min(size.y + m_padding, m_pageSize.y)),
+	    .x = 0,
+	    .y = 0,
+	    .was_packed = 0,
+	};
+
+	if (!stbrp_pack_rects(&m_pages[pageIndex]->context, &rect, 1)) {
+		return std::nullopt;
+	}
+
+	m_allocationCount++;
+	m_allocatedArea += u64(size.x) * size.y;
+
+	return Allocation{
+	    .page = pageIndex,
+	    .rect = Rect2u(size, Vec2u(u32(rect.x), u32(rect.y))),
+	};
+}
+
+Rect2 TextureAtlas::textureCoordinates(const Rect2u& rect) const
+{
+	return Rect2(Vec2(rect.size) / Vec2(m_pageSize), Vec2(rect.offset) / Vec2(m_pageSize));
+}
+
+float TextureAtlas::occupancy() const
+{
+	if (m_pages.empty()) {
+		return 0;
+	}
+	return float(double(m_allocatedArea) / (double(m_pageSize.x) * m_pageSize.y * double(m_pages.size())));
+}
+
+} // namespace Anker
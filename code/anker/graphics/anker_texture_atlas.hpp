@@ -0,0 +1,52 @@
+#pragma once
+
+namespace Anker {
+
+// The TextureAtlas packs rectangles into fixed-size pages using stb_rect_pack.
+// It only tracks allocations; the pages' textures are owned by the user, see
+// AssetCache::loadSpriteTexture.
+//
+// Allocations cannot be freed individually.
+class TextureAtlas {
+  public:
+	explicit TextureAtlas(Vec2u pageSize, u32 padding = 1);
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+	TextureAtlas(TextureAtlas&&) noexcept = delete;
+	TextureAtlas& operator=(TextureAtlas&&) noexcept = delete;
+	~TextureAtlas() noexcept;
+
+	struct Allocation {
+		u32 page = 0;
+		Rect2u rect;
+	};
+
+	// Adds a page when the rectangle does not fit into the existing ones. Fails
+	// if the rectangle is larger than a page.
+	std::optional<Allocation> allocate(Vec2u size);
+
+	// Converts the rect of an allocation to texture coordinates of its page.
+	Rect2 textureCoordinates(const Rect2u&) const;
+
+	Vec2u pageSize() const { return m_pageSize; }
+	u32 pageCount() const { return u32(m_pages.size()); }
+	u32 allocationCount() const { return m_allocationCount; }
+
+	// Fraction of the pages' area occupied by allocations, padding excluded.
+	float occupancy() const;
+
+  private:
+	struct Page;
+
+	std::optional<Allocation> allocate(u32 pageIndex, Vec2u size);
+
+	Vec2u m_pageSize;
+	u32 m_padding = 0;
+
+	std::vector<std::unique_ptr<Page>> m_pages;
+
+	u32 m_allocationCount = 0;
+	u64 m_allocatedArea = 0;
+};
+
+} // namespace Anker
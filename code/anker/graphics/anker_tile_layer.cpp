@@ -0,0 +1,24 @@
+#include <anker/graphics/anker_tile_layer.hpp>
+
+#include <anker/core/anker_engine.hpp>
+
+namespace Anker {
+
+bool serialize(InspectorWidgetDrawer& draw, TileLayer& tileLayer)
+{
+	bool changed = false;
+
+	changed = draw.fieldAsColor("color", tileLayer.color) || changed;
+	changed = draw.field("parallax", tileLayer.parallax) || changed;
+
+	ImGui::Text("Parts: %d", tileLayer.parts.size());
+	for (auto [i, part] : iter::enumerate(tileLayer.parts)) {
+		auto* texture = g_engine->assetCache.get(part.texture);
+		ImGui::Text("%2d: Vertices: %d\n    Texture:  %s", i, part.vertexBuffer.info.elementCount(),
+		            texture ? texture->info.name.c_str() : "<none>");
+	}
+
+	return changed;
+}
+
+} // namespace Anker
@@ -1,30 +1,25 @@
 #pragma once
 
 #include <anker/core/anker_asset.hpp>
+#include <anker/editor/anker_inspector_widget_drawer.hpp>
 #include <anker/graphics/anker_render_device.hpp>
 
 namespace Anker {
 
+// Tiles of a chunk using the same texture.
+struct TileLayerPart {
+	GpuBuffer vertexBuffer;
+	AssetHandle<Texture> texture;
+	Rect2 bounds; // Local space
+};
+
 struct TileLayer {
 	Vec4 color = Vec4(1);
 	Vec2 parallax = Vec2(1);
-	std::vector<std::pair<GpuBuffer, AssetPtr<Texture>>> parts;
+	std::vector<TileLayerPart> parts;
 };
 
-inline bool serialize(InspectorWidgetDrawer& draw, TileLayer& tileLayer)
-{
-	bool changed = false;
-
-	changed = draw.fieldAsColor("color", tileLayer.color) || changed;
-	changed = draw.field("parallax", tileLayer.parallax) || changed;
-
-	ImGui::Text("Parts: %d", tileLayer.parts.size());
-	for (auto [i, part] : iter::enumerate(tileLayer.parts)) {
-		ImGui::Text("%2d: Vertices: %d\n    Texture:  %s", i, part.first.info.elementCount(), part.second->info.name.c_str());
-	}
-
-	return changed;
-}
+bool serialize(InspectorWidgetDrawer&, TileLayer&);
 
 } // namespace Anker
 
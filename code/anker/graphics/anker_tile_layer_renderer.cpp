@@ -18,52 +18,75 @@ struct MapRendererConstantBuffer {
 };
 static_assert(sizeof(MapRendererConstantBuffer) % 16 == 0, "Constant Buffer size must be 16-byte aligned");
 
-TileLayerRenderer::TileLayerRenderer(RenderDevice& renderDevice, AssetCache& assetCache) : m_renderDevice(renderDevice)
+TileLayerRenderer::TileLayerRenderer(RenderDevice& renderDevice, AssetCache& assetCache)
+    : m_renderDevice(renderDevice), m_assetCache(assetCache)
 {
-	m_constantBuffer.info = {
-	    .name = "TileLayerRenderer Constant Buffer",
-	    .size = sizeof(MapRendererConstantBuffer),
-	    .stride = sizeof(MapRendererConstantBuffer),
-	    .bindFlags = GpuBindFlag::ConstantBuffer,
-	    .flags = GpuBufferFlag::CpuWriteable,
-	};
-	if (not m_renderDevice.createBuffer(m_constantBuffer)) {
-		ANKER_FATAL("Failed to create TileLayerRenderer Constant Buffer");
+	m_vertexShader =
+	    assetCache.pin(m_assetPins, assetCache.loadVertexShader("shaders/map.vs"_hs, Vertex2D::ShaderInputs));
+	m_pixelShader = assetCache.pin(m_assetPins, assetCache.loadPixelShader("shaders/map.ps"_hs));
+}
+
+void TileLayerRenderer::newFrame(Packet& packet)
+{
+	packet.vertexShader = *m_assetCache.get(m_vertexShader);
+	packet.pixelShader = *m_assetCache.get(m_pixelShader);
+	packet.parts.clear();
+	packet.draws.clear();
+}
+
+bool TileLayerRenderer::extract(const Scene&, const SceneNode* node, std::span<const u32> parts, Packet& packet)
+{
+	auto* layer = node->entity().try_get<TileLayer>();
+	if (!layer || parts.empty()) {
+		return false;
 	}
 
-	m_vertexShader = assetCache.loadVertexShader("shaders/map.vs", Vertex2D::ShaderInputs);
-	m_pixelShader = assetCache.loadPixelShader("shaders/map.ps");
+	const u32 firstPart = u32(packet.parts.size());
+	for (u32 partIndex : parts) {
+		auto& part = layer->parts[partIndex];
+		if (auto* texture = m_assetCache.get(part.texture)) {
+			packet.parts.push_back({
+			    .vertexBuffer = part.vertexBuffer.buffer,
+			    .vertexCount = part.vertexBuffer.info.elementCount(),
+			    .texture = texture->shaderView,
+			});
+		}
+	}
+
+	packet.draws.push_back({
+	    .transform = Mat3(node->globalTransform()),
+	    .color = layer->color,
+	    .parallax = layer->parallax,
+	    .firstPart = firstPart,
+	    .partCount = u32(packet.parts.size()) - firstPart,
+	});
+	return true;
 }
 
-void TileLayerRenderer::draw(const Scene&, const SceneNode* node)
+void TileLayerRenderer::draw(const Packet& packet, u32 drawIndex)
 {
 	ANKER_PROFILE_ZONE();
 
-	auto* layer = node->entity().try_get<TileLayer>();
-	if (!layer) {
-		return;
-	}
+	auto& draw = packet.draws[drawIndex];
 
-	m_renderDevice.bindVertexShader(*m_vertexShader);
-	m_renderDevice.bindPixelShader(*m_pixelShader);
+	m_renderDevice.bindVertexShader(packet.vertexShader);
+	m_renderDevice.bindPixelShader(packet.pixelShader);
 
 	{
 		MapRendererConstantBuffer cb = {
-		    .transform = Mat3(node->globalTransform()),
-		    .color = layer->color,
-		    .parallax = layer->parallax,
+		    .transform = draw.transform,
+		    .color = draw.color,
+		    .parallax = draw.parallax,
 		};
-		m_renderDevice.fillBuffer(m_constantBuffer, std::array{cb});
-		m_renderDevice.bindBufferVS(1, m_constantBuffer);
-		m_renderDevice.bindBufferPS(1, m_constantBuffer);
+		auto constants = m_renderDevice.uploadConstants(cb);
+		m_renderDevice.bindBufferVS(1, constants);
+		m_renderDevice.bindBufferPS(1, constants);
 	}
 
-	for (auto& [vertexBuffer, texture] : layer->parts) {
-		if (texture) {
-			m_renderDevice.bindTexturePS(0, *texture);
-			m_renderDevice.draw(vertexBuffer);
-			m_renderDevice.unbindTexturePS(0);
-		}
+	for (auto& part : std::span(packet.parts).subspan(draw.firstPart, draw.partCount)) {
+		m_renderDevice.bindTexturePS(0, part.texture);
+		m_renderDevice.draw(part.vertexBuffer, sizeof(Vertex), part.vertexCount);
+		m_renderDevice.unbindTexturePS(0);
 	}
 }
 
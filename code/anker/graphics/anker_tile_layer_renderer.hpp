@@ -18,17 +18,45 @@ class TileLayerRenderer {
 	TileLayerRenderer(TileLayerRenderer&&) noexcept = delete;
 	TileLayerRenderer& operator=(TileLayerRenderer&&) noexcept = delete;
 
-	void draw(const Scene&, const SceneNode*);
-
 	using Vertex = Vertex2D;
 
+	struct Packet {
+		VertexShader vertexShader;
+		PixelShader pixelShader;
+
+		struct Part {
+			GpuBufferRef vertexBuffer;
+			u32 vertexCount = 0;
+			ShaderViewRef texture;
+		};
+		std::vector<Part> parts;
+
+		struct Draw {
+			Mat3 transform = Mat3Id;
+			Vec4 color = Vec4(1);
+			Vec2 parallax = Vec2(1);
+			u32 firstPart = 0;
+			u32 partCount = 0;
+		};
+		std::vector<Draw> draws;
+	};
+
+	// Clears the packet, called at the start of every frame's extraction.
+	void newFrame(Packet&);
+
+	// Appends the given parts of the node's TileLayer to the packet, e.g. the
+	// visible ones. Returns false if there is nothing to draw.
+	bool extract(const Scene&, const SceneNode*, std::span<const u32> parts, Packet&);
+
+	void draw(const Packet&, u32 drawIndex);
+
   private:
 	RenderDevice& m_renderDevice;
+	AssetCache& m_assetCache;
 
-	GpuBuffer m_constantBuffer;
-
-	AssetPtr<VertexShader> m_vertexShader;
-	AssetPtr<PixelShader> m_pixelShader;
+	AssetPins m_assetPins;
+	AssetHandle<VertexShader> m_vertexShader;
+	AssetHandle<PixelShader> m_pixelShader;
 };
 
 } // namespace Anker
@@ -0,0 +1,55 @@
+#include <anker/graphics/anker_upload_ring.hpp>
+
+namespace Anker {
+
+// Upper bound of the capacity, buffer sizes are 32-bit.
+const u64 MaxUploadRingCapacity = u64(1) << 31;
+
+UploadRing::UploadRing(u32 capacity) : m_capacity(capacity), m_head(capacity) {}
+
+std::optional<UploadRing::Allocation> UploadRing::allocate(u32 size, u32 alignment)
+{
+	ANKER_CHECK(std::has_single_bit(alignment), std::nullopt);
+
+	if (size > m_capacity) {
+		return std::nullopt;
+	}
+
+	Allocation allocation = {.offset = (m_head + alignment - 1) & ~(alignment - 1)};
+
+	// The remainder of the buffer is skipped, hence counted as used. An offset
+	// at the end is not within the buffer, even for empty allocations.
+	if (allocation.offset >= m_capacity || allocation.offset > m_capacity - size) {
+		m_frameUsage += m_capacity - m_head;
+		m_head = 0;
+		allocation = {.offset = 0, .discard = true};
+	}
+
+	m_frameUsage += allocation.offset + size - m_head;
+	m_head = allocation.offset + size;
+
+	return allocation;
+}
+
+void UploadRing::grow(u32 size)
+{
+	const u64 capacity = std::max(u64(size) * FramesPerBuffer, u64(m_capacity) * 2);
+	m_capacity = u32(std::min(std::bit_ceil(capacity), MaxUploadRingCapacity));
+
+	// The recreated buffer is discarded by the first allocation.
+	m_head = m_capacity;
+}
+
+bool UploadRing::endFrame()
+{
+	m_previousFrameUsage = std::exchange(m_frameUsage, 0);
+
+	if (u64(m_previousFrameUsage) * FramesPerBuffer <= m_capacity) {
+		return false;
+	}
+
+	grow(m_previousFrameUsage);
+	return true;
+}
+
+} // namespace Anker
@@ -0,0 +1,59 @@
+#pragma once
+
+namespace Anker {
+
+// UploadRing sub-allocates ranges of a buffer for transient data, which is
+// written once and consumed by draws of the current frame. It only tracks
+// offsets; the buffer is owned by the user, see RenderDevice::uploadVertices.
+//
+// Allocations are placed back to back, across frames. When the end of the
+// buffer is reached, allocation continues at the start and the previous
+// contents of the buffer are discarded, i.e. mapped with
+// D3D11_MAP_WRITE_DISCARD. This invalidates all earlier allocations.
+//
+// The capacity only grows between frames, such that several frames fit before
+// wrapping, unless a single allocation exceeds it.
+class UploadRing {
+  public:
+	// Frames expected to fit into the buffer before it wraps.
+	static constexpr u32 FramesPerBuffer = 3;
+
+	explicit UploadRing(u32 capacity);
+	UploadRing(const UploadRing&) = delete;
+	UploadRing& operator=(const UploadRing&) = delete;
+	UploadRing(UploadRing&&) noexcept = delete;
+	UploadRing& operator=(UploadRing&&) noexcept = delete;
+
+	struct Allocation {
+		u32 offset = 0;
+
+		// The buffer's contents must be discarded when writing this allocation.
+		bool discard = false;
+	};
+
+	// Alignment must be a power of two. Fails if size exceeds the capacity.
+	std::optional<Allocation> allocate(u32 size, u32 alignment);
+
+	// Grows the capacity geometrically to hold at least FramesPerBuffer times
+	// the given size. The buffer must be recreated, the next allocation starts
+	// at its beginning.
+	void grow(u32 size);
+
+	// Returns true if the capacity has been grown because the frame did not fit
+	// FramesPerBuffer times. The buffer must be recreated then.
+	bool endFrame();
+
+	u32 capacity() const { return m_capacity; }
+
+	// Bytes used by the previous frame, including alignment.
+	u32 frameUsage() const { return m_previousFrameUsage; }
+
+  private:
+	u32 m_capacity = 0;
+	u32 m_head = 0;
+
+	u32 m_frameUsage = 0;
+	u32 m_previousFrameUsage = 0;
+};
+
+} // namespace Anker
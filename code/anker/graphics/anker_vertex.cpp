@@ -2,19 +2,17 @@
 
 namespace Anker {
 
-const std::array<D3D11_INPUT_ELEMENT_DESC, 2> Vertex2D::ShaderInputs = {
-    D3D11_INPUT_ELEMENT_DESC{
-        .SemanticName = "POSITION",
-        .Format = DXGI_FORMAT_R32G32_FLOAT,
-        .AlignedByteOffset = offsetof(Vertex2D, position),
-        .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+const std::array<VertexInput, 2> Vertex2D::ShaderInputs = {
+    VertexInput{
+        .semantic = "POSITION",
+        .format = VertexFormat::Float2,
+        .offset = offsetof(Vertex2D, position),
     },
-    D3D11_INPUT_ELEMENT_DESC{
-        .SemanticName = "TEXCOORD",
-        .SemanticIndex = 0,
-        .Format = DXGI_FORMAT_R32G32_FLOAT,
-        .AlignedByteOffset = offsetof(Vertex2D, uv),
-        .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+    VertexInput{
+        .semantic = "TEXCOORD",
+        .semanticIndex = 0,
+        .format = VertexFormat::Float2,
+        .offset = offsetof(Vertex2D, uv),
     },
 };
 
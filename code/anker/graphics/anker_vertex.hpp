@@ -1,5 +1,7 @@
 #pragma once
 
+#include <anker/graphics/anker_gpu_types.hpp>
+
 namespace Anker {
 
 // Generally, each renderer can use its own vertex format; however, for 2D
@@ -8,7 +10,7 @@ struct Vertex2D {
 	Vec2 position;
 	Vec2 uv;
 
-	static const std::array<D3D11_INPUT_ELEMENT_DESC, 2> ShaderInputs;
+	static const std::array<VertexInput, 2> ShaderInputs;
 
 	static std::array<Vertex2D, 6> makeQuad(const Rect2& position, const Rect2& uv, //
 	                                        bool uvFlipX = false, bool uvFlipY = false);
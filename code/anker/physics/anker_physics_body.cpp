@@ -0,0 +1,239 @@
+#include <anker/physics/anker_physics_body.hpp>
+
+namespace Anker {
+
+static void writeShape(BinaryWriter& write, const b2Shape& shape)
+{
+	write(shape.m_type);
+	write(shape.m_radius);
+
+	switch (shape.m_type) {
+	case b2Shape::e_circle: {
+		auto& circle = static_cast<const b2CircleShape&>(shape);
+		write(circle.m_p);
+		break;
+	}
+	case b2Shape::e_edge: {
+		auto& edge = static_cast<const b2EdgeShape&>(shape);
+		write(edge.m_vertex0);
+		write(edge.m_vertex1);
+		write(edge.m_vertex2);
+		write(edge.m_vertex3);
+		write(edge.m_oneSided);
+		break;
+	}
+	case b2Shape::e_polygon: {
+		auto& polygon = static_cast<const b2PolygonShape&>(shape);
+		write(polygon.m_centroid);
+		write(polygon.m_count);
+		write.bytes(asBytes(std::span(polygon.m_vertices, usize(polygon.m_count))));
+		write.bytes(asBytes(std::span(polygon.m_normals, usize(polygon.m_count))));
+		break;
+	}
+	case b2Shape::e_chain: {
+		auto& chain = static_cast<const b2ChainShape&>(shape);
+		write(chain.m_count);
+		write.bytes(asBytes(std::span(chain.m_vertices, usize(chain.m_count))));
+		write(chain.m_prevVertex);
+		write(chain.m_nextVertex);
+		break;
+	}
+	default:
+		ANKER_ERROR("Unsupported shape type {}", int(shape.m_type));
+		break;
+	}
+}
+
+// Box2D prepends new fixtures to the list. Writing fixtures back to front
+// retains their order when they are re-created.
+static void writeFixtures(BinaryWriter& write, const b2Fixture* fixture)
+{
+	if (!fixture) {
+		return;
+	}
+
+	writeFixtures(write, fixture->GetNext());
+
+	write(fixture->GetFriction());
+	write(fixture->GetRestitution());
+	write(fixture->GetRestitutionThreshold());
+	write(fixture->GetDensity());
+	write(fixture->IsSensor());
+	write(fixture->GetFilterData());
+	writeShape(write, *fixture->GetShape());
+}
+
+// Creates a fixture on the given body from the serialized shape.
+static bool readFixture(BinaryReader& read, b2Body& body, b2FixtureDef& fixtureDef)
+{
+	b2Shape::Type type = b2Shape::e_typeCount;
+	float radius = 0;
+	ANKER_TRY(read(type));
+	ANKER_TRY(read(radius));
+
+	switch (type) {
+	case b2Shape::e_circle: {
+		b2CircleShape circle;
+		circle.m_radius = radius;
+		ANKER_TRY(read(circle.m_p));
+		fixtureDef.shape = &circle;
+		return body.CreateFixture(&fixtureDef) != nullptr;
+	}
+	case b2Shape::e_edge: {
+		b2EdgeShape edge;
+		edge.m_radius = radius;
+		ANKER_TRY(read(edge.m_vertex0));
+		ANKER_TRY(read(edge.m_vertex1));
+		ANKER_TRY(read(edge.m_vertex2));
+		ANKER_TRY(read(edge.m_vertex3));
+		ANKER_TRY(read(edge.m_oneSided));
+		fixtureDef.shape = &edge;
+		return body.CreateFixture(&fixtureDef) != nullptr;
+	}
+	case b2Shape::e_polygon: {
+		b2PolygonShape polygon;
+		polygon.m_radius = radius;
+		ANKER_TRY(read(polygon.m_centroid));
+		ANKER_TRY(read(polygon.m_count));
+		ANKER_TRY(polygon.m_count >= 0 && polygon.m_count <= b2_maxPolygonVertices);
+		ANKER_TRY(read.bytes(asBytesWritable(std::span(polygon.m_vertices, usize(polygon.m_count)))));
+		ANKER_TRY(read.bytes(asBytesWritable(std::span(polygon.m_normals, usize(polygon.m_count)))));
+		fixtureDef.shape = &polygon;
+		return body.CreateFixture(&fixtureDef) != nullptr;
+	}
+	case b2Shape::e_chain: {
+		int32 count = 0;
+		ANKER_TRY(read(count));
+		ANKER_TRY(count >= 2 && usize(count) * sizeof(b2Vec2) <= read.remaining());
+
+		std::vector<b2Vec2> vertices(static_cast<usize>(count));
+		b2Vec2 prevVertex, nextVertex;
+		ANKER_TRY(read.bytes(asBytesWritable(std::span(vertices))));
+		ANKER_TRY(read(prevVertex));
+		ANKER_TRY(read(nextVertex));
+
+		b2ChainShape chain;
+		chain.CreateChain(vertices.data(), count, prevVertex, nextVertex);
+		fixtureDef.shape = &chain;
+		return body.CreateFixture(&fixtureDef) != nullptr;
+	}
+	default:
+		return false;
+	}
+}
+
+void serialize(BinaryWriter& write, const PhysicsBody& physicsBody)
+{
+	const b2Body* body = physicsBody.body;
+
+	write(body != nullptr);
+	if (!body) {
+		return;
+	}
+
+	write(body->GetType());
+	write(body->GetPosition());
+	write(body->GetAngle());
+	write(body->GetLinearVelocity());
+	write(body->GetAngularVelocity());
+	write(body->GetLinearDamping());
+	write(body->GetAngularDamping());
+	write(body->GetGravityScale());
+	write(body->IsAwake());
+	write(body->IsSleepingAllowed());
+	write(body->IsBullet());
+	write(body->IsEnabled());
+	write(body->IsFixedRotation());
+
+	// Fixtures are prefixed with their size in bytes, so they can be skipped
+	// quickly when restoring an existing body.
+	const usize fixturesOffset = write.size();
+	write(u32(0));
+
+	u32 fixtureCount = 0;
+	for (auto* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+		fixtureCount++;
+	}
+	write(fixtureCount);
+	writeFixtures(write, body->GetFixtureList());
+
+	write.patch(fixturesOffset, u32(write.size() - fixturesOffset - sizeof(u32)));
+}
+
+bool serialize(BinaryReader& read, PhysicsBody& physicsBody)
+{
+	bool hasBody = false;
+	ANKER_TRY(read(hasBody));
+	if (!hasBody) {
+		return true;
+	}
+
+	b2BodyType type = b2_staticBody;
+	b2Vec2 position, linearVelocity;
+	float angle = 0, angularVelocity = 0;
+	float linearDamping = 0, angularDamping = 0, gravityScale = 0;
+	bool awake = false, sleepingAllowed = false, bullet = false, enabled = false, fixedRotation = false;
+
+	ANKER_TRY(read(type));
+	ANKER_TRY(read(position));
+	ANKER_TRY(read(angle));
+	ANKER_TRY(read(linearVelocity));
+	ANKER_TRY(read(angularVelocity));
+	ANKER_TRY(read(linearDamping));
+	ANKER_TRY(read(angularDamping));
+	ANKER_TRY(read(gravityScale));
+	ANKER_TRY(read(awake));
+	ANKER_TRY(read(sleepingAllowed));
+	ANKER_TRY(read(bullet));
+	ANKER_TRY(read(enabled));
+	ANKER_TRY(read(fixedRotation));
+
+	u32 fixturesSize = 0;
+	ANKER_TRY(read(fixturesSize));
+
+	b2Body* body = physicsBody.body;
+	ANKER_TRY(body);
+
+	body->SetType(type);
+
+	// Moving a body updates the broad-phase, skip this for bodies that did not
+	// move, like static colliders.
+	if (body->GetPosition() != position || body->GetAngle() != angle) {
+		body->SetTransform(position, angle);
+	}
+
+	body->SetLinearDamping(linearDamping);
+	body->SetAngularDamping(angularDamping);
+	body->SetGravityScale(gravityScale);
+	body->SetSleepingAllowed(sleepingAllowed);
+	body->SetBullet(bullet);
+	body->SetFixedRotation(fixedRotation);
+	body->SetEnabled(enabled);
+
+	if (body->GetFixtureList()) {
+		ANKER_TRY(read.skip(fixturesSize));
+	} else {
+		u32 fixtureCount = 0;
+		ANKER_TRY(read(fixtureCount));
+		for (u32 i = 0; i < fixtureCount; ++i) {
+			b2FixtureDef fixtureDef;
+			ANKER_TRY(read(fixtureDef.friction));
+			ANKER_TRY(read(fixtureDef.restitution));
+			ANKER_TRY(read(fixtureDef.restitutionThreshold));
+			ANKER_TRY(read(fixtureDef.density));
+			ANKER_TRY(read(fixtureDef.isSensor));
+			ANKER_TRY(read(fixtureDef.filter));
+			ANKER_TRY(readFixture(read, *body, fixtureDef));
+		}
+	}
+
+	// Velocities are set last, as they are discarded by some of the setters
+	// above. Setting awake to false clears them as well.
+	body->SetAwake(awake);
+	body->SetLinearVelocity(linearVelocity);
+	body->SetAngularVelocity(angularVelocity);
+
+	return true;
+}
+
+} // namespace Anker
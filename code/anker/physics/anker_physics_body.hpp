@@ -27,6 +27,12 @@ struct PhysicsBody {
 	std::vector<b2Contact*> touchingContacts;
 };
 
+// Serializes the state of the body, including velocities and fixtures. When
+// reading, the state is applied to the existing body. Fixtures are only
+// created if the body has none, i.e. when it has just been created.
+void serialize(BinaryWriter&, const PhysicsBody&);
+bool serialize(BinaryReader&, PhysicsBody&);
+
 } // namespace Anker
 
 REFL_TYPE(Anker::PhysicsBody)
@@ -0,0 +1,22 @@
+#include <anker/platform/anker_file_dialogs.hpp>
+
+#if ANKER_HEADLESS
+
+namespace Anker {
+
+// Without window, there is nothing to show a dialog on. Behaves like a
+// cancelled dialog.
+
+std::optional<fs::path> openFileDialog()
+{
+	return std::nullopt;
+}
+
+std::optional<fs::path> saveFileDialog(const char*)
+{
+	return std::nullopt;
+}
+
+} // namespace Anker
+
+#endif
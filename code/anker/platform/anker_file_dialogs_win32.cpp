@@ -1,5 +1,7 @@
 #include <anker/platform/anker_file_dialogs.hpp>
 
+#if ANKER_PLATFORM_WINDOWS && !ANKER_HEADLESS
+
 #include <commdlg.h>
 
 #include <anker/platform/anker_platform.hpp>
@@ -48,3 +50,5 @@ std::optional<fs::path> saveFileDialog(const char* extension)
 }
 
 } // namespace Anker
+
+#endif
@@ -0,0 +1,34 @@
+#include <anker/platform/anker_file_watcher.hpp>
+
+namespace Anker {
+
+FileWatcher::FileWatcher(const fs::path& root) : m_root(root)
+{
+	if (!fs::is_directory(root)) {
+		return;
+	}
+
+	if (!start()) {
+		ANKER_WARN("{}: Change notifications unavailable", root);
+		return;
+	}
+
+	m_thread = std::thread([this] { run(); });
+}
+
+FileWatcher::~FileWatcher() noexcept
+{
+	if (m_thread.joinable()) {
+		stop();
+		m_thread.join();
+	}
+}
+
+void FileWatcher::push(fs::path filepath)
+{
+	if (!m_queue.push(std::move(filepath).lexically_normal())) {
+		m_overflow.store(true, std::memory_order_release);
+	}
+}
+
+} // namespace Anker
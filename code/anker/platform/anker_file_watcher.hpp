@@ -0,0 +1,58 @@
+#pragma once
+
+namespace Anker {
+
+// The FileWatcher observes a directory tree for modified files using the
+// operating system's change notification mechanism (ReadDirectoryChangesW on
+// Windows, inotify on Linux). Notifications are received on a background
+// thread and handed to the owning thread via a lock-free queue, hence
+// watching costs nothing while no files are modified.
+//
+// Only a single thread may drain modified files.
+class FileWatcher {
+  public:
+	explicit FileWatcher(const fs::path& root);
+	~FileWatcher() noexcept;
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+	FileWatcher(FileWatcher&&) noexcept = delete;
+	FileWatcher& operator=(FileWatcher&&) noexcept = delete;
+
+	// False if watching is not supported or could not be set up.
+	bool active() const { return m_thread.joinable(); }
+
+	// Pops the next modified file path, relative to the root directory. The
+	// same path may be reported multiple times.
+	std::optional<fs::path> pop() { return m_queue.pop(); }
+
+	// Returns true, and resets the flag, when notifications have been dropped
+	// since the previous call, either because the queue was full or the
+	// operating system's buffer overflowed. The caller needs to fall back to
+	// a full scan in this case.
+	bool consumeOverflow() { return m_overflow.exchange(false, std::memory_order_acquire); }
+
+  private:
+	// Implemented by the platform specific part.
+	bool start();
+	void stop();
+	void run();
+
+	void push(fs::path);
+
+	fs::path m_root;
+
+	SpscQueue<fs::path, 1024> m_queue;
+	std::atomic<bool> m_overflow = false;
+
+	// Platform specific state, defined alongside start, stop, and run.
+	struct Native;
+	struct NativeDeleter {
+		void operator()(Native*) const;
+	};
+	std::unique_ptr<Native, NativeDeleter> m_native;
+
+	std::thread m_thread;
+};
+
+} // namespace Anker
@@ -0,0 +1,152 @@
+#include <anker/platform/anker_file_watcher.hpp>
+
+#if ANKER_PLATFORM_LINUX
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace Anker {
+
+// inotify does not support watching a directory tree, hence every directory
+// is watched individually. Directories created later on are added by the
+// watcher thread.
+static constexpr u32 WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+struct FileWatcher::Native {
+	int inotify = -1;
+
+	// Written on stop to wake up the watcher thread.
+	int wakeup = -1;
+
+	// Watch descriptor -> directory, relative to root. Only accessed by the
+	// watcher thread once started.
+	std::unordered_map<int, fs::path> directories;
+
+	void watch(const fs::path& root, const fs::path& directory)
+	{
+		int wd = inotify_add_watch(inotify, (root / directory).c_str(), WatchMask);
+		if (wd < 0) {
+			ANKER_WARN("{}: Cannot watch directory: {}", root / directory, std::strerror(errno));
+			return;
+		}
+		directories[wd] = directory;
+
+		std::error_code err;
+		for (auto& entry : fs::directory_iterator(root / directory, err)) {
+			if (entry.is_directory(err)) {
+				watch(root, directory / entry.path().filename());
+			}
+		}
+	}
+};
+
+void FileWatcher::NativeDeleter::operator()(Native* native) const
+{
+	if (native->inotify >= 0) {
+		close(native->inotify);
+	}
+	if (native->wakeup >= 0) {
+		close(native->wakeup);
+	}
+	delete native;
+}
+
+bool FileWatcher::start()
+{
+	m_native.reset(new Native);
+
+	m_native->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	m_native->wakeup = eventfd(0, EFD_CLOEXEC);
+	if (m_native->inotify < 0 || m_native->wakeup < 0) {
+		ANKER_ERROR("Failed to initialize inotify: {}", std::strerror(errno));
+		return false;
+	}
+
+	m_native->watch(m_root, {});
+
+	return !m_native->directories.empty();
+}
+
+void FileWatcher::stop()
+{
+	u64 value = 1;
+	std::ignore = write(m_native->wakeup, &value, sizeof(value));
+}
+
+void FileWatcher::run()
+{
+	alignas(inotify_event) std::array<char, 16 * 1024> buffer;
+
+	std::array<pollfd, 2> fds{{
+	    {.fd = m_native->inotify, .events = POLLIN, .revents = 0},
+	    {.fd = m_native->wakeup, .events = POLLIN, .revents = 0},
+	}};
+
+	while (true) {
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			ANKER_ERROR("Failed to poll inotify: {}", std::strerror(errno));
+			return;
+		}
+
+		if (fds[1].revents) {
+			return;
+		}
+
+		ssize_t size = read(m_native->inotify, buffer.data(), buffer.size());
+		if (size <= 0) {
+			continue;
+		}
+
+		for (char* it = buffer.data(); it < buffer.data() + size;) {
+			auto* event = reinterpret_cast<const inotify_event*>(it);
+			it += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				m_overflow.store(true, std::memory_order_release);
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED) {
+				m_native->directories.erase(event->wd);
+				continue;
+			}
+
+			auto directory = m_native->directories.find(event->wd);
+			if (directory == m_native->directories.end() || event->len == 0) {
+				continue;
+			}
+
+			fs::path filepath = directory->second / event->name;
+
+			if (event->mask & IN_ISDIR) {
+				// Files may have been placed in the new directory before the
+				// watch got established.
+				m_native->watch(m_root, filepath);
+
+				std::error_code err;
+				for (auto& entry : fs::recursive_directory_iterator(m_root / filepath, err)) {
+					if (entry.is_regular_file(err)) {
+						push(fs::relative(entry.path(), m_root, err));
+					}
+				}
+				continue;
+			}
+
+			// Newly created files are reported once they are closed.
+			if (event->mask & IN_CREATE) {
+				continue;
+			}
+
+			push(std::move(filepath));
+		}
+	}
+}
+
+} // namespace Anker
+
+#endif
@@ -0,0 +1,120 @@
+#include <anker/platform/anker_file_watcher.hpp>
+
+#if ANKER_PLATFORM_WINDOWS
+
+namespace Anker {
+
+struct FileWatcher::Native {
+	HANDLE directory = INVALID_HANDLE_VALUE;
+	HANDLE changeEvent = nullptr;
+	HANDLE stopEvent = nullptr;
+
+	OVERLAPPED overlapped{};
+
+	// 64 KiB is the upper limit for directories on network shares.
+	alignas(DWORD) std::array<u8, 64 * 1024> buffer;
+};
+
+void FileWatcher::NativeDeleter::operator()(Native* native) const
+{
+	if (native->directory != INVALID_HANDLE_VALUE) {
+		CloseHandle(native->directory);
+	}
+	if (native->changeEvent) {
+		CloseHandle(native->changeEvent);
+	}
+	if (native->stopEvent) {
+		CloseHandle(native->stopEvent);
+	}
+	delete native;
+}
+
+bool FileWatcher::start()
+{
+	m_native.reset(new Native);
+
+	m_native->directory = CreateFileW(m_root.c_str(), FILE_LIST_DIRECTORY,                             //
+	                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, //
+	                                  OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (m_native->directory == INVALID_HANDLE_VALUE) {
+		ANKER_ERROR("{}: Failed to open directory: {}", m_root, win32ErrorMessage(GetLastError()));
+		return false;
+	}
+
+	m_native->changeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+	m_native->stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!m_native->changeEvent || !m_native->stopEvent) {
+		ANKER_ERROR("Failed to create event: {}", win32ErrorMessage(GetLastError()));
+		return false;
+	}
+
+	return true;
+}
+
+void FileWatcher::stop()
+{
+	SetEvent(m_native->stopEvent);
+}
+
+void FileWatcher::run()
+{
+	const DWORD notifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+	auto& native = *m_native;
+
+	while (true) {
+		native.overlapped = {};
+		native.overlapped.hEvent = native.changeEvent;
+
+		if (!ReadDirectoryChangesW(native.directory, native.buffer.data(), DWORD(native.buffer.size()), TRUE,
+		                           notifyFilter, nullptr, &native.overlapped, nullptr)) {
+			ANKER_ERROR("{}: Failed to watch directory: {}", m_root, win32ErrorMessage(GetLastError()));
+			return;
+		}
+
+		std::array handles = {native.changeEvent, native.stopEvent};
+		DWORD bytes = 0;
+
+		if (WaitForMultipleObjects(DWORD(handles.size()), handles.data(), FALSE, INFINITE) != WAIT_OBJECT_0) {
+			CancelIoEx(native.directory, &native.overlapped);
+			GetOverlappedResult(native.directory, &native.overlapped, &bytes, TRUE);
+			return;
+		}
+
+		if (!GetOverlappedResult(native.directory, &native.overlapped, &bytes, FALSE)) {
+			if (GetLastError() == ERROR_NOTIFY_ENUM_DIR) {
+				m_overflow.store(true, std::memory_order_release);
+				continue;
+			}
+			ANKER_ERROR("{}: Failed to watch directory: {}", m_root, win32ErrorMessage(GetLastError()));
+			return;
+		}
+
+		// Zero bytes indicates that the notification buffer overflowed.
+		if (bytes == 0) {
+			m_overflow.store(true, std::memory_order_release);
+			continue;
+		}
+
+		for (usize offset = 0;;) {
+			auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(native.buffer.data() + offset);
+
+			switch (info->Action) {
+			case FILE_ACTION_ADDED:
+			case FILE_ACTION_MODIFIED:
+			case FILE_ACTION_RENAMED_NEW_NAME:
+				push(fs::path(std::wstring_view(info->FileName, info->FileNameLength / sizeof(WCHAR))));
+				break;
+			}
+
+			if (info->NextEntryOffset == 0) {
+				break;
+			}
+			offset += info->NextEntryOffset;
+		}
+	}
+}
+
+} // namespace Anker
+
+#endif
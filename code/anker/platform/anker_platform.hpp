@@ -2,7 +2,7 @@
 
 #include <anker/core/anker_inputs.hpp>
 
-#if ANKER_PLATFORM_WINDOWS
+#if ANKER_PLATFORM_WINDOWS && !ANKER_HEADLESS
 using NativeWindow = HWND;
 #endif
 
@@ -22,13 +22,18 @@ bool shouldShutdown();
 ////////////////////////////////////////////////////////////
 // Window
 
-void createMainWindow();
+// A hidden main window is used for running without visible output, e.g. for
+// benchmarks. The render device still requires a window for its swapchain.
+// Headless builds have no window at all, only its size is kept.
+void createMainWindow(bool hidden = false);
 void destroyMainWindow();
 
 Vec2i windowSize();
 bool windowHasFocus();
 
+#if !ANKER_HEADLESS
 NativeWindow nativeWindow();
+#endif
 
 ////////////////////////////////////////////////////////////
 // Input / Cursor
@@ -36,6 +41,10 @@ NativeWindow nativeWindow();
 float inputValue(MkbInput);
 float inputValue(GamepadInput);
 
+// Overrides the state of the given input until the next injection or the next
+// corresponding event. Used to replay recorded input.
+void injectInput(MkbInput, bool down);
+
 Vec2 cursorPosition();
 Vec2 cursorDelta();
 Vec2 scrollDelta();
@@ -0,0 +1,117 @@
+#include <anker/platform/anker_platform.hpp>
+
+#if ANKER_HEADLESS
+
+#include <anker/core/anker_data_loader.hpp>
+#include <anker/core/anker_data_loader_filesystem.hpp>
+#include <anker/core/anker_derived_data_cache.hpp>
+
+namespace Anker::Platform {
+
+// The size of the main window in regular builds, which is also the size of
+// golden images.
+const Vec2i HeadlessWindowSize = {1280, 720};
+
+// Frame time handed to ImGui, which does not accept 0.
+const float HeadlessImguiDeltaTime = 1.0f / 60.0f;
+
+static std::optional<DataLoaderFilesystem> g_assetDataLoaderFs;
+
+static bool g_hasWindow = false;
+
+// There are no input devices, only injected inputs are pressed.
+static std::array<bool, EnumEntries<MkbInput>.size()> g_mkbState;
+
+void initialize()
+{
+	g_assetDataLoader.addSource(&g_assetDataLoaderFs.emplace("assets"));
+	g_derivedDataCache.setDirectory("cache");
+}
+
+void finalize()
+{
+	g_assetDataLoader.removeSource(&*g_assetDataLoaderFs);
+	g_assetDataLoaderFs.reset();
+}
+
+void tick() {}
+
+bool shouldShutdown()
+{
+	return false;
+}
+
+void createMainWindow(bool)
+{
+	g_hasWindow = true;
+}
+
+void destroyMainWindow()
+{
+	g_hasWindow = false;
+}
+
+Vec2i windowSize()
+{
+	ANKER_CHECK(g_hasWindow, {});
+	return HeadlessWindowSize;
+}
+
+bool windowHasFocus()
+{
+	return g_hasWindow;
+}
+
+float inputValue(MkbInput input)
+{
+	if (usize(input) >= g_mkbState.size()) {
+		return 0;
+	}
+	return g_mkbState[usize(input)];
+}
+
+void injectInput(MkbInput input, bool down)
+{
+	if (usize(input) < g_mkbState.size()) {
+		g_mkbState[usize(input)] = down;
+	}
+}
+
+float inputValue(GamepadInput)
+{
+	return 0.0f;
+}
+
+Vec2 cursorPosition()
+{
+	return {};
+}
+
+Vec2 cursorDelta()
+{
+	return {};
+}
+
+Vec2 scrollDelta()
+{
+	return {};
+}
+
+void hideCursor() {}
+
+void enableRelativeCursorMode() {}
+
+void imguiImplInit() {}
+
+void imguiImplNewFrame()
+{
+	auto& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(float(HeadlessWindowSize.x), float(HeadlessWindowSize.y));
+	io.DeltaTime = HeadlessImguiDeltaTime;
+}
+
+void imguiImplShutdown() {}
+
+} // namespace Anker::Platform
+
+#endif
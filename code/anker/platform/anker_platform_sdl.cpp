@@ -1,5 +1,7 @@
 #include <anker/platform/anker_platform.hpp>
 
+#if !ANKER_HEADLESS
+
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
 #include <SDL_syswm.h>
@@ -8,6 +10,7 @@
 
 #include <anker/core/anker_data_loader.hpp>
 #include <anker/core/anker_data_loader_filesystem.hpp>
+#include <anker/core/anker_derived_data_cache.hpp>
 
 namespace Anker::Platform {
 
@@ -93,6 +96,7 @@ void initialize()
 #include "anker_inputs_sdl.inc"
 
 	g_assetDataLoader.addSource(&g_assetDataLoaderFs.emplace("assets"));
+	g_derivedDataCache.setDirectory("cache");
 }
 
 void finalize()
@@ -104,8 +108,6 @@ void finalize()
 
 void tick()
 {
-	g_assetDataLoader.tick();
-
 	g_scrollDelta = Vec2(0);
 
 	SDL_Event event;
@@ -161,9 +163,10 @@ bool shouldShutdown()
 	return g_shouldShutdown;
 }
 
-void createMainWindow()
+void createMainWindow(bool hidden)
 {
-	g_sdlWindow = SDL_CreateWindow("Anker", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1280, 720, 0);
+	u32 flags = hidden ? SDL_WINDOW_HIDDEN : 0;
+	g_sdlWindow = SDL_CreateWindow("Anker", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1280, 720, flags);
 	if (!g_sdlWindow) {
 		ANKER_FATAL("Could not create main window: {}", SDL_GetError());
 	}
@@ -205,6 +208,13 @@ float inputValue(MkbInput input)
 	return g_mkbState[int(input)];
 }
 
+void injectInput(MkbInput input, bool down)
+{
+	if (usize(input) < g_mkbState.size()) {
+		g_mkbState[usize(input)] = down;
+	}
+}
+
 float inputValue(GamepadInput input)
 {
 	if (!g_gamepad) {
@@ -302,3 +312,5 @@ NativeWindow nativeWindow()
 }
 
 } // namespace Anker::Platform
+
+#endif
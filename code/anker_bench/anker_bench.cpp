@@ -0,0 +1,83 @@
+#include <anker_bench/anker_bench.hpp>
+
+namespace Anker::Bench {
+
+void Runner::add(Scenario scenario)
+{
+	m_scenarios.push_back(std::move(scenario));
+}
+
+std::vector<Result> Runner::run(const RunOptions& options)
+{
+	std::vector<Result> results;
+	for (auto& scenario : m_scenarios) {
+		if (scenario.name.find(options.filter) != std::string::npos) {
+			results.push_back(runScenario(scenario, options));
+		}
+	}
+	return results;
+}
+
+Result Runner::runScenario(Scenario& scenario, const RunOptions& options)
+{
+	ANKER_INFO("Running {}", scenario.name);
+
+	if (scenario.setup) {
+		scenario.setup();
+	}
+
+	for (u32 i = 0; i < scenario.warmupIterations; ++i) {
+		scenario.iteration(i);
+	}
+
+	const u32 iterations = std::max(options.iterations.value_or(scenario.iterations), 1u);
+
+	std::vector<float> timings;
+	timings.reserve(iterations);
+
+	const u64 allocationsBefore = allocationCount();
+	for (u32 i = 0; i < iterations; ++i) {
+		auto begin = Clock::now();
+		scenario.iteration(scenario.warmupIterations + i);
+		timings.push_back(std::chrono::duration<float, std::milli>(Clock::now() - begin).count());
+	}
+	const u64 allocations = allocationCount() - allocationsBefore;
+
+	if (scenario.teardown) {
+		scenario.teardown();
+	}
+
+	std::ranges::sort(timings);
+
+	// Nearest-rank percentile.
+	auto percentile = [&](float p) {
+		usize rank = usize(std::ceil(p * float(timings.size())));
+		return timings[std::clamp(rank, usize(1), timings.size()) - 1];
+	};
+
+	Result result;
+	result.name = scenario.name;
+	result.iterations = iterations;
+	result.minMs = timings.front();
+	result.medianMs = percentile(0.5f);
+	result.p99Ms = percentile(0.99f);
+	result.meanMs = std::accumulate(timings.begin(), timings.end(), 0.0f) / float(iterations);
+	result.allocationsPerIteration = float(allocations) / float(iterations);
+	return result;
+}
+
+std::string resultsToJson(std::span<const Result> results)
+{
+	JsonWriter write;
+	write.beginObject();
+	write.key("results");
+	write.beginArray();
+	for (auto& result : results) {
+		write(result);
+	}
+	write.endArray();
+	write.endObject();
+	return std::string(write.output());
+}
+
+} // namespace Anker::Bench
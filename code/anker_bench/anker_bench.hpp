@@ -0,0 +1,81 @@
+#pragma once
+
+namespace Anker::Bench {
+
+// A Scenario is a named piece of work that is measured repeatedly. Setup is
+// invoked once before warmup, teardown once after the last iteration. Only
+// the iteration function is measured.
+struct Scenario {
+	std::string name;
+	u32 warmupIterations = 3;
+	u32 iterations = 20;
+
+	std::function<void()> setup = {};
+	std::function<void(u32 iteration)> iteration = {};
+	std::function<void()> teardown = {};
+};
+
+struct Result {
+	std::string name;
+	u32 iterations = 0;
+	float minMs = 0;
+	float medianMs = 0;
+	float p99Ms = 0;
+	float meanMs = 0;
+	float allocationsPerIteration = 0;
+};
+
+struct RunOptions {
+	// Only scenarios containing this string are run.
+	std::string filter;
+
+	// Overrides the iteration count of every scenario, if set.
+	std::optional<u32> iterations;
+};
+
+class Runner {
+  public:
+	Runner() = default;
+	Runner(const Runner&) = delete;
+	Runner& operator=(const Runner&) = delete;
+	Runner(Runner&&) noexcept = delete;
+	Runner& operator=(Runner&&) noexcept = delete;
+
+	void add(Scenario);
+
+	std::vector<Result> run(const RunOptions&);
+
+	const std::vector<Scenario>& scenarios() const { return m_scenarios; }
+
+  private:
+	Result runScenario(Scenario&, const RunOptions&);
+
+	std::vector<Scenario> m_scenarios;
+};
+
+// Serializes results as JSON, suitable for tracking regressions over time.
+std::string resultsToJson(std::span<const Result>);
+
+////////////////////////////////////////////////////////////
+// Scenarios
+
+void addMapScenarios(Runner&);
+void addSimulationScenarios(Runner&);
+void addSerializeScenarios(Runner&);
+void addAssetScenarios(Runner&);
+void addFontScenarios(Runner&);
+void addSoftwareRasterScenarios(Runner&);
+void addParticleScenarios(Runner&);
+void addAudioScenarios(Runner&);
+
+} // namespace Anker::Bench
+
+REFL_TYPE(Anker::Bench::Result)
+REFL_FIELD(name)
+REFL_FIELD(iterations)
+REFL_FIELD(minMs)
+REFL_FIELD(medianMs)
+REFL_FIELD(p99Ms)
+REFL_FIELD(meanMs)
+REFL_FIELD(allocationsPerIteration)
+REFL_END
@@ -0,0 +1,54 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_derived_data_cache.hpp>
+#include <anker/core/anker_engine.hpp>
+
+namespace Anker::Bench {
+
+static void loadAndClearAssets()
+{
+	auto& assetCache = g_engine->assetCache;
+	for (auto identifier : {"textures/player"_hs, "tilesets/sewers_background"_hs, "tilesets/sewers_deco"_hs,
+	                        "tilesets/sewers_tiles"_hs}) {
+		std::ignore = assetCache.loadTexture(identifier);
+	}
+	std::ignore = assetCache.loadFont("fonts/Roboto"_hs);
+	std::ignore = assetCache.loadAudioTrack("sounds/bonk"_hs);
+	assetCache.clearUnused();
+}
+
+void addAssetScenarios(Runner& runner)
+{
+	// Every iteration loads a set of assets, drops all references and clears
+	// unused assets from the cache. Hence, each load request is a cache miss.
+	// Decoded data comes from the derived data cache, populated by warmup.
+	runner.add({
+	    .name = "asset_cache/churn",
+	    .iteration = [](u32) { loadAndClearAssets(); },
+	});
+
+	// Same as above, but every asset is decoded from its source.
+	runner.add({
+	    .name = "asset_cache/churn_decode",
+	    .setup = [] { g_derivedDataCache.enabled = false; },
+	    .iteration = [](u32) { loadAndClearAssets(); },
+	    .teardown = [] { g_derivedDataCache.enabled = true; },
+	});
+
+	// Repeated loads of the same assets, every request is a cache hit. The id
+	// is interned once, lookups only use its hash.
+	runner.add({
+	    .name = "asset_cache/hits",
+	    .setup = [] { g_engine->assetCache.loadTexture("textures/player"_hs); },
+	    .iteration =
+	        [](u32) {
+		        static const AssetId textureId = "textures/player"_hs;
+		        for (u32 i = 0; i < 10'000; ++i) {
+			        std::ignore = g_engine->assetCache.loadTexture(textureId);
+		        }
+	        },
+	    .teardown = [] { g_engine->assetCache.clearUnused(); },
+	});
+}
+
+} // namespace Anker::Bench
@@ -0,0 +1,98 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/audio/anker_audio_mixer.hpp>
+
+namespace Anker::Bench {
+
+const u32 MixSampleRate = 48000;
+
+// Frames per mix call, like an audio device buffer.
+const u32 MixBufferFrames = 512;
+
+// Each iteration renders one second of audio into memory.
+const u32 MixFramesPerIteration = MixSampleRate;
+
+static AudioSamplesPtr makeTone(u32 sampleRate, u32 channels, float frequency)
+{
+	auto samples = std::make_shared<AudioSamples>();
+	samples->sampleRate = sampleRate;
+	samples->channels = channels;
+
+	const u32 frameCount = sampleRate * 2;
+	samples->data.resize(usize(frameCount) * channels);
+	for (u32 i = 0; i < frameCount; ++i) {
+		const float value = 0.1f * std::sin(glm::two_pi<float>() * frequency * float(i) / float(sampleRate));
+		for (u32 channel = 0; channel < channels; ++channel) {
+			samples->data[usize(i) * channels + channel] = value;
+		}
+	}
+	return samples;
+}
+
+struct MixScenario {
+	std::string name;
+	u32 voices = 0;
+	u32 sampleRate = MixSampleRate;
+	u32 channels = 2;
+	float pitch = 1.0f;
+
+	// Changes the volume of every voice once per buffer, keeping them ramping.
+	bool rampVolume = false;
+};
+
+void addAudioScenarios(Runner& runner)
+{
+	const std::array scenarios = {
+	    MixScenario{.name = "audio_mix/voices_16", .voices = 16},
+	    MixScenario{.name = "audio_mix/voices_256", .voices = 256},
+	    MixScenario{.name = "audio_mix/voices_256_mono", .voices = 256, .channels = 1},
+	    MixScenario{.name = "audio_mix/voices_256_ramp", .voices = 256, .rampVolume = true},
+	    MixScenario{.name = "audio_mix/voices_256_resample", .voices = 256, .sampleRate = 44100, .pitch = 1.1f},
+	};
+
+	for (auto& scenario : scenarios) {
+		auto mixer = std::make_shared<std::unique_ptr<AudioMixer>>();
+		auto voices = std::make_shared<std::vector<AudioMixer::VoiceId>>();
+		auto output = std::make_shared<std::vector<float>>();
+
+		runner.add({
+		    .name = scenario.name,
+		    .warmupIterations = 2,
+		    .iterations = 50,
+		    .setup =
+		        [=] {
+			        *mixer = std::make_unique<AudioMixer>(MixSampleRate);
+			        output->resize(MixBufferFrames * AudioMixer::Channels);
+
+			        voices->clear();
+			        for (u32 i = 0; i < scenario.voices; ++i) {
+				        auto tone = makeTone(scenario.sampleRate, scenario.channels, 220.0f + 10.0f * float(i));
+				        const AudioPlayParams params = {.volume = 0.5f, .pitch = scenario.pitch, .loop = true};
+				        voices->push_back((*mixer)->play(tone, params));
+			        }
+		        },
+		    .iteration =
+		        [=](u32) {
+			        for (u32 frame = 0; frame < MixFramesPerIteration; frame += MixBufferFrames) {
+				        if (scenario.rampVolume) {
+					        const float volume = frame % (2 * MixBufferFrames) ? 0.25f : 0.75f;
+					        for (auto voice : *voices) {
+						        (*mixer)->setVolume(voice, volume, 0.01f);
+					        }
+				        }
+
+				        std::ranges::fill(*output, 0.0f);
+				        (*mixer)->mix(*output);
+				        (*mixer)->update();
+			        }
+		        },
+		    .teardown =
+		        [=] {
+			        ANKER_INFO("{}: {} active voices", scenario.name, (*mixer)->activeVoices());
+			        mixer->reset();
+		        },
+		});
+	}
+}
+
+} // namespace Anker::Bench
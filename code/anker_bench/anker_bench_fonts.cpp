@@ -0,0 +1,80 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_derived_data_cache.hpp>
+#include <anker/core/anker_engine.hpp>
+
+namespace Anker::Bench {
+
+// Bitmap glyphs are needed for every size text is displayed at. SDF glyphs are
+// generated once and serve all of these sizes.
+const std::array BitmapPixelSizes = {16u, 24u, 32u, 48u, 64u};
+
+static std::vector<char32_t> printableAscii()
+{
+	std::vector<char32_t> codepoints;
+	for (char32_t c = 0x20; c < 0x7F; ++c) {
+		codepoints.push_back(c);
+	}
+	return codepoints;
+}
+
+static void logGlyphCacheMemory(std::string_view scenario, GlyphMode mode)
+{
+	auto& glyphCache = g_engine->fontSystem.glyphCache(mode);
+	auto stats = glyphCache.stats();
+	ANKER_INFO("{}: {} glyphs, {} pages, {} KiB", scenario, stats.glyphs, stats.pages, glyphCache.byteSize() / 1024);
+}
+
+void addFontScenarios(Runner& runner)
+{
+	// Every iteration starts with empty glyph caches, pages remain allocated.
+	// Memory is logged after the last iteration.
+
+	// Printable ASCII rasterized at all sizes.
+	runner.add({
+	    .name = "fonts/bitmap_glyphs",
+	    .iteration =
+	        [](u32) {
+		        auto& fontSystem = g_engine->fontSystem;
+		        fontSystem.clearGlyphCaches();
+		        for (u32 pixelSize : BitmapPixelSizes) {
+			        for (char32_t codepoint : printableAscii()) {
+				        std::ignore = fontSystem.glyph(fontSystem.systemFont(), codepoint, pixelSize);
+			        }
+		        }
+	        },
+	    .teardown = [] { logGlyphCacheMemory("fonts/bitmap_glyphs", GlyphMode::Bitmap); },
+	});
+
+	// SDF base character set (printable ASCII and Latin-1) generated on the
+	// worker pool.
+	runner.add({
+	    .name = "fonts/sdf_glyphs",
+	    .setup = [] { g_derivedDataCache.enabled = false; },
+	    .iteration =
+	        [](u32) {
+		        auto& fontSystem = g_engine->fontSystem;
+		        fontSystem.clearGlyphCaches();
+		        fontSystem.prepareSdfGlyphs(fontSystem.systemFont(), printableAscii());
+	        },
+	    .teardown =
+	        [] {
+		        g_derivedDataCache.enabled = true;
+		        logGlyphCacheMemory("fonts/sdf_glyphs", GlyphMode::Sdf);
+	        },
+	});
+
+	// Same as above, but the glyphs come from the derived data cache,
+	// populated by warmup.
+	runner.add({
+	    .name = "fonts/sdf_glyphs_cached",
+	    .iteration =
+	        [](u32) {
+		        auto& fontSystem = g_engine->fontSystem;
+		        fontSystem.clearGlyphCaches();
+		        fontSystem.prepareSdfGlyphs(fontSystem.systemFont(), printableAscii());
+	        },
+	});
+}
+
+} // namespace Anker::Bench
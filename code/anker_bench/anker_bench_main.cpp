@@ -0,0 +1,85 @@
+#if !ANKER_HEADLESS
+#include <SDL_main.h>
+#endif
+
+#include <anker/core/anker_engine.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+#include <anker_bench/anker_bench.hpp>
+
+using namespace Anker;
+
+// The benchmark executable runs a set of scenarios against a regular engine
+// instance. The main window is hidden and vsync is disabled. Results are
+// written as JSON.
+//
+// Usage: anker_bench [--list] [--filter <text>] [--iterations <n>] [--output <file>]
+
+#if ANKER_HEADLESS
+int main(int argc, char* argv[])
+#else
+int SDL_main(int argc, char* argv[])
+#endif
+{
+	Bench::RunOptions options;
+	fs::path outputPath = "anker_bench.json";
+	bool listOnly = false;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--list") {
+			listOnly = true;
+		} else if (arg == "--filter" && hasValue) {
+			options.filter = argv[++i];
+		} else if (arg == "--iterations" && hasValue) {
+			options.iterations = u32(std::strtoul(argv[++i], nullptr, 10));
+		} else if (arg == "--output" && hasValue) {
+			outputPath = argv[++i];
+		} else {
+			ANKER_ERROR("Unknown argument: {}", arg);
+			return 1;
+		}
+	}
+
+	Platform::initialize();
+	Platform::createMainWindow(true);
+
+	g_engine.emplace();
+	g_engine->renderDevice.vsync = false;
+	g_engine->fixedDeltaTime = 1.0f / 60.0f;
+
+	Bench::Runner runner;
+	Bench::addMapScenarios(runner);
+	Bench::addSimulationScenarios(runner);
+	Bench::addSerializeScenarios(runner);
+	Bench::addAssetScenarios(runner);
+	Bench::addFontScenarios(runner);
+	Bench::addSoftwareRasterScenarios(runner);
+	Bench::addParticleScenarios(runner);
+	Bench::addAudioScenarios(runner);
+
+	int exitCode = 0;
+
+	if (listOnly) {
+		for (auto& scenario : runner.scenarios()) {
+			fmt::print("{}\n", scenario.name);
+		}
+	} else {
+		auto results = runner.run(options);
+		for (auto& result : results) {
+			ANKER_INFO("{}: min={:.3f}ms median={:.3f}ms p99={:.3f}ms allocs={:.1f}", result.name, result.minMs,
+			           result.medianMs, result.p99Ms, result.allocationsPerIteration);
+		}
+		if (not writeFile(Bench::resultsToJson(results), outputPath)) {
+			exitCode = 1;
+		}
+	}
+
+	g_engine.reset();
+
+	Platform::destroyMainWindow();
+	Platform::finalize();
+
+	return exitCode;
+}
@@ -0,0 +1,63 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_scene_snapshot.hpp>
+#include <anker/game/anker_map.hpp>
+
+namespace Anker::Bench {
+
+void addMapScenarios(Runner& runner)
+{
+	std::vector<fs::path> mapFilepaths;
+	for (auto& entry : fs::directory_iterator("assets/maps")) {
+		if (entry.path().extension() == ".tmj") {
+			mapFilepaths.push_back(entry.path());
+		}
+	}
+	std::ranges::sort(mapFilepaths);
+
+	// Assets are loaded during warmup, hence iterations measure map parsing and
+	// scene construction, not asset decoding.
+	for (auto& mapFilepath : mapFilepaths) {
+		auto mapIdentifier = toIdentifier(fs::relative(mapFilepath, "assets"));
+		runner.add({
+		    .name = "map_load/" + mapFilepath.stem().string(),
+		    .warmupIterations = 2,
+		    .iterations = 20,
+		    .iteration = [=](u32) { ScenePtr scene = loadMap(mapIdentifier); },
+		});
+	}
+
+	// Snapshots are the fast alternative to loading a map again; compare
+	// against map_load.
+	for (auto& mapFilepath : mapFilepaths) {
+		auto mapIdentifier = toIdentifier(fs::relative(mapFilepath, "assets"));
+		auto scene = std::make_shared<ScenePtr>();
+		auto snapshot = std::make_shared<SceneSnapshot>();
+
+		auto setup = [=] {
+			*scene = loadMap(mapIdentifier);
+			*snapshot = captureSceneSnapshot(**scene);
+			ANKER_INFO("{}: Snapshot size {} bytes", mapIdentifier, snapshot->data.size());
+		};
+		auto teardown = [=] {
+			scene->reset();
+			*snapshot = {};
+		};
+
+		runner.add({
+		    .name = "snapshot_capture/" + mapFilepath.stem().string(),
+		    .setup = setup,
+		    .iteration = [=](u32) { *snapshot = captureSceneSnapshot(**scene); },
+		    .teardown = teardown,
+		});
+
+		runner.add({
+		    .name = "snapshot_restore/" + mapFilepath.stem().string(),
+		    .setup = setup,
+		    .iteration = [=](u32) { std::ignore = restoreSceneSnapshot(**scene, *snapshot); },
+		    .teardown = teardown,
+		});
+	}
+}
+
+} // namespace Anker::Bench
@@ -0,0 +1,99 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_engine.hpp>
+#include <anker/core/anker_scene_node.hpp>
+#include <anker/graphics/anker_particle_emitter.hpp>
+#include <anker/graphics/anker_particle_renderer.hpp>
+
+namespace Anker::Bench {
+
+const float ParticleTimestep = 1.0f / 60.0f;
+
+// Emits ParticleCount particles per ParticleLifetime, such that the pool stays
+// saturated once warmed up.
+const u32 ParticleCount = 100'000;
+const float ParticleLifetime = 2.0f;
+
+// The scene is not activated, hence nothing is rendered and only the particle
+// simulation is measured.
+static ScenePtr createParticleScene(bool collide)
+{
+	auto scene = g_engine->createScene();
+
+	auto emitter = scene->createEntity("Emitter");
+	emitter.emplace<SceneNode>(Transform2D(Vec2(0, 8)));
+	emitter.emplace<ParticleEmitter>(ParticleEmitter{
+	    .rate = float(ParticleCount) / ParticleLifetime,
+	    .maxParticles = int(ParticleCount),
+	    .lifetime = ParticleLifetime,
+	    .spawnExtent = Vec2(16, 1),
+	    .velocity = Vec2(0, 2),
+	    .velocityVariance = Vec2(2),
+	    .acceleration = 10.0f * Vec2::WorldDown,
+	    .drag = 0.1f,
+	    .texture = {},
+	    .collide = collide,
+	    .pool = {},
+	});
+
+	// Ground the particles land on, a floor of boxes like a tiled map.
+	if (collide) {
+		b2BodyDef bodyDef;
+		auto* ground = scene->physicsWorld->CreateBody(&bodyDef);
+		for (i32 x = -16; x < 16; ++x) {
+			b2PolygonShape box;
+			box.SetAsBox(0.5f, 0.5f, b2Vec2(float(x) + 0.5f, -0.5f), 0.0f);
+			ground->CreateFixture(&box, 0.0f);
+		}
+	}
+
+	for (float t = 0.0f; t < ParticleLifetime; t += ParticleTimestep) {
+		ParticleEmitter::tick(ParticleTimestep, *scene);
+	}
+
+	return scene;
+}
+
+static const ParticlePool& particlePool(Scene& scene)
+{
+	auto view = scene.registry.view<ParticleEmitter>();
+	return view.get<ParticleEmitter>(view.front()).pool;
+}
+
+void addParticleScenarios(Runner& runner)
+{
+	auto scene = std::make_shared<ScenePtr>();
+
+	auto teardown = [=] {
+		ANKER_INFO("particles: {} live particles", particlePool(**scene).count);
+		scene->reset();
+	};
+
+	for (bool collide : {false, true}) {
+		runner.add({
+		    .name = fmt::format("particles/{}/{}", collide ? "collide" : "simulate", ParticleCount),
+		    .warmupIterations = 10,
+		    .iterations = 500,
+		    .setup = [=] { *scene = createParticleScene(collide); },
+		    .iteration = [=](u32) { ParticleEmitter::tick(ParticleTimestep, **scene); },
+		    .teardown = teardown,
+		});
+	}
+
+	// Culling against a view covering half of the emitter's area.
+	auto instances = std::make_shared<std::vector<ParticleRenderer::Instance>>();
+	runner.add({
+	    .name = fmt::format("particles/cull/{}", ParticleCount),
+	    .warmupIterations = 10,
+	    .iterations = 500,
+	    .setup = [=] { *scene = createParticleScene(false); },
+	    .iteration =
+	        [=](u32) {
+		        instances->clear();
+		        ParticleRenderer::cull(particlePool(**scene), Rect2(Vec2(16, 18), Vec2(0, -9)), *instances);
+	        },
+	    .teardown = teardown,
+	});
+}
+
+} // namespace Anker::Bench
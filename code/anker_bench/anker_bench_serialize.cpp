@@ -0,0 +1,247 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/game/anker_player_movement_params.hpp>
+#include <anker/graphics/anker_post_process_params.hpp>
+
+namespace Anker::Bench {
+
+constexpr u32 RoundTripsPerIteration = 1'000;
+constexpr u32 ReadsPerIteration = 1'000;
+
+// Synthetic parameter struct with many members, representing the worst case
+// for looking up keys by member name.
+struct SyntheticParams {
+	float value00 = 1.0f;
+	int value01 = 1;
+	bool value02 = true;
+	u32 value03 = 1;
+	float value04 = 1.0f;
+	int value05 = 1;
+	bool value06 = true;
+	u32 value07 = 1;
+	float value08 = 1.0f;
+	int value09 = 1;
+	bool value10 = true;
+	u32 value11 = 1;
+	float value12 = 1.0f;
+	int value13 = 1;
+	bool value14 = true;
+	u32 value15 = 1;
+	float value16 = 1.0f;
+	int value17 = 1;
+	bool value18 = true;
+	u32 value19 = 1;
+	float value20 = 1.0f;
+	int value21 = 1;
+	bool value22 = true;
+	u32 value23 = 1;
+	float value24 = 1.0f;
+	int value25 = 1;
+	bool value26 = true;
+	u32 value27 = 1;
+	float value28 = 1.0f;
+	int value29 = 1;
+	bool value30 = true;
+	u32 value31 = 1;
+	float value32 = 1.0f;
+	int value33 = 1;
+	bool value34 = true;
+	u32 value35 = 1;
+	float value36 = 1.0f;
+	int value37 = 1;
+	bool value38 = true;
+	u32 value39 = 1;
+	float value40 = 1.0f;
+	int value41 = 1;
+	bool value42 = true;
+	u32 value43 = 1;
+	float value44 = 1.0f;
+	int value45 = 1;
+	bool value46 = true;
+	u32 value47 = 1;
+};
+
+} // namespace Anker::Bench
+
+REFL_TYPE(Anker::Bench::SyntheticParams)
+REFL_FIELD(value00)
+REFL_FIELD(value01)
+REFL_FIELD(value02)
+REFL_FIELD(value03)
+REFL_FIELD(value04)
+REFL_FIELD(value05)
+REFL_FIELD(value06)
+REFL_FIELD(value07)
+REFL_FIELD(value08)
+REFL_FIELD(value09)
+REFL_FIELD(value10)
+REFL_FIELD(value11)
+REFL_FIELD(value12)
+REFL_FIELD(value13)
+REFL_FIELD(value14)
+REFL_FIELD(value15)
+REFL_FIELD(value16)
+REFL_FIELD(value17)
+REFL_FIELD(value18)
+REFL_FIELD(value19)
+REFL_FIELD(value20)
+REFL_FIELD(value21)
+REFL_FIELD(value22)
+REFL_FIELD(value23)
+REFL_FIELD(value24)
+REFL_FIELD(value25)
+REFL_FIELD(value26)
+REFL_FIELD(value27)
+REFL_FIELD(value28)
+REFL_FIELD(value29)
+REFL_FIELD(value30)
+REFL_FIELD(value31)
+REFL_FIELD(value32)
+REFL_FIELD(value33)
+REFL_FIELD(value34)
+REFL_FIELD(value35)
+REFL_FIELD(value36)
+REFL_FIELD(value37)
+REFL_FIELD(value38)
+REFL_FIELD(value39)
+REFL_FIELD(value40)
+REFL_FIELD(value41)
+REFL_FIELD(value42)
+REFL_FIELD(value43)
+REFL_FIELD(value44)
+REFL_FIELD(value45)
+REFL_FIELD(value46)
+REFL_FIELD(value47)
+REFL_END
+
+namespace Anker::Bench {
+
+// Consumes all parsing events without doing anything, used to measure raw
+// parsing performance of JsonStreamReader.
+class NullJsonStreamHandler : public JsonStreamHandler<NullJsonStreamHandler> {
+  public:
+	bool beginObject() { return true; }
+	bool endObject() { return true; }
+	bool beginArray() { return true; }
+	bool endArray() { return true; }
+	bool value(const JsonStreamValue&) { return true; }
+};
+
+template <typename T>
+static void addJsonRoundTripScenario(Runner& runner)
+{
+	runner.add({
+	    .name = fmt::format("json_roundtrip/{}", get_simple_name(refl::reflect<T>()).c_str()),
+	    .iteration =
+	        [](u32) {
+		        T value;
+		        for (u32 i = 0; i < RoundTripsPerIteration; ++i) {
+			        JsonWriter write;
+			        write(value);
+
+			        JsonReader read;
+			        std::ignore = read.parse(write.output());
+			        read(value);
+		        }
+	        },
+	});
+}
+
+// Same as the JSON round trip, for comparison with the binary archives.
+template <typename T>
+static void addBinaryRoundTripScenario(Runner& runner)
+{
+	runner.add({
+	    .name = fmt::format("binary_roundtrip/{}", get_simple_name(refl::reflect<T>()).c_str()),
+	    .iteration =
+	        [](u32) {
+		        T value;
+		        for (u32 i = 0; i < RoundTripsPerIteration; ++i) {
+			        BinaryWriter write;
+			        write(value);
+
+			        BinaryReader read(write.output());
+			        read(value);
+		        }
+	        },
+	});
+}
+
+// Measures deserialization of an already parsed document, isolating the
+// reflective member lookup from JSON parsing.
+template <typename T>
+static void addJsonReadScenario(Runner& runner)
+{
+	auto read = std::make_shared<JsonReader>();
+
+	runner.add({
+	    .name = fmt::format("json_read/{}", get_simple_name(refl::reflect<T>()).c_str()),
+	    .setup =
+	        [=] {
+		        JsonWriter write;
+		        write(T());
+		        std::ignore = read->parse(write.output());
+	        },
+	    .iteration =
+	        [=](u32) {
+		        T value;
+		        for (u32 i = 0; i < ReadsPerIteration; ++i) {
+			        (*read)(value);
+		        }
+	        },
+	});
+}
+
+void addSerializeScenarios(Runner& runner)
+{
+	addJsonRoundTripScenario<PlayerMovementParams>(runner);
+	addJsonRoundTripScenario<PostProcessParams>(runner);
+	addJsonRoundTripScenario<SyntheticParams>(runner);
+
+	addBinaryRoundTripScenario<PlayerMovementParams>(runner);
+	addBinaryRoundTripScenario<PostProcessParams>(runner);
+	addBinaryRoundTripScenario<SyntheticParams>(runner);
+
+	addJsonReadScenario<PlayerMovementParams>(runner);
+	addJsonReadScenario<PostProcessParams>(runner);
+	addJsonReadScenario<SyntheticParams>(runner);
+
+	// Parsing map files gives a JSON workload of realistic size. The DOM-based
+	// JsonReader is compared against the in-situ JsonStreamReader. Since
+	// in-situ parsing modifies the input, the stream variant includes copying
+	// the input into a scratch buffer.
+	for (auto mapIdentifier : {"maps/gym", "maps/sewers00"}) {
+		auto input = std::make_shared<ByteBuffer>();
+		auto scratch = std::make_shared<ByteBuffer>();
+		auto setup = [=] { std::ignore = readFile(*input, fmt::format("assets/{}.tmj", mapIdentifier)); };
+		auto teardown = [=] {
+			*input = {};
+			*scratch = {};
+		};
+
+		runner.add({
+		    .name = fmt::format("json_parse/dom/{}", mapIdentifier),
+		    .setup = setup,
+		    .iteration =
+		        [=](u32) {
+			        JsonReader read;
+			        std::ignore = read.parse(*input);
+		        },
+		    .teardown = teardown,
+		});
+
+		runner.add({
+		    .name = fmt::format("json_parse/stream/{}", mapIdentifier),
+		    .setup = setup,
+		    .iteration =
+		        [=](u32) {
+			        scratch->assign(input->begin(), input->end());
+			        NullJsonStreamHandler handler;
+			        std::ignore = JsonStreamReader::parse(*scratch, handler);
+		        },
+		    .teardown = teardown,
+		});
+	}
+}
+
+} // namespace Anker::Bench
@@ -0,0 +1,102 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_engine.hpp>
+#include <anker/core/anker_scene_node.hpp>
+#include <anker/game/anker_map.hpp>
+#include <anker/graphics/anker_sprite.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+namespace Anker::Bench {
+
+// Input script replayed during simulation. The script loops every
+// InputScriptLength frames. An input is held down within [begin, end).
+struct ScriptedInput {
+	MkbInput input;
+	u32 begin;
+	u32 end;
+};
+
+constexpr u32 InputScriptLength = 600;
+
+constexpr std::array InputScript = {
+    ScriptedInput{MkbInput::Right, 0, 240},
+    ScriptedInput{MkbInput::Space, 30, 40},
+    ScriptedInput{MkbInput::Space, 150, 160},
+    ScriptedInput{MkbInput::Space, 170, 180},
+    ScriptedInput{MkbInput::LeftShift, 200, 205},
+    ScriptedInput{MkbInput::Left, 300, 540},
+    ScriptedInput{MkbInput::Space, 330, 340},
+    ScriptedInput{MkbInput::LeftShift, 380, 385},
+    ScriptedInput{MkbInput::Space, 420, 430},
+    ScriptedInput{MkbInput::Down, 560, 570},
+};
+
+static void replayInput(u32 frame)
+{
+	frame %= InputScriptLength;
+	for (auto& scripted : InputScript) {
+		Platform::injectInput(scripted.input, scripted.begin <= frame && frame < scripted.end);
+	}
+}
+
+static void releaseInput()
+{
+	for (auto& scripted : InputScript) {
+		Platform::injectInput(scripted.input, false);
+	}
+}
+
+static void tickFrame()
+{
+	Platform::tick();
+	g_engine->tick();
+}
+
+void addSimulationScenarios(Runner& runner)
+{
+	// Each iteration is a single frame, hence the timings describe the frame
+	// time distribution of the simulation.
+	runner.add({
+	    .name = "simulation/sewers00",
+	    .warmupIterations = 60,
+	    .iterations = 10'000,
+	    .setup = [] { g_engine->nextScene = loadMap("maps/sewers00"); },
+	    .iteration =
+	        [](u32 frame) {
+		        replayInput(frame);
+		        tickFrame();
+	        },
+	    .teardown = [] { releaseInput(); },
+	});
+
+	// Lots of sprites, laid out in a grid covering the view.
+	for (u32 spriteCount : {1'000u, 10'000u}) {
+		runner.add({
+		    .name = fmt::format("sprites/{}", spriteCount),
+		    .warmupIterations = 10,
+		    .iterations = 500,
+		    .setup =
+		        [=] {
+			        auto scene = g_engine->createScene();
+			        auto& assetCache = g_engine->assetCache;
+			        auto texture = assetCache.loadSpriteTexture("textures/player"_hs);
+			        assetCache.pin(scene->assetPins, texture.texture);
+
+			        u32 columns = u32(std::sqrt(float(spriteCount)));
+			        for (u32 i = 0; i < spriteCount; ++i) {
+				        Vec2 position = {float(i % columns), float(i / columns)};
+				        position = position / float(columns) * Vec2(32, 18) - Vec2(16, 9);
+
+				        auto entity = scene->createEntity();
+				        entity.emplace<SceneNode>(Transform2D(position));
+				        entity.emplace<Sprite>(Sprite{.texture = texture.texture, .textureRect = texture.rect});
+			        }
+
+			        g_engine->nextScene = scene;
+		        },
+		    .iteration = [](u32) { tickFrame(); },
+		});
+	}
+}
+
+} // namespace Anker::Bench
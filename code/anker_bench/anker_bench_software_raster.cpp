@@ -0,0 +1,37 @@
+#include <anker_bench/anker_bench.hpp>
+
+#include <anker/core/anker_engine.hpp>
+#include <anker/game/anker_map.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+namespace Anker::Bench {
+
+void addSoftwareRasterScenarios([[maybe_unused]] Runner& runner)
+{
+#if ANKER_HEADLESS
+	// Each iteration simulates and renders one engine frame of the gym map,
+	// i.e. the measurement includes simulation. The last frame is written to
+	// anker_bench_software_raster.png, see anker_golden for the comparison.
+	runner.add({
+	    .name = "software_raster/gym",
+	    .setup =
+	        [] {
+		        g_engine->nextScene = loadMap("maps/gym");
+		        g_engine->tick();
+	        },
+	    .iteration =
+	        [](u32) {
+		        Platform::tick();
+		        g_engine->tick();
+		        g_engine->renderThread.wait();
+	        },
+	    .teardown =
+	        [] {
+		        std::ignore = writePng(g_engine->renderDevice.backBuffer(), "anker_bench_software_raster.png");
+		        g_engine->activeScene.reset();
+	        },
+	});
+#endif
+}
+
+} // namespace Anker::Bench
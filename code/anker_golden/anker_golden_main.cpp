@@ -0,0 +1,113 @@
+#include <anker/core/anker_engine.hpp>
+#include <anker/game/anker_map.hpp>
+#include <anker/platform/anker_platform.hpp>
+
+using namespace Anker;
+
+// The golden image test renders maps in a headless build, i.e. with the
+// software rasterizer, and compares the frames against golden images committed
+// next to this file. Simulation uses a fixed delta-time without input, hence
+// frames are deterministic.
+//
+// Usage: anker_golden [--update] [--output <directory>]
+//
+// Frames differing from their golden image are written to the output directory
+// for inspection. --update overwrites the golden images instead.
+
+const fs::path GoldenDirectory = "code/anker_golden/golden";
+
+const std::array GoldenMaps = {"gym"};
+
+// Ticks before the frame is taken, lets the player settle on the ground.
+const u32 GoldenTicks = 30;
+
+// Allows for rounding differences across compilers, anything else fails.
+const float GoldenTolerance = 2.0f / 255.0f;
+
+static Status renderMap(Texture& outFrame, const std::string& mapName)
+{
+	g_engine->nextScene = loadMap("maps/" + mapName);
+	ANKER_CHECK(g_engine->nextScene, ReadError);
+
+	for (u32 i = 0; i < GoldenTicks; ++i) {
+		Platform::tick();
+		g_engine->tick();
+	}
+	g_engine->renderThread.wait();
+
+	// Shares the pixels of the back buffer, no further frames are drawn.
+	outFrame = g_engine->renderDevice.backBuffer();
+	return Ok;
+}
+
+static bool checkMap(const std::string& mapName, bool update, const fs::path& outputDirectory)
+{
+	auto goldenFilepath = GoldenDirectory / (mapName + ".png");
+
+	Texture frame;
+	if (not renderMap(frame, mapName)) {
+		ANKER_ERROR("{}: Rendering failed", mapName);
+		return false;
+	}
+
+	if (update) {
+		return bool(writePng(frame, goldenFilepath));
+	}
+
+	Texture golden;
+	if (not readPng(golden, goldenFilepath)) {
+		ANKER_ERROR("{}: Golden image missing, run with --update to create it", mapName);
+		return false;
+	}
+
+	auto difference = compareImages(frame, golden, GoldenTolerance);
+	if (difference.differingPixels > 0) {
+		auto outputFilepath = outputDirectory / (mapName + ".png");
+		ANKER_ERROR("{}: {} pixels differ from the golden image, by up to {:.3f}, see {}", mapName,
+		            difference.differingPixels, difference.maxDifference, outputFilepath);
+		std::ignore = writePng(frame, outputFilepath);
+		return false;
+	}
+
+	ANKER_INFO("{}: Matches the golden image", mapName);
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	bool update = false;
+	fs::path outputDirectory = ".";
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--update") {
+			update = true;
+		} else if (arg == "--output" && hasValue) {
+			outputDirectory = argv[++i];
+		} else {
+			ANKER_ERROR("Unknown argument: {}", arg);
+			return 1;
+		}
+	}
+
+	Platform::initialize();
+	Platform::createMainWindow(true);
+
+	g_engine.emplace();
+	g_engine->fixedDeltaTime = 1.0f / 60.0f;
+
+	int exitCode = 0;
+	for (std::string mapName : GoldenMaps) {
+		if (!checkMap(mapName, update, outputDirectory)) {
+			exitCode = 1;
+		}
+	}
+
+	g_engine.reset();
+
+	Platform::destroyMainWindow();
+	Platform::finalize();
+
+	return exitCode;
+}
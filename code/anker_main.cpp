@@ -8,6 +8,10 @@ using namespace Anker;
 
 int SDL_main(int argc, char* argv[])
 {
+#if ANKER_PROFILE_BACKEND == ANKER_PROFILE_BACKEND_BUILTIN
+	Profiler::writeCaptureAtExit("anker_profile.json");
+#endif
+
 	Platform::initialize();
 	Platform::createMainWindow();
 
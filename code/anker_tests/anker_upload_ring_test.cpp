@@ -0,0 +1,82 @@
+#include <anker/graphics/anker_upload_ring.hpp>
+
+using namespace Anker;
+
+// Tests UploadRing's offset arithmetic, no buffer is involved.
+//
+// Usage: anker_upload_ring_test
+
+static bool g_failed = false;
+
+static void expect(bool condition, std::string_view description)
+{
+	if (!condition) {
+		ANKER_ERROR("Failed: {}", description);
+		g_failed = true;
+	}
+}
+
+static void expectAllocation(std::optional<UploadRing::Allocation> allocation, u32 offset, bool discard,
+                             std::string_view description)
+{
+	expect(allocation && allocation->offset == offset && allocation->discard == discard, description);
+}
+
+static void testBackToBack()
+{
+	UploadRing ring(1024);
+	expectAllocation(ring.allocate(10, 16), 0, true, "first allocation discards");
+	expectAllocation(ring.allocate(10, 16), 16, false, "second allocation is aligned");
+	expectAllocation(ring.allocate(4, 4), 28, false, "third allocation follows back to back");
+}
+
+static void testWrap()
+{
+	UploadRing ring(64);
+	expectAllocation(ring.allocate(40, 1), 0, true, "first allocation discards");
+	expectAllocation(ring.allocate(16, 8), 40, false, "allocation fits before the end");
+	expectAllocation(ring.allocate(16, 8), 0, true, "allocation past the end wraps and discards");
+	expectAllocation(ring.allocate(8, 8), 16, false, "allocation after the wrap continues");
+}
+
+static void testOversized()
+{
+	UploadRing ring(64);
+	expect(!ring.allocate(65, 1), "allocation exceeding the capacity fails");
+	expectAllocation(ring.allocate(64, 1), 0, true, "allocation of the whole capacity succeeds");
+}
+
+static void testGrowth()
+{
+	UploadRing ring(64);
+	std::ignore = ring.allocate(16, 1);
+	expect(!ring.endFrame(), "frame fitting FramesPerBuffer times does not grow");
+	expect(ring.frameUsage() == 16, "frame usage is tracked");
+
+	std::ignore = ring.allocate(60, 1);
+	expect(ring.endFrame(), "frame not fitting FramesPerBuffer times grows");
+	expect(ring.capacity() >= 60 * UploadRing::FramesPerBuffer, "capacity holds FramesPerBuffer frames");
+	expect(std::has_single_bit(ring.capacity()), "capacity is a power of two");
+	expectAllocation(ring.allocate(8, 1), 0, true, "first allocation after growth discards");
+}
+
+static void testZeroSize()
+{
+	UploadRing ring(64);
+	expectAllocation(ring.allocate(0, 16), 0, true, "zero-size first allocation discards");
+	expectAllocation(ring.allocate(8, 16), 0, false, "zero-size allocation takes no space");
+}
+
+int main()
+{
+	testBackToBack();
+	testWrap();
+	testOversized();
+	testGrowth();
+	testZeroSize();
+
+	if (!g_failed) {
+		ANKER_INFO("All UploadRing tests passed");
+	}
+	return g_failed ? 1 : 0;
+}